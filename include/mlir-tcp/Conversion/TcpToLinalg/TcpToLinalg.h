@@ -21,5 +21,8 @@ namespace tcp {
 
 std::unique_ptr<OperationPass<func::FuncOp>> createConvertTcpToLinalgPass();
 
+std::unique_ptr<OperationPass<func::FuncOp>>
+createConvertTcpToLinalgPass(bool reassociateFP);
+
 } // namespace tcp
 } // namespace mlir
@@ -9,8 +9,83 @@
 
 #pragma once
 
+#include "mlir/Pass/PassOptions.h"
+
+#include <string>
+
 namespace mlir {
 namespace tcp {
+
+// Options of `tcp-to-llvm-pipeline`. The optimization level picks the
+// defaults of the individual optimizations, any of which can also be set
+// explicitly:
+//   O0: scalar code, no optimizations. The default.
+//   O1: fusion of elementwise ops and memory planning.
+//   O2: O1 plus vectorization.
+//   O3: O2 plus multi-threading on 8 threads.
+struct TcpToLlvmPipelineOptions
+    : public PassPipelineOptions<TcpToLlvmPipelineOptions> {
+  PassOptions::Option<unsigned> optLevel{
+      *this, "opt-level",
+      llvm::cl::desc("Optimization level, from 0 to 3"), llvm::cl::init(0)};
+  PassOptions::Option<bool> fuseElementwise{
+      *this, "fuse-elementwise",
+      llvm::cl::desc("Fuse chains of elementwise linalg ops into a single "
+                     "loop nest (default: derived from opt-level, enabled "
+                     "from O1)"),
+      llvm::cl::init(false)};
+  PassOptions::Option<bool> vectorize{
+      *this, "vectorize",
+      llvm::cl::desc("Vectorize linalg ops instead of lowering them to "
+                     "scalar loops (default: derived from opt-level, "
+                     "enabled from O2)"),
+      llvm::cl::init(false)};
+  PassOptions::Option<unsigned> vectorWidth{
+      *this, "vector-width",
+      llvm::cl::desc("Width of the vector registers in bits. Derived from "
+                     "`target-features` when zero"),
+      llvm::cl::init(0)};
+  PassOptions::Option<std::string> targetFeatures{
+      *this, "target-features",
+      llvm::cl::desc("Comma separated list of target features, e.g. "
+                     "`+avx2,+fma`. Set on the generated LLVM functions"),
+      llvm::cl::init("")};
+  PassOptions::ListOption<int64_t> tileSizes{
+      *this, "tile-sizes",
+      llvm::cl::desc("Tile sizes for the loop nests generated for tcp group "
+                     "ops")};
+  PassOptions::Option<unsigned> numThreads{
+      *this, "num-threads",
+      llvm::cl::desc("Number of threads to run parallel loops on. Values "
+                     "above one require linking the MLIR async runtime "
+                     "(default: derived from opt-level, 8 at O3 and 1 "
+                     "below)"),
+      llvm::cl::init(1)};
+  PassOptions::Option<bool> fastMath{
+      *this, "fast-math",
+      llvm::cl::desc("Allow floating point optimizations that do not "
+                     "preserve IEEE semantics, such as reassociation"),
+      llvm::cl::init(false)};
+  PassOptions::Option<bool> memoryPlanning{
+      *this, "memory-planning",
+      llvm::cl::desc("Hoist buffer allocations out of loops and pack "
+                     "static intermediate buffers into one arena "
+                     "(default: derived from opt-level, enabled from O1)"),
+      llvm::cl::init(false)};
+  PassOptions::Option<unsigned> stackPromotionThreshold{
+      *this, "stack-promotion-threshold",
+      llvm::cl::desc("With memory planning, allocate statically shaped "
+                     "buffers of up to this many bytes on the stack. Zero "
+                     "disables stack promotion"),
+      llvm::cl::init(1024)};
+  PassOptions::Option<bool> destinationPassing{
+      *this, "destination-passing",
+      llvm::cl::desc("Return results through caller provided buffers that "
+                     "are passed as trailing arguments, instead of "
+                     "allocating them"),
+      llvm::cl::init(false)};
+};
+
 void registerTcpPipelines();
-}
+} // namespace tcp
 } // namespace mlir
@@ -0,0 +1,85 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TcpToLinalg/TcpToLinalg.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "../PassDetail.h"
+#include "PopulatePatterns.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Transforms/DialectConversion.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+
+namespace {
+
+// Lowers a contraction to the named linalg op `LinalgOpTy`, accumulating into
+// a zero filled tensor. The named op is kept, so that the contraction can be
+// packed and vectorized as a whole later on.
+template <typename TcpOpTy, typename LinalgOpTy>
+class ConvertContractionOp : public OpConversionPattern<TcpOpTy> {
+public:
+  using OpConversionPattern<TcpOpTy>::OpConversionPattern;
+  using OpAdaptor = typename TcpOpTy::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(TcpOpTy op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &b) const override {
+    Location loc = op->getLoc();
+    auto resultTensorType = cast<RankedTensorType>(
+        this->getTypeConverter()->convertType(op.getOut().getType()));
+    Value lhs = adaptor.getLhs();
+    Value rhs = adaptor.getRhs();
+    int64_t rank = resultTensorType.getRank();
+
+    // The batch and M dims are taken from lhs, the N dim from rhs.
+    SmallVector<OpFoldResult> resultDimSizes;
+    for (int64_t i = 0; i < rank - 1; ++i) {
+      if (resultTensorType.isDynamicDim(i))
+        resultDimSizes.push_back(tensor::getMixedSize(b, loc, lhs, i));
+      else
+        resultDimSizes.push_back(
+            b.getIndexAttr(resultTensorType.getDimSize(i)));
+    }
+    if (resultTensorType.isDynamicDim(rank - 1))
+      resultDimSizes.push_back(tensor::getMixedSize(b, loc, rhs, rank - 1));
+    else
+      resultDimSizes.push_back(
+          b.getIndexAttr(resultTensorType.getDimSize(rank - 1)));
+
+    Type elementType = resultTensorType.getElementType();
+    Value emptyTensor =
+        b.create<tensor::EmptyOp>(loc, resultDimSizes, elementType);
+    Value zero = b.create<arith::ConstantOp>(loc, b.getZeroAttr(elementType));
+    Value init = b.create<linalg::FillOp>(loc, zero, emptyTensor).getResult(0);
+    b.replaceOpWithNewOp<LinalgOpTy>(op, resultTensorType,
+                                     ValueRange{lhs, rhs}, ValueRange{init});
+    return success();
+  }
+};
+
+} // namespace
+
+void mlir::TcpToLinalg::populateContractionPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target) {
+  MLIRContext *context = patterns.getContext();
+
+  target.addIllegalOp<MatmulOp, BatchMatmulOp>();
+  patterns.add<ConvertContractionOp<MatmulOp, linalg::MatmulOp>>(typeConverter,
+                                                                  context);
+  patterns.add<ConvertContractionOp<BatchMatmulOp, linalg::BatchMatmulOp>>(
+      typeConverter, context);
+}
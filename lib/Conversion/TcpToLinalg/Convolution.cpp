@@ -0,0 +1,264 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TcpToLinalg/TcpToLinalg.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "../PassDetail.h"
+#include "PopulatePatterns.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Transforms/DialectConversion.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+
+namespace {
+
+SmallVector<int64_t> getValuesFromIndexArrayAttribute(ArrayAttr attr) {
+  SmallVector<int64_t> arrayValues;
+  for (Attribute val : attr.getValue())
+    arrayValues.push_back(cast<IntegerAttr>(val).getValue().getSExtValue());
+  return arrayValues;
+}
+
+// Returns `value / divisor` for a size that is divisible by `divisor`.
+OpFoldResult divideSize(OpBuilder &b, Location loc, OpFoldResult value,
+                        int64_t divisor) {
+  if (std::optional<int64_t> constant = getConstantIntValue(value))
+    return b.getIndexAttr(*constant / divisor);
+  return b
+      .create<arith::DivUIOp>(loc, cast<Value>(value),
+                              b.create<arith::ConstantIndexOp>(loc, divisor))
+      .getResult();
+}
+
+// Returns the sizes of the result of a convolution of the padded `input`
+// with `weight`.
+SmallVector<OpFoldResult> getResultSizes(OpBuilder &b, Location loc,
+                                         RankedTensorType resultType,
+                                         Value input, Value weight,
+                                         ArrayRef<int64_t> stride,
+                                         ArrayRef<int64_t> dilation) {
+  SmallVector<OpFoldResult> sizes;
+  for (int64_t i = 0; i < resultType.getRank(); ++i) {
+    if (!resultType.isDynamicDim(i)) {
+      sizes.push_back(b.getIndexAttr(resultType.getDimSize(i)));
+      continue;
+    }
+    if (i == 0) {
+      sizes.push_back(tensor::getMixedSize(b, loc, input, 0));
+      continue;
+    }
+    if (i == 1) {
+      sizes.push_back(tensor::getMixedSize(b, loc, weight, 0));
+      continue;
+    }
+    // (in - dilation * (kernel - 1) - 1) / stride + 1
+    int64_t s = i - 2;
+    Value in = b.createOrFold<tensor::DimOp>(loc, input, i);
+    Value kernel = b.createOrFold<tensor::DimOp>(loc, weight, i);
+    Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+    Value extent = b.create<arith::MulIOp>(
+        loc, b.create<arith::SubIOp>(loc, kernel, one),
+        b.create<arith::ConstantIndexOp>(loc, dilation[s]));
+    Value size = b.create<arith::SubIOp>(
+        loc, b.create<arith::SubIOp>(loc, in, extent), one);
+    size = b.create<arith::DivUIOp>(
+        loc, size, b.create<arith::ConstantIndexOp>(loc, stride[s]));
+    sizes.push_back(b.create<arith::AddIOp>(loc, size, one).getResult());
+  }
+  return sizes;
+}
+
+// Returns a convolution as a `linalg.generic` over the expanded operands
+// input [N, G, C/G, I...], weight [G, F/G, C/G, K...] and result
+// [N, G, F/G, O...].
+Value createGroupedConvolution(OpBuilder &b, Location loc, Value input,
+                               Value weight, Value init,
+                               ArrayRef<int64_t> stride,
+                               ArrayRef<int64_t> dilation) {
+  int64_t numSpatialDims = stride.size();
+  MLIRContext *context = b.getContext();
+  // Loops: n, g, fg, o..., cg, k...
+  int64_t numLoops = 4 + 2 * numSpatialDims;
+  AffineExpr n = getAffineDimExpr(0, context);
+  AffineExpr g = getAffineDimExpr(1, context);
+  AffineExpr fg = getAffineDimExpr(2, context);
+  AffineExpr cg = getAffineDimExpr(3 + numSpatialDims, context);
+
+  SmallVector<AffineExpr> inputExprs = {n, g, cg};
+  SmallVector<AffineExpr> weightExprs = {g, fg, cg};
+  SmallVector<AffineExpr> outputExprs = {n, g, fg};
+  for (int64_t i = 0; i < numSpatialDims; ++i) {
+    AffineExpr o = getAffineDimExpr(3 + i, context);
+    AffineExpr k = getAffineDimExpr(4 + numSpatialDims + i, context);
+    inputExprs.push_back(o * stride[i] + k * dilation[i]);
+    weightExprs.push_back(k);
+    outputExprs.push_back(o);
+  }
+  SmallVector<AffineMap> indexingMaps = {
+      AffineMap::get(numLoops, 0, inputExprs, context),
+      AffineMap::get(numLoops, 0, weightExprs, context),
+      AffineMap::get(numLoops, 0, outputExprs, context)};
+
+  SmallVector<utils::IteratorType> iteratorTypes(3 + numSpatialDims,
+                                                 utils::IteratorType::parallel);
+  iteratorTypes.append(1 + numSpatialDims, utils::IteratorType::reduction);
+
+  return b
+      .create<linalg::GenericOp>(
+          loc, init.getType(), ValueRange{input, weight}, ValueRange{init},
+          indexingMaps, iteratorTypes,
+          [&](OpBuilder &b, Location loc, ValueRange args) {
+            Value result;
+            if (isa<FloatType>(args[0].getType())) {
+              Value product = b.create<arith::MulFOp>(loc, args[0], args[1]);
+              result = b.create<arith::AddFOp>(loc, args[2], product);
+            } else {
+              Value product = b.create<arith::MulIOp>(loc, args[0], args[1]);
+              result = b.create<arith::AddIOp>(loc, args[2], product);
+            }
+            b.create<linalg::YieldOp>(loc, result);
+          })
+      .getResult(0);
+}
+
+// Lowers a convolution to `ConvOpTy` if it has a single group, to
+// `DepthwiseOpTy` if it is depthwise, and to a `linalg.generic` otherwise.
+// The named ops are kept, so that a lowering strategy can be picked for them
+// later on.
+template <typename TcpOpTy, typename ConvOpTy, typename DepthwiseOpTy>
+class ConvertConvOp : public OpConversionPattern<TcpOpTy> {
+public:
+  using OpConversionPattern<TcpOpTy>::OpConversionPattern;
+  using OpAdaptor = typename TcpOpTy::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(TcpOpTy op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &b) const override {
+    Location loc = op->getLoc();
+    auto resultTensorType = cast<RankedTensorType>(
+        this->getTypeConverter()->convertType(op.getOut().getType()));
+    Value input = adaptor.getInput();
+    Value weight = adaptor.getWeight();
+    auto weightType = cast<RankedTensorType>(weight.getType());
+    Type elementType = resultTensorType.getElementType();
+    int64_t rank = resultTensorType.getRank();
+
+    SmallVector<int64_t> stride =
+        getValuesFromIndexArrayAttribute(op.getStride());
+    SmallVector<int64_t> padding =
+        getValuesFromIndexArrayAttribute(op.getPadding());
+    SmallVector<int64_t> dilation =
+        getValuesFromIndexArrayAttribute(op.getDilation());
+    int64_t groups = op.getGroups();
+
+    Value zero = b.create<arith::ConstantOp>(loc, b.getZeroAttr(elementType));
+    if (llvm::any_of(padding, [](int64_t p) { return p != 0; })) {
+      SmallVector<OpFoldResult> pads = {b.getIndexAttr(0), b.getIndexAttr(0)};
+      for (int64_t p : padding)
+        pads.push_back(b.getIndexAttr(p));
+      input = b.create<tensor::PadOp>(loc, Type(), input, pads, pads, zero);
+    }
+
+    SmallVector<OpFoldResult> resultSizes = getResultSizes(
+        b, loc, resultTensorType, input, weight, stride, dilation);
+    Value emptyTensor = b.create<tensor::EmptyOp>(loc, resultSizes, elementType);
+    Value init = b.create<linalg::FillOp>(loc, zero, emptyTensor).getResult(0);
+
+    auto strideAttr = b.getI64VectorAttr(stride);
+    auto dilationAttr = b.getI64VectorAttr(dilation);
+
+    if (groups == 1) {
+      b.replaceOpWithNewOp<ConvOpTy>(op, resultTensorType,
+                                     ValueRange{input, weight},
+                                     ValueRange{init}, strideAttr,
+                                     dilationAttr);
+      return success();
+    }
+
+    // Depthwise: every input channel is convolved with a single filter. The
+    // unit channel dim of the weight is dropped.
+    SmallVector<ReassociationIndices> weightReassociation = {{0, 1}};
+    for (int64_t i = 2; i < rank; ++i)
+      weightReassociation.push_back({i});
+    if (weightType.getDimSize(0) == groups && weightType.getDimSize(1) == 1) {
+      Value depthwiseWeight = b.create<tensor::CollapseShapeOp>(
+          loc, weight, weightReassociation);
+      b.replaceOpWithNewOp<DepthwiseOpTy>(op, resultTensorType,
+                                          ValueRange{input, depthwiseWeight},
+                                          ValueRange{init}, strideAttr,
+                                          dilationAttr);
+      return success();
+    }
+
+    // Other grouped convolutions split the channel dims into groups.
+    SmallVector<ReassociationIndices> reassociation = {{0}, {1, 2}};
+    for (int64_t i = 2; i < rank; ++i)
+      reassociation.push_back({i + 1});
+    auto expand = [&](Value value, int64_t channelDim) {
+      SmallVector<OpFoldResult> sizes =
+          tensor::getMixedSizes(b, loc, value);
+      OpFoldResult channels = sizes[channelDim];
+      sizes.erase(sizes.begin() + channelDim);
+      sizes.insert(sizes.begin() + channelDim,
+                   {b.getIndexAttr(groups), divideSize(b, loc, channels,
+                                                       groups)});
+      SmallVector<int64_t> staticSizes;
+      SmallVector<Value> dynamicSizes;
+      dispatchIndexOpFoldResults(sizes, dynamicSizes, staticSizes);
+      auto type = RankedTensorType::get(staticSizes, elementType);
+      SmallVector<ReassociationIndices> valueReassociation;
+      for (int64_t i = 0; i < channelDim; ++i)
+        valueReassociation.push_back({i});
+      valueReassociation.push_back({channelDim, channelDim + 1});
+      for (int64_t i = channelDim + 1; i < rank; ++i)
+        valueReassociation.push_back({i + 1});
+      return b
+          .create<tensor::ExpandShapeOp>(loc, type, value, valueReassociation,
+                                         sizes)
+          .getResult();
+    };
+    Value groupedInput = expand(input, /*channelDim=*/1);
+    Value groupedWeight = expand(weight, /*channelDim=*/0);
+    Value groupedInit = expand(init, /*channelDim=*/1);
+    Value result = createGroupedConvolution(b, loc, groupedInput, groupedWeight,
+                                            groupedInit, stride, dilation);
+    result = b.create<tensor::CollapseShapeOp>(loc, result, reassociation);
+    if (result.getType() != resultTensorType)
+      result = b.create<tensor::CastOp>(loc, resultTensorType, result);
+    b.replaceOp(op, result);
+    return success();
+  }
+};
+
+} // namespace
+
+void mlir::TcpToLinalg::populateConvolutionPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target) {
+  MLIRContext *context = patterns.getContext();
+
+  target.addIllegalOp<Conv1DOp, Conv2DOp, Conv3DOp>();
+  patterns.add<ConvertConvOp<Conv1DOp, linalg::Conv1DNcwFcwOp,
+                             linalg::DepthwiseConv1DNcwCwOp>>(typeConverter,
+                                                              context);
+  patterns.add<ConvertConvOp<Conv2DOp, linalg::Conv2DNchwFchwOp,
+                             linalg::DepthwiseConv2DNchwChwOp>>(typeConverter,
+                                                                context);
+  patterns.add<ConvertConvOp<Conv3DOp, linalg::Conv3DNcdhwFcdhwOp,
+                             linalg::DepthwiseConv3DNcdhwCdhwOp>>(typeConverter,
+                                                                  context);
+}
@@ -15,14 +15,19 @@
 #include "../PassDetail.h"
 #include "PopulatePatterns.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Arith/Utils/Utils.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/Math/IR/Math.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/Matchers.h"
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/Transforms/DialectConversion.h"
 
 #include "llvm/Support/Debug.h"
 
+#include <set>
+
 using namespace mlir;
 using namespace mlir::tcp;
 
@@ -184,6 +189,229 @@ public:
   }
 };
 
+// Returns true if the rows of the indices of `op` are known to be unique:
+// either `op` says so or the indices are a constant without repeated rows.
+bool hasUniqueIndices(ScatterOp op) {
+  if (op.getUniqueIndices())
+    return true;
+  DenseIntElementsAttr indices;
+  if (!matchPattern(op.getIndices(), m_Constant(&indices)))
+    return false;
+  RankedTensorType destType = op.getDest().getType();
+  size_t numIndexedDims = op.getIndices().getType().getShape().back();
+  if (numIndexedDims == 0)
+    return false;
+
+  std::set<SmallVector<int64_t>> rows;
+  SmallVector<int64_t> row;
+  for (const APInt &value : indices.getValues<APInt>()) {
+    int64_t index = value.getSExtValue();
+    if (index < 0) {
+      int64_t dimSize = destType.getDimSize(row.size());
+      if (ShapedType::isDynamic(dimSize))
+        return false;
+      index += dimSize;
+    }
+    row.push_back(index);
+    if (row.size() == numIndexedDims) {
+      if (!rows.insert(row).second)
+        return false;
+      row.clear();
+    }
+  }
+  return true;
+}
+
+// The slice of the destination of a scatter that is updated by one row of
+// its indices, and the value it is updated with.
+struct ScatterSlice {
+  Value update;
+  SmallVector<OpFoldResult> offsets;
+  SmallVector<OpFoldResult> sizes;
+  SmallVector<OpFoldResult> strides;
+};
+
+// Returns the slice of `dest` that is updated by the row of `indices` at
+// `ivs`. The slice has unit sizes along the indexed dims, which are dropped
+// from the update.
+ScatterSlice getScatterSlice(OpBuilder &b, Location loc, ScatterOp op,
+                             Value dest, Value indices, Value updates,
+                             ValueRange ivs) {
+  auto destType = cast<RankedTensorType>(dest.getType());
+  auto indicesType = cast<RankedTensorType>(indices.getType());
+  auto updatesType = cast<RankedTensorType>(updates.getType());
+  Type elementType = destType.getElementType();
+  int64_t numIndexedDims = indicesType.getShape().back();
+  int64_t batchRank = ivs.size();
+  Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+
+  ScatterSlice slice;
+  for (int64_t i = 0; i < destType.getRank(); ++i) {
+    slice.strides.push_back(b.getIndexAttr(1));
+    if (i >= numIndexedDims) {
+      slice.offsets.push_back(b.getIndexAttr(0));
+      slice.sizes.push_back(tensor::getMixedSize(b, loc, dest, i));
+      continue;
+    }
+    SmallVector<Value> position = llvm::to_vector(ivs);
+    position.push_back(b.create<arith::ConstantIndexOp>(loc, i));
+    Value index = b.create<arith::IndexCastOp>(
+        loc, b.getIndexType(),
+        b.create<tensor::ExtractOp>(loc, indices, position));
+    // Negative indices count from the end of the dim.
+    Value isNegative = b.create<arith::CmpIOp>(
+        loc, arith::CmpIPredicate::slt, index, zero);
+    Value wrapped = b.create<arith::AddIOp>(
+        loc, index, b.createOrFold<tensor::DimOp>(loc, dest, i));
+    slice.offsets.push_back(
+        b.create<arith::SelectOp>(loc, isNegative, wrapped, index)
+            .getResult());
+    slice.sizes.push_back(b.getIndexAttr(1));
+  }
+
+  SmallVector<OpFoldResult> updateOffsets = getAsOpFoldResult(ivs);
+  SmallVector<OpFoldResult> updateSizes(batchRank, b.getIndexAttr(1));
+  for (int64_t i = batchRank; i < updatesType.getRank(); ++i) {
+    updateOffsets.push_back(b.getIndexAttr(0));
+    updateSizes.push_back(tensor::getMixedSize(b, loc, updates, i));
+  }
+  SmallVector<OpFoldResult> updateStrides(updatesType.getRank(),
+                                          b.getIndexAttr(1));
+  auto updateType = RankedTensorType::get(
+      updatesType.getShape().drop_front(batchRank), elementType);
+  slice.update = b.create<tensor::ExtractSliceOp>(
+      loc, updateType, updates, updateOffsets, updateSizes, updateStrides);
+  if (!op.getAccumulate())
+    return slice;
+
+  // Add the update to the current value of the slice.
+  auto currentType = RankedTensorType::get(
+      destType.getShape().drop_front(numIndexedDims), elementType);
+  Value current = b.create<tensor::ExtractSliceOp>(
+      loc, currentType, dest, slice.offsets, slice.sizes, slice.strides);
+  int64_t rank = currentType.getRank();
+  SmallVector<AffineMap> indexingMaps(2, b.getMultiDimIdentityMap(rank));
+  SmallVector<utils::IteratorType> iteratorTypes(rank,
+                                                 utils::IteratorType::parallel);
+  auto bodyBuilder = [&](OpBuilder &builder, Location loc,
+                         ValueRange payloadArgs) {
+    Value sum;
+    if (isa<FloatType>(elementType))
+      sum = builder.create<arith::AddFOp>(loc, payloadArgs[0], payloadArgs[1]);
+    else if (elementType.isInteger(1))
+      sum = builder.create<arith::OrIOp>(loc, payloadArgs[0], payloadArgs[1]);
+    else
+      sum = builder.create<arith::AddIOp>(loc, payloadArgs[0], payloadArgs[1]);
+    builder.create<linalg::YieldOp>(loc, sum);
+  };
+  slice.update = b.create<linalg::GenericOp>(loc, currentType, slice.update,
+                                             current, indexingMaps,
+                                             iteratorTypes, bodyBuilder)
+                     .getResult(0);
+  return slice;
+}
+
+// tcp.scatter is lowered to a loop nest over the rows of its indices, which
+// inserts the update of each row into its slice of the destination. The
+// destination is carried through the loops, so that one-shot bufferization
+// updates it in place when it is dead afterwards, and updates a copy of it
+// otherwise.
+//
+// When the rows of the indices are known to be unique, the slices do not
+// overlap and are updated in parallel with an `scf.forall`. Otherwise, they
+// are updated one after the other with `scf.for` loops, so that the result is
+// deterministic: the last update of a repeated row wins, and accumulations
+// are summed in order.
+class ConvertScatterOp : public OpConversionPattern<ScatterOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(ScatterOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+    Value dest = adaptor.getDest();
+    Value indices = adaptor.getIndices();
+    Value updates = adaptor.getUpdates();
+    int64_t batchRank =
+        cast<RankedTensorType>(indices.getType()).getRank() - 1;
+
+    SmallVector<OpFoldResult> lowerBounds(batchRank, rewriter.getIndexAttr(0));
+    SmallVector<OpFoldResult> steps(batchRank, rewriter.getIndexAttr(1));
+    SmallVector<OpFoldResult> upperBounds;
+    for (int64_t i = 0; i < batchRank; ++i)
+      upperBounds.push_back(tensor::getMixedSize(rewriter, loc, indices, i));
+
+    if (batchRank > 0 && hasUniqueIndices(op)) {
+      auto forallOp = rewriter.create<scf::ForallOp>(
+          loc, lowerBounds, upperBounds, steps, ValueRange{dest},
+          /*mapping=*/std::nullopt);
+      Value sharedDest = forallOp.getRegionIterArgs().front();
+      rewriter.setInsertionPoint(forallOp.getTerminator());
+      ScatterSlice slice =
+          getScatterSlice(rewriter, loc, op, sharedDest, indices, updates,
+                          forallOp.getInductionVars());
+      rewriter.setInsertionPointToStart(forallOp.getTerminator().getBody());
+      rewriter.create<tensor::ParallelInsertSliceOp>(
+          loc, slice.update, sharedDest, slice.offsets, slice.sizes,
+          slice.strides);
+      rewriter.replaceOp(op, forallOp->getResults());
+      return success();
+    }
+
+    scf::LoopNest loopNest = scf::buildLoopNest(
+        rewriter, loc,
+        getValueOrCreateConstantIndexOp(rewriter, loc, lowerBounds),
+        getValueOrCreateConstantIndexOp(rewriter, loc, upperBounds),
+        getValueOrCreateConstantIndexOp(rewriter, loc, steps),
+        ValueRange{dest},
+        [&](OpBuilder &b, Location loc, ValueRange ivs,
+            ValueRange iterArgs) -> scf::ValueVector {
+          ScatterSlice slice = getScatterSlice(b, loc, op, iterArgs.front(),
+                                               indices, updates, ivs);
+          return {b.create<tensor::InsertSliceOp>(
+              loc, slice.update, iterArgs.front(), slice.offsets, slice.sizes,
+              slice.strides)};
+        });
+    rewriter.replaceOp(op, loopNest.results);
+    return success();
+  }
+};
+
+class ConvertTransposeOp : public OpConversionPattern<TransposeOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(TransposeOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+    auto resultTensorType = cast<RankedTensorType>(
+        getTypeConverter()->convertType(op.getOut().getType()));
+    Value input = adaptor.getIn();
+
+    SmallVector<int64_t> permutation;
+    for (Attribute dim : op.getPermutation())
+      permutation.push_back(cast<IntegerAttr>(dim).getInt());
+
+    SmallVector<OpFoldResult> resultSizes;
+    for (int64_t dim : permutation)
+      resultSizes.push_back(tensor::getMixedSize(rewriter, loc, input, dim));
+    Value emptyTensor = rewriter.create<tensor::EmptyOp>(
+        loc, resultSizes, resultTensorType.getElementType());
+    Value result =
+        rewriter
+            .create<linalg::TransposeOp>(loc, input, emptyTensor, permutation)
+            ->getResult(0);
+
+    // The result may be more static than the type of the op.
+    if (result.getType() != resultTensorType)
+      result = rewriter.create<tensor::CastOp>(loc, resultTensorType, result);
+    rewriter.replaceOp(op, result);
+    return success();
+  }
+};
+
 } // namespace
 
 void mlir::TcpToLinalg::populateDataMovementPatternsAndLegality(
@@ -195,4 +423,8 @@ void mlir::TcpToLinalg::populateDataMovementPatternsAndLegality(
   patterns.add<ConvertGatherOp>(typeConverter, context);
   target.addIllegalOp<GatherNDOp>();
   patterns.add<ConvertGatherNDOp>(typeConverter, context);
+  target.addIllegalOp<ScatterOp>();
+  patterns.add<ConvertScatterOp>(typeConverter, context);
+  target.addIllegalOp<TransposeOp>();
+  patterns.add<ConvertTransposeOp>(typeConverter, context);
 }
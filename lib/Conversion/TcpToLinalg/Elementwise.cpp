@@ -55,6 +55,43 @@ Value createElementwiseLinalgGeneric(
       .getResult(0);
 }
 
+arith::CmpFPredicate getCmpFPredicate(ComparePredicate predicate) {
+  switch (predicate) {
+  case ComparePredicate::EQ:
+    return arith::CmpFPredicate::OEQ;
+  case ComparePredicate::NE:
+    return arith::CmpFPredicate::UNE;
+  case ComparePredicate::LT:
+    return arith::CmpFPredicate::OLT;
+  case ComparePredicate::LE:
+    return arith::CmpFPredicate::OLE;
+  case ComparePredicate::GT:
+    return arith::CmpFPredicate::OGT;
+  case ComparePredicate::GE:
+    return arith::CmpFPredicate::OGE;
+  }
+  llvm_unreachable("unknown tcp.compare predicate");
+}
+
+arith::CmpIPredicate getCmpIPredicate(ComparePredicate predicate,
+                                      bool isSigned) {
+  switch (predicate) {
+  case ComparePredicate::EQ:
+    return arith::CmpIPredicate::eq;
+  case ComparePredicate::NE:
+    return arith::CmpIPredicate::ne;
+  case ComparePredicate::LT:
+    return isSigned ? arith::CmpIPredicate::slt : arith::CmpIPredicate::ult;
+  case ComparePredicate::LE:
+    return isSigned ? arith::CmpIPredicate::sle : arith::CmpIPredicate::ule;
+  case ComparePredicate::GT:
+    return isSigned ? arith::CmpIPredicate::sgt : arith::CmpIPredicate::ugt;
+  case ComparePredicate::GE:
+    return isSigned ? arith::CmpIPredicate::sge : arith::CmpIPredicate::uge;
+  }
+  llvm_unreachable("unknown tcp.compare predicate");
+}
+
 FailureOr<Value>
 createLinalgPayloadForElementwiseOp(Operation *op,
                                     RankedTensorType resultTensorType,
@@ -229,6 +266,28 @@ createLinalgPayloadForElementwiseOp(Operation *op,
                        "createLinalgPayloadForElementwiseOp for tcp.atan2");
   }
 
+  if (auto compareOp = dyn_cast<CompareOp>(op)) {
+    auto inputType = compareOp.getIn1().getType().getElementType();
+    if (isa<mlir::FloatType>(inputType))
+      return {b.create<arith::CmpFOp>(
+          loc, getCmpFPredicate(compareOp.getPredicate()), payloadArgs[0],
+          payloadArgs[1])};
+    else if (isa<mlir::IntegerType>(inputType))
+      return {b.create<arith::CmpIOp>(
+          loc,
+          getCmpIPredicate(compareOp.getPredicate(),
+                           compareOp.getIntSignedness() == Signedness::Signed),
+          payloadArgs[0], payloadArgs[1])};
+    else
+      llvm_unreachable("unsupported element type in "
+                       "createLinalgPayloadForElementwiseOp for tcp.compare");
+  }
+
+  if (isa<SelectOp>(op)) {
+    return {b.create<arith::SelectOp>(loc, payloadArgs[0], payloadArgs[1],
+                                      payloadArgs[2])};
+  }
+
   if (auto castOp = dyn_cast<CastOp>(op)) {
     auto inputType =
         dyn_cast<RankedTensorType>(castOp.getIn().getType()).getElementType();
@@ -373,6 +432,8 @@ void mlir::TcpToLinalg::populateElementwisePatternsAndLegality(
   INSERT_TCP_TO_LINALG_PATTERN(NegOp);
   INSERT_TCP_TO_LINALG_PATTERN(AtanOp);
   INSERT_TCP_TO_LINALG_PATTERN(Atan2Op);
+  INSERT_TCP_TO_LINALG_PATTERN(CompareOp);
+  INSERT_TCP_TO_LINALG_PATTERN(SelectOp);
   INSERT_TCP_TO_LINALG_PATTERN(CastOp);
 #undef INSERT_TCP_TO_LINALG_PATTERN
 }
@@ -0,0 +1,420 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TcpToLinalg/TcpToLinalg.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "../PassDetail.h"
+#include "PopulatePatterns.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Math/IR/Math.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/IR/TypeUtilities.h"
+#include "mlir/Transforms/DialectConversion.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+
+namespace {
+
+// The per row statistics of a normalization of `input` over `reducedDims`:
+// an identity map for the input, and a map that drops `reducedDims` for the
+// statistics. The loops along `reducedDims` are the only reduction loops.
+struct RowStatsLayout {
+  SmallVector<OpFoldResult> statsSizes;
+  AffineMap inputMap;
+  AffineMap statsMap;
+  SmallVector<utils::IteratorType> reductionIteratorTypes;
+  SmallVector<utils::IteratorType> parallelIteratorTypes;
+};
+
+RowStatsLayout getRowStatsLayout(OpBuilder &b, Location loc, Value input,
+                                 ArrayRef<int64_t> reducedDims) {
+  auto inputType = cast<RankedTensorType>(input.getType());
+  int64_t rank = inputType.getRank();
+  MLIRContext *context = b.getContext();
+
+  RowStatsLayout layout;
+  SmallVector<AffineExpr> statsExprs;
+  layout.parallelIteratorTypes.assign(rank, utils::IteratorType::parallel);
+  layout.reductionIteratorTypes = layout.parallelIteratorTypes;
+  for (int64_t i = 0; i < rank; ++i) {
+    if (llvm::is_contained(reducedDims, i)) {
+      layout.reductionIteratorTypes[i] = utils::IteratorType::reduction;
+      continue;
+    }
+    layout.statsSizes.push_back(tensor::getMixedSize(b, loc, input, i));
+    statsExprs.push_back(getAffineDimExpr(i, context));
+  }
+  layout.inputMap = b.getMultiDimIdentityMap(rank);
+  layout.statsMap =
+      AffineMap::get(rank, /*symbolCount=*/0, statsExprs, context);
+  return layout;
+}
+
+Value createFilledTensor(OpBuilder &b, Location loc,
+                         ArrayRef<OpFoldResult> sizes, TypedAttr value) {
+  Value emptyTensor = b.create<tensor::EmptyOp>(loc, sizes, value.getType());
+  Value constant = b.create<arith::ConstantOp>(loc, value);
+  return b.create<linalg::FillOp>(loc, constant, emptyTensor).getResult(0);
+}
+
+// Lowers a softmax to two loop nests, so that every row is read twice rather
+// than three times:
+//
+//  1. An online reduction that computes the running max `m` of each row
+//     together with the sum `s` of `exp(x - m)`, rescaling `s` whenever `m`
+//     grows.
+//  2. An elementwise op that computes `exp(x - m) / s`, or `x - m - log(s)`
+//     for the log softmax.
+template <typename TcpOpTy>
+class ConvertSoftmaxOp : public OpConversionPattern<TcpOpTy> {
+public:
+  using OpConversionPattern<TcpOpTy>::OpConversionPattern;
+  using OpAdaptor = typename TcpOpTy::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(TcpOpTy op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &b) const override {
+    Location loc = op->getLoc();
+    auto resultTensorType = cast<RankedTensorType>(
+        this->getTypeConverter()->convertType(op.getOut().getType()));
+    Value input = adaptor.getIn();
+    auto elementType = cast<FloatType>(resultTensorType.getElementType());
+    int64_t axis = op.getAxis();
+
+    RowStatsLayout layout = getRowStatsLayout(b, loc, input, {axis});
+    TypedAttr negInf = b.getFloatAttr(
+        elementType, APFloat::getInf(elementType.getFloatSemantics(),
+                                     /*Negative=*/true));
+    Value maxInit = createFilledTensor(b, loc, layout.statsSizes, negInf);
+    Value sumInit = createFilledTensor(b, loc, layout.statsSizes,
+                                       b.getFloatAttr(elementType, 0.0));
+
+    auto stats = b.create<linalg::GenericOp>(
+        loc, TypeRange{maxInit.getType(), sumInit.getType()},
+        ValueRange{input}, ValueRange{maxInit, sumInit},
+        ArrayRef<AffineMap>{layout.inputMap, layout.statsMap,
+                            layout.statsMap},
+        layout.reductionIteratorTypes,
+        [&](OpBuilder &nb, Location nl, ValueRange args) {
+          Value x = args[0], max = args[1], sum = args[2];
+          Value newMax = nb.create<arith::MaximumFOp>(nl, max, x);
+          Value scale = nb.create<math::ExpOp>(
+              nl, nb.create<arith::SubFOp>(nl, max, newMax));
+          Value term = nb.create<math::ExpOp>(
+              nl, nb.create<arith::SubFOp>(nl, x, newMax));
+          Value newSum = nb.create<arith::AddFOp>(
+              nl, nb.create<arith::MulFOp>(nl, sum, scale), term);
+          // Leading -inf elements of a row do not contribute to the sum,
+          // and would otherwise turn it into a NaN through `-inf - -inf`.
+          Value isNegInf = nb.create<arith::CmpFOp>(
+              nl, arith::CmpFPredicate::OEQ, newMax,
+              nb.create<arith::ConstantOp>(nl, negInf));
+          newSum = nb.create<arith::SelectOp>(nl, isNegInf, sum, newSum);
+          nb.create<linalg::YieldOp>(nl, ValueRange{newMax, newSum});
+        });
+
+    Value outInit = b.create<tensor::EmptyOp>(
+        loc, tensor::getMixedSizes(b, loc, input), elementType);
+    Value result =
+        b.create<linalg::GenericOp>(
+             loc, TypeRange{outInit.getType()},
+             ValueRange{input, stats.getResult(0), stats.getResult(1)},
+             ValueRange{outInit},
+             ArrayRef<AffineMap>{layout.inputMap, layout.statsMap,
+                                 layout.statsMap, layout.inputMap},
+             layout.parallelIteratorTypes,
+             [&](OpBuilder &nb, Location nl, ValueRange args) {
+               Value x = args[0], max = args[1], sum = args[2];
+               Value shifted = nb.create<arith::SubFOp>(nl, x, max);
+               Value out;
+               if (std::is_same_v<TcpOpTy, LogSoftmaxOp>)
+                 out = nb.create<arith::SubFOp>(
+                     nl, shifted, nb.create<math::LogOp>(nl, sum));
+               else
+                 out = nb.create<arith::DivFOp>(
+                     nl, nb.create<math::ExpOp>(nl, shifted), sum);
+               nb.create<linalg::YieldOp>(nl, out);
+             })
+            .getResult(0);
+
+    // The result may be more static than the type of the op.
+    if (result.getType() != resultTensorType)
+      result = b.create<tensor::CastOp>(loc, resultTensorType, result);
+    b.replaceOp(op, result);
+    return success();
+  }
+};
+
+// Returns the number of elements of `input` along `dims` as a scalar of
+// `elementType`.
+Value getNumElements(OpBuilder &b, Location loc, Value input,
+                     ArrayRef<int64_t> dims, Type elementType) {
+  auto inputType = cast<RankedTensorType>(input.getType());
+  int64_t staticCount = 1;
+  Value dynamicCount;
+  for (int64_t dim : dims) {
+    if (!inputType.isDynamicDim(dim)) {
+      staticCount *= inputType.getDimSize(dim);
+      continue;
+    }
+    Value size = b.create<tensor::DimOp>(loc, input, dim);
+    dynamicCount =
+        dynamicCount ? b.create<arith::MulIOp>(loc, dynamicCount, size) : size;
+  }
+  if (!dynamicCount)
+    return b.create<arith::ConstantOp>(
+        loc, b.getFloatAttr(elementType, staticCount));
+  if (staticCount != 1)
+    dynamicCount = b.create<arith::MulIOp>(
+        loc, dynamicCount, b.create<arith::ConstantIndexOp>(loc, staticCount));
+  Value countInt =
+      b.create<arith::IndexCastOp>(loc, b.getI64Type(), dynamicCount);
+  return b.create<arith::SIToFPOp>(loc, elementType, countInt);
+}
+
+// Computes `1 / sqrt(sumOfSquares / count + epsilon)` for every row.
+Value createReciprocalStdDev(OpBuilder &b, Location loc, Value sumOfSquares,
+                             Value count, FloatType elementType,
+                             double epsilon) {
+  auto statsType = cast<RankedTensorType>(sumOfSquares.getType());
+  int64_t statsRank = statsType.getRank();
+  Value eps = b.create<arith::ConstantOp>(loc,
+                                          b.getFloatAttr(elementType, epsilon));
+  Value init = b.create<tensor::EmptyOp>(
+      loc, tensor::getMixedSizes(b, loc, sumOfSquares), elementType);
+  AffineMap identityMap = b.getMultiDimIdentityMap(statsRank);
+  return b
+      .create<linalg::GenericOp>(
+          loc, TypeRange{init.getType()}, ValueRange{sumOfSquares},
+          ValueRange{init}, ArrayRef<AffineMap>{identityMap, identityMap},
+          SmallVector<utils::IteratorType>(statsRank,
+                                           utils::IteratorType::parallel),
+          [&](OpBuilder &nb, Location nl, ValueRange args) {
+            Value variance = nb.create<arith::DivFOp>(nl, args[0], count);
+            Value rstd = nb.create<math::RsqrtOp>(
+                nl, nb.create<arith::AddFOp>(nl, variance, eps));
+            nb.create<linalg::YieldOp>(nl, rstd);
+          })
+      .getResult(0);
+}
+
+// Applies `(x - mean) * rstd * weight + bias` to every element, where `mean`
+// and `bias` may be missing. The computation happens in the element type of
+// `rstd`, which may be wider than the one of `input`.
+Value createNormalizeOp(OpBuilder &b, Location loc, Value input, Value mean,
+                        Value rstd, Value weight, Value bias,
+                        const RowStatsLayout &layout, int64_t axis) {
+  auto inputType = cast<RankedTensorType>(input.getType());
+  int64_t rank = inputType.getRank();
+  SmallVector<AffineExpr> paramExprs;
+  for (int64_t i = axis; i < rank; ++i)
+    paramExprs.push_back(b.getAffineDimExpr(i));
+  AffineMap paramMap =
+      AffineMap::get(rank, /*symbolCount=*/0, paramExprs, b.getContext());
+
+  SmallVector<Value> inputs = {input};
+  SmallVector<AffineMap> indexingMaps = {layout.inputMap};
+  for (auto [value, map] :
+       {std::make_pair(mean, layout.statsMap),
+        std::make_pair(rstd, layout.statsMap), std::make_pair(weight, paramMap),
+        std::make_pair(bias, paramMap)}) {
+    if (!value)
+      continue;
+    inputs.push_back(value);
+    indexingMaps.push_back(map);
+  }
+  indexingMaps.push_back(layout.inputMap);
+
+  Type elementType = inputType.getElementType();
+  Type computeType = getElementTypeOrSelf(rstd.getType());
+  Value init = b.create<tensor::EmptyOp>(
+      loc, tensor::getMixedSizes(b, loc, input), elementType);
+  return b
+      .create<linalg::GenericOp>(
+          loc, TypeRange{init.getType()}, inputs, ValueRange{init},
+          indexingMaps, layout.parallelIteratorTypes,
+          [&](OpBuilder &nb, Location nl, ValueRange args) {
+            auto extend = [&](Value value) -> Value {
+              if (value.getType() == computeType)
+                return value;
+              return nb.create<arith::ExtFOp>(nl, computeType, value);
+            };
+            unsigned next = 0;
+            Value out = extend(args[next++]);
+            if (mean)
+              out = nb.create<arith::SubFOp>(nl, out, args[next++]);
+            out = nb.create<arith::MulFOp>(nl, out, args[next++]);
+            if (weight)
+              out = nb.create<arith::MulFOp>(nl, out, extend(args[next++]));
+            if (bias)
+              out = nb.create<arith::AddFOp>(nl, out, extend(args[next++]));
+            if (computeType != elementType)
+              out = nb.create<arith::TruncFOp>(nl, elementType, out);
+            nb.create<linalg::YieldOp>(nl, out);
+          })
+      .getResult(0);
+}
+
+// Lowers a layer norm to a single pass over the input that computes the mean
+// and the sum of squared deviations of every row with Welford's algorithm,
+// which is stable for rows with a large mean, followed by an elementwise op
+// that normalizes the input and applies the affine transform. The number of
+// elements seen so far is derived from the loop indices, and the statistics
+// of types narrower than f32 are accumulated in f32.
+class ConvertLayerNormOp : public OpConversionPattern<LayerNormOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(LayerNormOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &b) const override {
+    Location loc = op->getLoc();
+    auto resultTensorType = cast<RankedTensorType>(
+        getTypeConverter()->convertType(op.getOut().getType()));
+    Value input = adaptor.getIn();
+    auto elementType = cast<FloatType>(resultTensorType.getElementType());
+    int64_t axis = op.getAxis();
+    int64_t rank = resultTensorType.getRank();
+
+    SmallVector<int64_t> reducedDims =
+        llvm::to_vector(llvm::seq<int64_t>(axis, rank));
+    RowStatsLayout layout = getRowStatsLayout(b, loc, input, reducedDims);
+    FloatType accType =
+        elementType.getWidth() < 32 ? b.getF32Type() : elementType;
+    TypedAttr zero = b.getFloatAttr(accType, 0.0);
+    Value meanInit = createFilledTensor(b, loc, layout.statsSizes, zero);
+    Value m2Init = createFilledTensor(b, loc, layout.statsSizes, zero);
+    // The sizes of the reduced dims that the position within a row is
+    // strided by.
+    SmallVector<Value> strideSizes;
+    for (int64_t dim : ArrayRef(reducedDims).drop_front())
+      strideSizes.push_back(b.createOrFold<tensor::DimOp>(loc, input, dim));
+
+    auto stats = b.create<linalg::GenericOp>(
+        loc, TypeRange{meanInit.getType(), m2Init.getType()},
+        ValueRange{input}, ValueRange{meanInit, m2Init},
+        ArrayRef<AffineMap>{layout.inputMap, layout.statsMap,
+                            layout.statsMap},
+        layout.reductionIteratorTypes,
+        [&](OpBuilder &nb, Location nl, ValueRange args) {
+          Value x = args[0], mean = args[1], m2 = args[2];
+          if (accType != elementType)
+            x = nb.create<arith::ExtFOp>(nl, accType, x);
+          // The row major position of the element within its row.
+          Value position = nb.create<linalg::IndexOp>(nl, reducedDims[0]);
+          for (auto [dim, size] :
+               llvm::zip(ArrayRef(reducedDims).drop_front(), strideSizes))
+            position = nb.create<arith::AddIOp>(
+                nl, nb.create<arith::MulIOp>(nl, position, size),
+                nb.create<linalg::IndexOp>(nl, dim));
+          Value newCountIndex = nb.create<arith::AddIOp>(
+              nl, position, nb.create<arith::ConstantIndexOp>(nl, 1));
+          Value newCount = nb.create<arith::UIToFPOp>(
+              nl, accType,
+              nb.create<arith::IndexCastUIOp>(nl, nb.getI64Type(),
+                                              newCountIndex));
+          Value delta = nb.create<arith::SubFOp>(nl, x, mean);
+          Value newMean = nb.create<arith::AddFOp>(
+              nl, mean, nb.create<arith::DivFOp>(nl, delta, newCount));
+          Value newDelta = nb.create<arith::SubFOp>(nl, x, newMean);
+          Value newM2 = nb.create<arith::AddFOp>(
+              nl, m2, nb.create<arith::MulFOp>(nl, delta, newDelta));
+          nb.create<linalg::YieldOp>(nl, ValueRange{newMean, newM2});
+        });
+
+    Value count = getNumElements(b, loc, input, reducedDims, accType);
+    Value rstd =
+        createReciprocalStdDev(b, loc, stats.getResult(1), count, accType,
+                               op.getEpsilon().convertToDouble());
+    Value result = createNormalizeOp(b, loc, input, stats.getResult(0), rstd,
+                                     adaptor.getWeight(), adaptor.getBias(),
+                                     layout, axis);
+
+    // The result may be more static than the type of the op.
+    if (result.getType() != resultTensorType)
+      result = b.create<tensor::CastOp>(loc, resultTensorType, result);
+    b.replaceOp(op, result);
+    return success();
+  }
+};
+
+// Lowers an RMS norm to a single pass over the input that computes the sum
+// of squares of every row, followed by an elementwise op that scales the
+// input.
+class ConvertRMSNormOp : public OpConversionPattern<RMSNormOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(RMSNormOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &b) const override {
+    Location loc = op->getLoc();
+    auto resultTensorType = cast<RankedTensorType>(
+        getTypeConverter()->convertType(op.getOut().getType()));
+    Value input = adaptor.getIn();
+    auto elementType = cast<FloatType>(resultTensorType.getElementType());
+    int64_t axis = op.getAxis();
+    int64_t rank = resultTensorType.getRank();
+
+    SmallVector<int64_t> reducedDims =
+        llvm::to_vector(llvm::seq<int64_t>(axis, rank));
+    RowStatsLayout layout = getRowStatsLayout(b, loc, input, reducedDims);
+    Value sumInit = createFilledTensor(b, loc, layout.statsSizes,
+                                       b.getFloatAttr(elementType, 0.0));
+
+    Value sumOfSquares =
+        b.create<linalg::GenericOp>(
+             loc, TypeRange{sumInit.getType()}, ValueRange{input},
+             ValueRange{sumInit},
+             ArrayRef<AffineMap>{layout.inputMap, layout.statsMap},
+             layout.reductionIteratorTypes,
+             [&](OpBuilder &nb, Location nl, ValueRange args) {
+               Value square = nb.create<arith::MulFOp>(nl, args[0], args[0]);
+               Value sum = nb.create<arith::AddFOp>(nl, square, args[1]);
+               nb.create<linalg::YieldOp>(nl, sum);
+             })
+            .getResult(0);
+
+    Value count = getNumElements(b, loc, input, reducedDims, elementType);
+    Value rstd =
+        createReciprocalStdDev(b, loc, sumOfSquares, count, elementType,
+                               op.getEpsilon().convertToDouble());
+    Value result = createNormalizeOp(b, loc, input, /*mean=*/Value(), rstd,
+                                     adaptor.getWeight(), /*bias=*/Value(),
+                                     layout, axis);
+
+    // The result may be more static than the type of the op.
+    if (result.getType() != resultTensorType)
+      result = b.create<tensor::CastOp>(loc, resultTensorType, result);
+    b.replaceOp(op, result);
+    return success();
+  }
+};
+
+} // namespace
+
+void mlir::TcpToLinalg::populateNormalizationPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target) {
+  MLIRContext *context = patterns.getContext();
+
+  target.addIllegalOp<SoftmaxOp, LogSoftmaxOp>();
+  patterns.add<ConvertSoftmaxOp<SoftmaxOp>>(typeConverter, context);
+  patterns.add<ConvertSoftmaxOp<LogSoftmaxOp>>(typeConverter, context);
+
+  target.addIllegalOp<LayerNormOp, RMSNormOp>();
+  patterns.add<ConvertLayerNormOp>(typeConverter, context);
+  patterns.add<ConvertRMSNormOp>(typeConverter, context);
+}
@@ -0,0 +1,228 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TcpToLinalg/TcpToLinalg.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "../PassDetail.h"
+#include "PopulatePatterns.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Transforms/DialectConversion.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+
+namespace {
+
+SmallVector<int64_t> getValuesFromIndexArrayAttribute(ArrayAttr attr) {
+  SmallVector<int64_t> arrayValues;
+  for (Attribute val : attr.getValue())
+    arrayValues.push_back(cast<IntegerAttr>(val).getValue().getSExtValue());
+  return arrayValues;
+}
+
+// Returns the sizes of the result of a pooling of the padded `input`.
+SmallVector<OpFoldResult> getResultSizes(OpBuilder &b, Location loc,
+                                         RankedTensorType resultType,
+                                         Value input,
+                                         ArrayRef<int64_t> kernelSize,
+                                         ArrayRef<int64_t> stride,
+                                         ArrayRef<int64_t> dilation) {
+  SmallVector<OpFoldResult> sizes;
+  for (int64_t i = 0; i < 4; ++i) {
+    if (!resultType.isDynamicDim(i)) {
+      sizes.push_back(b.getIndexAttr(resultType.getDimSize(i)));
+      continue;
+    }
+    if (i < 2) {
+      sizes.push_back(tensor::getMixedSize(b, loc, input, i));
+      continue;
+    }
+    // (in - dilation * (kernel - 1) - 1) / stride + 1
+    int64_t s = i - 2;
+    Value in = b.createOrFold<tensor::DimOp>(loc, input, i);
+    Value extent = b.create<arith::ConstantIndexOp>(
+        loc, dilation[s] * (kernelSize[s] - 1) + 1);
+    Value size = b.create<arith::SubIOp>(loc, in, extent);
+    size = b.create<arith::DivUIOp>(
+        loc, size, b.create<arith::ConstantIndexOp>(loc, stride[s]));
+    sizes.push_back(
+        b.create<arith::AddIOp>(loc, size,
+                                b.create<arith::ConstantIndexOp>(loc, 1))
+            .getResult());
+  }
+  return sizes;
+}
+
+// Returns the value that padded elements and the accumulator of a max
+// pooling start with, which never wins the maximum.
+TypedAttr getMaxPoolIdentity(OpBuilder &b, Type elementType) {
+  if (auto floatType = dyn_cast<FloatType>(elementType))
+    return b.getFloatAttr(
+        floatType,
+        APFloat::getInf(floatType.getFloatSemantics(), /*Negative=*/true));
+  auto intType = cast<IntegerType>(elementType);
+  return b.getIntegerAttr(intType,
+                          APInt::getSignedMinValue(intType.getWidth()));
+}
+
+// Lowers a pooling to `PoolingOpTy`, a named linalg pooling op over the
+// padded input. The padding is a separate `tensor.pad`, which
+// `tcp-lower-conv-ops` fuses into the tiles of the vectorized kernel. The
+// sum of an average pooling is then divided by the size of every window.
+template <typename TcpOpTy, typename PoolingOpTy>
+class ConvertPool2DOp : public OpConversionPattern<TcpOpTy> {
+public:
+  using OpConversionPattern<TcpOpTy>::OpConversionPattern;
+  using OpAdaptor = typename TcpOpTy::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(TcpOpTy op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &b) const override {
+    Location loc = op->getLoc();
+    auto resultTensorType = cast<RankedTensorType>(
+        this->getTypeConverter()->convertType(op.getOut().getType()));
+    Value input = adaptor.getIn();
+    Value originalInput = input;
+    Type elementType = resultTensorType.getElementType();
+    constexpr bool isMax = std::is_same_v<TcpOpTy, MaxPool2DOp>;
+
+    SmallVector<int64_t> kernelSize =
+        getValuesFromIndexArrayAttribute(op.getKernelSize());
+    SmallVector<int64_t> stride =
+        getValuesFromIndexArrayAttribute(op.getStride());
+    SmallVector<int64_t> padding =
+        getValuesFromIndexArrayAttribute(op.getPadding());
+    SmallVector<int64_t> dilation = {1, 1};
+    if constexpr (isMax)
+      dilation = getValuesFromIndexArrayAttribute(op.getDilation());
+
+    Value identity = b.create<arith::ConstantOp>(
+        loc, isMax ? getMaxPoolIdentity(b, elementType)
+                   : b.getZeroAttr(elementType));
+    if (llvm::any_of(padding, [](int64_t p) { return p != 0; })) {
+      SmallVector<OpFoldResult> pads = {b.getIndexAttr(0), b.getIndexAttr(0)};
+      for (int64_t p : padding)
+        pads.push_back(b.getIndexAttr(p));
+      input = b.create<tensor::PadOp>(loc, Type(), input, pads, pads, identity);
+    }
+
+    SmallVector<OpFoldResult> resultSizes = getResultSizes(
+        b, loc, resultTensorType, input, kernelSize, stride, dilation);
+    Value emptyTensor =
+        b.create<tensor::EmptyOp>(loc, resultSizes, elementType);
+    Value init =
+        b.create<linalg::FillOp>(loc, identity, emptyTensor).getResult(0);
+    // The pooling ops only read the shape of the window.
+    Value window = b.create<tensor::EmptyOp>(loc, kernelSize, elementType);
+
+    Value result =
+        b.create<PoolingOpTy>(loc, init.getType(), ValueRange{input, window},
+                              ValueRange{init}, b.getI64VectorAttr(stride),
+                              b.getI64VectorAttr(dilation))
+            ->getResult(0);
+
+    if constexpr (!isMax)
+      result = divideByWindowSize(b, loc, op, originalInput, result,
+                                  kernelSize, stride, padding);
+
+    if (result.getType() != resultTensorType)
+      result = b.create<tensor::CastOp>(loc, resultTensorType, result);
+    b.replaceOp(op, result);
+    return success();
+  }
+
+private:
+  // Divides the window sums in `sum` by the number of elements in every
+  // window. Without `count_include_pad`, the padding is not counted, so that
+  // the windows at the borders are smaller.
+  static Value divideByWindowSize(OpBuilder &b, Location loc, AvgPool2DOp op,
+                                  Value input, Value sum,
+                                  ArrayRef<int64_t> kernelSize,
+                                  ArrayRef<int64_t> stride,
+                                  ArrayRef<int64_t> padding) {
+    auto sumType = cast<RankedTensorType>(sum.getType());
+    Type elementType = sumType.getElementType();
+    bool hasPadding = llvm::any_of(padding, [](int64_t p) { return p != 0; });
+    bool countIncludePad = op.getCountIncludePad() || !hasPadding;
+
+    Value fullWindowSize;
+    SmallVector<Value> inSizes;
+    if (countIncludePad) {
+      fullWindowSize = b.create<arith::ConstantOp>(
+          loc, b.getFloatAttr(elementType, kernelSize[0] * kernelSize[1]));
+    } else {
+      for (int64_t i = 0; i < 2; ++i)
+        inSizes.push_back(b.createOrFold<tensor::DimOp>(loc, input, i + 2));
+    }
+
+    int64_t rank = sumType.getRank();
+    AffineMap identityMap = b.getMultiDimIdentityMap(rank);
+    return b
+        .create<linalg::GenericOp>(
+            loc, sumType, ValueRange{}, ValueRange{sum},
+            ArrayRef<AffineMap>{identityMap},
+            SmallVector<utils::IteratorType>(rank,
+                                             utils::IteratorType::parallel),
+            [&](OpBuilder &nb, Location nl, ValueRange args) {
+              Value windowSize = fullWindowSize;
+              if (!countIncludePad) {
+                // Clamp [o * stride - padding, o * stride - padding + kernel)
+                // to the input.
+                Value count;
+                for (int64_t i = 0; i < 2; ++i) {
+                  Value o = nb.create<linalg::IndexOp>(nl, i + 2);
+                  Value start = nb.create<arith::SubIOp>(
+                      nl,
+                      nb.create<arith::MulIOp>(
+                          nl, o,
+                          nb.create<arith::ConstantIndexOp>(nl, stride[i])),
+                      nb.create<arith::ConstantIndexOp>(nl, padding[i]));
+                  Value end = nb.create<arith::MinSIOp>(
+                      nl,
+                      nb.create<arith::AddIOp>(
+                          nl, start,
+                          nb.create<arith::ConstantIndexOp>(nl, kernelSize[i])),
+                      inSizes[i]);
+                  start = nb.create<arith::MaxSIOp>(
+                      nl, start, nb.create<arith::ConstantIndexOp>(nl, 0));
+                  Value extent = nb.create<arith::SubIOp>(nl, end, start);
+                  count = count ? nb.create<arith::MulIOp>(nl, count, extent)
+                                : extent;
+                }
+                Value countInt =
+                    nb.create<arith::IndexCastOp>(nl, nb.getI64Type(), count);
+                windowSize =
+                    nb.create<arith::SIToFPOp>(nl, elementType, countInt);
+              }
+              Value mean = nb.create<arith::DivFOp>(nl, args[0], windowSize);
+              nb.create<linalg::YieldOp>(nl, mean);
+            })
+        .getResult(0);
+  }
+};
+
+} // namespace
+
+void mlir::TcpToLinalg::populatePoolingPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target) {
+  MLIRContext *context = patterns.getContext();
+
+  target.addIllegalOp<MaxPool2DOp, AvgPool2DOp>();
+  patterns.add<ConvertPool2DOp<MaxPool2DOp, linalg::PoolingNchwMaxOp>>(
+      typeConverter, context);
+  patterns.add<ConvertPool2DOp<AvgPool2DOp, linalg::PoolingNchwSumOp>>(
+      typeConverter, context);
+}
@@ -21,6 +21,25 @@ void populateMiscPatternsAndLegality(TypeConverter &typeConverter,
 void populateDataMovementPatternsAndLegality(TypeConverter &typeConverter,
                                              RewritePatternSet &patterns,
                                              ConversionTarget &target);
+void populateContractionPatternsAndLegality(TypeConverter &typeConverter,
+                                            RewritePatternSet &patterns,
+                                            ConversionTarget &target);
+void populateConvolutionPatternsAndLegality(TypeConverter &typeConverter,
+                                            RewritePatternSet &patterns,
+                                            ConversionTarget &target);
+void populateReductionPatternsAndLegality(TypeConverter &typeConverter,
+                                          RewritePatternSet &patterns,
+                                          ConversionTarget &target,
+                                          bool reassociateFP);
+void populateNormalizationPatternsAndLegality(TypeConverter &typeConverter,
+                                              RewritePatternSet &patterns,
+                                              ConversionTarget &target);
+void populatePoolingPatternsAndLegality(TypeConverter &typeConverter,
+                                        RewritePatternSet &patterns,
+                                        ConversionTarget &target);
+void populateSortPatternsAndLegality(TypeConverter &typeConverter,
+                                     RewritePatternSet &patterns,
+                                     ConversionTarget &target);
 
 } // namespace TcpToLinalg
 } // namespace mlir
@@ -0,0 +1,490 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TcpToLinalg/TcpToLinalg.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "../PassDetail.h"
+#include "PopulatePatterns.h"
+#include "Utils.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Transforms/DialectConversion.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+using namespace mlir::tcp_to_linalg;
+
+namespace {
+
+SmallVector<int64_t> getValuesFromIndexArrayAttribute(ArrayAttr attr) {
+  SmallVector<int64_t> arrayValues;
+  for (Attribute val : attr.getValue())
+    arrayValues.push_back(cast<IntegerAttr>(val).getValue().getSExtValue());
+  return arrayValues;
+}
+
+// Returns the identity of the reduction or scan `op` for `elementType`, which
+// the accumulator is initialized with.
+TypedAttr getReductionIdentity(Operation *op, Type elementType, OpBuilder &b) {
+  if (auto floatType = dyn_cast<FloatType>(elementType)) {
+    const llvm::fltSemantics &semantics = floatType.getFloatSemantics();
+    if (isa<ReduceSumOp, CumsumOp>(op))
+      return b.getFloatAttr(floatType, 0.0);
+    if (isa<ReduceProdOp, CumprodOp>(op))
+      return b.getFloatAttr(floatType, 1.0);
+    return b.getFloatAttr(
+        floatType,
+        APFloat::getInf(semantics, /*Negative=*/isa<ReduceMaxOp>(op)));
+  }
+  auto intType = cast<IntegerType>(elementType);
+  unsigned width = intType.getWidth();
+  if (isa<ReduceSumOp, CumsumOp>(op))
+    return b.getIntegerAttr(intType, 0);
+  if (isa<ReduceProdOp, CumprodOp>(op))
+    return b.getIntegerAttr(intType, 1);
+  // Booleans are ordered as unsigned, see `createReductionCombiner`.
+  if (width == 1)
+    return b.getIntegerAttr(intType, isa<ReduceMaxOp>(op) ? 0 : 1);
+  if (isa<ReduceMaxOp>(op))
+    return b.getIntegerAttr(intType, APInt::getSignedMinValue(width));
+  return b.getIntegerAttr(intType, APInt::getSignedMaxValue(width));
+}
+
+// Combines the element `in` with the accumulator `acc`.
+Value createReductionCombiner(Operation *op, OpBuilder &b, Location loc,
+                              Value in, Value acc) {
+  bool isFloat = isa<FloatType>(in.getType());
+  if (isa<ReduceSumOp, CumsumOp>(op))
+    return isFloat ? b.create<arith::AddFOp>(loc, in, acc).getResult()
+                   : b.create<arith::AddIOp>(loc, in, acc).getResult();
+  if (isa<ReduceProdOp, CumprodOp>(op))
+    return isFloat ? b.create<arith::MulFOp>(loc, in, acc).getResult()
+                   : b.create<arith::MulIOp>(loc, in, acc).getResult();
+  if (isFloat)
+    return isa<ReduceMaxOp>(op)
+               ? b.create<arith::MaximumFOp>(loc, in, acc).getResult()
+               : b.create<arith::MinimumFOp>(loc, in, acc).getResult();
+  // Booleans are ordered as unsigned, so that max is "any" and min is "all";
+  // as signed, `true` would be -1.
+  if (in.getType().isInteger(1))
+    return isa<ReduceMaxOp>(op)
+               ? b.create<arith::MaxUIOp>(loc, in, acc).getResult()
+               : b.create<arith::MinUIOp>(loc, in, acc).getResult();
+  return isa<ReduceMaxOp>(op)
+             ? b.create<arith::MaxSIOp>(loc, in, acc).getResult()
+             : b.create<arith::MinSIOp>(loc, in, acc).getResult();
+}
+
+// Lowers a reduction to `linalg.reduce` into an accumulator that is filled
+// with the identity of the reduction. With `keepdim`, the unit dims are added
+// back with `tensor.expand_shape`.
+template <typename TcpOpTy>
+class ConvertReduceOp : public OpConversionPattern<TcpOpTy> {
+public:
+  using OpConversionPattern<TcpOpTy>::OpConversionPattern;
+  using OpAdaptor = typename TcpOpTy::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(TcpOpTy op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &b) const override {
+    Location loc = op->getLoc();
+    auto resultTensorType = cast<RankedTensorType>(
+        this->getTypeConverter()->convertType(op.getOut().getType()));
+    Value input = adaptor.getIn();
+    auto inputType = cast<RankedTensorType>(input.getType());
+    Type elementType = resultTensorType.getElementType();
+    SmallVector<int64_t> axes = getValuesFromIndexArrayAttribute(op.getAxes());
+    bool keepdim = op.getKeepdim();
+
+    // The sizes of the dims that are not reduced. Static sizes are taken from
+    // the result, which may be more static than the input.
+    SmallVector<OpFoldResult> keptSizes;
+    SmallVector<OpFoldResult> resultSizes;
+    int64_t resultDim = 0;
+    for (int64_t i = 0; i < inputType.getRank(); ++i) {
+      if (llvm::is_contained(axes, i)) {
+        if (keepdim) {
+          resultSizes.push_back(b.getIndexAttr(1));
+          ++resultDim;
+        }
+        continue;
+      }
+      int64_t size = resultTensorType.getDimSize(resultDim++);
+      OpFoldResult mixedSize = ShapedType::isDynamic(size)
+                                   ? tensor::getMixedSize(b, loc, input, i)
+                                   : b.getIndexAttr(size);
+      keptSizes.push_back(mixedSize);
+      resultSizes.push_back(mixedSize);
+    }
+
+    Value emptyTensor = b.create<tensor::EmptyOp>(loc, keptSizes, elementType);
+    Value identity = b.create<arith::ConstantOp>(
+        loc, getReductionIdentity(op, elementType, b));
+    Value init =
+        b.create<linalg::FillOp>(loc, identity, emptyTensor).getResult(0);
+
+    Value result =
+        b.create<linalg::ReduceOp>(
+             loc, ValueRange{input}, ValueRange{init}, axes,
+             [&](OpBuilder &nestedBuilder, Location nestedLoc,
+                 ValueRange args) {
+               Value combined = createReductionCombiner(
+                   op, nestedBuilder, nestedLoc, args[0], args[1]);
+               nestedBuilder.create<linalg::YieldOp>(nestedLoc, combined);
+             })
+            .getResult(0);
+
+    if (keepdim) {
+      // Each reduced unit dim is grouped with the next kept dim, trailing
+      // unit dims with the last one.
+      SmallVector<ReassociationIndices> reassociation;
+      ReassociationIndices group;
+      for (int64_t i = 0; i < inputType.getRank(); ++i) {
+        group.push_back(i);
+        if (!llvm::is_contained(axes, i)) {
+          reassociation.push_back(group);
+          group.clear();
+        }
+      }
+      if (!reassociation.empty())
+        reassociation.back().append(group.begin(), group.end());
+      SmallVector<int64_t> staticSizes;
+      SmallVector<Value> dynamicSizes;
+      dispatchIndexOpFoldResults(resultSizes, dynamicSizes, staticSizes);
+      result = b.create<tensor::ExpandShapeOp>(
+          loc, RankedTensorType::get(staticSizes, elementType), result,
+          reassociation, resultSizes);
+    }
+
+    // The result may be more static than the type of the op.
+    if (result.getType() != resultTensorType)
+      result = b.create<tensor::CastOp>(loc, resultTensorType, result);
+    b.replaceOp(op, result);
+    return success();
+  }
+};
+
+// The rows of a scan are split into blocks of this size, which are scanned in
+// parallel.
+constexpr int64_t kScanBlockSize = 4096;
+
+// The blocks are processed by chunks of this size, the elements of which are
+// combined with independent ops.
+constexpr int64_t kScanChunkSize = 8;
+
+// Returns the largest multiple of `kScanChunkSize` up to `size`.
+Value getChunkedSize(OpBuilder &b, Location loc, Value size) {
+  Value chunkSize = b.create<arith::ConstantIndexOp>(loc, kScanChunkSize);
+  return b.createOrFold<arith::SubIOp>(
+      loc, size, b.createOrFold<arith::RemUIOp>(loc, size, chunkSize));
+}
+
+// Reduces the 1-D `row` with the combiner of the scan `op`. The elements of
+// each chunk are combined into as many partial results, which do not depend
+// on each other, as the lanes of a vector accumulator. They are combined at
+// the end, with the elements left after the last chunk.
+Value reduceRow(Operation *op, OpBuilder &b, Location loc, Value row) {
+  Type elementType = cast<RankedTensorType>(row.getType()).getElementType();
+  Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  Value chunkSize = b.create<arith::ConstantIndexOp>(loc, kScanChunkSize);
+  Value size = b.createOrFold<tensor::DimOp>(loc, row, 0);
+  Value chunkedSize = getChunkedSize(b, loc, size);
+  Value identity = b.create<arith::ConstantOp>(
+      loc, getReductionIdentity(op, elementType, b));
+
+  SmallVector<Value> partials(kScanChunkSize, identity);
+  auto chunks = b.create<scf::ForOp>(
+      loc, zero, chunkedSize, chunkSize, partials,
+      [&](OpBuilder &b, Location loc, Value i, ValueRange iterArgs) {
+        SmallVector<Value> newPartials;
+        for (int64_t lane = 0; lane < kScanChunkSize; ++lane) {
+          Value position = b.create<arith::AddIOp>(
+              loc, i, b.create<arith::ConstantIndexOp>(loc, lane));
+          Value element = b.create<tensor::ExtractOp>(loc, row, position);
+          newPartials.push_back(createReductionCombiner(op, b, loc, element,
+                                                        iterArgs[lane]));
+        }
+        b.create<scf::YieldOp>(loc, newPartials);
+      });
+
+  partials = llvm::to_vector(chunks.getResults());
+  for (int64_t width = kScanChunkSize / 2; width >= 1; width /= 2) {
+    for (int64_t lane = 0; lane < width; ++lane)
+      partials[lane] = createReductionCombiner(op, b, loc, partials[lane],
+                                               partials[lane + width]);
+  }
+  auto rest = b.create<scf::ForOp>(
+      loc, chunkedSize, size, one, ValueRange{partials[0]},
+      [&](OpBuilder &b, Location loc, Value i, ValueRange iterArgs) {
+        Value element = b.create<tensor::ExtractOp>(loc, row, i);
+        b.create<scf::YieldOp>(
+            loc, createReductionCombiner(op, b, loc, element, iterArgs[0]));
+      });
+  return rest.getResult(0);
+}
+
+// Scans the 1-D `row` with the scan `op` into `out`, of the same size, after
+// the elements combined into `init`. Returns the updated `out`.
+//
+// Without `reassociate`, the elements are combined one after the other.
+// Otherwise, each chunk is scanned in log2(kScanChunkSize) steps, each of
+// which combines every element with the one a power of two before it, as in
+// an in-register SIMD scan. The chunk is then combined with the carry from
+// the previous chunks. The steps are straight-line code with independent
+// ops, which the LLVM vectorizers can map onto vector ops and shuffles, and
+// the chain of dependent ops across chunks is one op per chunk instead of one
+// per element.
+Value scanRow(Operation *op, OpBuilder &b, Location loc, Value row, Value out,
+              Value init, bool reassociate) {
+  Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  Value size = b.createOrFold<tensor::DimOp>(loc, row, 0);
+  Value start = zero;
+  SmallVector<Value> carries = {init, out};
+
+  if (reassociate) {
+    Value chunkSize = b.create<arith::ConstantIndexOp>(loc, kScanChunkSize);
+    start = getChunkedSize(b, loc, size);
+    auto chunks = b.create<scf::ForOp>(
+        loc, zero, start, chunkSize, carries,
+        [&](OpBuilder &b, Location loc, Value i, ValueRange iterArgs) {
+          SmallVector<Value> positions, elements;
+          for (int64_t lane = 0; lane < kScanChunkSize; ++lane) {
+            positions.push_back(b.create<arith::AddIOp>(
+                loc, i, b.create<arith::ConstantIndexOp>(loc, lane)));
+            elements.push_back(
+                b.create<tensor::ExtractOp>(loc, row, positions.back()));
+          }
+          for (int64_t shift = 1; shift < kScanChunkSize; shift *= 2) {
+            SmallVector<Value> shifted = elements;
+            for (int64_t lane = shift; lane < kScanChunkSize; ++lane)
+              shifted[lane] = createReductionCombiner(
+                  op, b, loc, elements[lane], elements[lane - shift]);
+            elements = shifted;
+          }
+          Value newOut = iterArgs[1];
+          for (int64_t lane = 0; lane < kScanChunkSize; ++lane) {
+            elements[lane] = createReductionCombiner(op, b, loc, elements[lane],
+                                                     iterArgs[0]);
+            newOut = b.create<tensor::InsertOp>(loc, elements[lane], newOut,
+                                                positions[lane]);
+          }
+          b.create<scf::YieldOp>(loc, ValueRange{elements.back(), newOut});
+        });
+    carries = llvm::to_vector(chunks.getResults());
+  }
+
+  auto rest = b.create<scf::ForOp>(
+      loc, start, size, one, carries,
+      [&](OpBuilder &b, Location loc, Value i, ValueRange iterArgs) {
+        Value element = b.create<tensor::ExtractOp>(loc, row, i);
+        Value carry =
+            createReductionCombiner(op, b, loc, element, iterArgs[0]);
+        Value newOut = b.create<tensor::InsertOp>(loc, carry, iterArgs[1], i);
+        b.create<scf::YieldOp>(loc, ValueRange{carry, newOut});
+      });
+  return rest.getResult(1);
+}
+
+// Scans the 1-D `row` with the scan `op` into `out`, of the same size,
+// excluding each element from its own result. Returns the updated `out`.
+Value scanRowExclusive(Operation *op, OpBuilder &b, Location loc, Value row,
+                       Value out) {
+  Type elementType = cast<RankedTensorType>(row.getType()).getElementType();
+  Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  Value size = b.createOrFold<tensor::DimOp>(loc, row, 0);
+  Value identity = b.create<arith::ConstantOp>(
+      loc, getReductionIdentity(op, elementType, b));
+  auto loop = b.create<scf::ForOp>(
+      loc, zero, size, one, ValueRange{identity, out},
+      [&](OpBuilder &b, Location loc, Value i, ValueRange iterArgs) {
+        Value element = b.create<tensor::ExtractOp>(loc, row, i);
+        Value newOut =
+            b.create<tensor::InsertOp>(loc, iterArgs[0], iterArgs[1], i);
+        Value carry =
+            createReductionCombiner(op, b, loc, element, iterArgs[0]);
+        b.create<scf::YieldOp>(loc, ValueRange{carry, newOut});
+      });
+  return loop.getResult(1);
+}
+
+// Lowers a scan along `dim` to loops over the rows along `dim`, which are
+// independent, so that they are scanned in parallel with multiple threads.
+//
+// Rows of a static size of at most `kScanBlockSize` are each scanned with
+// `scanRow`. Longer rows are split into blocks of `kScanBlockSize` elements,
+// which are scanned in parallel in three steps:
+//   1. An `scf.forall` over the blocks of all rows reduces each block.
+//   2. The totals of the blocks of each row are scanned, excluding each
+//      block, into the offset of the block, i.e. the combination of the
+//      elements before it.
+//   3. An `scf.forall` over the blocks of all rows scans each block after its
+//      offset.
+// The rows are read twice and written once, and the sequential step 2 only
+// processes one element per block.
+//
+// Both the chunks of `scanRow` and the blocks reassociate the scan. Floating
+// point scans are therefore only split with `reassociateFP`, and otherwise
+// scan each row in order.
+template <typename TcpOpTy>
+class ConvertScanOp : public OpConversionPattern<TcpOpTy> {
+public:
+  ConvertScanOp(TypeConverter &typeConverter, MLIRContext *context,
+                bool reassociateFP)
+      : OpConversionPattern<TcpOpTy>(typeConverter, context),
+        reassociateFP(reassociateFP) {}
+  using OpAdaptor = typename TcpOpTy::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(TcpOpTy op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &b) const override {
+    Location loc = op->getLoc();
+    auto resultTensorType = cast<RankedTensorType>(
+        this->getTypeConverter()->convertType(op.getOut().getType()));
+    Value input = adaptor.getIn();
+    auto inputType = cast<RankedTensorType>(input.getType());
+    Type elementType = inputType.getElementType();
+    int64_t rank = inputType.getRank();
+    int64_t dim = op.getDim();
+    bool reassociate = reassociateFP || !isa<FloatType>(elementType);
+
+    SmallVector<OpFoldResult> sizes = tensor::getMixedSizes(b, loc, input);
+    OpFoldResult zero = b.getIndexAttr(0);
+    OpFoldResult rowSize = sizes[dim];
+    Value out = b.create<tensor::EmptyOp>(loc, sizes, elementType);
+
+    Value result;
+    if (!reassociate || (!inputType.isDynamicDim(dim) &&
+                         inputType.getDimSize(dim) <= kScanBlockSize)) {
+      Value identity = b.create<arith::ConstantOp>(
+          loc, getReductionIdentity(op, elementType, b));
+      if (rank == 1) {
+        result = scanRow(op, b, loc, input, out, identity, reassociate);
+      } else {
+        result = createRowLoop(
+            b, loc, input, dim, /*numParts=*/std::nullopt, {out},
+            [&](OpBuilder &b, Location loc, ValueRange ivs, Value,
+                ValueRange outputs) -> RowPart {
+              Value row = extractRow(b, loc, input, dim, ivs, zero, rowSize);
+              Value rowOut =
+                  extractRow(b, loc, outputs[0], dim, ivs, zero, rowSize);
+              return {zero,
+                      rowSize,
+                      {scanRow(op, b, loc, row, rowOut, identity,
+                               reassociate)}};
+            })[0];
+      }
+    } else {
+      Value size = b.createOrFold<tensor::DimOp>(loc, input, dim);
+      Value blockSize = b.create<arith::ConstantIndexOp>(loc, kScanBlockSize);
+      OpFoldResult numBlocks =
+          getAsOpFoldResult(getNumParts(b, loc, size, blockSize));
+      SmallVector<OpFoldResult> totalsSizes = sizes;
+      totalsSizes[dim] = numBlocks;
+      OpFoldResult unitSize = b.getIndexAttr(1);
+      auto getBlock = [&](OpBuilder &b, Location loc, Value block) {
+        Value offset = b.create<arith::MulIOp>(loc, block, blockSize);
+        Value partSize = b.create<arith::MinUIOp>(
+            loc, b.create<arith::SubIOp>(loc, size, offset), blockSize);
+        return std::make_pair(offset, partSize);
+      };
+
+      // 1. Reduces each block into its total.
+      Value totals = b.create<tensor::EmptyOp>(loc, totalsSizes, elementType);
+      totals = createRowLoop(
+          b, loc, input, dim, numBlocks, {totals},
+          [&](OpBuilder &b, Location loc, ValueRange ivs, Value block,
+              ValueRange) -> RowPart {
+            auto [offset, partSize] = getBlock(b, loc, block);
+            Value row =
+                extractRow(b, loc, input, dim, ivs, offset, partSize);
+            Value total = b.create<tensor::FromElementsOp>(
+                loc, RankedTensorType::get({1}, elementType),
+                reduceRow(op, b, loc, row));
+            return {block, unitSize, {total}};
+          })[0];
+
+      // 2. Scans the totals of each row into the offsets of the blocks.
+      Value offsets = b.create<tensor::EmptyOp>(loc, totalsSizes, elementType);
+      if (rank == 1) {
+        offsets = scanRowExclusive(op, b, loc, totals, offsets);
+      } else {
+        offsets = createRowLoop(
+            b, loc, totals, dim, /*numParts=*/std::nullopt, {offsets},
+            [&](OpBuilder &b, Location loc, ValueRange ivs, Value,
+                ValueRange outputs) -> RowPart {
+              Value row =
+                  extractRow(b, loc, totals, dim, ivs, zero, numBlocks);
+              Value rowOut =
+                  extractRow(b, loc, outputs[0], dim, ivs, zero, numBlocks);
+              return {zero,
+                      numBlocks,
+                      {scanRowExclusive(op, b, loc, row, rowOut)}};
+            })[0];
+      }
+
+      // 3. Scans each block after its offset.
+      result = createRowLoop(
+          b, loc, input, dim, numBlocks, {out},
+          [&](OpBuilder &b, Location loc, ValueRange ivs, Value block,
+              ValueRange outputs) -> RowPart {
+            auto [offset, partSize] = getBlock(b, loc, block);
+            SmallVector<Value> indices = llvm::to_vector(ivs);
+            indices.insert(indices.begin() + dim, block);
+            Value init = b.create<tensor::ExtractOp>(loc, offsets, indices);
+            Value row =
+                extractRow(b, loc, input, dim, ivs, offset, partSize);
+            Value rowOut =
+                extractRow(b, loc, outputs[0], dim, ivs, offset, partSize);
+            return {offset,
+                    partSize,
+                    {scanRow(op, b, loc, row, rowOut, init,
+                             /*reassociate=*/true)}};
+          })[0];
+    }
+
+    // The result may be more static than the input.
+    if (result.getType() != resultTensorType)
+      result = b.create<tensor::CastOp>(loc, resultTensorType, result);
+    b.replaceOp(op, result);
+    return success();
+  }
+
+private:
+  bool reassociateFP;
+};
+
+} // namespace
+
+void mlir::TcpToLinalg::populateReductionPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target, bool reassociateFP) {
+  MLIRContext *context = patterns.getContext();
+
+  target.addIllegalOp<ReduceSumOp, ReduceProdOp, ReduceMaxOp, ReduceMinOp>();
+  patterns.add<ConvertReduceOp<ReduceSumOp>>(typeConverter, context);
+  patterns.add<ConvertReduceOp<ReduceProdOp>>(typeConverter, context);
+  patterns.add<ConvertReduceOp<ReduceMaxOp>>(typeConverter, context);
+  patterns.add<ConvertReduceOp<ReduceMinOp>>(typeConverter, context);
+
+  target.addIllegalOp<CumsumOp, CumprodOp>();
+  patterns.add<ConvertScanOp<CumsumOp>>(typeConverter, context,
+                                        reassociateFP);
+  patterns.add<ConvertScanOp<CumprodOp>>(typeConverter, context,
+                                         reassociateFP);
+}
@@ -0,0 +1,551 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TcpToLinalg/TcpToLinalg.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "../PassDetail.h"
+#include "PopulatePatterns.h"
+#include "Utils.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Transforms/DialectConversion.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+using namespace mlir::tcp_to_linalg;
+
+namespace {
+
+// Returns whether `lhs` comes strictly before `rhs` in descending order with
+// `descending`, and in ascending order otherwise. NaNs are larger than every
+// other value, and integers are compared as signed.
+Value isBefore(OpBuilder &b, Location loc, Value lhs, Value rhs,
+               bool descending) {
+  if (!isa<FloatType>(lhs.getType()))
+    return b.create<arith::CmpIOp>(loc,
+                                   descending ? arith::CmpIPredicate::sgt
+                                              : arith::CmpIPredicate::slt,
+                                   lhs, rhs);
+
+  Value lhsIsNaN =
+      b.create<arith::CmpFOp>(loc, arith::CmpFPredicate::UNO, lhs, lhs);
+  Value rhsIsNaN =
+      b.create<arith::CmpFOp>(loc, arith::CmpFPredicate::UNO, rhs, rhs);
+  Value isOrdered = b.create<arith::CmpFOp>(
+      loc, descending ? arith::CmpFPredicate::OGT : arith::CmpFPredicate::OLT,
+      lhs, rhs);
+  // With i1 operands, `lhsIsNaN > rhsIsNaN` holds when only `lhs` is a NaN.
+  Value isNaNOrdered = b.create<arith::CmpIOp>(
+      loc, descending ? arith::CmpIPredicate::ugt : arith::CmpIPredicate::ult,
+      lhsIsNaN, rhsIsNaN);
+  return b.create<arith::OrIOp>(loc, isOrdered, isNaNOrdered);
+}
+
+// Inserts `element`, found at `index`, into the sorted 1-D `values` and its
+// index into `indices`, at slot `slot` or before it. The elements before
+// `slot` that `element` comes before are shifted by one slot, overwriting
+// the one at `slot`. Returns the updated `values` and `indices`.
+std::pair<Value, Value> insertSorted(OpBuilder &b, Location loc, Value element,
+                                     Value index, Value values, Value indices,
+                                     Value slot, bool descending) {
+  Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  auto shift = b.create<scf::WhileOp>(
+      loc, TypeRange{b.getIndexType(), values.getType(), indices.getType()},
+      ValueRange{slot, values, indices},
+      [&](OpBuilder &b, Location loc, ValueRange args) {
+        Value isNotFirst = b.create<arith::CmpIOp>(
+            loc, arith::CmpIPredicate::ugt, args[0], zero);
+        auto isShifted = b.create<scf::IfOp>(
+            loc, TypeRange{b.getI1Type()}, isNotFirst,
+            [&](OpBuilder &b, Location loc) {
+              Value previous = b.create<arith::SubIOp>(loc, args[0], one);
+              Value other = b.create<tensor::ExtractOp>(loc, args[1], previous);
+              b.create<scf::YieldOp>(
+                  loc, isBefore(b, loc, element, other, descending));
+            },
+            [&](OpBuilder &b, Location loc) {
+              Value isFirst = b.create<arith::ConstantIntOp>(loc, 0, 1);
+              b.create<scf::YieldOp>(loc, isFirst);
+            });
+        b.create<scf::ConditionOp>(loc, isShifted.getResult(0), args);
+      },
+      [&](OpBuilder &b, Location loc, ValueRange args) {
+        Value previous = b.create<arith::SubIOp>(loc, args[0], one);
+        Value shiftedValue =
+            b.create<tensor::ExtractOp>(loc, args[1], previous);
+        Value shiftedIndex =
+            b.create<tensor::ExtractOp>(loc, args[2], previous);
+        Value newValues =
+            b.create<tensor::InsertOp>(loc, shiftedValue, args[1], args[0]);
+        Value newIndices =
+            b.create<tensor::InsertOp>(loc, shiftedIndex, args[2], args[0]);
+        b.create<scf::YieldOp>(loc,
+                               ValueRange{previous, newValues, newIndices});
+      });
+
+  Value insertSlot = shift.getResult(0);
+  Value newValues = b.create<tensor::InsertOp>(loc, element,
+                                               shift.getResult(1), insertSlot);
+  Value newIndices = b.create<tensor::InsertOp>(loc, index, shift.getResult(2),
+                                                insertSlot);
+  return {newValues, newIndices};
+}
+
+// Selects the `k` first elements of the 1-D `row` in the order of `isBefore`
+// into `values` and their indices into `indices`, both of size `k`. The row is
+// scanned once, and the best `k` elements so far are kept sorted in
+// `values`. Once it is full, an element that does not come before its last
+// one is rejected with a single comparison. The others are inserted in place,
+// shifting the elements they come before by one. Elements that are equal to
+// one already selected are inserted after it, so ties are ordered by index.
+//
+// This takes a single pass over the row and a buffer of `k` elements. For
+// rows without a trend, only a few elements are inserted once the buffer is
+// full, which makes it linear in the size of the row for small `k`, instead
+// of the `n log n` of sorting the whole row.
+std::pair<Value, Value> selectTopK(OpBuilder &b, Location loc, Value row,
+                                   Value values, Value indices, int64_t k,
+                                   bool largest) {
+  Type indexElementType =
+      cast<RankedTensorType>(indices.getType()).getElementType();
+  Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  Value kValue = b.create<arith::ConstantIndexOp>(loc, k);
+  Value last = b.create<arith::ConstantIndexOp>(loc, k - 1);
+  Value size = b.createOrFold<tensor::DimOp>(loc, row, 0);
+
+  auto loop = b.create<scf::ForOp>(
+      loc, zero, size, one, ValueRange{values, indices},
+      [&](OpBuilder &b, Location loc, Value i, ValueRange iterArgs) {
+        Value element = b.create<tensor::ExtractOp>(loc, row, i);
+        Value isFull =
+            b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::uge, i, kValue);
+        auto isSelected = b.create<scf::IfOp>(
+            loc, TypeRange{b.getI1Type()}, isFull,
+            [&](OpBuilder &b, Location loc) {
+              Value worst = b.create<tensor::ExtractOp>(loc, iterArgs[0], last);
+              b.create<scf::YieldOp>(
+                  loc, isBefore(b, loc, element, worst, largest));
+            },
+            [&](OpBuilder &b, Location loc) {
+              Value isFree = b.create<arith::ConstantIntOp>(loc, 1, 1);
+              b.create<scf::YieldOp>(loc, isFree);
+            });
+
+        auto insert = b.create<scf::IfOp>(
+            loc, iterArgs.getTypes(), isSelected.getResult(0),
+            [&](OpBuilder &b, Location loc) {
+              // Start from the first free slot, or from the last one, which
+              // is dropped, when the buffer is full.
+              Value slot = b.create<arith::MinUIOp>(loc, i, last);
+              Value index =
+                  b.create<arith::IndexCastOp>(loc, indexElementType, i);
+              auto [newValues, newIndices] =
+                  insertSorted(b, loc, element, index, iterArgs[0],
+                               iterArgs[1], slot, largest);
+              b.create<scf::YieldOp>(loc, ValueRange{newValues, newIndices});
+            },
+            [&](OpBuilder &b, Location loc) {
+              b.create<scf::YieldOp>(loc, iterArgs);
+            });
+        b.create<scf::YieldOp>(loc, insert.getResults());
+      });
+  return {loop.getResult(0), loop.getResult(1)};
+}
+
+// Returns an empty tensor of `resultType`, with a size of `size` along `dim`
+// and the sizes of `input` along the other dims.
+Value createEmptyResult(OpBuilder &b, Location loc, RankedTensorType resultType,
+                        Value input, int64_t dim, int64_t size) {
+  SmallVector<Value> dynamicSizes;
+  for (int64_t i = 0; i < resultType.getRank(); ++i) {
+    if (!resultType.isDynamicDim(i))
+      continue;
+    dynamicSizes.push_back(
+        i == dim ? b.create<arith::ConstantIndexOp>(loc, size).getResult()
+                 : b.createOrFold<tensor::DimOp>(loc, input, i));
+  }
+  return b.create<tensor::EmptyOp>(loc, resultType, dynamicSizes);
+}
+
+// tcp.topk is lowered to an `scf.forall` over the rows of `in` along `dim`,
+// which are independent, so that they are selected in parallel with multiple
+// threads. Each row is selected with `selectTopK` directly into its slice of
+// the results.
+class ConvertTopKOp : public OpConversionPattern<TopKOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(TopKOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+    Value input = adaptor.getIn();
+    int64_t rank = cast<RankedTensorType>(input.getType()).getRank();
+    int64_t dim = op.getDim();
+    int64_t k = op.getK();
+    bool largest = op.getLargest();
+
+    Value values = createEmptyResult(rewriter, loc, op.getValues().getType(),
+                                     input, dim, k);
+    Value indices = createEmptyResult(rewriter, loc, op.getIndices().getType(),
+                                      input, dim, k);
+    if (k == 0) {
+      rewriter.replaceOp(op, {values, indices});
+      return success();
+    }
+
+    if (rank == 1) {
+      auto [rowValues, rowIndices] =
+          selectTopK(rewriter, loc, input, values, indices, k, largest);
+      rewriter.replaceOp(op, {rowValues, rowIndices});
+      return success();
+    }
+
+    SmallVector<OpFoldResult> lowerBounds(rank - 1, rewriter.getIndexAttr(0));
+    SmallVector<OpFoldResult> steps(rank - 1, rewriter.getIndexAttr(1));
+    SmallVector<OpFoldResult> upperBounds;
+    for (int64_t i = 0; i < rank; ++i) {
+      if (i != dim)
+        upperBounds.push_back(tensor::getMixedSize(rewriter, loc, input, i));
+    }
+    auto forallOp = rewriter.create<scf::ForallOp>(
+        loc, lowerBounds, upperBounds, steps, ValueRange{values, indices},
+        /*mapping=*/std::nullopt);
+    ValueRange ivs = forallOp.getInductionVars();
+    Value sharedValues = forallOp.getRegionIterArgs()[0];
+    Value sharedIndices = forallOp.getRegionIterArgs()[1];
+
+    rewriter.setInsertionPoint(forallOp.getTerminator());
+    OpFoldResult zero = rewriter.getIndexAttr(0);
+    OpFoldResult rowSize = tensor::getMixedSize(rewriter, loc, input, dim);
+    OpFoldResult kSize = rewriter.getIndexAttr(k);
+    Value row = extractRow(rewriter, loc, input, dim, ivs, zero, rowSize);
+    auto [rowValues, rowIndices] = selectTopK(
+        rewriter, loc, row,
+        extractRow(rewriter, loc, sharedValues, dim, ivs, zero, kSize),
+        extractRow(rewriter, loc, sharedIndices, dim, ivs, zero, kSize), k,
+        largest);
+
+    rewriter.setInsertionPointToStart(forallOp.getTerminator().getBody());
+    parallelInsertRow(rewriter, loc, rowValues, sharedValues, dim, ivs, zero,
+                      kSize);
+    parallelInsertRow(rewriter, loc, rowIndices, sharedIndices, dim, ivs, zero,
+                      kSize);
+    rewriter.replaceOp(op, forallOp->getResults());
+    return success();
+  }
+};
+
+// Rows of at most this static size are sorted with a sorting network.
+constexpr int64_t kMaxNetworkSize = 16;
+
+// Longer rows are merge sorted, starting from runs of this size that are
+// sorted by insertion.
+constexpr int64_t kRunSize = 16;
+
+// Returns the comparators of Batcher's odd-even merge sort of `size`
+// elements, as pairs of positions `(i, j)` with `i < j`. Each comparator
+// orders the elements at `i` and `j`. The network of the next power of two is
+// pruned of the comparators past `size`, which is valid since these would
+// only compare padding elements, which are larger than the others and never
+// move.
+SmallVector<std::pair<int64_t, int64_t>> getSortingNetwork(int64_t size) {
+  SmallVector<std::pair<int64_t, int64_t>> comparators;
+  for (int64_t p = 1; p < size; p *= 2) {
+    for (int64_t k = p; k >= 1; k /= 2) {
+      for (int64_t j = k % p; j + k < size; j += 2 * k) {
+        for (int64_t i = 0; i < k && i + j + k < size; ++i) {
+          if ((i + j) / (2 * p) == (i + j + k) / (2 * p))
+            comparators.emplace_back(i + j, i + j + k);
+        }
+      }
+    }
+  }
+  return comparators;
+}
+
+// Sorts the 1-D `row` of static size with a sorting network. The elements are
+// extracted and the comparators are emitted as straight-line code, with
+// `arith.select` ops and no branches, which the LLVM vectorizers can map onto
+// SIMD min/max and blend instructions. With `stable`, equal elements are
+// ordered by their index, which makes the order total and the sort stable.
+std::pair<Value, Value> sortWithNetwork(OpBuilder &b, Location loc, Value row,
+                                        Type indexElementType, bool descending,
+                                        bool stable) {
+  auto rowType = cast<RankedTensorType>(row.getType());
+  int64_t size = rowType.getDimSize(0);
+  SmallVector<Value> values, indices;
+  for (int64_t i = 0; i < size; ++i) {
+    Value position = b.create<arith::ConstantIndexOp>(loc, i);
+    values.push_back(b.create<tensor::ExtractOp>(loc, row, position));
+    indices.push_back(b.create<arith::ConstantIntOp>(loc, i, indexElementType));
+  }
+
+  for (auto [i, j] : getSortingNetwork(size)) {
+    Value isSwapped = isBefore(b, loc, values[j], values[i], descending);
+    if (stable) {
+      Value isNotBefore = b.create<arith::XOrIOp>(
+          loc, isBefore(b, loc, values[i], values[j], descending),
+          b.create<arith::ConstantIntOp>(loc, 1, 1));
+      Value isIndexBefore = b.create<arith::CmpIOp>(
+          loc, arith::CmpIPredicate::slt, indices[j], indices[i]);
+      isSwapped = b.create<arith::OrIOp>(
+          loc, isSwapped,
+          b.create<arith::AndIOp>(loc, isNotBefore, isIndexBefore));
+    }
+    Value first =
+        b.create<arith::SelectOp>(loc, isSwapped, values[j], values[i]);
+    Value second =
+        b.create<arith::SelectOp>(loc, isSwapped, values[i], values[j]);
+    Value firstIndex =
+        b.create<arith::SelectOp>(loc, isSwapped, indices[j], indices[i]);
+    Value secondIndex =
+        b.create<arith::SelectOp>(loc, isSwapped, indices[i], indices[j]);
+    values[i] = first;
+    values[j] = second;
+    indices[i] = firstIndex;
+    indices[j] = secondIndex;
+  }
+
+  Value sortedValues = b.create<tensor::FromElementsOp>(loc, rowType, values);
+  Value sortedIndices = b.create<tensor::FromElementsOp>(
+      loc, RankedTensorType::get({size}, indexElementType), indices);
+  return {sortedValues, sortedIndices};
+}
+
+// Sorts the 1-D `row` by insertion into `values` and `indices`, of the size of
+// `row`. `offset` is the index of the first element of `row`. Equal elements
+// are not shifted, so the sort is stable.
+std::pair<Value, Value> sortWithInsertion(OpBuilder &b, Location loc, Value row,
+                                          Value offset, Value values,
+                                          Value indices, bool descending) {
+  Type indexElementType =
+      cast<RankedTensorType>(indices.getType()).getElementType();
+  Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  Value size = b.createOrFold<tensor::DimOp>(loc, row, 0);
+  auto loop = b.create<scf::ForOp>(
+      loc, zero, size, one, ValueRange{values, indices},
+      [&](OpBuilder &b, Location loc, Value i, ValueRange iterArgs) {
+        Value element = b.create<tensor::ExtractOp>(loc, row, i);
+        Value index = b.create<arith::IndexCastOp>(
+            loc, indexElementType, b.create<arith::AddIOp>(loc, offset, i));
+        auto [newValues, newIndices] =
+            insertSorted(b, loc, element, index, iterArgs[0], iterArgs[1], i,
+                         descending);
+        b.create<scf::YieldOp>(loc, ValueRange{newValues, newIndices});
+      });
+  return {loop.getResult(0), loop.getResult(1)};
+}
+
+// Merges the sorted runs `[0, middle)` and `[middle, size)` of the 1-D
+// `values` and `indices` into `outValues` and `outIndices`. Equal elements
+// are taken from the first run, so the merge is stable. Both runs are read at
+// their cursor, clamped to stay in bounds, and the next element is picked
+// with `arith.select` ops, so that the loop has no branches to mispredict.
+std::pair<Value, Value> mergeRuns(OpBuilder &b, Location loc, Value values,
+                                  Value indices, Value middle, Value outValues,
+                                  Value outIndices, bool descending) {
+  Value zero = b.create<arith::ConstantIndexOp>(loc, 0);
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  Value size = b.createOrFold<tensor::DimOp>(loc, values, 0);
+  Value lastFirst = b.create<arith::SubIOp>(loc, middle, one);
+  Value lastSecond = b.create<arith::SubIOp>(loc, size, one);
+  auto loop = b.create<scf::ForOp>(
+      loc, zero, size, one, ValueRange{zero, middle, outValues, outIndices},
+      [&](OpBuilder &b, Location loc, Value k, ValueRange iterArgs) {
+        Value i = iterArgs[0];
+        Value j = iterArgs[1];
+        Value first = b.create<arith::MinUIOp>(loc, i, lastFirst);
+        Value second = b.create<arith::MinUIOp>(loc, j, lastSecond);
+        Value firstValue = b.create<tensor::ExtractOp>(loc, values, first);
+        Value secondValue = b.create<tensor::ExtractOp>(loc, values, second);
+        Value firstIndex = b.create<tensor::ExtractOp>(loc, indices, first);
+        Value secondIndex = b.create<tensor::ExtractOp>(loc, indices, second);
+
+        // The next element is taken from the second run when it is not
+        // exhausted, and either the first one is or it comes before.
+        Value isFirstDone =
+            b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::uge, i, middle);
+        Value isSecondLeft =
+            b.create<arith::CmpIOp>(loc, arith::CmpIPredicate::ult, j, size);
+        Value isSecond = b.create<arith::AndIOp>(
+            loc, isSecondLeft,
+            b.create<arith::OrIOp>(
+                loc, isFirstDone,
+                isBefore(b, loc, secondValue, firstValue, descending)));
+
+        Value value =
+            b.create<arith::SelectOp>(loc, isSecond, secondValue, firstValue);
+        Value index =
+            b.create<arith::SelectOp>(loc, isSecond, secondIndex, firstIndex);
+        Value newValues =
+            b.create<tensor::InsertOp>(loc, value, iterArgs[2], k);
+        Value newIndices =
+            b.create<tensor::InsertOp>(loc, index, iterArgs[3], k);
+        Value newI = b.create<arith::SelectOp>(
+            loc, isSecond, i, b.create<arith::AddIOp>(loc, i, one));
+        Value newJ = b.create<arith::SelectOp>(
+            loc, isSecond, b.create<arith::AddIOp>(loc, j, one), j);
+        b.create<scf::YieldOp>(loc,
+                               ValueRange{newI, newJ, newValues, newIndices});
+      });
+  return {loop.getResult(2), loop.getResult(3)};
+}
+
+// tcp.sort is lowered to loops over the rows of `in` along `dim`, which are
+// independent, so that they are sorted in parallel with multiple threads.
+//
+// Rows of a static size of at most `kMaxNetworkSize` are sorted with a
+// sorting network, in a single `scf.forall` over the rows.
+//
+// Longer rows are sorted with a bottom-up merge sort. An `scf.forall` over
+// the runs of `kRunSize` elements of all rows sorts them by insertion. Then,
+// each pass of an `scf.while` merges pairs of adjacent runs, doubling their
+// size, until a single run is left. The merges of a pass are independent, so
+// each pass is an `scf.forall` over the pairs of runs of all rows. This keeps
+// the threads busy on long rows, where the early passes have many pairs, even
+// when there are few rows. Since both the insertion sort and the merges are
+// stable, so is the sort.
+class ConvertSortOp : public OpConversionPattern<SortOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(SortOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op->getLoc();
+    Value input = adaptor.getIn();
+    auto inputType = cast<RankedTensorType>(input.getType());
+    int64_t dim = op.getDim();
+    bool descending = op.getDescending();
+    Type indexElementType = op.getIndices().getType().getElementType();
+
+    SmallVector<OpFoldResult> sizes =
+        tensor::getMixedSizes(rewriter, loc, input);
+    auto createOutputs = [&](OpBuilder &b) -> std::pair<Value, Value> {
+      return {b.create<tensor::EmptyOp>(loc, sizes,
+                                        inputType.getElementType()),
+              b.create<tensor::EmptyOp>(loc, sizes, indexElementType)};
+    };
+    OpFoldResult zero = rewriter.getIndexAttr(0);
+    OpFoldResult rowSize = sizes[dim];
+
+    if (!inputType.isDynamicDim(dim) &&
+        inputType.getDimSize(dim) <= kMaxNetworkSize) {
+      if (inputType.getRank() == 1) {
+        auto [values, indices] =
+            sortWithNetwork(rewriter, loc, input, indexElementType,
+                            descending, op.getStable());
+        rewriter.replaceOp(op, {values, indices});
+        return success();
+      }
+      auto [values, indices] = createOutputs(rewriter);
+      ValueRange results = createRowLoop(
+          rewriter, loc, input, dim, /*numParts=*/std::nullopt,
+          {values, indices},
+          [&](OpBuilder &b, Location loc, ValueRange ivs, Value,
+              ValueRange) -> RowPart {
+            Value row = extractRow(b, loc, input, dim, ivs, zero, rowSize);
+            auto [rowValues, rowIndices] = sortWithNetwork(
+                b, loc, row, indexElementType, descending, op.getStable());
+            return {zero, rowSize, {rowValues, rowIndices}};
+          });
+      rewriter.replaceOp(op, results);
+      return success();
+    }
+
+    // Sorts the runs of `kRunSize` elements by insertion.
+    Value size = rewriter.createOrFold<tensor::DimOp>(loc, input, dim);
+    Value runSize = rewriter.create<arith::ConstantIndexOp>(loc, kRunSize);
+    Value numRuns = getNumParts(rewriter, loc, size, runSize);
+    auto [values, indices] = createOutputs(rewriter);
+    ValueRange runs = createRowLoop(
+        rewriter, loc, input, dim, getAsOpFoldResult(numRuns),
+        {values, indices},
+        [&](OpBuilder &b, Location loc, ValueRange ivs, Value part,
+            ValueRange outputs) -> RowPart {
+          Value offset = b.create<arith::MulIOp>(loc, part, runSize);
+          Value partSize = b.create<arith::MinUIOp>(
+              loc, b.create<arith::SubIOp>(loc, size, offset), runSize);
+          Value row = extractRow(b, loc, input, dim, ivs, offset, partSize);
+          auto [partValues, partIndices] = sortWithInsertion(
+              b, loc, row, offset,
+              extractRow(b, loc, outputs[0], dim, ivs, offset, partSize),
+              extractRow(b, loc, outputs[1], dim, ivs, offset, partSize),
+              descending);
+          return {offset, partSize, {partValues, partIndices}};
+        });
+
+    // Merges pairs of adjacent runs of `width` elements, until the runs span
+    // the rows.
+    auto passes = rewriter.create<scf::WhileOp>(
+        loc,
+        TypeRange{rewriter.getIndexType(), runs[0].getType(),
+                  runs[1].getType()},
+        ValueRange{runSize, runs[0], runs[1]},
+        [&](OpBuilder &b, Location loc, ValueRange args) {
+          Value isUnsorted = b.create<arith::CmpIOp>(
+              loc, arith::CmpIPredicate::ult, args[0], size);
+          b.create<scf::ConditionOp>(loc, isUnsorted, args);
+        },
+        [&](OpBuilder &b, Location loc, ValueRange args) {
+          Value width = args[0];
+          Value pairSize = b.create<arith::AddIOp>(loc, width, width);
+          Value numPairs = getNumParts(b, loc, size, pairSize);
+          auto [mergedValues, mergedIndices] = createOutputs(b);
+          ValueRange merged = createRowLoop(
+              b, loc, input, dim, OpFoldResult(numPairs),
+              {mergedValues, mergedIndices},
+              [&](OpBuilder &b, Location loc, ValueRange ivs, Value part,
+                  ValueRange outputs) -> RowPart {
+                Value offset = b.create<arith::MulIOp>(loc, part, pairSize);
+                Value partSize = b.create<arith::MinUIOp>(
+                    loc, b.create<arith::SubIOp>(loc, size, offset), pairSize);
+                Value middle = b.create<arith::MinUIOp>(loc, width, partSize);
+                auto [partValues, partIndices] = mergeRuns(
+                    b, loc,
+                    extractRow(b, loc, args[1], dim, ivs, offset, partSize),
+                    extractRow(b, loc, args[2], dim, ivs, offset, partSize),
+                    middle,
+                    extractRow(b, loc, outputs[0], dim, ivs, offset,
+                               partSize),
+                    extractRow(b, loc, outputs[1], dim, ivs, offset,
+                               partSize),
+                    descending);
+                return {offset, partSize, {partValues, partIndices}};
+              });
+          b.create<scf::YieldOp>(loc,
+                                 ValueRange{pairSize, merged[0], merged[1]});
+        });
+    rewriter.replaceOp(op, passes.getResults().drop_front());
+    return success();
+  }
+};
+
+} // namespace
+
+void mlir::TcpToLinalg::populateSortPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target) {
+  MLIRContext *context = patterns.getContext();
+
+  target.addIllegalOp<TopKOp>();
+  patterns.add<ConvertTopKOp>(typeConverter, context);
+  target.addIllegalOp<SortOp>();
+  patterns.add<ConvertSortOp>(typeConverter, context);
+}
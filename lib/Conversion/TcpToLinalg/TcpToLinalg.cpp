@@ -17,6 +17,7 @@
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Linalg/IR/Linalg.h"
 #include "mlir/Dialect/Math/IR/Math.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/IR/PatternMatch.h"
 #include "mlir/Pass/Pass.h"
@@ -35,11 +36,24 @@ namespace {
 
 class ConvertTcpToLinalg : public ConvertTcpToLinalgBase<ConvertTcpToLinalg> {
 public:
+  ConvertTcpToLinalg() = default;
+  ConvertTcpToLinalg(bool reassociateFP) {
+    this->reassociateFP = reassociateFP;
+  }
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    ConvertTcpToLinalgBase::getDependentDialects(registry);
+    // tcp.scatter, tcp.topk, tcp.sort and the scans are lowered to loops over
+    // the rows of their operands.
+    registry.insert<scf::SCFDialect>();
+  }
+
   void runOnOperation() override {
     MLIRContext *context = &getContext();
     ConversionTarget target(*context);
     target.addLegalDialect<linalg::LinalgDialect, math::MathDialect,
-                           tensor::TensorDialect, arith::ArithDialect>();
+                           tensor::TensorDialect, arith::ArithDialect,
+                           scf::SCFDialect>();
 
     TypeConverter typeConverter;
     typeConverter.addConversion([](Type type) { return type; });
@@ -52,6 +66,18 @@ public:
                                                  target);
     TcpToLinalg::populateDataMovementPatternsAndLegality(typeConverter,
                                                          patterns, target);
+    TcpToLinalg::populateContractionPatternsAndLegality(typeConverter,
+                                                        patterns, target);
+    TcpToLinalg::populateConvolutionPatternsAndLegality(typeConverter,
+                                                        patterns, target);
+    TcpToLinalg::populateReductionPatternsAndLegality(typeConverter, patterns,
+                                                      target, reassociateFP);
+    TcpToLinalg::populateNormalizationPatternsAndLegality(typeConverter,
+                                                          patterns, target);
+    TcpToLinalg::populatePoolingPatternsAndLegality(typeConverter, patterns,
+                                                    target);
+    TcpToLinalg::populateSortPatternsAndLegality(typeConverter, patterns,
+                                                 target);
 
     if (failed(applyPartialConversion(getOperation(), target,
                                       std::move(patterns))))
@@ -65,5 +91,10 @@ std::unique_ptr<OperationPass<func::FuncOp>> createConvertTcpToLinalgPass() {
   return std::make_unique<ConvertTcpToLinalg>();
 }
 
+std::unique_ptr<OperationPass<func::FuncOp>>
+createConvertTcpToLinalgPass(bool reassociateFP) {
+  return std::make_unique<ConvertTcpToLinalg>(reassociateFP);
+}
+
 } // namespace tcp
 } // namespace mlir
@@ -0,0 +1,90 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "Utils.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+
+using namespace mlir;
+
+namespace mlir::tcp_to_linalg {
+
+Value extractRow(OpBuilder &b, Location loc, Value tensor, int64_t dim,
+                 ValueRange ivs, OpFoldResult offset, OpFoldResult size) {
+  auto tensorType = cast<RankedTensorType>(tensor.getType());
+  SmallVector<OpFoldResult> offsets, sizes;
+  SmallVector<OpFoldResult> strides(tensorType.getRank(), b.getIndexAttr(1));
+  for (int64_t i = 0, iv = 0; i < tensorType.getRank(); ++i) {
+    offsets.push_back(i == dim ? offset : OpFoldResult(ivs[iv++]));
+    sizes.push_back(i == dim ? size : OpFoldResult(b.getIndexAttr(1)));
+  }
+  auto rowType = RankedTensorType::get(
+      {getConstantIntValue(size).value_or(ShapedType::kDynamic)},
+      tensorType.getElementType());
+  return b.create<tensor::ExtractSliceOp>(loc, rowType, tensor, offsets,
+                                          sizes, strides);
+}
+
+void parallelInsertRow(OpBuilder &b, Location loc, Value row, Value dest,
+                       int64_t dim, ValueRange ivs, OpFoldResult offset,
+                       OpFoldResult size) {
+  auto destType = cast<RankedTensorType>(dest.getType());
+  SmallVector<OpFoldResult> offsets, sizes;
+  SmallVector<OpFoldResult> strides(destType.getRank(), b.getIndexAttr(1));
+  for (int64_t i = 0, iv = 0; i < destType.getRank(); ++i) {
+    offsets.push_back(i == dim ? offset : OpFoldResult(ivs[iv++]));
+    sizes.push_back(i == dim ? size : OpFoldResult(b.getIndexAttr(1)));
+  }
+  b.create<tensor::ParallelInsertSliceOp>(loc, row, dest, offsets, sizes,
+                                          strides);
+}
+
+Value getNumParts(OpBuilder &b, Location loc, Value size, Value partSize) {
+  Value one = b.create<arith::ConstantIndexOp>(loc, 1);
+  Value padding = b.createOrFold<arith::SubIOp>(loc, partSize, one);
+  return b.createOrFold<arith::DivUIOp>(
+      loc, b.createOrFold<arith::AddIOp>(loc, size, padding), partSize);
+}
+
+ValueRange createRowLoop(OpBuilder &b, Location loc, Value input, int64_t dim,
+                         std::optional<OpFoldResult> numParts,
+                         ValueRange outputs, RowPartBuilder buildPart) {
+  int64_t rank = cast<RankedTensorType>(input.getType()).getRank();
+  SmallVector<OpFoldResult> upperBounds;
+  for (int64_t i = 0; i < rank; ++i) {
+    if (i != dim)
+      upperBounds.push_back(tensor::getMixedSize(b, loc, input, i));
+  }
+  if (numParts)
+    upperBounds.push_back(*numParts);
+  assert(!upperBounds.empty() && "expected at least one dim to iterate over");
+  SmallVector<OpFoldResult> lowerBounds(upperBounds.size(), b.getIndexAttr(0));
+  SmallVector<OpFoldResult> steps(upperBounds.size(), b.getIndexAttr(1));
+  auto forallOp =
+      b.create<scf::ForallOp>(loc, lowerBounds, upperBounds, steps, outputs,
+                              /*mapping=*/std::nullopt);
+  ValueRange ivs = forallOp.getInductionVars();
+  ValueRange rowIvs = numParts ? ivs.drop_back() : ivs;
+  Value part = numParts ? ivs.back() : Value();
+  ValueRange sharedOutputs = forallOp.getRegionIterArgs();
+
+  OpBuilder::InsertionGuard guard(b);
+  b.setInsertionPoint(forallOp.getTerminator());
+  RowPart rowPart = buildPart(b, loc, rowIvs, part, sharedOutputs);
+  b.setInsertionPointToStart(forallOp.getTerminator().getBody());
+  for (auto [value, output] : llvm::zip_equal(rowPart.values, sharedOutputs))
+    parallelInsertRow(b, loc, value, output, dim, rowIvs, rowPart.offset,
+                      rowPart.size);
+  return forallOp->getResults();
+}
+
+} // namespace mlir::tcp_to_linalg
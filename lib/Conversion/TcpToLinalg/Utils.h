@@ -0,0 +1,54 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir/IR/Builders.h"
+
+#include <optional>
+
+namespace mlir {
+namespace tcp_to_linalg {
+
+// Returns the slice of `tensor` along `dim` at the position `ivs` in the other
+// dims, as a 1-D tensor of `size` elements starting at `offset`.
+Value extractRow(OpBuilder &b, Location loc, Value tensor, int64_t dim,
+                 ValueRange ivs, OpFoldResult offset, OpFoldResult size);
+
+// Inserts the 1-D `row` of `size` elements into `dest` in parallel, at the
+// slice extracted by `extractRow`.
+void parallelInsertRow(OpBuilder &b, Location loc, Value row, Value dest,
+                       int64_t dim, ValueRange ivs, OpFoldResult offset,
+                       OpFoldResult size);
+
+// Returns the number of parts of `partSize` elements that cover `size` ones.
+Value getNumParts(OpBuilder &b, Location loc, Value size, Value partSize);
+
+// A part of a row, at `offset` along the dim of the row, with a value for each
+// output of the loop that computes it.
+struct RowPart {
+  OpFoldResult offset;
+  OpFoldResult size;
+  SmallVector<Value> values;
+};
+
+using RowPartBuilder =
+    function_ref<RowPart(OpBuilder &b, Location loc, ValueRange ivs,
+                         Value part, ValueRange outputs)>;
+
+// Creates an `scf.forall` over the rows of `input` along `dim`, and over
+// `numParts` parts of each row when it is set, with `outputs` as shared
+// outputs. There must be at least one dim to iterate over. `buildPart` is
+// called with the position of the row in the other dims, the index of the
+// part, and the shared outputs. The part that it returns is inserted into the
+// outputs. Returns the results of the loop.
+ValueRange createRowLoop(OpBuilder &b, Location loc, Value input, int64_t dim,
+                         std::optional<OpFoldResult> numParts,
+                         ValueRange outputs, RowPartBuilder buildPart);
+
+} // namespace tcp_to_linalg
+} // namespace mlir
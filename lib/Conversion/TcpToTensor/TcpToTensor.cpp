@@ -47,12 +47,112 @@ public:
   }
 };
 
+// The insert is computed in place of the destination when it is dead
+// afterwards, and into a copy of it otherwise.
+class SliceScatterOpConverter
+    : public OpConversionPattern<tcp::SliceScatterOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(tcp::SliceScatterOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    SmallVector<OpFoldResult> sizes =
+        tensor::getMixedSizes(rewriter, op.getLoc(), adaptor.getSrc());
+    rewriter.replaceOpWithNewOp<tensor::InsertSliceOp>(
+        op, adaptor.getSrc(), adaptor.getDest(),
+        getAsOpFoldResult(adaptor.getStarts()), sizes,
+        getAsOpFoldResult(adaptor.getStrides()));
+    return success();
+  }
+};
+
+// The padding is kept symbolic in a `tensor.pad`, which tiling pushes into
+// the tiles of its consumers, where it becomes per tile bounds and masked
+// vector reads instead of a padded copy of the input.
+class PadOpConverter : public OpConversionPattern<tcp::PadOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(tcp::PadOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto getPads = [&](ArrayAttr attr) {
+      SmallVector<int64_t> pads;
+      for (Attribute pad : attr)
+        pads.push_back(cast<IntegerAttr>(pad).getInt());
+      return getAsIndexOpFoldResult(rewriter.getContext(), pads);
+    };
+    Value paddingValue = rewriter.create<tensor::ExtractOp>(
+        op.getLoc(), adaptor.getPaddingValue(), ValueRange{});
+    rewriter.replaceOpWithNewOp<tensor::PadOp>(
+        op, op.getType(), adaptor.getIn(), getPads(op.getLow()),
+        getPads(op.getHigh()), paddingValue);
+    return success();
+  }
+};
+
+class ReshapeOpConverter : public OpConversionPattern<tcp::ReshapeOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(tcp::ReshapeOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto shapeType = RankedTensorType::get(
+        {static_cast<int64_t>(adaptor.getShape().size())},
+        rewriter.getIndexType());
+    Value shape = rewriter.create<tensor::FromElementsOp>(
+        op.getLoc(), shapeType, adaptor.getShape());
+    rewriter.replaceOpWithNewOp<tensor::ReshapeOp>(op, op.getType(),
+                                                   adaptor.getIn(), shape);
+    return success();
+  }
+};
+
+// The reassociative reshapes map to their tensor counterparts, which
+// bufferize to views of the input buffer instead of copies.
+class ExpandShapeOpConverter : public OpConversionPattern<tcp::ExpandShapeOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(tcp::ExpandShapeOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    rewriter.replaceOpWithNewOp<tensor::ExpandShapeOp>(
+        op, op.getType(), adaptor.getIn(), op.getReassociationIndices());
+    return success();
+  }
+};
+
+class CollapseShapeOpConverter
+    : public OpConversionPattern<tcp::CollapseShapeOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(tcp::CollapseShapeOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    rewriter.replaceOpWithNewOp<tensor::CollapseShapeOp>(
+        op, op.getType(), adaptor.getIn(), op.getReassociationIndices());
+    return success();
+  }
+};
+
 void populateTcpToTensorPatternsAndLegality(RewritePatternSet &patterns,
                                             ConversionTarget &target) {
   MLIRContext *context = patterns.getContext();
 
-  target.addIllegalOp<tcp::SliceOp>();
-  patterns.add<SliceOpConverter>(context);
+  target.addIllegalOp<tcp::SliceOp, tcp::SliceScatterOp>();
+  patterns.add<SliceOpConverter, SliceScatterOpConverter>(context);
+
+  target.addIllegalOp<tcp::PadOp>();
+  patterns.add<PadOpConverter>(context);
+
+  target.addIllegalOp<tcp::ReshapeOp, tcp::ExpandShapeOp,
+                      tcp::CollapseShapeOp>();
+  patterns.add<ReshapeOpConverter, ExpandShapeOpConverter,
+               CollapseShapeOpConverter>(context);
 }
 
 class ConvertTcpToTensor : public ConvertTcpToTensorBase<ConvertTcpToTensor> {
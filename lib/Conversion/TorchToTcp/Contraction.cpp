@@ -0,0 +1,360 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TorchToTcp/TorchToTcp.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "PopulatePatterns.h"
+#include "Utils.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "torch-mlir/Dialect/Torch/IR/TorchOps.h"
+
+#include "llvm/ADT/StringSet.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+using namespace mlir::torch;
+using namespace mlir::torch::Torch;
+
+namespace {
+
+// Returns the reassociation that merges the leading `numDims` dims of a
+// tensor of rank `rank` into one and keeps all other dims.
+SmallVector<ReassociationIndices> getLeadingDimsReassociation(int64_t rank,
+                                                              int64_t numDims) {
+  SmallVector<ReassociationIndices> reassociation(1);
+  for (int64_t i = 0; i < numDims; ++i)
+    reassociation.back().push_back(i);
+  for (int64_t i = numDims; i < rank; ++i)
+    reassociation.push_back({i});
+  return reassociation;
+}
+
+// Returns the reassociation that merges the trailing two dims of a tensor of
+// rank `rank` into one and keeps all other dims.
+SmallVector<ReassociationIndices> getTrailingDimsReassociation(int64_t rank) {
+  SmallVector<ReassociationIndices> reassociation;
+  for (int64_t i = 0; i < rank - 2; ++i)
+    reassociation.push_back({i});
+  reassociation.push_back({rank - 2, rank - 1});
+  return reassociation;
+}
+
+// Expands `input` to a tensor with the given `sizes`.
+Value expandToSizes(OpBuilder &b, Location loc, Value input,
+                    ArrayRef<OpFoldResult> sizes,
+                    ArrayRef<ReassociationIndices> reassociation) {
+  SmallVector<int64_t> staticSizes;
+  SmallVector<Value> dynamicSizes;
+  dispatchIndexOpFoldResults(sizes, dynamicSizes, staticSizes);
+  auto resultType = RankedTensorType::get(
+      staticSizes, cast<RankedTensorType>(input.getType()).getElementType());
+  return b.create<tensor::ExpandShapeOp>(loc, resultType, input, reassociation,
+                                         sizes);
+}
+
+// Returns the more static of two sizes that are known to be equal.
+OpFoldResult mergeSizes(OpFoldResult a, OpFoldResult b) {
+  return getConstantIntValue(a) ? a : b;
+}
+
+// Multiplies `lhs` of shape [B..., M, K] with `rhs` of shape [K, N] or
+// [B..., K, N] and returns a tensor of shape [B..., M, N]. Batch dims are
+// collapsed into a single dim, so that the contraction maps onto
+// `tcp.matmul` or `tcp.batch_matmul`.
+FailureOr<Value> createContraction(ConversionPatternRewriter &rewriter,
+                                   Location loc, Value lhs, Value rhs) {
+  auto lhsType = cast<RankedTensorType>(lhs.getType());
+  auto rhsType = cast<RankedTensorType>(rhs.getType());
+  int64_t lhsRank = lhsType.getRank();
+  int64_t rhsRank = rhsType.getRank();
+  Type elementType = lhsType.getElementType();
+
+  SmallVector<OpFoldResult> lhsSizes =
+      tensor::getMixedSizes(rewriter, loc, lhs);
+  SmallVector<OpFoldResult> rhsSizes =
+      tensor::getMixedSizes(rewriter, loc, rhs);
+
+  auto createMatmul = [&](Value a, Value b) -> Value {
+    SmallVector<int64_t> shape = {
+        cast<RankedTensorType>(a.getType()).getDimSize(0),
+        cast<RankedTensorType>(b.getType()).getDimSize(1)};
+    return rewriter.create<tcp::MatmulOp>(
+        loc, RankedTensorType::get(shape, elementType), a, b);
+  };
+
+  if (lhsRank == 2 && rhsRank == 2)
+    return createMatmul(lhs, rhs);
+
+  // [B..., M, K] x [K, N]: the batch dims of lhs are folded into M.
+  if (lhsRank > 2 && rhsRank == 2) {
+    Value collapsedLhs = rewriter.create<tensor::CollapseShapeOp>(
+        loc, lhs, getLeadingDimsReassociation(lhsRank, lhsRank - 1));
+    Value result = createMatmul(collapsedLhs, rhs);
+    SmallVector<OpFoldResult> resultSizes(lhsSizes.begin(),
+                                          lhsSizes.end() - 1);
+    resultSizes.push_back(rhsSizes[1]);
+    return expandToSizes(rewriter, loc, result, resultSizes,
+                         getLeadingDimsReassociation(lhsRank, lhsRank - 1));
+  }
+
+  // [B..., M, K] x [B..., K, N] without broadcasting of the batch dims.
+  if (lhsRank > 2 && lhsRank == rhsRank) {
+    int64_t numBatchDims = lhsRank - 2;
+    SmallVector<OpFoldResult> resultSizes;
+    for (int64_t i = 0; i < numBatchDims; ++i) {
+      int64_t lhsDim = lhsType.getDimSize(i);
+      int64_t rhsDim = rhsType.getDimSize(i);
+      if (!ShapedType::isDynamic(lhsDim) && !ShapedType::isDynamic(rhsDim) &&
+          lhsDim != rhsDim)
+        return failure();
+      resultSizes.push_back(mergeSizes(lhsSizes[i], rhsSizes[i]));
+    }
+    resultSizes.push_back(lhsSizes[lhsRank - 2]);
+    resultSizes.push_back(rhsSizes[rhsRank - 1]);
+
+    SmallVector<ReassociationIndices> reassociation =
+        getLeadingDimsReassociation(lhsRank, numBatchDims);
+    Value collapsedLhs =
+        rewriter.create<tensor::CollapseShapeOp>(loc, lhs, reassociation);
+    Value collapsedRhs =
+        rewriter.create<tensor::CollapseShapeOp>(loc, rhs, reassociation);
+    auto collapsedLhsType = cast<RankedTensorType>(collapsedLhs.getType());
+    auto collapsedRhsType = cast<RankedTensorType>(collapsedRhs.getType());
+    int64_t batchSize = collapsedLhsType.getDimSize(0);
+    if (ShapedType::isDynamic(batchSize))
+      batchSize = collapsedRhsType.getDimSize(0);
+    SmallVector<int64_t> shape = {batchSize, collapsedLhsType.getDimSize(1),
+                                  collapsedRhsType.getDimSize(2)};
+    Value result = rewriter.create<tcp::BatchMatmulOp>(
+        loc, RankedTensorType::get(shape, elementType), collapsedLhs,
+        collapsedRhs);
+    if (numBatchDims == 1)
+      return result;
+    return expandToSizes(rewriter, loc, result, resultSizes, reassociation);
+  }
+
+  return failure();
+}
+
+// Returns the rank of `value` if it is a tensor of known rank.
+std::optional<int64_t> getRank(Value value) {
+  auto type = dyn_cast<Torch::ValueTensorType>(value.getType());
+  if (!type || !type.hasSizes())
+    return std::nullopt;
+  return type.getSizes().size();
+}
+
+// Returns true if `lhs` and `rhs` are tensors of known rank and the same
+// known dtype. Contractions of mixed element types are left in Torch.
+bool haveRanksAndSameDtype(Value lhs, Value rhs) {
+  auto lhsType = dyn_cast<Torch::ValueTensorType>(lhs.getType());
+  auto rhsType = dyn_cast<Torch::ValueTensorType>(rhs.getType());
+  return lhsType && rhsType && lhsType.hasSizes() && rhsType.hasSizes() &&
+         lhsType.hasDtype() &&
+         lhsType.getOptionalDtype() == rhsType.getOptionalDtype();
+}
+
+template <typename AtenOpT> bool isSupportedMm(AtenOpT op) {
+  return haveRanksAndSameDtype(op.getSelf(), op.getMat2());
+}
+
+template <typename AtenOpT, typename TcpOpT>
+class ConvertAtenMmLikeOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (!isSupportedMm(op))
+      return rewriter.notifyMatchFailure(
+          op, "Only ranked operands of the same element type are supported");
+    Value lhs = adaptor.getSelf();
+    Value rhs = adaptor.getMat2();
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op.getType()));
+    rewriter.replaceOpWithNewOp<TcpOpT>(op, resultType, lhs, rhs);
+    return success();
+  }
+};
+
+// `aten.matmul` is supported for ranked operands of the same dtype, unless
+// both are 1-D or their batch dims would need broadcasting, see
+// `createContraction`.
+bool isSupportedMatmul(AtenMatmulOp op) {
+  if (!haveRanksAndSameDtype(op.getSelf(), op.getOther()))
+    return false;
+  ArrayRef<int64_t> lhsSizes =
+      cast<Torch::ValueTensorType>(op.getSelf().getType()).getSizes();
+  ArrayRef<int64_t> rhsSizes =
+      cast<Torch::ValueTensorType>(op.getOther().getType()).getSizes();
+  int64_t lhsRank = lhsSizes.size();
+  int64_t rhsRank = rhsSizes.size();
+  if (lhsRank == 0 || rhsRank == 0 || (lhsRank == 1 && rhsRank == 1))
+    return false;
+  // A 1-D rhs is a column vector, and any lhs is folded into its rows.
+  if (rhsRank <= 2)
+    return true;
+  if (lhsRank != rhsRank)
+    return false;
+  for (int64_t i = 0; i < lhsRank - 2; ++i) {
+    if (lhsSizes[i] != kUnknownSize && rhsSizes[i] != kUnknownSize &&
+        lhsSizes[i] != rhsSizes[i])
+      return false;
+  }
+  return true;
+}
+
+class ConvertAtenMatmulOp : public OpConversionPattern<AtenMatmulOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(AtenMatmulOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (!isSupportedMatmul(op))
+      return rewriter.notifyMatchFailure(
+          op, "Only ranked operands of the same element type that are not "
+              "both 1-D and need no broadcasting of the batch dims are "
+              "supported");
+    Location loc = op.getLoc();
+    Value lhs = adaptor.getSelf();
+    Value rhs = adaptor.getOther();
+    int64_t lhsRank = cast<RankedTensorType>(lhs.getType()).getRank();
+    int64_t rhsRank = cast<RankedTensorType>(rhs.getType()).getRank();
+
+    // Per PyTorch, a 1-D lhs is treated as a row vector and a 1-D rhs as a
+    // column vector. The unit dim is removed from the result again below.
+    SmallVector<ReassociationIndices> unitDimReassociation = {{0, 1}};
+    OpFoldResult one = rewriter.getIndexAttr(1);
+    if (lhsRank == 1) {
+      OpFoldResult k = tensor::getMixedSize(rewriter, loc, lhs, 0);
+      lhs = expandToSizes(rewriter, loc, lhs, {one, k}, unitDimReassociation);
+    }
+    if (rhsRank == 1) {
+      OpFoldResult k = tensor::getMixedSize(rewriter, loc, rhs, 0);
+      rhs = expandToSizes(rewriter, loc, rhs, {k, one}, unitDimReassociation);
+    }
+
+    FailureOr<Value> result = createContraction(rewriter, loc, lhs, rhs);
+    if (failed(result))
+      return rewriter.notifyMatchFailure(
+          op, "Unimplemented: broadcasting of the batch dims");
+
+    if (lhsRank == 1 || rhsRank == 1) {
+      int64_t rank = cast<RankedTensorType>(result->getType()).getRank();
+      *result = rewriter.create<tensor::CollapseShapeOp>(
+          loc, *result, getTrailingDimsReassociation(rank));
+    }
+
+    // The result may be less static than the type inferred by Torch.
+    RankedTensorType resultType = cast<RankedTensorType>(
+        getTypeConverter()->convertType(op.getType()));
+    if (result->getType() != resultType)
+      *result = rewriter.create<tensor::CastOp>(loc, resultType, *result);
+    rewriter.replaceOp(op, *result);
+    return success();
+  }
+};
+
+// `aten.linear` computes `input * weight^T + bias` with a weight of shape
+// [N, K] and an optional bias of shape [N] or [].
+bool isSupportedLinear(AtenLinearOp op) {
+  if (!haveRanksAndSameDtype(op.getInput(), op.getWeight()))
+    return false;
+  std::optional<int64_t> inputRank = getRank(op.getInput());
+  std::optional<int64_t> weightRank = getRank(op.getWeight());
+  if (!inputRank || *inputRank < 2 || weightRank != 2)
+    return false;
+  if (isa<Torch::NoneType>(op.getBias().getType()))
+    return true;
+  std::optional<int64_t> biasRank = getRank(op.getBias());
+  return biasRank && *biasRank <= 1;
+}
+
+class ConvertAtenLinearOp : public OpConversionPattern<AtenLinearOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(AtenLinearOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+    Value input = adaptor.getInput();
+    Value weight = adaptor.getWeight();
+    if (!isSupportedLinear(op))
+      return rewriter.notifyMatchFailure(
+          op, "Only ranked operands of the same element type, a 2-D weight "
+              "and a 0-D or 1-D bias are supported");
+    auto weightType = cast<RankedTensorType>(weight.getType());
+
+    auto transposedType = RankedTensorType::get(
+        {weightType.getDimSize(1), weightType.getDimSize(0)},
+        weightType.getElementType());
+    Value transposedWeight = rewriter.create<tcp::TransposeOp>(
+        loc, transposedType, weight, rewriter.getI64ArrayAttr({1, 0}));
+    FailureOr<Value> result =
+        createContraction(rewriter, loc, input, transposedWeight);
+    if (failed(result))
+      return rewriter.notifyMatchFailure(op, "Unsupported operand shapes");
+
+    // The bias is added along the last dim of the result.
+    if (!isa<Torch::NoneType>(op.getBias().getType())) {
+      auto resultType = cast<RankedTensorType>(result->getType());
+      Value bias = torch_to_tcp::broadcast0DOr1DToNDAndMatchShape(
+          rewriter, adaptor.getBias(), *result, resultType.getElementType(),
+          /*axisInOutput=*/resultType.getRank() - 1);
+      *result = rewriter.create<tcp::AddOp>(loc, resultType, *result, bias);
+    }
+
+    // The result may be less static than the type inferred by Torch.
+    RankedTensorType resultType = cast<RankedTensorType>(
+        getTypeConverter()->convertType(op.getType()));
+    if (result->getType() != resultType)
+      *result = rewriter.create<tensor::CastOp>(loc, resultType, *result);
+    rewriter.replaceOp(op, *result);
+    return success();
+  }
+};
+
+} // namespace
+
+void torch_to_tcp::populateContractionPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target, const llvm::StringSet<> &convertTorchOpsSet) {
+
+  // Contractions that cannot be expressed in TCP are left in Torch.
+#define INSERT_ATEN_MM_LIKE_OP_PATTERN(AtenOp, TcpOp)                          \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenMmLikeOp<AtenOp, TcpOp>, AtenOp>(                             \
+      typeConverter, patterns, target, convertTorchOpsSet,                     \
+      [](AtenOp op) { return !isSupportedMm(op); })
+  INSERT_ATEN_MM_LIKE_OP_PATTERN(AtenMmOp, tcp::MatmulOp);
+  INSERT_ATEN_MM_LIKE_OP_PATTERN(AtenBmmOp, tcp::BatchMatmulOp);
+#undef INSERT_ATEN_MM_LIKE_OP_PATTERN
+
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<ConvertAtenMatmulOp,
+                                                   AtenMatmulOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenMatmulOp op) { return !isSupportedMatmul(op); });
+
+  // Linear layers with a weight or bias of unsupported rank are left in
+  // Torch.
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<ConvertAtenLinearOp,
+                                                   AtenLinearOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenLinearOp op) { return !isSupportedLinear(op); });
+}
@@ -0,0 +1,145 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TorchToTcp/TorchToTcp.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "PopulatePatterns.h"
+#include "Utils.h"
+#include "torch-mlir/Dialect/Torch/IR/TorchOps.h"
+
+#include "llvm/ADT/StringSet.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+using namespace mlir::torch;
+using namespace mlir::torch::Torch;
+
+namespace {
+
+// The attributes of a convolution that maps onto `tcp.conv1d`, `tcp.conv2d`
+// or `tcp.conv3d`.
+struct ConvolutionAttrs {
+  int64_t numSpatialDims;
+  SmallVector<int64_t> stride;
+  SmallVector<int64_t> padding;
+  SmallVector<int64_t> dilation;
+  int64_t groups;
+};
+
+// Returns the attributes of `op` if it is a non-transposed 1-D, 2-D or 3-D
+// convolution with constant attributes. Other convolutions are left to
+// `tcp.custom_op`.
+std::optional<ConvolutionAttrs> getConvolutionAttrs(AtenConvolutionOp op) {
+  auto inputType = dyn_cast<Torch::ValueTensorType>(op.getInput().getType());
+  if (!inputType || !inputType.hasSizes())
+    return std::nullopt;
+
+  ConvolutionAttrs attrs;
+  attrs.numSpatialDims = inputType.getSizes().size() - 2;
+  if (attrs.numSpatialDims < 1 || attrs.numSpatialDims > 3)
+    return std::nullopt;
+
+  bool transposed;
+  if (!matchPattern(op.getTransposed(), m_TorchConstantBool(&transposed)) ||
+      transposed)
+    return std::nullopt;
+
+  if (!torch_to_tcp::getSpatialDimsList(op.getStride(), attrs.numSpatialDims,
+                                        attrs.stride) ||
+      !torch_to_tcp::getSpatialDimsList(op.getPadding(), attrs.numSpatialDims,
+                                        attrs.padding) ||
+      !torch_to_tcp::getSpatialDimsList(op.getDilation(), attrs.numSpatialDims,
+                                        attrs.dilation) ||
+      !matchPattern(op.getGroups(), m_TorchConstantInt(&attrs.groups)))
+    return std::nullopt;
+  return attrs;
+}
+
+// Returns true if `op` has constant attributes, see `getConvolutionAttrs`,
+// and an input and a weight of known rank and the same dtype.
+bool isSupportedConvolution(AtenConvolutionOp op) {
+  auto inputType = dyn_cast<Torch::ValueTensorType>(op.getInput().getType());
+  auto weightType = dyn_cast<Torch::ValueTensorType>(op.getWeight().getType());
+  if (!inputType || !weightType || !weightType.hasSizes() ||
+      !inputType.hasDtype() ||
+      inputType.getOptionalDtype() != weightType.getOptionalDtype())
+    return false;
+  return getConvolutionAttrs(op).has_value();
+}
+
+class ConvertAtenConvolutionOp : public OpConversionPattern<AtenConvolutionOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(AtenConvolutionOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (!isSupportedConvolution(op))
+      return rewriter.notifyMatchFailure(
+          op, "Only non-transposed convolutions with constant attributes and "
+              "ranked operands of the same element type are supported");
+    Value input = adaptor.getInput();
+    Value weight = adaptor.getWeight();
+    std::optional<ConvolutionAttrs> attrs = getConvolutionAttrs(op);
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        getTypeConverter()->convertType(op.getType()));
+    ArrayAttr strideAttr = rewriter.getI64ArrayAttr(attrs->stride);
+    ArrayAttr paddingAttr = rewriter.getI64ArrayAttr(attrs->padding);
+    ArrayAttr dilationAttr = rewriter.getI64ArrayAttr(attrs->dilation);
+    IntegerAttr groupsAttr = rewriter.getI64IntegerAttr(attrs->groups);
+
+    Value result;
+    switch (attrs->numSpatialDims) {
+    case 1:
+      result = rewriter.create<tcp::Conv1DOp>(
+          op.getLoc(), resultType, input, weight, strideAttr, paddingAttr,
+          dilationAttr, groupsAttr);
+      break;
+    case 2:
+      result = rewriter.create<tcp::Conv2DOp>(
+          op.getLoc(), resultType, input, weight, strideAttr, paddingAttr,
+          dilationAttr, groupsAttr);
+      break;
+    default:
+      result = rewriter.create<tcp::Conv3DOp>(
+          op.getLoc(), resultType, input, weight, strideAttr, paddingAttr,
+          dilationAttr, groupsAttr);
+      break;
+    }
+
+    // The bias is a [F] vector that is added along the channel dim.
+    if (!isa<Torch::NoneType>(op.getBias().getType())) {
+      Value bias = torch_to_tcp::broadcast0DOr1DToNDAndMatchShape(
+          rewriter, adaptor.getBias(), result, resultType.getElementType(),
+          /*axisInOutput=*/1);
+      result =
+          rewriter.create<tcp::AddOp>(op.getLoc(), resultType, result, bias);
+    }
+
+    rewriter.replaceOp(op, result);
+    return success();
+  }
+};
+
+} // namespace
+
+void torch_to_tcp::populateConvolutionPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target, const llvm::StringSet<> &convertTorchOpsSet) {
+  // Convolutions that cannot be expressed in TCP are left in Torch, to be
+  // mapped to `tcp.custom_op` by `-convert-torch-to-tcp-custom-op`.
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<ConvertAtenConvolutionOp,
+                                                   AtenConvolutionOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenConvolutionOp op) { return !isSupportedConvolution(op); });
+}
@@ -16,10 +16,13 @@
 #include "Utils.h"
 #include "mlir/Dialect/Arith/IR/Arith.h"
 #include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/ReshapeOpsUtils.h"
+#include "mlir/IR/AffineExpr.h"
 #include "torch-mlir/Conversion/TorchToLinalg/Utils.h"
 #include "torch-mlir/Conversion/Utils/Utils.h"
 #include "torch-mlir/Dialect/Torch/IR/TorchOps.h"
 #include "torch-mlir/Dialect/Torch/Utils/Utils.h"
+#include "torch-mlir/Dialect/TorchConversion/IR/TorchConversionOps.h"
 
 #include "llvm/ADT/StringSet.h"
 #include "llvm/Support/Debug.h"
@@ -202,6 +205,309 @@ public:
   }
 };
 
+// Returns the permutation of the dims of `op`, or std::nullopt if the dims are
+// not valid constants.
+std::optional<SmallVector<int64_t>> getPermutation(AtenPermuteOp op) {
+  auto selfType = dyn_cast<Torch::ValueTensorType>(op.getSelf().getType());
+  if (!selfType || !selfType.hasSizes())
+    return std::nullopt;
+  int64_t rank = selfType.getSizes().size();
+  SmallVector<int64_t> dims;
+  if (!matchPattern(op.getDims(), m_TorchListOfConstantInts(dims)) ||
+      static_cast<int64_t>(dims.size()) != rank)
+    return std::nullopt;
+  SmallVector<bool> seen(rank, false);
+  for (int64_t &dim : dims) {
+    dim = toPositiveDim(dim, rank);
+    if (!isValidDim(dim, rank) || seen[dim])
+      return std::nullopt;
+    seen[dim] = true;
+  }
+  return dims;
+}
+
+std::optional<SmallVector<int64_t>> getPermutation(AtenTransposeIntOp op) {
+  auto selfType = dyn_cast<Torch::ValueTensorType>(op.getSelf().getType());
+  if (!selfType || !selfType.hasSizes())
+    return std::nullopt;
+  int64_t rank = selfType.getSizes().size();
+  int64_t dim0, dim1;
+  if (!matchPattern(op.getDim0(), m_TorchConstantInt(&dim0)) ||
+      !matchPattern(op.getDim1(), m_TorchConstantInt(&dim1)))
+    return std::nullopt;
+  dim0 = toPositiveDim(dim0, rank);
+  dim1 = toPositiveDim(dim1, rank);
+  if (!isValidDim(dim0, rank) || !isValidDim(dim1, rank))
+    return std::nullopt;
+  SmallVector<int64_t> permutation =
+      llvm::to_vector(llvm::seq<int64_t>(0, rank));
+  std::swap(permutation[dim0], permutation[dim1]);
+  return permutation;
+}
+
+template <typename AtenOpT>
+class ConvertAtenTransposeLikeOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value input = adaptor.getSelf();
+    if (!isa<RankedTensorType>(input.getType()))
+      return rewriter.notifyMatchFailure(
+          op, "Only Ranked Tensor types are supported in TCP");
+
+    std::optional<SmallVector<int64_t>> permutation = getPermutation(op);
+    if (!permutation)
+      return rewriter.notifyMatchFailure(
+          op, "Only constant and valid dims are supported");
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op.getType()));
+    rewriter.replaceOpWithNewOp<tcp::TransposeOp>(
+        op, resultType, input, rewriter.getI64ArrayAttr(*permutation));
+    return success();
+  }
+};
+
+Value getSizeList(AtenViewOp op) { return op.getSize(); }
+Value getSizeList(AtenReshapeOp op) { return op.getShape(); }
+
+// Returns the expression that a `torch.bind_symbolic_shape` binds to dim `dim`
+// of `tensor`. The symbols of the expression are numbered by the position of
+// their values in `symbols`, which is extended as needed, so that expressions
+// of different tensors can be compared.
+std::optional<AffineExpr> getSymbolicDimExpr(Value tensor, int64_t dim,
+                                             SmallVectorImpl<Value> &symbols) {
+  for (Operation *user : tensor.getUsers()) {
+    auto bindOp = dyn_cast<Torch::BindSymbolicShapeOp>(user);
+    if (!bindOp)
+      continue;
+    AffineMap map = bindOp.getShapeExpressions();
+    if (dim >= static_cast<int64_t>(map.getNumResults()))
+      return std::nullopt;
+    SmallVector<AffineExpr> replacements;
+    for (Value symbol : bindOp.getShapeSymbols()) {
+      auto it = llvm::find(symbols, symbol);
+      if (it == symbols.end()) {
+        symbols.push_back(symbol);
+        it = std::prev(symbols.end());
+      }
+      replacements.push_back(getAffineSymbolExpr(it - symbols.begin(),
+                                                 tensor.getContext()));
+    }
+    return map.getResult(dim).replaceSymbols(replacements);
+  }
+  return std::nullopt;
+}
+
+// Returns true if `size` is read from dim `selfDim` of `self`.
+bool isSizeIntOfDim(Value size, Value self, int64_t selfDim) {
+  auto sizeOp = size.getDefiningOp<AtenSizeIntOp>();
+  if (!sizeOp || sizeOp.getSelf() != self)
+    return false;
+  int64_t rank = cast<ValueTensorType>(self.getType()).getSizes().size();
+  int64_t dim;
+  return matchPattern(sizeOp.getDim(), m_TorchConstantInt(&dim)) &&
+         toPositiveDim(dim, rank) == selfDim;
+}
+
+// Returns true if `size`, the size of dim `resultDim` of the result of the
+// view `op`, provably satisfies
+//   size(self, selfDim) * selfFactor == size * resultFactor,
+// where the factors are the static sizes that the view merges with the dims.
+// Either `size` is computed from that dim of the input, or both dims are bound
+// to symbolic expressions that satisfy it.
+template <typename AtenOpT>
+bool isSizeOfSelfDim(AtenOpT op, Value size, int64_t selfDim,
+                     int64_t resultDim, int64_t selfFactor,
+                     int64_t resultFactor) {
+  Value self = op.getSelf();
+  if (selfFactor == 1 && resultFactor == 1 &&
+      isSizeIntOfDim(size, self, selfDim))
+    return true;
+  // A merged dim is the product of the input dim and the static dims.
+  int64_t factor;
+  if (auto mulOp = size.getDefiningOp<AtenMulIntOp>()) {
+    if (resultFactor == 1 &&
+        ((isSizeIntOfDim(mulOp.getA(), self, selfDim) &&
+          matchPattern(mulOp.getB(), m_TorchConstantInt(&factor))) ||
+         (isSizeIntOfDim(mulOp.getB(), self, selfDim) &&
+          matchPattern(mulOp.getA(), m_TorchConstantInt(&factor)))) &&
+        factor == selfFactor)
+      return true;
+  }
+  // A split dim is the input dim divided by the static dims.
+  if (auto divOp = size.getDefiningOp<AtenFloordivIntOp>()) {
+    if (selfFactor == 1 && isSizeIntOfDim(divOp.getA(), self, selfDim) &&
+        matchPattern(divOp.getB(), m_TorchConstantInt(&factor)) &&
+        factor == resultFactor)
+      return true;
+  }
+
+  SmallVector<Value> symbols;
+  std::optional<AffineExpr> selfExpr =
+      getSymbolicDimExpr(self, selfDim, symbols);
+  std::optional<AffineExpr> resultExpr =
+      getSymbolicDimExpr(op->getResult(0), resultDim, symbols);
+  if (!selfExpr || !resultExpr)
+    return false;
+  return simplifyAffineExpr(*selfExpr * selfFactor, 0, symbols.size()) ==
+         simplifyAffineExpr(*resultExpr * resultFactor, 0, symbols.size());
+}
+
+// A view that only splits or merges dims is converted to a
+// `tcp.expand_shape` or `tcp.collapse_shape`, which stay views of the input
+// buffer after bufferization. Other views are converted to a `tcp.reshape`.
+struct ViewConversion {
+  enum class Kind { Expand, Collapse, Reshape };
+  Kind kind;
+  SmallVector<ReassociationIndices> reassociation;
+};
+
+// Returns how to convert the view `op`, or std::nullopt if it is not
+// supported.
+template <typename AtenOpT>
+std::optional<ViewConversion> getViewConversion(AtenOpT op) {
+  auto selfType = dyn_cast<ValueTensorType>(op.getSelf().getType());
+  auto resultType = dyn_cast<ValueTensorType>(op.getType());
+  if (!selfType || !selfType.hasSizes() || !resultType ||
+      !resultType.hasSizes())
+    return std::nullopt;
+  SmallVector<int64_t> selfShape = makeShapeLLVMCompatible(selfType.getSizes());
+  SmallVector<int64_t> resultShape =
+      makeShapeLLVMCompatible(resultType.getSizes());
+
+  SmallVector<Value> sizes;
+  if (!getListConstructElements(getSizeList(op), sizes) ||
+      sizes.size() != resultShape.size())
+    return std::nullopt;
+
+  ViewConversion conversion;
+  bool isCollapse = resultShape.size() < selfShape.size();
+  ArrayRef<int64_t> expandedShape = isCollapse ? selfShape : resultShape;
+  std::optional<SmallVector<ReassociationIndices>> reassociation =
+      getReassociationIndicesForCollapse(
+          expandedShape, isCollapse ? resultShape : selfShape);
+
+  // The reassociation pairs each dynamic dim of the input with one dynamic
+  // dim of the result, which is only correct if the collapsed dim is the
+  // expanded dynamic dim times the static dims of its group. With all but one
+  // of the pairs proven, the sizes of the last pair match if its size is
+  // inferred by the view (-1).
+  auto isReassociationProven = [&](ArrayRef<ReassociationIndices> groups) {
+    int64_t numInferredSizes = 0;
+    for (auto [collapsedDim, group] : llvm::enumerate(groups)) {
+      SmallVector<int64_t> dynamicDims;
+      int64_t staticSize = 1;
+      for (int64_t dim : group) {
+        if (ShapedType::isDynamic(expandedShape[dim]))
+          dynamicDims.push_back(dim);
+        else
+          staticSize *= expandedShape[dim];
+      }
+      if (dynamicDims.empty())
+        continue;
+      if (dynamicDims.size() > 1)
+        return false;
+
+      int64_t selfDim = isCollapse ? dynamicDims.front() : collapsedDim;
+      int64_t resultDim = isCollapse ? collapsedDim : dynamicDims.front();
+      int64_t selfFactor = isCollapse ? staticSize : 1;
+      int64_t resultFactor = isCollapse ? 1 : staticSize;
+      if (isSizeOfSelfDim(op, sizes[resultDim], selfDim, resultDim,
+                          selfFactor, resultFactor))
+        continue;
+      int64_t constantSize;
+      if (!matchPattern(sizes[resultDim], m_TorchConstantInt(&constantSize)) ||
+          constantSize != -1 || ++numInferredSizes > 1)
+        return false;
+    }
+    return true;
+  };
+
+  if (reassociation && isReassociationProven(*reassociation)) {
+    conversion.kind = isCollapse ? ViewConversion::Kind::Collapse
+                                 : ViewConversion::Kind::Expand;
+    conversion.reassociation = std::move(*reassociation);
+    return conversion;
+  }
+
+  // A `tcp.reshape` takes the sizes of the dynamic dims of the result from
+  // the view, so they must not be inferred.
+  for (auto [size, resultSize] : llvm::zip(sizes, resultShape)) {
+    int64_t constantSize;
+    if (ShapedType::isDynamic(resultSize) &&
+        matchPattern(size, m_TorchConstantInt(&constantSize)) &&
+        constantSize < 0)
+      return std::nullopt;
+  }
+  conversion.kind = ViewConversion::Kind::Reshape;
+  return conversion;
+}
+
+template <typename AtenOpT>
+class ConvertAtenViewLikeOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+    Value input = adaptor.getSelf();
+    if (!isa<RankedTensorType>(input.getType()))
+      return rewriter.notifyMatchFailure(
+          op, "Only Ranked Tensor types are supported in TCP");
+
+    std::optional<ViewConversion> conversion = getViewConversion(op);
+    if (!conversion)
+      return rewriter.notifyMatchFailure(
+          op, "Only views with known ranks and sizes are supported");
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op.getType()));
+    switch (conversion->kind) {
+    case ViewConversion::Kind::Expand:
+      rewriter.replaceOpWithNewOp<tcp::ExpandShapeOp>(
+          op, resultType, input,
+          getReassociationIndicesAttribute(rewriter,
+                                           conversion->reassociation));
+      return success();
+    case ViewConversion::Kind::Collapse:
+      rewriter.replaceOpWithNewOp<tcp::CollapseShapeOp>(
+          op, resultType, input,
+          getReassociationIndicesAttribute(rewriter,
+                                           conversion->reassociation));
+      return success();
+    case ViewConversion::Kind::Reshape:
+      break;
+    }
+
+    SmallVector<Value> sizes;
+    getListConstructElements(getSizeList(op), sizes);
+    SmallVector<Value> shape;
+    for (auto [size, resultSize] : llvm::zip(sizes, resultType.getShape())) {
+      if (!ShapedType::isDynamic(resultSize)) {
+        shape.push_back(
+            rewriter.create<arith::ConstantIndexOp>(loc, resultSize));
+        continue;
+      }
+      Value dimSize =
+          rewriter.create<torch::TorchConversion::ToI64Op>(loc, size);
+      shape.push_back(rewriter.create<arith::IndexCastOp>(
+          loc, rewriter.getIndexType(), dimSize));
+    }
+    rewriter.replaceOpWithNewOp<tcp::ReshapeOp>(op, resultType, input, shape);
+    return success();
+  }
+};
+
 class ConvertAtenGatherOp : public OpConversionPattern<AtenGatherOp> {
 public:
   using OpConversionPattern::OpConversionPattern;
@@ -275,6 +581,49 @@ public:
   }
 };
 
+// Broadcasts the index tensors of an advanced indexing op to the same shape,
+// and stacks them along a new trailing dim. The result indexes into the
+// leading dims of the indexed tensor, as the indices of `tcp.gather_nd` and
+// `tcp.scatter` do.
+std::optional<Value> stackIndices(ConversionPatternRewriter &rewriter,
+                                  Location loc, SmallVector<Value> indices) {
+  if (auto indiciesBroadcasted =
+          torch_to_tcp::broadcastManyToMatchShape(rewriter, loc, indices)) {
+    indices = indiciesBroadcasted.value();
+  } else {
+    return std::nullopt;
+  }
+
+  for (int i = 0; i < indices.size(); i++) {
+    Value v =
+        torch_to_tcp::broadcastRankInTrailingDims(rewriter, indices[i], 1);
+    if (!cast<RankedTensorType>(v.getType()).getElementType().isInteger(64)) {
+      v = rewriter.createOrFold<tcp::CastOp>(
+          loc,
+          RankedTensorType::get(cast<RankedTensorType>(v.getType()).getShape(),
+                                rewriter.getI64Type()),
+          v, SignednessAttr::get(rewriter.getContext(), Signedness::Signed),
+          SignednessAttr::get(rewriter.getContext(), Signedness::Signless));
+    }
+    indices[i] = v;
+  }
+
+  auto indicesType = cast<RankedTensorType>(indices[0].getType());
+  int indicesRank = indicesType.getRank();
+  SmallVector<int64_t> outIndexShape;
+  outIndexShape.insert(outIndexShape.begin(), indicesType.getShape().begin(),
+                       indicesType.getShape().end());
+  outIndexShape.back() = indices.size();
+
+  auto outIndexType =
+      RankedTensorType::get(outIndexShape, indicesType.getElementType());
+  return rewriter
+      .create<tensor::ConcatOp>(loc, outIndexType,
+                                rewriter.getI64IntegerAttr(indicesRank - 1),
+                                indices)
+      .getResult();
+}
+
 /**
  * The index.Tensor_hacked_twin takes a list of tensors which have to be
  * broadcast together to be the same shape, and then those are fed into a
@@ -296,49 +645,16 @@ class ConvertAtenIndexTensorHackedTwin
     indices = getTypeConvertedValues(rewriter, op.getLoc(), getTypeConverter(),
                                      indices);
 
-    if (auto indiciesBroadcasted = torch_to_tcp::broadcastManyToMatchShape(
-            rewriter, op.getLoc(), indices)) {
-      indices = indiciesBroadcasted.value();
-    } else {
+    std::optional<Value> indexTensor =
+        stackIndices(rewriter, op.getLoc(), indices);
+    if (!indexTensor)
       return failure("failed to broadcast the shapes of the input indicies");
-    }
-
-    for (int i = 0; i < indices.size(); i++) {
-      Value v =
-          torch_to_tcp::broadcastRankInTrailingDims(rewriter, indices[i], 1);
-      if (!cast<RankedTensorType>(v.getType()).getElementType().isInteger(64)) {
-        v = rewriter.createOrFold<tcp::CastOp>(
-            op.getLoc(),
-            RankedTensorType::get(
-                cast<RankedTensorType>(v.getType()).getShape(),
-                rewriter.getI64Type()),
-            v, SignednessAttr::get(op->getContext(), Signedness::Signed),
-            SignednessAttr::get(op->getContext(), Signedness::Signless));
-      }
-      indices[i] = v;
-    }
-
-    auto indicesType = cast<RankedTensorType>(indices[0].getType());
-    int indicesRank = indicesType.getRank();
-    SmallVector<int64_t> outIndexShape;
-    outIndexShape.insert(outIndexShape.begin(), indicesType.getShape().begin(),
-                         indicesType.getShape().end());
-    outIndexShape.back() = indices.size();
-
-    auto outIndexType =
-        RankedTensorType::get(outIndexShape, indicesType.getElementType());
-    auto indexTensor =
-        rewriter
-            .create<tensor::ConcatOp>(
-                op.getLoc(), outIndexType,
-                rewriter.getI64IntegerAttr(indicesRank - 1), indices)
-            .getResult();
 
     auto outType =
         cast<RankedTensorType>(getTypeConverter()->convertType(op.getType()));
 
     auto gatherOp = rewriter.create<tcp::GatherNDOp>(op.getLoc(), outType, self,
-                                                     indexTensor);
+                                                     *indexTensor);
 
     rewriter.replaceOp(op, gatherOp);
 
@@ -346,6 +662,195 @@ class ConvertAtenIndexTensorHackedTwin
   }
 };
 
+// Returns true if all the indices of `op` are tensors, i.e. it indexes into
+// the leading dims of `self`, and `accumulate` is a constant.
+bool isSupportedIndexPut(Aten_IndexPutImplOp op) {
+  SmallVector<Value> indices;
+  if (!getListConstructElements(op.getIndices(), indices) || indices.empty())
+    return false;
+  if (llvm::any_of(indices, [](Value index) {
+        return !isa<Torch::ValueTensorType>(index.getType());
+      }))
+    return false;
+  bool accumulate;
+  return matchPattern(op.getAccumulate(), m_TorchConstantBool(&accumulate));
+}
+
+class ConvertAten_IndexPutImplOp
+    : public OpConversionPattern<Aten_IndexPutImplOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(Aten_IndexPutImplOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+    if (!isSupportedIndexPut(op))
+      return rewriter.notifyMatchFailure(
+          op, "only tensor indices and a constant accumulate are supported");
+    bool accumulate = false;
+    matchPattern(op.getAccumulate(), m_TorchConstantBool(&accumulate));
+
+    SmallVector<Value> indices;
+    getListConstructElements(op.getIndices(), indices);
+    indices =
+        getTypeConvertedValues(rewriter, loc, getTypeConverter(), indices);
+    std::optional<Value> indexTensor = stackIndices(rewriter, loc, indices);
+    if (!indexTensor)
+      return rewriter.notifyMatchFailure(
+          op, "failed to broadcast the shapes of the indices");
+
+    // The values are broadcast to the shape of the indexed slices: the shape
+    // of the indices followed by the dims of `self` that are not indexed.
+    Value self = adaptor.getSelf();
+    auto selfType = cast<RankedTensorType>(self.getType());
+    auto indicesType = cast<RankedTensorType>(indexTensor->getType());
+    int64_t batchRank = indicesType.getRank() - 1;
+    int64_t numIndexedDims = indices.size();
+    SmallVector<int64_t> updatesShape(indicesType.getShape().drop_back());
+    llvm::append_range(updatesShape,
+                       selfType.getShape().drop_front(numIndexedDims));
+
+    Value values = adaptor.getValues();
+    int64_t valuesRank = cast<RankedTensorType>(values.getType()).getRank();
+    int64_t updatesRank = updatesShape.size();
+    if (valuesRank > updatesRank)
+      return rewriter.notifyMatchFailure(
+          op, "values have a higher rank than the indexed slices");
+    values = torch_to_tcp::broadcastRankInLeadingDims(rewriter, values,
+                                                      updatesRank - valuesRank);
+
+    auto valuesType = cast<RankedTensorType>(values.getType());
+    SmallVector<int64_t> broadcastShape(valuesType.getShape());
+    SmallVector<int64_t> axes;
+    SmallVector<Value> sizes;
+    for (int64_t dim = 0; dim < updatesRank; ++dim) {
+      if (broadcastShape[dim] != 1 || updatesShape[dim] == 1)
+        continue;
+      axes.push_back(dim);
+      sizes.push_back(
+          dim < batchRank
+              ? rewriter.createOrFold<tensor::DimOp>(loc, *indexTensor, dim)
+              : rewriter.createOrFold<tensor::DimOp>(
+                    loc, self, dim - batchRank + numIndexedDims));
+      broadcastShape[dim] = updatesShape[dim];
+    }
+    if (!axes.empty())
+      values = rewriter.create<tcp::BroadcastOp>(
+          loc,
+          RankedTensorType::get(broadcastShape, valuesType.getElementType()),
+          values, sizes,
+          rewriter.getI64ArrayAttr(axes));
+
+    // Indices may repeat even without `accumulate`, so they are not marked
+    // unique. The lowering still updates the rows in parallel when it can
+    // prove that they are unique.
+    RankedTensorType resultType = cast<RankedTensorType>(
+        getTypeConverter()->convertType(op->getResult(0).getType()));
+    rewriter.replaceOpWithNewOp<tcp::ScatterOp>(
+        op, resultType, self, *indexTensor, values,
+        rewriter.getBoolAttr(accumulate), /*unique_indices=*/UnitAttr());
+    return success();
+  }
+};
+
+// Returns true if `op` has a constant, valid `dim` and `start` and `end` that
+// are not optional, as `prepareArgumentsForSlicingOp` requires.
+bool isSupportedSliceScatter(AtenSliceScatterOp op) {
+  auto selfType = dyn_cast<Torch::ValueTensorType>(op.getSelf().getType());
+  int64_t dim;
+  if (!selfType || !selfType.hasSizes() ||
+      !matchPattern(op.getDim(), m_TorchConstantInt(&dim)))
+    return false;
+  int64_t rank = selfType.getSizes().size();
+  return isValidDim(toPositiveDim(dim, rank), rank) &&
+         !isa<OptionalType>(op.getStart().getType()) &&
+         !isa<OptionalType>(op.getEnd().getType());
+}
+
+class ConvertAtenSliceScatterOp
+    : public OpConversionPattern<AtenSliceScatterOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(AtenSliceScatterOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    if (failed(verifyLinalgCompatibleTypes(op, rewriter)))
+      return failure();
+
+    SmallVector<Value> resultShape;
+    SmallVector<Value> offsets;
+    SmallVector<Value> strides;
+    if (failed(prepareArgumentsForSlicingOp<AtenSliceScatterOp,
+                                            AtenSliceScatterOpAdaptor>(
+            op, adaptor, rewriter, resultShape, offsets, strides))) {
+      return failure();
+    }
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        getTypeConverter()->convertType(op->getResult(0).getType()));
+    rewriter.replaceOpWithNewOp<tcp::SliceScatterOp>(
+        op, resultType, adaptor.getSelf(), adaptor.getSrc(), offsets, strides);
+    return success();
+  }
+};
+
+// Returns the low and high pads of each dim of `self`, when the pads are
+// constant and non-negative. The pads are listed from the last dim backwards,
+// as pairs of low and high pads, and the dims they do not cover are not
+// padded.
+std::optional<std::pair<SmallVector<int64_t>, SmallVector<int64_t>>>
+getConstantPads(AtenConstantPadNdOp op) {
+  auto selfType = dyn_cast<ValueTensorType>(op.getSelf().getType());
+  SmallVector<int64_t> pad;
+  if (!selfType || !selfType.hasSizes() ||
+      !matchPattern(op.getPad(), m_TorchListOfConstantInts(pad)))
+    return std::nullopt;
+  int64_t rank = selfType.getSizes().size();
+  if (pad.size() % 2 != 0 || static_cast<int64_t>(pad.size()) > 2 * rank ||
+      llvm::any_of(pad, [](int64_t p) { return p < 0; }))
+    return std::nullopt;
+
+  SmallVector<int64_t> low(rank, 0);
+  SmallVector<int64_t> high(rank, 0);
+  for (size_t i = 0; i < pad.size() / 2; ++i) {
+    low[rank - 1 - i] = pad[2 * i];
+    high[rank - 1 - i] = pad[2 * i + 1];
+  }
+  return std::make_pair(low, high);
+}
+
+class ConvertAtenConstantPadNdOp
+    : public OpConversionPattern<AtenConstantPadNdOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(AtenConstantPadNdOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    auto pads = getConstantPads(op);
+    if (!pads)
+      return rewriter.notifyMatchFailure(
+          op, "only constant, non-negative pads are supported");
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        getTypeConverter()->convertType(op.getType()));
+    Type dtype = cast<ValueTensorType>(op.getType()).getDtype();
+    Value paddingValue = torch_to_tcp::convertScalarOperandToTensor(
+        rewriter, op, op.getValue(), adaptor.getValue(), dtype,
+        resultType.getElementType());
+    if (!paddingValue)
+      return rewriter.notifyMatchFailure(op, "unsupported padding value type");
+
+    rewriter.replaceOpWithNewOp<tcp::PadOp>(
+        op, resultType, adaptor.getSelf(), paddingValue,
+        rewriter.getI64ArrayAttr(pads->first),
+        rewriter.getI64ArrayAttr(pads->second));
+    return success();
+  }
+};
+
 } // namespace
 
 void torch_to_tcp::populateDataMovementPatternsAndLegality(
@@ -356,6 +861,28 @@ void torch_to_tcp::populateDataMovementPatternsAndLegality(
   torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<ConvertAtenSliceTensorOp,
                                                    AtenSliceTensorOp>(
       typeConverter, patterns, target, convertTorchOpsSet);
+
+  // Permutations over non-constant dims are left in Torch.
+#define INSERT_ATEN_TRANSPOSE_LIKE_OP_PATTERN(AtenOp)                          \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenTransposeLikeOp<AtenOp>, AtenOp>(                             \
+      typeConverter, patterns, target, convertTorchOpsSet,                     \
+      [](AtenOp op) { return !getPermutation(op); })
+  INSERT_ATEN_TRANSPOSE_LIKE_OP_PATTERN(AtenPermuteOp);
+  INSERT_ATEN_TRANSPOSE_LIKE_OP_PATTERN(AtenTransposeIntOp);
+#undef INSERT_ATEN_TRANSPOSE_LIKE_OP_PATTERN
+
+  // Views with an inferred size that cannot be proven are left in Torch, and
+  // fall back to a custom op.
+#define INSERT_ATEN_VIEW_LIKE_OP_PATTERN(AtenOp)                               \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenViewLikeOp<AtenOp>, AtenOp>(                                  \
+      typeConverter, patterns, target, convertTorchOpsSet,                     \
+      [](AtenOp op) { return !getViewConversion(op); })
+  INSERT_ATEN_VIEW_LIKE_OP_PATTERN(AtenViewOp);
+  INSERT_ATEN_VIEW_LIKE_OP_PATTERN(AtenReshapeOp);
+#undef INSERT_ATEN_VIEW_LIKE_OP_PATTERN
+
   torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<ConvertAtenGatherOp,
                                                    AtenGatherOp>(
       typeConverter, patterns, target, convertTorchOpsSet);
@@ -365,4 +892,21 @@ void torch_to_tcp::populateDataMovementPatternsAndLegality(
   torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<
       ConvertAtenIndexTensorHackedTwin, AtenIndexTensorHackedTwinOp>(
       typeConverter, patterns, target, convertTorchOpsSet);
+
+  // Index puts with `None` indices or a non-constant `accumulate`, and slice
+  // scatters with a non-constant `dim`, are left in Torch.
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<ConvertAten_IndexPutImplOp,
+                                                   Aten_IndexPutImplOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](Aten_IndexPutImplOp op) { return !isSupportedIndexPut(op); });
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<ConvertAtenSliceScatterOp,
+                                                   AtenSliceScatterOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenSliceScatterOp op) { return !isSupportedSliceScatter(op); });
+
+  // Pads that are not constant, or that crop the input, are left in Torch.
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<ConvertAtenConstantPadNdOp,
+                                                   AtenConstantPadNdOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenConstantPadNdOp op) { return !getConstantPads(op); });
 }
@@ -38,25 +38,27 @@ bool IsMultiplyAlphaOne(Value alphaValue) {
   return ((isFloat && doubleValue == 1.0) || (isInt && intValue == 1.0));
 }
 
-Value convertScalarOperandToTensor(ConversionPatternRewriter &rewriter,
-                                   Operation *op, Value scalarValue,
-                                   Value convertedScalarValue, Type outputType,
-                                   Type convertedOutputType) {
-  RankedTensorType scalarToTensorType =
-      RankedTensorType::get({}, convertedScalarValue.getType());
-  Value resultValue = torch_to_tcp::scalarToTcpTensor(
-      rewriter, op, scalarToTensorType, scalarValue);
-  if (isa<mlir::FloatType>(convertedScalarValue.getType()))
-    // FP scalarValue is treated as fp64
-    resultValue = torch_to_tcp::castTensorToDtype(
-        rewriter, rewriter.getF64Type(), outputType, resultValue,
-        convertedOutputType);
-  else if (isa<mlir::IntegerType>(convertedScalarValue.getType()))
-    // INT scalarValue is treated as si64
-    resultValue = torch_to_tcp::castTensorToDtype(
-        rewriter, rewriter.getIntegerType(64, true), outputType, resultValue,
-        convertedOutputType);
-  return resultValue;
+// Converts `value`, which is either a tensor or a scalar, to a tensor of the
+// given `dtype`.
+Value convertOperandToDtype(ConversionPatternRewriter &rewriter, Operation *op,
+                            Value value, Value convertedValue, Type dtype,
+                            Type convertedDtype) {
+  if (auto tensorType =
+          dyn_cast<torch::Torch::ValueTensorType>(value.getType()))
+    return torch_to_tcp::castTensorToDtype(rewriter, tensorType.getDtype(),
+                                           dtype, convertedValue,
+                                           convertedDtype);
+  return torch_to_tcp::convertScalarOperandToTensor(
+      rewriter, op, value, convertedValue, dtype, convertedDtype);
+}
+
+// Returns the signedness attribute of a `tcp.compare` of operands of the
+// given `dtype`.
+SignednessAttr getCompareSignednessAttr(MLIRContext *context, Type dtype) {
+  if (auto intType = dyn_cast<mlir::IntegerType>(dtype))
+    return torch_to_tcp::getTcpSignednessAttr(context,
+                                              intType.getSignedness());
+  return SignednessAttr{};
 }
 
 template <typename AtenOpT, typename TcpOpT>
@@ -88,9 +90,9 @@ public:
         dyn_cast<torch::Torch::ValueTensorType>(op.getType()).getDtype();
 
     if (isa<AtenAddScalarOp>(op) || isa<AtenSubScalarOp>(op)) {
-      rhs = convertScalarOperandToTensor(rewriter, op, op.getOther(),
-                                         adaptor.getOther(), outputType,
-                                         resultType.getElementType());
+      rhs = torch_to_tcp::convertScalarOperandToTensor(
+          rewriter, op, op.getOther(), adaptor.getOther(), outputType,
+          resultType.getElementType());
       if (!rhs)
         return rewriter.notifyMatchFailure(op, "Unsupported rhs data type");
     } else {
@@ -106,9 +108,9 @@ public:
         torch_to_tcp::broadcastToMatchShape(rewriter, lhs, rhs);
 
     if (!IsMultiplyAlphaOne(op.getAlpha())) {
-      Value alpha = convertScalarOperandToTensor(rewriter, op, op.getAlpha(),
-                                                 adaptor.getAlpha(), outputType,
-                                                 resultType.getElementType());
+      Value alpha = torch_to_tcp::convertScalarOperandToTensor(
+          rewriter, op, op.getAlpha(), adaptor.getAlpha(), outputType,
+          resultType.getElementType());
       if (!alpha)
         return rewriter.notifyMatchFailure(op, "Unsupported alpha data type");
       std::tie(alpha, rhs) =
@@ -150,9 +152,9 @@ public:
         dyn_cast<torch::Torch::ValueTensorType>(op.getType()).getDtype();
 
     if (isa<AtenMulScalarOp>(op)) {
-      rhs = convertScalarOperandToTensor(rewriter, op, op.getOther(),
-                                         adaptor.getOther(), outputType,
-                                         resultType.getElementType());
+      rhs = torch_to_tcp::convertScalarOperandToTensor(
+          rewriter, op, op.getOther(), adaptor.getOther(), outputType,
+          resultType.getElementType());
       if (!rhs)
         return rewriter.notifyMatchFailure(op, "Unsupported rhs data type");
     } else {
@@ -304,9 +306,9 @@ public:
     if (isa<AtenDivScalarOp>(op)) {
       inputBType = adaptor.getOther().getType();
 
-      rhs = convertScalarOperandToTensor(rewriter, op, op.getOther(),
-                                         adaptor.getOther(), outputType,
-                                         resultType.getElementType());
+      rhs = torch_to_tcp::convertScalarOperandToTensor(
+          rewriter, op, op.getOther(), adaptor.getOther(), outputType,
+          resultType.getElementType());
       if (!rhs)
         return rewriter.notifyMatchFailure(op, "Unsupported rhs data type");
     } else {
@@ -615,6 +617,209 @@ public:
   }
 };
 
+// Comparisons are computed in the dtype of `self`. Comparisons that need
+// type promotion are not converted, see `isSupportedComparison`.
+template <typename AtenOpT, ComparePredicate predicate>
+class ConvertAtenCompareOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value lhs = adaptor.getSelf();
+    RankedTensorType lhsType = dyn_cast<RankedTensorType>(lhs.getType());
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op.getType()));
+
+    if (!lhsType || !resultType)
+      return rewriter.notifyMatchFailure(
+          op, "Only Ranked Tensor types are supported in TCP");
+
+    auto inputAType =
+        dyn_cast<torch::Torch::ValueTensorType>(op.getSelf().getType())
+            .getDtype();
+    if (!inputAType.isIntOrFloat())
+      return rewriter.notifyMatchFailure(
+          op, "Input tensor must have integer or floating-point datatype");
+
+    Value rhs =
+        convertOperandToDtype(rewriter, op, op.getOther(), adaptor.getOther(),
+                              inputAType, lhsType.getElementType());
+    if (!rhs)
+      return rewriter.notifyMatchFailure(op, "Unsupported rhs data type");
+    std::tie(lhs, rhs) =
+        torch_to_tcp::broadcastToMatchShape(rewriter, lhs, rhs);
+
+    MLIRContext *context = op.getContext();
+    rewriter.replaceOpWithNewOp<tcp::CompareOp>(
+        op, resultType, lhs, rhs, ComparePredicateAttr::get(context, predicate),
+        getCompareSignednessAttr(context, inputAType));
+    return success();
+  }
+};
+
+// Returns true if the comparison `op` can be computed in the dtype of `self`,
+// i.e. when `other` is a tensor of the same dtype, or a scalar that does not
+// promote `self` to floating point.
+template <typename AtenOpT> bool isSupportedComparison(AtenOpT op) {
+  auto selfType = cast<torch::Torch::ValueTensorType>(op.getSelf().getType());
+  if (!selfType.hasDtype())
+    return false;
+  if (auto otherType =
+          dyn_cast<torch::Torch::ValueTensorType>(op.getOther().getType()))
+    return otherType.hasDtype() && otherType.getDtype() == selfType.getDtype();
+  return isa<mlir::FloatType>(selfType.getDtype()) ||
+         !isa<torch::Torch::FloatType>(op.getOther().getType());
+}
+
+// Converts `aten.where` and its variants with scalar operands.
+template <typename AtenOpT>
+class ConvertAtenWhereOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value condition = adaptor.getCondition();
+    RankedTensorType conditionType =
+        dyn_cast<RankedTensorType>(condition.getType());
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op.getType()));
+
+    if (!conditionType || !resultType)
+      return rewriter.notifyMatchFailure(
+          op, "Only Ranked Tensor types are supported in TCP");
+    if (!conditionType.getElementType().isInteger(1))
+      return rewriter.notifyMatchFailure(op, "Condition must be a bool tensor");
+
+    auto outputType =
+        dyn_cast<torch::Torch::ValueTensorType>(op.getType()).getDtype();
+    Value lhs =
+        convertOperandToDtype(rewriter, op, op.getSelf(), adaptor.getSelf(),
+                              outputType, resultType.getElementType());
+    Value rhs =
+        convertOperandToDtype(rewriter, op, op.getOther(), adaptor.getOther(),
+                              outputType, resultType.getElementType());
+    if (!lhs || !rhs)
+      return rewriter.notifyMatchFailure(op, "Unsupported operand data type");
+
+    std::tie(lhs, rhs) =
+        torch_to_tcp::broadcastToMatchShape(rewriter, lhs, rhs);
+    std::tie(condition, lhs) =
+        torch_to_tcp::broadcastToMatchShape(rewriter, condition, lhs);
+    std::tie(lhs, rhs) =
+        torch_to_tcp::broadcastToMatchShape(rewriter, lhs, rhs);
+
+    rewriter.replaceOpWithNewOp<tcp::SelectOp>(op, resultType, condition, lhs,
+                                               rhs);
+    return success();
+  }
+};
+
+// Converts `aten.masked_fill` with a scalar or a 0-d tensor `value` into a
+// `tcp.select` of `value` where `mask` is set.
+template <typename AtenOpT>
+class ConvertAtenMaskedFillOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value input = adaptor.getSelf();
+    RankedTensorType inputType = dyn_cast<RankedTensorType>(input.getType());
+
+    Value mask = adaptor.getMask();
+    RankedTensorType maskType = dyn_cast<RankedTensorType>(mask.getType());
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op.getType()));
+
+    if (!inputType || !maskType || !resultType)
+      return rewriter.notifyMatchFailure(
+          op, "Only Ranked Tensor types are supported in TCP");
+    if (!maskType.getElementType().isInteger(1))
+      return rewriter.notifyMatchFailure(op, "Mask must be a bool tensor");
+
+    auto inputDType =
+        dyn_cast<torch::Torch::ValueTensorType>(op.getSelf().getType())
+            .getDtype();
+    Value value =
+        convertOperandToDtype(rewriter, op, op.getValue(), adaptor.getValue(),
+                              inputDType, inputType.getElementType());
+    if (!value)
+      return rewriter.notifyMatchFailure(op, "Unsupported value data type");
+
+    // The result has the shape of `self`, which `mask` broadcasts to.
+    std::tie(mask, input) =
+        torch_to_tcp::broadcastToMatchShape(rewriter, mask, input);
+    std::tie(value, input) =
+        torch_to_tcp::broadcastToMatchShape(rewriter, value, input);
+
+    rewriter.replaceOpWithNewOp<tcp::SelectOp>(op, resultType, mask, value,
+                                               input);
+    return success();
+  }
+};
+
+// Converts `aten.threshold`, i.e. `self > threshold ? self : value`, into a
+// `tcp.compare` and a `tcp.select`.
+class ConvertAtenThresholdOp : public OpConversionPattern<AtenThresholdOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(AtenThresholdOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value input = adaptor.getSelf();
+    RankedTensorType inputType = dyn_cast<RankedTensorType>(input.getType());
+
+    if (!inputType)
+      return rewriter.notifyMatchFailure(
+          op, "Only Ranked Tensor types are supported in TCP");
+
+    auto elementType = inputType.getElementType();
+    if (!elementType.isIntOrFloat())
+      return rewriter.notifyMatchFailure(
+          op, "Input tensor must have integer or floating-point datatype");
+
+    auto inputDType =
+        dyn_cast<torch::Torch::ValueTensorType>(op.getSelf().getType())
+            .getDtype();
+    Value threshold = torch_to_tcp::convertScalarOperandToTensor(
+        rewriter, op, op.getThreshold(), adaptor.getThreshold(), inputDType,
+        elementType);
+    Value value = torch_to_tcp::convertScalarOperandToTensor(
+        rewriter, op, op.getValue(), adaptor.getValue(), inputDType,
+        elementType);
+    if (!threshold || !value)
+      return rewriter.notifyMatchFailure(op, "Unsupported scalar data type");
+    threshold = torch_to_tcp::broadcast0DOr1DToNDAndMatchShape(
+        rewriter, threshold, input, elementType);
+    value = torch_to_tcp::broadcast0DOr1DToNDAndMatchShape(rewriter, value,
+                                                           input, elementType);
+
+    MLIRContext *context = op.getContext();
+    Value mask = rewriter.create<tcp::CompareOp>(
+        op.getLoc(), inputType.clone(rewriter.getI1Type()), input, threshold,
+        ComparePredicateAttr::get(context, ComparePredicate::GT),
+        getCompareSignednessAttr(context, inputDType));
+    rewriter.replaceOpWithNewOp<tcp::SelectOp>(op, inputType, mask, input,
+                                               value);
+    return success();
+  }
+};
+
 class ConvertAtenToDtypeOp : public OpConversionPattern<AtenToDtypeOp> {
 public:
   using OpConversionPattern::OpConversionPattern;
@@ -728,6 +933,7 @@ void torch_to_tcp::populateElementwisePatternsAndLegality(
   INSERT_ATEN_ELEMENTWISE_OP_PATTERN(AtenAtan2Op);
   INSERT_ATEN_ELEMENTWISE_OP_PATTERN(AtenSqrtOp);
   INSERT_ATEN_ELEMENTWISE_OP_PATTERN(AtenLog1pOp);
+  INSERT_ATEN_ELEMENTWISE_OP_PATTERN(AtenThresholdOp);
 #undef INSERT_ATEN_ELEMENTWISE_OP_PATTERN
 
 #define INSERT_ATEN_ELEMENTWISE_ADD_SUB_PATTERN(AtenOp, TcpOp)                 \
@@ -750,6 +956,36 @@ void torch_to_tcp::populateElementwisePatternsAndLegality(
   INSERT_ATEN_ELEMENTWISE_MUL_DIV_PATTERN(ConvertAtenDivOp, AtenDivScalarOp);
 #undef INSERT_ATEN_ELEMENTWISE_MUL_DIV_PATTERN
 
+#define INSERT_ATEN_COMPARE_PATTERN(AtenOp, Predicate)                         \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenCompareOp<AtenOp, ComparePredicate::Predicate>, AtenOp>(      \
+      typeConverter, patterns, target, convertTorchOpsSet,                     \
+      [](AtenOp op) { return !isSupportedComparison(op); })
+  INSERT_ATEN_COMPARE_PATTERN(AtenEqTensorOp, EQ);
+  INSERT_ATEN_COMPARE_PATTERN(AtenNeTensorOp, NE);
+  INSERT_ATEN_COMPARE_PATTERN(AtenLtTensorOp, LT);
+  INSERT_ATEN_COMPARE_PATTERN(AtenLeTensorOp, LE);
+  INSERT_ATEN_COMPARE_PATTERN(AtenGtTensorOp, GT);
+  INSERT_ATEN_COMPARE_PATTERN(AtenGeTensorOp, GE);
+  INSERT_ATEN_COMPARE_PATTERN(AtenEqScalarOp, EQ);
+  INSERT_ATEN_COMPARE_PATTERN(AtenNeScalarOp, NE);
+  INSERT_ATEN_COMPARE_PATTERN(AtenLtScalarOp, LT);
+  INSERT_ATEN_COMPARE_PATTERN(AtenLeScalarOp, LE);
+  INSERT_ATEN_COMPARE_PATTERN(AtenGtScalarOp, GT);
+  INSERT_ATEN_COMPARE_PATTERN(AtenGeScalarOp, GE);
+#undef INSERT_ATEN_COMPARE_PATTERN
+
+#define INSERT_ATEN_SELECT_PATTERN(ConvertAtenOpPattern, AtenOp)               \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenOpPattern<AtenOp>, AtenOp>(typeConverter, patterns, target,   \
+                                            convertTorchOpsSet)
+  INSERT_ATEN_SELECT_PATTERN(ConvertAtenWhereOp, AtenWhereSelfOp);
+  INSERT_ATEN_SELECT_PATTERN(ConvertAtenWhereOp, AtenWhereScalarOtherOp);
+  INSERT_ATEN_SELECT_PATTERN(ConvertAtenWhereOp, AtenWhereScalarSelfOp);
+  INSERT_ATEN_SELECT_PATTERN(ConvertAtenMaskedFillOp, AtenMaskedFillScalarOp);
+  INSERT_ATEN_SELECT_PATTERN(ConvertAtenMaskedFillOp, AtenMaskedFillTensorOp);
+#undef INSERT_ATEN_SELECT_PATTERN
+
 // We only convert torch ops with fp inputs here. Hence marking torch ops
 // with non-fp inputs as dynamically legal (in Torch dialect) i.e. leave
 // them in Torch, to be handled by Torch -> TOSA later. This helps avoid
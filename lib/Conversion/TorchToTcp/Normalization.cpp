@@ -0,0 +1,210 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TorchToTcp/TorchToTcp.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "PopulatePatterns.h"
+#include "Utils.h"
+#include "torch-mlir/Dialect/Torch/IR/TorchOps.h"
+#include "torch-mlir/Dialect/Torch/Utils/Utils.h"
+
+#include "llvm/ADT/StringSet.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+using namespace mlir::torch;
+using namespace mlir::torch::Torch;
+
+namespace {
+
+// Returns the positive softmax axis of `self`, or std::nullopt if `dim` is
+// not a valid constant.
+std::optional<int64_t> getSoftmaxAxis(Value self, Value dim) {
+  auto selfType = dyn_cast<Torch::ValueTensorType>(self.getType());
+  if (!selfType || !selfType.hasSizes())
+    return std::nullopt;
+  int64_t rank = selfType.getSizes().size();
+  int64_t axis;
+  if (!matchPattern(dim, m_TorchConstantInt(&axis)))
+    return std::nullopt;
+  axis = toPositiveDim(axis, rank);
+  if (!isValidDim(axis, rank))
+    return std::nullopt;
+  return axis;
+}
+
+// `aten._softmax` and `aten._log_softmax` are supported if they compute in
+// the input dtype.
+template <typename AtenOpT>
+std::optional<int64_t> getSoftmaxAxis(AtenOpT op) {
+  bool halfToFloat;
+  if (!matchPattern(op.getHalfToFloat(), m_TorchConstantBool(&halfToFloat)) ||
+      halfToFloat)
+    return std::nullopt;
+  return getSoftmaxAxis(op.getSelf(), op.getDim());
+}
+
+std::optional<int64_t> getSoftmaxAxis(AtenSoftmaxIntOp op) {
+  if (!isa<Torch::NoneType>(op.getDtype().getType()))
+    return std::nullopt;
+  return getSoftmaxAxis(op.getSelf(), op.getDim());
+}
+
+std::optional<int64_t> getSoftmaxAxis(AtenLogSoftmaxIntOp op) {
+  if (!isa<Torch::NoneType>(op.getDtype().getType()))
+    return std::nullopt;
+  return getSoftmaxAxis(op.getSelf(), op.getDim());
+}
+
+template <typename AtenOpT, typename TcpOpT>
+class ConvertAtenSoftmaxOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value input = adaptor.getSelf();
+    auto inputType = dyn_cast<RankedTensorType>(input.getType());
+    if (!inputType)
+      return rewriter.notifyMatchFailure(
+          op, "Only Ranked Tensor types are supported in TCP");
+    if (!isa<mlir::FloatType>(inputType.getElementType()))
+      return rewriter.notifyMatchFailure(
+          op, "Only floating point inputs are supported");
+
+    std::optional<int64_t> axis = getSoftmaxAxis(op);
+    if (!axis)
+      return rewriter.notifyMatchFailure(
+          op, "Only a constant dim and no dtype conversion are supported");
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op.getType()));
+    rewriter.replaceOpWithNewOp<TcpOpT>(op, resultType, input,
+                                        rewriter.getI64IntegerAttr(*axis));
+    return success();
+  }
+};
+
+// Returns the first normalized dim of a layer norm of `self` over the
+// trailing `normalizedShape`, or std::nullopt if the shape is not constant.
+std::optional<int64_t> getLayerNormAxis(Value self, Value normalizedShape) {
+  auto selfType = dyn_cast<Torch::ValueTensorType>(self.getType());
+  if (!selfType || !selfType.hasSizes())
+    return std::nullopt;
+  int64_t rank = selfType.getSizes().size();
+  SmallVector<int64_t> shape;
+  if (!matchPattern(normalizedShape, m_TorchListOfConstantInts(shape)))
+    return std::nullopt;
+  if (shape.empty() || static_cast<int64_t>(shape.size()) > rank)
+    return std::nullopt;
+  return rank - static_cast<int64_t>(shape.size());
+}
+
+template <typename AtenOpT> bool isSupportedLayerNorm(AtenOpT op) {
+  double eps;
+  return getLayerNormAxis(op.getInput(), op.getNormalizedShape()) &&
+         matchPattern(op.getEps(), m_TorchConstantFloat(&eps));
+}
+
+// `aten.native_layer_norm` also returns the mean and the reciprocal of the
+// standard deviation, which are only supported if unused.
+bool isSupportedLayerNorm(AtenNativeLayerNormOp op) {
+  double eps;
+  return op->getResult(1).use_empty() && op->getResult(2).use_empty() &&
+         getLayerNormAxis(op.getInput(), op.getNormalizedShape()) &&
+         matchPattern(op.getEps(), m_TorchConstantFloat(&eps));
+}
+
+template <typename AtenOpT>
+class ConvertAtenLayerNormOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value input = adaptor.getInput();
+    auto inputType = dyn_cast<RankedTensorType>(input.getType());
+    if (!inputType)
+      return rewriter.notifyMatchFailure(
+          op, "Only Ranked Tensor types are supported in TCP");
+    if (!isa<mlir::FloatType>(inputType.getElementType()))
+      return rewriter.notifyMatchFailure(
+          op, "Only floating point inputs are supported");
+    if (!isSupportedLayerNorm(op))
+      return rewriter.notifyMatchFailure(
+          op, "Only a constant normalized shape and eps are supported");
+
+    int64_t axis = *getLayerNormAxis(op.getInput(), op.getNormalizedShape());
+    double eps;
+    matchPattern(op.getEps(), m_TorchConstantFloat(&eps));
+
+    // A missing weight or bias is left out of the TCP op.
+    Value weight, bias;
+    if (!isa<Torch::NoneType>(op.getWeight().getType()))
+      weight = adaptor.getWeight();
+    if (!isa<Torch::NoneType>(op.getBias().getType()))
+      bias = adaptor.getBias();
+    for (Value param : {weight, bias}) {
+      if (param && !isa<RankedTensorType>(param.getType()))
+        return rewriter.notifyMatchFailure(
+            op, "Only Ranked Tensor types are supported in TCP");
+    }
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op->getResult(0).getType()));
+    Value result = rewriter.create<tcp::LayerNormOp>(
+        op.getLoc(), resultType, input, weight, bias,
+        rewriter.getI64IntegerAttr(axis), rewriter.getF64FloatAttr(eps));
+
+    // The unused mean and reciprocal standard deviation results of
+    // `aten.native_layer_norm` are dropped.
+    SmallVector<Value> results(op->getNumResults(), Value());
+    results[0] = result;
+    rewriter.replaceOp(op, results);
+    return success();
+  }
+};
+
+} // namespace
+
+void torch_to_tcp::populateNormalizationPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target, const llvm::StringSet<> &convertTorchOpsSet) {
+  // Softmaxes over a non-constant dim, or with a dtype conversion, are left
+  // in Torch.
+#define INSERT_ATEN_SOFTMAX_OP_PATTERN(AtenOp, TcpOp)                          \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenSoftmaxOp<AtenOp, TcpOp>, AtenOp>(                            \
+      typeConverter, patterns, target, convertTorchOpsSet,                     \
+      [](AtenOp op) { return !getSoftmaxAxis(op); })
+  INSERT_ATEN_SOFTMAX_OP_PATTERN(Aten_SoftmaxOp, tcp::SoftmaxOp);
+  INSERT_ATEN_SOFTMAX_OP_PATTERN(AtenSoftmaxIntOp, tcp::SoftmaxOp);
+  INSERT_ATEN_SOFTMAX_OP_PATTERN(Aten_LogSoftmaxOp, tcp::LogSoftmaxOp);
+  INSERT_ATEN_SOFTMAX_OP_PATTERN(AtenLogSoftmaxIntOp, tcp::LogSoftmaxOp);
+#undef INSERT_ATEN_SOFTMAX_OP_PATTERN
+
+  // Layer norms over a non-constant shape or eps are left in Torch.
+#define INSERT_ATEN_LAYER_NORM_OP_PATTERN(AtenOp)                              \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenLayerNormOp<AtenOp>, AtenOp>(                                 \
+      typeConverter, patterns, target, convertTorchOpsSet,                     \
+      [](AtenOp op) { return !isSupportedLayerNorm(op); })
+  INSERT_ATEN_LAYER_NORM_OP_PATTERN(AtenLayerNormOp);
+  INSERT_ATEN_LAYER_NORM_OP_PATTERN(AtenNativeLayerNormOp);
+#undef INSERT_ATEN_LAYER_NORM_OP_PATTERN
+}
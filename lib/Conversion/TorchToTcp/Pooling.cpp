@@ -0,0 +1,206 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TorchToTcp/TorchToTcp.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "PopulatePatterns.h"
+#include "Utils.h"
+#include "torch-mlir/Dialect/Torch/IR/TorchOps.h"
+
+#include "llvm/ADT/StringSet.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+using namespace mlir::torch;
+using namespace mlir::torch::Torch;
+
+namespace {
+
+// The poolings are 2-D.
+constexpr int64_t kNumSpatialDims = 2;
+
+// The attributes of a pooling that maps onto `tcp.max_pool2d` or
+// `tcp.avg_pool2d`.
+struct Pool2DAttrs {
+  SmallVector<int64_t> kernelSize;
+  SmallVector<int64_t> stride;
+  SmallVector<int64_t> padding;
+  SmallVector<int64_t> dilation = {1, 1};
+  bool countIncludePad = true;
+};
+
+bool isNCHWTensor(Value value) {
+  auto type = dyn_cast<Torch::ValueTensorType>(value.getType());
+  return type && type.hasSizes() && type.getSizes().size() == 4;
+}
+
+// Reads the attributes shared by all poolings. Per PyTorch, an empty
+// `stride` defaults to `kernel_size`. Poolings in ceil mode, whose last
+// window may start in the padding, are not supported.
+std::optional<Pool2DAttrs> getPool2DAttrs(Value self, Value kernelSize,
+                                          Value stride, Value padding,
+                                          Value ceilMode) {
+  if (!isNCHWTensor(self))
+    return std::nullopt;
+  bool ceil;
+  if (!matchPattern(ceilMode, m_TorchConstantBool(&ceil)) || ceil)
+    return std::nullopt;
+
+  Pool2DAttrs attrs;
+  if (!torch_to_tcp::getSpatialDimsList(kernelSize, kNumSpatialDims,
+                                        attrs.kernelSize) ||
+      !torch_to_tcp::getSpatialDimsList(padding, kNumSpatialDims,
+                                        attrs.padding))
+    return std::nullopt;
+  SmallVector<int64_t> strideValues;
+  if (!matchPattern(stride, m_TorchListOfConstantInts(strideValues)))
+    return std::nullopt;
+  if (strideValues.empty())
+    attrs.stride = attrs.kernelSize;
+  else if (!torch_to_tcp::getSpatialDimsList(stride, kNumSpatialDims,
+                                              attrs.stride))
+    return std::nullopt;
+  return attrs;
+}
+
+std::optional<Pool2DAttrs> getPool2DAttrs(AtenMaxPool2dOp op) {
+  std::optional<Pool2DAttrs> attrs =
+      getPool2DAttrs(op.getSelf(), op.getKernelSize(), op.getStride(),
+                     op.getPadding(), op.getCeilMode());
+  if (!attrs || !torch_to_tcp::getSpatialDimsList(
+                    op.getDilation(), kNumSpatialDims, attrs->dilation))
+    return std::nullopt;
+  return attrs;
+}
+
+std::optional<Pool2DAttrs> getPool2DAttrs(AtenAvgPool2dOp op) {
+  if (!isa<Torch::NoneType>(op.getDivisorOverride().getType()))
+    return std::nullopt;
+  std::optional<Pool2DAttrs> attrs =
+      getPool2DAttrs(op.getSelf(), op.getKernelSize(), op.getStride(),
+                     op.getPadding(), op.getCeilMode());
+  if (!attrs || !matchPattern(op.getCountIncludePad(),
+                              m_TorchConstantBool(&attrs->countIncludePad)))
+    return std::nullopt;
+  return attrs;
+}
+
+// An adaptive average pooling is a plain one if the spatial dims of the
+// input are static multiples of the output size.
+std::optional<Pool2DAttrs> getPool2DAttrs(AtenAdaptiveAvgPool2dOp op) {
+  if (!isNCHWTensor(op.getSelf()))
+    return std::nullopt;
+  ArrayRef<int64_t> inputShape =
+      cast<Torch::ValueTensorType>(op.getSelf().getType()).getSizes();
+  SmallVector<int64_t> outputSize;
+  if (!torch_to_tcp::getSpatialDimsList(op.getOutputSize(), kNumSpatialDims,
+                                        outputSize))
+    return std::nullopt;
+
+  Pool2DAttrs attrs;
+  for (int64_t i = 0; i < kNumSpatialDims; ++i) {
+    int64_t inSize = inputShape[i + 2];
+    if (inSize == Torch::kUnknownSize || outputSize[i] < 1 ||
+        inSize % outputSize[i] != 0)
+      return std::nullopt;
+    attrs.kernelSize.push_back(inSize / outputSize[i]);
+    attrs.stride.push_back(inSize / outputSize[i]);
+    attrs.padding.push_back(0);
+  }
+  return attrs;
+}
+
+template <typename AtenOpT, typename TcpOpT>
+class ConvertAtenPool2DOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value input = adaptor.getSelf();
+    auto inputType = dyn_cast<RankedTensorType>(input.getType());
+    if (!inputType)
+      return rewriter.notifyMatchFailure(
+          op, "Only Ranked Tensor types are supported in TCP");
+
+    std::optional<Pool2DAttrs> attrs = getPool2DAttrs(op);
+    if (!attrs)
+      return rewriter.notifyMatchFailure(
+          op, "Only NCHW poolings with constant attributes are supported");
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op.getType()));
+    if constexpr (std::is_same_v<TcpOpT, tcp::MaxPool2DOp>) {
+      rewriter.replaceOpWithNewOp<tcp::MaxPool2DOp>(
+          op, resultType, input, rewriter.getI64ArrayAttr(attrs->kernelSize),
+          rewriter.getI64ArrayAttr(attrs->stride),
+          rewriter.getI64ArrayAttr(attrs->padding),
+          rewriter.getI64ArrayAttr(attrs->dilation));
+    } else {
+      if (!isa<mlir::FloatType>(inputType.getElementType()))
+        return rewriter.notifyMatchFailure(
+            op, "Only floating point average poolings are supported");
+      rewriter.replaceOpWithNewOp<tcp::AvgPool2DOp>(
+          op, resultType, input, rewriter.getI64ArrayAttr(attrs->kernelSize),
+          rewriter.getI64ArrayAttr(attrs->stride),
+          rewriter.getI64ArrayAttr(attrs->padding),
+          rewriter.getBoolAttr(attrs->countIncludePad));
+    }
+    return success();
+  }
+};
+
+// Integers are compared as signed in `tcp.max_pool2d`.
+bool hasUnsignedDtype(Value value) {
+  auto type = dyn_cast<Torch::ValueTensorType>(value.getType());
+  if (!type || !type.hasDtype())
+    return false;
+  auto intType = dyn_cast<mlir::IntegerType>(type.getDtype());
+  return intType && intType.isUnsigned();
+}
+
+bool hasFloatDtype(Value value) {
+  auto type = dyn_cast<Torch::ValueTensorType>(value.getType());
+  return type && type.hasDtype() && isa<mlir::FloatType>(type.getDtype());
+}
+
+} // namespace
+
+void torch_to_tcp::populatePoolingPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target, const llvm::StringSet<> &convertTorchOpsSet) {
+  // Poolings with non-constant attributes, in ceil mode or with a divisor
+  // override are left in Torch, as are unsigned max poolings and integer
+  // average poolings.
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<
+      ConvertAtenPool2DOp<AtenMaxPool2dOp, tcp::MaxPool2DOp>, AtenMaxPool2dOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenMaxPool2dOp op) {
+        return !getPool2DAttrs(op) || hasUnsignedDtype(op.getSelf());
+      });
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<
+      ConvertAtenPool2DOp<AtenAvgPool2dOp, tcp::AvgPool2DOp>, AtenAvgPool2dOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenAvgPool2dOp op) {
+        return !getPool2DAttrs(op) || !hasFloatDtype(op.getSelf());
+      });
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<
+      ConvertAtenPool2DOp<AtenAdaptiveAvgPool2dOp, tcp::AvgPool2DOp>,
+      AtenAdaptiveAvgPool2dOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenAdaptiveAvgPool2dOp op) {
+        return !getPool2DAttrs(op) || !hasFloatDtype(op.getSelf());
+      });
+}
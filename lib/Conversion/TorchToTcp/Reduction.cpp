@@ -0,0 +1,308 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TorchToTcp/TorchToTcp.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "PopulatePatterns.h"
+#include "Utils.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "torch-mlir/Dialect/Torch/IR/TorchOps.h"
+#include "torch-mlir/Dialect/Torch/Utils/Utils.h"
+
+#include "llvm/ADT/StringSet.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+using namespace mlir::torch;
+using namespace mlir::torch::Torch;
+
+namespace {
+
+// The attributes of a reduction that maps onto a `tcp.reduce_*` op.
+struct ReductionAttrs {
+  SmallVector<int64_t> axes;
+  bool keepdim = false;
+};
+
+// Returns the sorted, unique and positive dims reduced by a reduction of
+// `self`. `dim` is either none, a constant int or a constant list of ints;
+// per PyTorch, a missing or empty list reduces all dims. Returns
+// std::nullopt if the dims or `keepdim` are not constant.
+std::optional<ReductionAttrs> getReductionAttrs(Value self, Value dim,
+                                                Value keepdim) {
+  auto selfType = dyn_cast<Torch::ValueTensorType>(self.getType());
+  if (!selfType || !selfType.hasSizes())
+    return std::nullopt;
+  int64_t rank = selfType.getSizes().size();
+
+  ReductionAttrs attrs;
+  if (keepdim && !matchPattern(keepdim, m_TorchConstantBool(&attrs.keepdim)))
+    return std::nullopt;
+
+  SmallVector<int64_t> dims;
+  if (dim && isa<Torch::IntType>(dim.getType())) {
+    int64_t value;
+    if (!matchPattern(dim, m_TorchConstantInt(&value)))
+      return std::nullopt;
+    dims.push_back(value);
+  } else if (dim && !isa<Torch::NoneType>(dim.getType())) {
+    if (!matchPattern(dim, m_TorchListOfConstantInts(dims)))
+      return std::nullopt;
+  }
+
+  if (dims.empty()) {
+    attrs.axes = llvm::to_vector(llvm::seq<int64_t>(0, rank));
+    return attrs;
+  }
+  for (int64_t &d : dims) {
+    d = toPositiveDim(d, rank);
+    if (!isValidDim(d, rank))
+      return std::nullopt;
+  }
+  llvm::sort(dims);
+  if (std::adjacent_find(dims.begin(), dims.end()) != dims.end())
+    return std::nullopt;
+  attrs.axes = dims;
+  return attrs;
+}
+
+// Reductions over all dims, e.g. `aten.sum`.
+template <typename AtenOpT>
+std::optional<ReductionAttrs> getReductionAttrs(AtenOpT op) {
+  return getReductionAttrs(op.getSelf(), /*dim=*/Value(), /*keepdim=*/Value());
+}
+
+std::optional<ReductionAttrs> getReductionAttrs(AtenSumDimIntListOp op) {
+  return getReductionAttrs(op.getSelf(), op.getDim(), op.getKeepdim());
+}
+
+std::optional<ReductionAttrs> getReductionAttrs(AtenMeanDimOp op) {
+  return getReductionAttrs(op.getSelf(), op.getDim(), op.getKeepdim());
+}
+
+std::optional<ReductionAttrs> getReductionAttrs(AtenProdDimIntOp op) {
+  return getReductionAttrs(op.getSelf(), op.getDim(), op.getKeepdim());
+}
+
+std::optional<ReductionAttrs> getReductionAttrs(AtenAmaxOp op) {
+  return getReductionAttrs(op.getSelf(), op.getDim(), op.getKeepdim());
+}
+
+std::optional<ReductionAttrs> getReductionAttrs(AtenAminOp op) {
+  return getReductionAttrs(op.getSelf(), op.getDim(), op.getKeepdim());
+}
+
+// Returns the number of elements of `input` along `axes` as a 0-D tensor of
+// `elementType`.
+Value getNumReducedElements(ConversionPatternRewriter &rewriter, Location loc,
+                            Value input, ArrayRef<int64_t> axes,
+                            Type elementType) {
+  auto inputType = cast<RankedTensorType>(input.getType());
+  int64_t staticCount = 1;
+  Value dynamicCount;
+  for (int64_t axis : axes) {
+    if (!inputType.isDynamicDim(axis)) {
+      staticCount *= inputType.getDimSize(axis);
+      continue;
+    }
+    Value size = rewriter.create<tensor::DimOp>(loc, input, axis);
+    dynamicCount =
+        dynamicCount ? rewriter.create<arith::MulIOp>(loc, dynamicCount, size)
+                     : size;
+  }
+
+  Value count;
+  if (!dynamicCount) {
+    count = rewriter.create<arith::ConstantOp>(
+        loc, rewriter.getFloatAttr(elementType, staticCount));
+  } else {
+    if (staticCount != 1)
+      dynamicCount = rewriter.create<arith::MulIOp>(
+          loc, dynamicCount,
+          rewriter.create<arith::ConstantIndexOp>(loc, staticCount));
+    Value countInt = rewriter.create<arith::IndexCastOp>(
+        loc, rewriter.getI64Type(), dynamicCount);
+    count = rewriter.create<arith::SIToFPOp>(loc, elementType, countInt);
+  }
+  return rewriter.create<tensor::FromElementsOp>(
+      loc, RankedTensorType::get({}, elementType), count);
+}
+
+// Converts a reduction to `TcpOpT`. With `IsMean`, the sum is divided by the
+// number of reduced elements.
+template <typename AtenOpT, typename TcpOpT, bool IsMean = false>
+class ConvertAtenReductionOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Location loc = op.getLoc();
+    Value input = adaptor.getSelf();
+    if (!isa<RankedTensorType>(input.getType()))
+      return rewriter.notifyMatchFailure(
+          op, "Only Ranked Tensor types are supported in TCP");
+
+    std::optional<ReductionAttrs> attrs = getReductionAttrs(op);
+    if (!attrs)
+      return rewriter.notifyMatchFailure(
+          op, "Only reductions over constant dims are supported");
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op.getType()));
+    Type elementType = resultType.getElementType();
+    if (IsMean && !isa<mlir::FloatType>(elementType))
+      return rewriter.notifyMatchFailure(
+          op, "Only floating point means are supported");
+
+    // The reduction is computed in the result type, e.g. the sum of an int8
+    // tensor is computed in int64 per PyTorch.
+    Type inputDtype =
+        cast<Torch::ValueTensorType>(op.getSelf().getType()).getDtype();
+    Type resultDtype = cast<Torch::ValueTensorType>(op.getType()).getDtype();
+    input = torch_to_tcp::castTensorToDtype(rewriter, inputDtype, resultDtype,
+                                            input, elementType);
+
+    Value result = rewriter.create<TcpOpT>(
+        loc, resultType, input, rewriter.getI64ArrayAttr(attrs->axes),
+        rewriter.getBoolAttr(attrs->keepdim));
+
+    if (IsMean) {
+      Value count = getNumReducedElements(rewriter, loc, input, attrs->axes,
+                                          elementType);
+      if (resultType.getRank() > 0)
+        count = torch_to_tcp::broadcast0DOr1DToNDAndMatchShape(
+            rewriter, count, result, elementType);
+      result = rewriter.create<tcp::DivFOp>(loc, resultType, result, count);
+    }
+
+    rewriter.replaceOp(op, result);
+    return success();
+  }
+};
+
+// Integers are compared as signed in `tcp.reduce_max` and `tcp.reduce_min`.
+// Booleans are signless and compared as unsigned, so they are supported.
+bool hasUnsignedDtype(Value value) {
+  auto type = dyn_cast<Torch::ValueTensorType>(value.getType());
+  if (!type || !type.hasDtype())
+    return false;
+  auto intType = dyn_cast<mlir::IntegerType>(type.getDtype());
+  return intType && intType.isUnsigned();
+}
+
+// Returns the positive dim of `self` that the scan `op` runs along, if it is
+// constant and the dtype of the scan is not set.
+template <typename AtenOpT>
+std::optional<int64_t> getScanDim(AtenOpT op) {
+  auto selfType = dyn_cast<Torch::ValueTensorType>(op.getSelf().getType());
+  int64_t dim;
+  if (!selfType || !selfType.hasSizes() ||
+      !isa<Torch::NoneType>(op.getDtype().getType()) ||
+      !matchPattern(op.getDim(), m_TorchConstantInt(&dim)))
+    return std::nullopt;
+  int64_t rank = selfType.getSizes().size();
+  dim = toPositiveDim(dim, rank);
+  if (!isValidDim(dim, rank))
+    return std::nullopt;
+  return dim;
+}
+
+// Converts a cumulative reduction to the scan `TcpOpT`.
+template <typename AtenOpT, typename TcpOpT>
+class ConvertAtenScanOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    Value input = adaptor.getSelf();
+    std::optional<int64_t> dim = getScanDim(op);
+    if (!dim)
+      return rewriter.notifyMatchFailure(
+          op, "Only scans along a constant dim and without dtype are "
+              "supported");
+
+    RankedTensorType resultType = cast<RankedTensorType>(
+        OpConversionPattern<AtenOpT>::getTypeConverter()->convertType(
+            op.getType()));
+
+    // The scan is computed in the result type, e.g. the cumulative sum of an
+    // int32 tensor is computed in int64 per PyTorch.
+    Type inputDtype =
+        cast<Torch::ValueTensorType>(op.getSelf().getType()).getDtype();
+    Type resultDtype = cast<Torch::ValueTensorType>(op.getType()).getDtype();
+    input = torch_to_tcp::castTensorToDtype(rewriter, inputDtype, resultDtype,
+                                            input,
+                                            resultType.getElementType());
+
+    rewriter.replaceOpWithNewOp<TcpOpT>(op, resultType, input,
+                                        rewriter.getI64IntegerAttr(*dim));
+    return success();
+  }
+};
+
+} // namespace
+
+void torch_to_tcp::populateReductionPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target, const llvm::StringSet<> &convertTorchOpsSet) {
+  // Reductions over non-constant dims are left in Torch.
+#define INSERT_ATEN_REDUCTION_OP_PATTERN(AtenOp, TcpOp)                        \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenReductionOp<AtenOp, TcpOp>, AtenOp>(                          \
+      typeConverter, patterns, target, convertTorchOpsSet,                     \
+      [](AtenOp op) { return !getReductionAttrs(op); })
+  INSERT_ATEN_REDUCTION_OP_PATTERN(AtenSumOp, tcp::ReduceSumOp);
+  INSERT_ATEN_REDUCTION_OP_PATTERN(AtenSumDimIntListOp, tcp::ReduceSumOp);
+  INSERT_ATEN_REDUCTION_OP_PATTERN(AtenProdOp, tcp::ReduceProdOp);
+  INSERT_ATEN_REDUCTION_OP_PATTERN(AtenProdDimIntOp, tcp::ReduceProdOp);
+#undef INSERT_ATEN_REDUCTION_OP_PATTERN
+
+#define INSERT_ATEN_MEAN_OP_PATTERN(AtenOp)                                    \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenReductionOp<AtenOp, tcp::ReduceSumOp, /*IsMean=*/true>,       \
+      AtenOp>(typeConverter, patterns, target, convertTorchOpsSet,             \
+              [](AtenOp op) { return !getReductionAttrs(op); })
+  INSERT_ATEN_MEAN_OP_PATTERN(AtenMeanOp);
+  INSERT_ATEN_MEAN_OP_PATTERN(AtenMeanDimOp);
+#undef INSERT_ATEN_MEAN_OP_PATTERN
+
+  // Unsigned min / max reductions are left in Torch as well.
+#define INSERT_ATEN_MIN_MAX_OP_PATTERN(AtenOp, TcpOp)                          \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenReductionOp<AtenOp, TcpOp>, AtenOp>(                          \
+      typeConverter, patterns, target, convertTorchOpsSet, [](AtenOp op) {     \
+        return !getReductionAttrs(op) || hasUnsignedDtype(op.getSelf());       \
+      })
+  INSERT_ATEN_MIN_MAX_OP_PATTERN(AtenMaxOp, tcp::ReduceMaxOp);
+  INSERT_ATEN_MIN_MAX_OP_PATTERN(AtenAmaxOp, tcp::ReduceMaxOp);
+  INSERT_ATEN_MIN_MAX_OP_PATTERN(AtenMinOp, tcp::ReduceMinOp);
+  INSERT_ATEN_MIN_MAX_OP_PATTERN(AtenAminOp, tcp::ReduceMinOp);
+#undef INSERT_ATEN_MIN_MAX_OP_PATTERN
+
+  // Scans along non-constant dims, or with a dtype, are left in Torch.
+#define INSERT_ATEN_SCAN_OP_PATTERN(AtenOp, TcpOp)                             \
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<                            \
+      ConvertAtenScanOp<AtenOp, TcpOp>, AtenOp>(                               \
+      typeConverter, patterns, target, convertTorchOpsSet,                     \
+      [](AtenOp op) { return !getScanDim(op); })
+  INSERT_ATEN_SCAN_OP_PATTERN(AtenCumsumOp, tcp::CumsumOp);
+  INSERT_ATEN_SCAN_OP_PATTERN(AtenCumprodOp, tcp::CumprodOp);
+#undef INSERT_ATEN_SCAN_OP_PATTERN
+}
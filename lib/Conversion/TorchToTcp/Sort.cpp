@@ -0,0 +1,175 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Conversion/TorchToTcp/TorchToTcp.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "PopulatePatterns.h"
+#include "Utils.h"
+#include "torch-mlir/Dialect/Torch/IR/TorchOps.h"
+#include "torch-mlir/Dialect/Torch/Utils/Utils.h"
+
+#include "llvm/ADT/StringSet.h"
+
+using namespace mlir;
+using namespace mlir::tcp;
+using namespace mlir::torch;
+using namespace mlir::torch::Torch;
+
+namespace {
+
+// Integers are compared as signed by the TCP sorting ops, which do not
+// support unsigned and boolean dtypes.
+bool hasSortableDtype(Value value) {
+  auto type = dyn_cast<Torch::ValueTensorType>(value.getType());
+  if (!type || !type.hasSizes() || !type.hasDtype())
+    return false;
+  if (isa<mlir::FloatType>(type.getDtype()))
+    return true;
+  auto intType = dyn_cast<mlir::IntegerType>(type.getDtype());
+  return intType && intType.isSigned();
+}
+
+// Returns the positive `dim` of `self` that `op` operates on, when it is
+// constant.
+template <typename AtenOpT>
+std::optional<int64_t> getSortDim(AtenOpT op) {
+  auto selfType = dyn_cast<Torch::ValueTensorType>(op.getSelf().getType());
+  int64_t dim;
+  if (!selfType || !selfType.hasSizes() ||
+      !matchPattern(op.getDim(), m_TorchConstantInt(&dim)))
+    return std::nullopt;
+  int64_t rank = selfType.getSizes().size();
+  dim = toPositiveDim(dim, rank);
+  if (!isValidDim(dim, rank))
+    return std::nullopt;
+  return dim;
+}
+
+// The attributes of an `aten.topk` that maps onto `tcp.topk`. The values are
+// always returned sorted, which is valid whether `sorted` is set or not.
+struct TopKAttrs {
+  int64_t k;
+  int64_t dim;
+  bool largest;
+};
+
+std::optional<TopKAttrs> getTopKAttrs(AtenTopkOp op) {
+  TopKAttrs attrs;
+  std::optional<int64_t> dim = getSortDim(op);
+  if (!dim || !hasSortableDtype(op.getSelf()) ||
+      !matchPattern(op.getK(), m_TorchConstantInt(&attrs.k)) ||
+      !matchPattern(op.getLargest(), m_TorchConstantBool(&attrs.largest)))
+    return std::nullopt;
+  attrs.dim = *dim;
+  return attrs;
+}
+
+class ConvertAtenTopkOp : public OpConversionPattern<AtenTopkOp> {
+public:
+  using OpConversionPattern::OpConversionPattern;
+
+  LogicalResult
+  matchAndRewrite(AtenTopkOp op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    std::optional<TopKAttrs> attrs = getTopKAttrs(op);
+    if (!attrs)
+      return rewriter.notifyMatchFailure(
+          op, "Only constant attributes and signed or float dtypes are "
+              "supported");
+
+    SmallVector<Type> resultTypes;
+    if (failed(getTypeConverter()->convertTypes(op->getResultTypes(),
+                                                resultTypes)))
+      return failure();
+    rewriter.replaceOpWithNewOp<tcp::TopKOp>(
+        op, resultTypes, adaptor.getSelf(),
+        rewriter.getI64IntegerAttr(attrs->k),
+        rewriter.getI64IntegerAttr(attrs->dim),
+        rewriter.getBoolAttr(attrs->largest));
+    return success();
+  }
+};
+
+// The attributes of an `aten.sort` or `aten.sort.stable` that maps onto
+// `tcp.sort`. `aten.sort` does not guarantee the order of equal elements, and
+// neither does `aten.sort.stable` without `stable`.
+struct SortAttrs {
+  int64_t dim;
+  bool descending;
+  bool stable = false;
+};
+
+template <typename AtenOpT>
+std::optional<SortAttrs> getSortAttrs(AtenOpT op) {
+  SortAttrs attrs;
+  std::optional<int64_t> dim = getSortDim(op);
+  if (!dim || !hasSortableDtype(op.getSelf()) ||
+      !matchPattern(op.getDescending(),
+                    m_TorchConstantBool(&attrs.descending)))
+    return std::nullopt;
+  if constexpr (std::is_same_v<AtenOpT, AtenSortStableOp>) {
+    if (!isa<Torch::NoneType>(op.getStable().getType()) &&
+        !matchPattern(op.getStable(), m_TorchConstantBool(&attrs.stable)))
+      return std::nullopt;
+  }
+  attrs.dim = *dim;
+  return attrs;
+}
+
+template <typename AtenOpT>
+class ConvertAtenSortOp : public OpConversionPattern<AtenOpT> {
+public:
+  using OpConversionPattern<AtenOpT>::OpConversionPattern;
+  using OpAdaptor = typename AtenOpT::Adaptor;
+
+  LogicalResult
+  matchAndRewrite(AtenOpT op, OpAdaptor adaptor,
+                  ConversionPatternRewriter &rewriter) const override {
+    std::optional<SortAttrs> attrs = getSortAttrs(op);
+    if (!attrs)
+      return rewriter.notifyMatchFailure(
+          op, "Only constant attributes and signed or float dtypes are "
+              "supported");
+
+    SmallVector<Type> resultTypes;
+    if (failed(this->getTypeConverter()->convertTypes(op->getResultTypes(),
+                                                      resultTypes)))
+      return failure();
+    rewriter.replaceOpWithNewOp<tcp::SortOp>(
+        op, resultTypes, adaptor.getSelf(),
+        rewriter.getI64IntegerAttr(attrs->dim),
+        rewriter.getBoolAttr(attrs->descending),
+        rewriter.getBoolAttr(attrs->stable));
+    return success();
+  }
+};
+
+} // namespace
+
+void torch_to_tcp::populateSortPatternsAndLegality(
+    TypeConverter &typeConverter, RewritePatternSet &patterns,
+    ConversionTarget &target, const llvm::StringSet<> &convertTorchOpsSet) {
+  // Top-k and sorts with non-constant attributes, or of unsigned or boolean
+  // tensors, are left in Torch.
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<ConvertAtenTopkOp,
+                                                   AtenTopkOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenTopkOp op) { return !getTopKAttrs(op); });
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<
+      ConvertAtenSortOp<AtenSortOp>, AtenSortOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenSortOp op) { return !getSortAttrs(op); });
+  torch_to_tcp::addPatternIfOpInConvertTorchOpsSet<
+      ConvertAtenSortOp<AtenSortStableOp>, AtenSortStableOp>(
+      typeConverter, patterns, target, convertTorchOpsSet,
+      [](AtenSortStableOp op) { return !getSortAttrs(op); });
+}
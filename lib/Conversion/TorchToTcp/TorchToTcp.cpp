@@ -85,6 +85,24 @@ public:
     torch_to_tcp::populateDataMovementPatternsAndLegality(
         typeConverter, patterns, target, convertTorchOpsSet);
 
+    torch_to_tcp::populateContractionPatternsAndLegality(
+        typeConverter, patterns, target, convertTorchOpsSet);
+
+    torch_to_tcp::populateConvolutionPatternsAndLegality(
+        typeConverter, patterns, target, convertTorchOpsSet);
+
+    torch_to_tcp::populateReductionPatternsAndLegality(
+        typeConverter, patterns, target, convertTorchOpsSet);
+
+    torch_to_tcp::populateNormalizationPatternsAndLegality(
+        typeConverter, patterns, target, convertTorchOpsSet);
+
+    torch_to_tcp::populatePoolingPatternsAndLegality(
+        typeConverter, patterns, target, convertTorchOpsSet);
+
+    torch_to_tcp::populateSortPatternsAndLegality(typeConverter, patterns,
+                                                  target, convertTorchOpsSet);
+
     if (failed(applyPartialConversion(getOperation(), target,
                                       std::move(patterns)))) {
       return signalPassFailure();
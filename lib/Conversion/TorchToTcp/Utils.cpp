@@ -363,6 +363,15 @@ SmallVector<int64_t> getShapeFromPrimList(ArrayRef<Value> listVal) {
   return resultShape;
 }
 
+bool getSpatialDimsList(Value list, int64_t numSpatialDims,
+                        SmallVectorImpl<int64_t> &values) {
+  if (!matchPattern(list, m_TorchListOfConstantInts(values)))
+    return false;
+  if (values.size() == 1)
+    values.resize(numSpatialDims, values.front());
+  return static_cast<int64_t>(values.size()) == numSpatialDims;
+}
+
 Value broadcast0DOr1DFromShape(ConversionPatternRewriter &rewriter, Value input,
                                ArrayRef<Value> targetVal,
                                SmallVector<int64_t> resultShape,
@@ -551,6 +560,29 @@ Value scalarToTcpTensor(ConversionPatternRewriter &rewriter, Operation *op,
                                                  ArrayRef<Value>{scalarValue});
 }
 
+// scalarValue should be accessed by op itself, not through the adaptor
+Value convertScalarOperandToTensor(ConversionPatternRewriter &rewriter,
+                                   Operation *op, Value scalarValue,
+                                   Value convertedScalarValue, Type outputType,
+                                   Type convertedOutputType) {
+  RankedTensorType scalarToTensorType =
+      RankedTensorType::get({}, convertedScalarValue.getType());
+  Value resultValue =
+      scalarToTcpTensor(rewriter, op, scalarToTensorType, scalarValue);
+  if (isa<mlir::FloatType>(convertedScalarValue.getType()))
+    // FP scalarValue is treated as fp64
+    resultValue = castTensorToDtype(rewriter, rewriter.getF64Type(),
+                                    outputType, resultValue,
+                                    convertedOutputType);
+  else if (isa<mlir::IntegerType>(convertedScalarValue.getType()))
+    // INT scalarValue is treated as si64
+    resultValue = castTensorToDtype(rewriter,
+                                    rewriter.getIntegerType(64, true),
+                                    outputType, resultValue,
+                                    convertedOutputType);
+  return resultValue;
+}
+
 void TorchToTcpCustomOpConversionHelper::addOperand(std::string opName,
                                                     Value value) {
   if (conversionResult.failed())
@@ -570,11 +602,14 @@ void TorchToTcpCustomOpConversionHelper::addAsMultipleTensorOperands(
     return;
   }
 
-  mlir::SmallVector<Value> indexTensors = torch::Torch::getTypeConvertedValues(
-      rewriter, op->getLoc(), typeConverter, indicesTorchType);
-
-  for (size_t i = 0; i < indexTensors.size(); ++i) {
-    addOperand(opNamePrefix + std::to_string(i), indexTensors[i]);
+  for (size_t i = 0; i < indicesTorchType.size(); ++i) {
+    if (isa<torch::Torch::NoneType>(indicesTorchType[i].getType()))
+      continue;
+    mlir::SmallVector<Value> index = {indicesTorchType[i]};
+    mlir::SmallVector<Value> indexTensors =
+        torch::Torch::getTypeConvertedValues(rewriter, op->getLoc(),
+                                             typeConverter, index);
+    addOperand(opNamePrefix + std::to_string(i), indexTensors[0]);
   }
 }
 
@@ -91,10 +91,23 @@ Value broadcast0DOr1DFromShape(ConversionPatternRewriter &rewriter, Value input,
 // default is ShapedType::kDynamic if the element is not a constant
 SmallVector<int64_t> getShapeFromPrimList(ArrayRef<Value> listVal);
 
+// Reads a constant list of ints with one entry per spatial dim into `values`.
+// Per PyTorch, a single entry applies to all spatial dims. Returns false if
+// the list is not constant or has the wrong number of entries.
+bool getSpatialDimsList(Value list, int64_t numSpatialDims,
+                        SmallVectorImpl<int64_t> &values);
+
 // Helper function to create a Tcp tensor from a scalar value
 Value scalarToTcpTensor(ConversionPatternRewriter &rewriter, Operation *op,
                         Type targetType, Value scalarValue);
 
+// Helper function to create a Tcp tensor of the `outputType` dtype from a
+// scalar value
+Value convertScalarOperandToTensor(ConversionPatternRewriter &rewriter,
+                                   Operation *op, Value scalarValue,
+                                   Value convertedScalarValue, Type outputType,
+                                   Type convertedOutputType);
+
 // Helper function to convert a Tcp tensor to the target data type
 Value castTensorToDtype(ConversionPatternRewriter &rewriter, Type srcType,
                         Type dstType, Value input, Type convertedType);
@@ -152,7 +165,7 @@ getConstTensorUtil(PatternRewriter &rewriter, Operation *op, ArrayRef<T> vec,
 /// 2. Some of the non-tensor operands are converted into named attributes of
 /// the final tcp.custom_op
 ///
-/// See `ConvertAtenConvolutionOp` and `ConvertAten_IndexPutImplOp` for an
+/// See `ConvertAtenConvolutionOp` and `ConvertAtenGatherOp` for an
 /// example usages.
 class TorchToTcpCustomOpConversionHelper {
 
@@ -166,7 +179,9 @@ public:
   void addOperand(std::string opName, Value value);
 
   /// Expand the passed in value as multiple named tensor operands. Expects
-  /// that value is a torch list type with tensors as elements
+  /// that value is a torch list type with tensors as elements. `None`
+  /// elements are skipped, and the operands are named after the positions of
+  /// their elements in the list.
   void addAsMultipleTensorOperands(std::string opNamePrefix, mlir::Value value);
 
   // Add value as a named bool attribute
@@ -10,8 +10,10 @@
 #include "mlir-tcp/Dialect/IR/TcpOps.h"
 
 #include "mlir/IR/Builders.h"
+#include "mlir/IR/Matchers.h"
 #include "mlir/IR/OpImplementation.h"
 #include "mlir/IR/OperationSupport.h"
+#include "mlir/IR/PatternMatch.h"
 #include "mlir/IR/TypeUtilities.h"
 #include "mlir/IR/Value.h"
 
@@ -133,6 +135,14 @@ LogicalResult ConstOp::verify() {
   return success();
 }
 
+LogicalResult CompareOp::verify() {
+  auto inputType = cast<RankedTensorType>(getIn1().getType());
+  if (isa<FloatType>(inputType.getElementType()) && getIntSignedness())
+    return emitOpError("failed to verify that `int_signedness` is not set "
+                       "for floating point operands");
+  return success();
+}
+
 LogicalResult CastOp::verify() {
   auto inputType = cast<RankedTensorType>(getIn().getType());
   auto outputType = cast<RankedTensorType>(getOut().getType());
@@ -252,6 +262,718 @@ LogicalResult GatherNDOp::verify() {
   return success();
 }
 
+LogicalResult ScatterOp::verify() {
+  RankedTensorType destType = getDest().getType();
+  RankedTensorType indicesType = getIndices().getType();
+  RankedTensorType updatesType = getUpdates().getType();
+
+  if (indicesType.getRank() < 1)
+    return emitOpError(
+        "failed to verify that `indices` has a rank of at least one");
+  int64_t numIndexedDims = indicesType.getShape().back();
+  if (ShapedType::isDynamic(numIndexedDims) ||
+      numIndexedDims > destType.getRank())
+    return emitOpError("failed to verify that the last dim of `indices` is "
+                       "static and at most the rank of `dest`");
+
+  SmallVector<int64_t> expectedShape(indicesType.getShape().drop_back());
+  llvm::append_range(expectedShape,
+                     destType.getShape().drop_front(numIndexedDims));
+  if (updatesType.getRank() != static_cast<int64_t>(expectedShape.size()))
+    return emitOpError("failed to verify that `updates` has the rank of the "
+                       "indexed slices");
+  for (auto [size, expectedSize] :
+       llvm::zip(updatesType.getShape(), expectedShape)) {
+    if (!ShapedType::isDynamic(size) && !ShapedType::isDynamic(expectedSize) &&
+        size != expectedSize)
+      return emitOpError("failed to verify that `updates` has the shape of "
+                         "the indexed slices");
+  }
+  return success();
+}
+
+LogicalResult SliceScatterOp::verify() {
+  int64_t rank = getDest().getType().getRank();
+  if (getSrc().getType().getRank() != rank)
+    return emitOpError(
+        "failed to verify that `dest` and `src` have the same rank");
+  if (static_cast<int64_t>(getStarts().size()) != rank)
+    return emitOpError(
+        "failed to verify that there is one start and stride per dim");
+  return success();
+}
+
+static SmallVector<int64_t> getIntValues(ArrayAttr attr) {
+  SmallVector<int64_t> values;
+  for (Attribute value : attr)
+    values.push_back(cast<IntegerAttr>(value).getInt());
+  return values;
+}
+
+LogicalResult PadOp::verify() {
+  RankedTensorType inType = getIn().getType();
+  RankedTensorType outType = getOut().getType();
+  int64_t rank = inType.getRank();
+  if (getPaddingValue().getType().getRank() != 0)
+    return emitOpError("failed to verify that `padding_value` is a 0-d tensor");
+  if (outType.getRank() != rank)
+    return emitOpError(
+        "failed to verify that the input and result have the same rank");
+
+  SmallVector<int64_t> low = getIntValues(getLow());
+  SmallVector<int64_t> high = getIntValues(getHigh());
+  if (static_cast<int64_t>(low.size()) != rank ||
+      static_cast<int64_t>(high.size()) != rank)
+    return emitOpError(
+        "failed to verify that `low` and `high` have one entry per dim");
+  if (llvm::any_of(llvm::concat<int64_t>(low, high),
+                   [](int64_t pad) { return pad < 0; }))
+    return emitOpError(
+        "failed to verify that `low` and `high` are non-negative");
+
+  for (int64_t i = 0; i < rank; ++i) {
+    int64_t inSize = inType.getDimSize(i);
+    int64_t outSize = outType.getDimSize(i);
+    if (!ShapedType::isDynamic(inSize) && !ShapedType::isDynamic(outSize) &&
+        inSize + low[i] + high[i] != outSize)
+      return emitOpError("failed to verify that the result dims are the "
+                         "padded input dims");
+  }
+  return success();
+}
+
+OpFoldResult PadOp::fold(FoldAdaptor) {
+  auto isZero = [](Attribute pad) {
+    return cast<IntegerAttr>(pad).getInt() == 0;
+  };
+  if (llvm::all_of(getLow(), isZero) && llvm::all_of(getHigh(), isZero) &&
+      getIn().getType() == getType())
+    return getIn();
+  return {};
+}
+
+static SmallVector<int64_t> getPermutationValues(TransposeOp op) {
+  SmallVector<int64_t> permutation;
+  for (Attribute dim : op.getPermutation())
+    permutation.push_back(cast<IntegerAttr>(dim).getInt());
+  return permutation;
+}
+
+static bool isIdentityPermutation(ArrayRef<int64_t> permutation) {
+  for (auto [i, dim] : llvm::enumerate(permutation)) {
+    if (dim != static_cast<int64_t>(i))
+      return false;
+  }
+  return true;
+}
+
+LogicalResult TransposeOp::verify() {
+  RankedTensorType inType = getIn().getType();
+  RankedTensorType outType = getOut().getType();
+  int64_t rank = inType.getRank();
+  if (outType.getRank() != rank)
+    return emitOpError(
+        "failed to verify that the input and result have the same rank");
+
+  SmallVector<int64_t> permutation = getPermutationValues(*this);
+  SmallVector<bool> seen(rank, false);
+  if (static_cast<int64_t>(permutation.size()) != rank)
+    return emitOpError("failed to verify that `permutation` is a "
+                       "permutation of the input dims");
+  for (int64_t dim : permutation) {
+    if (dim < 0 || dim >= rank || seen[dim])
+      return emitOpError("failed to verify that `permutation` is a "
+                         "permutation of the input dims");
+    seen[dim] = true;
+  }
+
+  for (int64_t i = 0; i < rank; ++i) {
+    int64_t inSize = inType.getDimSize(permutation[i]);
+    int64_t outSize = outType.getDimSize(i);
+    if (!ShapedType::isDynamic(inSize) && !ShapedType::isDynamic(outSize) &&
+        inSize != outSize)
+      return emitOpError("failed to verify that the result shape is the "
+                         "permuted input shape");
+  }
+  return success();
+}
+
+OpFoldResult TransposeOp::fold(FoldAdaptor) {
+  SmallVector<int64_t> permutation = getPermutationValues(*this);
+  if (isIdentityPermutation(permutation) && getIn().getType() == getType())
+    return getIn();
+
+  // A transpose that undoes its producer yields the input of the producer.
+  auto producer = getIn().getDefiningOp<TransposeOp>();
+  if (!producer || producer.getIn().getType() != getType())
+    return {};
+  SmallVector<int64_t> producerPermutation = getPermutationValues(producer);
+  SmallVector<int64_t> composed;
+  for (int64_t dim : permutation)
+    composed.push_back(producerPermutation[dim]);
+  if (isIdentityPermutation(composed))
+    return producer.getIn();
+  return {};
+}
+
+LogicalResult ReshapeOp::verify() {
+  RankedTensorType inType = getIn().getType();
+  RankedTensorType outType = getOut().getType();
+  if (static_cast<int64_t>(getShape().size()) != outType.getRank())
+    return emitOpError(
+        "failed to verify that `shape` has one size per dim of the result");
+  if (inType.hasStaticShape() && outType.hasStaticShape() &&
+      inType.getNumElements() != outType.getNumElements())
+    return emitOpError("failed to verify that the input and result have the "
+                       "same number of elements");
+  return success();
+}
+
+OpFoldResult ReshapeOp::fold(FoldAdaptor) {
+  if (getIn().getType() == getType() && getOut().getType().hasStaticShape())
+    return getIn();
+  return {};
+}
+
+static SmallVector<ReassociationIndices, 4>
+getReassociationIndicesFromAttr(ArrayAttr reassociation) {
+  SmallVector<ReassociationIndices, 4> groups;
+  for (Attribute group : reassociation) {
+    ReassociationIndices dims;
+    for (Attribute dim : cast<ArrayAttr>(group))
+      dims.push_back(cast<IntegerAttr>(dim).getInt());
+    groups.push_back(dims);
+  }
+  return groups;
+}
+
+// Verifies that `reassociation` splits each dim of `collapsedType` into a
+// contiguous group of dims of `expandedType` with the same number of
+// elements.
+static LogicalResult
+verifyReassociation(Operation *op, RankedTensorType collapsedType,
+                    RankedTensorType expandedType,
+                    ArrayRef<ReassociationIndices> reassociation,
+                    bool allowMultipleDynamicDimsPerGroup) {
+  if (static_cast<int64_t>(reassociation.size()) != collapsedType.getRank())
+    return op->emitOpError("failed to verify that `reassociation` has one "
+                           "group per dim of the collapsed tensor");
+
+  // Only a tensor of unit dims collapses to a 0-d tensor.
+  if (reassociation.empty()) {
+    if (llvm::any_of(expandedType.getShape(),
+                     [](int64_t size) { return size != 1; }))
+      return op->emitOpError("failed to verify that all dims are 1 when "
+                             "collapsing to a 0-d tensor");
+    return success();
+  }
+
+  int64_t nextDim = 0;
+  for (auto [collapsedDim, group] : llvm::enumerate(reassociation)) {
+    bool isContiguous = !group.empty();
+    int64_t numDynamicDims = 0;
+    int64_t staticSize = 1;
+    for (int64_t dim : group) {
+      if (dim != nextDim++ || dim >= expandedType.getRank()) {
+        isContiguous = false;
+        break;
+      }
+      int64_t size = expandedType.getDimSize(dim);
+      if (ShapedType::isDynamic(size))
+        ++numDynamicDims;
+      else
+        staticSize *= size;
+    }
+    if (!isContiguous)
+      return op->emitOpError("failed to verify that the groups of "
+                             "`reassociation` are contiguous and cover all "
+                             "dims of the expanded tensor");
+    if (numDynamicDims > 1 && !allowMultipleDynamicDimsPerGroup)
+      return op->emitOpError("failed to verify that each group of "
+                             "`reassociation` has at most one dynamic dim");
+
+    int64_t collapsedSize = collapsedType.getDimSize(collapsedDim);
+    if ((numDynamicDims > 0) != ShapedType::isDynamic(collapsedSize) ||
+        (numDynamicDims == 0 && staticSize != collapsedSize))
+      return op->emitOpError("failed to verify that each collapsed dim is the "
+                             "product of its group of dims");
+  }
+  if (nextDim != expandedType.getRank())
+    return op->emitOpError("failed to verify that the groups of "
+                           "`reassociation` are contiguous and cover all dims "
+                           "of the expanded tensor");
+  return success();
+}
+
+SmallVector<ReassociationIndices, 4> ExpandShapeOp::getReassociationIndices() {
+  return getReassociationIndicesFromAttr(getReassociation());
+}
+
+LogicalResult ExpandShapeOp::verify() {
+  // The size of the dynamic dim of each group is inferred from the input,
+  // so there can be at most one.
+  return verifyReassociation(*this, getIn().getType(), getOut().getType(),
+                             getReassociationIndices(),
+                             /*allowMultipleDynamicDimsPerGroup=*/false);
+}
+
+OpFoldResult ExpandShapeOp::fold(FoldAdaptor) {
+  if (getIn().getType() == getType())
+    return getIn();
+
+  // Expanding the dims that were just collapsed yields the original tensor.
+  auto producer = getIn().getDefiningOp<CollapseShapeOp>();
+  if (producer && producer.getIn().getType() == getType() &&
+      producer.getReassociation() == getReassociation())
+    return producer.getIn();
+  return {};
+}
+
+SmallVector<ReassociationIndices, 4>
+CollapseShapeOp::getReassociationIndices() {
+  return getReassociationIndicesFromAttr(getReassociation());
+}
+
+LogicalResult CollapseShapeOp::verify() {
+  return verifyReassociation(*this, getOut().getType(), getIn().getType(),
+                             getReassociationIndices(),
+                             /*allowMultipleDynamicDimsPerGroup=*/true);
+}
+
+OpFoldResult CollapseShapeOp::fold(FoldAdaptor) {
+  if (getIn().getType() == getType())
+    return getIn();
+
+  // Collapsing the dims that were just expanded yields the original tensor.
+  auto producer = getIn().getDefiningOp<ExpandShapeOp>();
+  if (producer && producer.getIn().getType() == getType() &&
+      producer.getReassociation() == getReassociation())
+    return producer.getIn();
+  return {};
+}
+
+// Verifies the shapes of a contraction `out = lhs * rhs` where all operands
+// have `numBatchDims` leading batch dims followed by two matrix dims.
+static LogicalResult verifyContractionShapes(Operation *op,
+                                             RankedTensorType lhsType,
+                                             RankedTensorType rhsType,
+                                             RankedTensorType outType,
+                                             int64_t numBatchDims) {
+  int64_t rank = numBatchDims + 2;
+  if (lhsType.getRank() != rank || rhsType.getRank() != rank ||
+      outType.getRank() != rank)
+    return op->emitOpError("failed to verify that all operands and the "
+                           "result are of rank ")
+           << rank;
+
+  auto isCompatible = [](int64_t a, int64_t b) {
+    return ShapedType::isDynamic(a) || ShapedType::isDynamic(b) || a == b;
+  };
+
+  ArrayRef<int64_t> lhsShape = lhsType.getShape();
+  ArrayRef<int64_t> rhsShape = rhsType.getShape();
+  ArrayRef<int64_t> outShape = outType.getShape();
+  for (int64_t i = 0; i < numBatchDims; ++i) {
+    if (!isCompatible(lhsShape[i], rhsShape[i]) ||
+        !isCompatible(lhsShape[i], outShape[i]) ||
+        !isCompatible(rhsShape[i], outShape[i]))
+      return op->emitOpError(
+          "failed to verify that the batch dims of all operands match");
+  }
+
+  int64_t m = numBatchDims, n = numBatchDims + 1;
+  if (!isCompatible(lhsShape[n], rhsShape[m]))
+    return op->emitOpError("failed to verify that the contraction dims of "
+                           "lhs and rhs match");
+  if (!isCompatible(lhsShape[m], outShape[m]) ||
+      !isCompatible(rhsShape[n], outShape[n]))
+    return op->emitOpError(
+        "failed to verify that the result shape matches the operands");
+
+  return success();
+}
+
+LogicalResult MatmulOp::verify() {
+  return verifyContractionShapes(*this, getLhs().getType(), getRhs().getType(),
+                                 getOut().getType(), /*numBatchDims=*/0);
+}
+
+LogicalResult BatchMatmulOp::verify() {
+  return verifyContractionShapes(*this, getLhs().getType(), getRhs().getType(),
+                                 getOut().getType(), /*numBatchDims=*/1);
+}
+
+// Verifies a convolution with `numSpatialDims` spatial dims in the
+// channels-first layout.
+template <typename ConvOpTy>
+static LogicalResult verifyConvOp(ConvOpTy op, int64_t numSpatialDims) {
+  RankedTensorType inputType = op.getInput().getType();
+  RankedTensorType weightType = op.getWeight().getType();
+  RankedTensorType outType = op.getOut().getType();
+  int64_t rank = numSpatialDims + 2;
+  if (inputType.getRank() != rank || weightType.getRank() != rank ||
+      outType.getRank() != rank)
+    return op.emitOpError("failed to verify that input, weight and result "
+                          "are of rank ")
+           << rank;
+
+  SmallVector<int64_t> stride = getIntValues(op.getStride());
+  SmallVector<int64_t> padding = getIntValues(op.getPadding());
+  SmallVector<int64_t> dilation = getIntValues(op.getDilation());
+  if (static_cast<int64_t>(stride.size()) != numSpatialDims ||
+      static_cast<int64_t>(padding.size()) != numSpatialDims ||
+      static_cast<int64_t>(dilation.size()) != numSpatialDims)
+    return op.emitOpError("failed to verify that `stride`, `padding` and "
+                          "`dilation` have one entry per spatial dim");
+  if (llvm::any_of(stride, [](int64_t v) { return v < 1; }) ||
+      llvm::any_of(dilation, [](int64_t v) { return v < 1; }) ||
+      llvm::any_of(padding, [](int64_t v) { return v < 0; }))
+    return op.emitOpError("failed to verify that `stride` and `dilation` are "
+                          "positive and `padding` is non-negative");
+
+  int64_t groups = op.getGroups();
+  if (groups < 1)
+    return op.emitOpError("failed to verify that `groups` is positive");
+
+  auto isCompatible = [](int64_t a, int64_t b) {
+    return ShapedType::isDynamic(a) || ShapedType::isDynamic(b) || a == b;
+  };
+
+  int64_t inChannels = inputType.getDimSize(1);
+  int64_t outChannels = weightType.getDimSize(0);
+  int64_t channelsPerGroup = weightType.getDimSize(1);
+  if (!ShapedType::isDynamic(channelsPerGroup) &&
+      !isCompatible(inChannels, channelsPerGroup * groups))
+    return op.emitOpError("failed to verify that the input channels match "
+                          "the weight channels times `groups`");
+  if (!ShapedType::isDynamic(outChannels) && outChannels % groups != 0)
+    return op.emitOpError(
+        "failed to verify that the output channels are divisible by `groups`");
+  if (!isCompatible(inputType.getDimSize(0), outType.getDimSize(0)) ||
+      !isCompatible(outChannels, outType.getDimSize(1)))
+    return op.emitOpError("failed to verify that the batch and channel dims "
+                          "of the result match the operands");
+
+  for (int64_t i = 0; i < numSpatialDims; ++i) {
+    int64_t inSize = inputType.getDimSize(i + 2);
+    int64_t kernelSize = weightType.getDimSize(i + 2);
+    if (ShapedType::isDynamic(inSize) || ShapedType::isDynamic(kernelSize))
+      continue;
+    int64_t paddedSize = inSize + 2 * padding[i];
+    int64_t dilatedKernelSize = dilation[i] * (kernelSize - 1) + 1;
+    if (dilatedKernelSize > paddedSize)
+      return op.emitOpError("failed to verify that the dilated kernel fits "
+                            "into the padded input");
+    int64_t expected = (paddedSize - dilatedKernelSize) / stride[i] + 1;
+    if (!isCompatible(expected, outType.getDimSize(i + 2)))
+      return op.emitOpError("failed to verify that the spatial dims of the "
+                            "result match the convolution parameters");
+  }
+
+  return success();
+}
+
+LogicalResult Conv1DOp::verify() {
+  return verifyConvOp(*this, /*numSpatialDims=*/1);
+}
+
+LogicalResult Conv2DOp::verify() {
+  return verifyConvOp(*this, /*numSpatialDims=*/2);
+}
+
+LogicalResult Conv3DOp::verify() {
+  return verifyConvOp(*this, /*numSpatialDims=*/3);
+}
+
+// Returns true if `value` is a constant zero, possibly converted by
+// `tcp.cast`s, as TorchToTcp converts scalar operands to the element type.
+// A zero stays a zero through any cast, and a positive float zero stays
+// positive.
+static bool isZeroConstant(Value value) {
+  while (auto castOp = value.getDefiningOp<CastOp>())
+    value = castOp.getIn();
+  return matchPattern(value, m_PosZeroFloat()) ||
+         matchPattern(value, m_Zero());
+}
+
+namespace {
+// Folds a `tcp.pad` of the input of a convolution into its padding, when it
+// pads with zeros and only pads the spatial dims, by the same amount on both
+// sides. The convolution then pads the input per tile when it is lowered,
+// instead of reading a padded copy of it.
+template <typename ConvOpTy>
+struct FoldPadIntoConvOp : public OpRewritePattern<ConvOpTy> {
+  using OpRewritePattern<ConvOpTy>::OpRewritePattern;
+
+  LogicalResult matchAndRewrite(ConvOpTy op,
+                                PatternRewriter &rewriter) const override {
+    auto padOp = op.getInput().template getDefiningOp<PadOp>();
+    if (!padOp)
+      return failure();
+    if (!isZeroConstant(padOp.getPaddingValue()))
+      return failure();
+
+    SmallVector<int64_t> low = getIntValues(padOp.getLow());
+    SmallVector<int64_t> high = getIntValues(padOp.getHigh());
+    if (low != high || low[0] != 0 || low[1] != 0)
+      return failure();
+
+    SmallVector<int64_t> padding = getIntValues(op.getPadding());
+    for (size_t i = 0; i < padding.size(); ++i)
+      padding[i] += low[i + 2];
+    rewriter.modifyOpInPlace(op, [&]() {
+      op.getInputMutable().assign(padOp.getIn());
+      op.setPaddingAttr(rewriter.getI64ArrayAttr(padding));
+    });
+    return success();
+  }
+};
+} // namespace
+
+void Conv1DOp::getCanonicalizationPatterns(RewritePatternSet &results,
+                                           MLIRContext *context) {
+  results.add<FoldPadIntoConvOp<Conv1DOp>>(context);
+}
+
+void Conv2DOp::getCanonicalizationPatterns(RewritePatternSet &results,
+                                           MLIRContext *context) {
+  results.add<FoldPadIntoConvOp<Conv2DOp>>(context);
+}
+
+void Conv3DOp::getCanonicalizationPatterns(RewritePatternSet &results,
+                                           MLIRContext *context) {
+  results.add<FoldPadIntoConvOp<Conv3DOp>>(context);
+}
+
+// Verifies a 2-D pooling in the channels-first layout. A null `dilation`
+// stands for a unit dilation.
+static LogicalResult verifyPool2DOp(Operation *op, RankedTensorType inType,
+                                    RankedTensorType outType,
+                                    ArrayAttr kernelSizeAttr,
+                                    ArrayAttr strideAttr, ArrayAttr paddingAttr,
+                                    ArrayAttr dilationAttr) {
+  if (inType.getRank() != 4 || outType.getRank() != 4)
+    return op->emitOpError(
+        "failed to verify that the input and result are of rank 4");
+
+  auto getInts = [](ArrayAttr attr) {
+    SmallVector<int64_t> values;
+    for (Attribute value : attr)
+      values.push_back(cast<IntegerAttr>(value).getInt());
+    return values;
+  };
+  SmallVector<int64_t> kernelSize = getInts(kernelSizeAttr);
+  SmallVector<int64_t> stride = getInts(strideAttr);
+  SmallVector<int64_t> padding = getInts(paddingAttr);
+  SmallVector<int64_t> dilation =
+      dilationAttr ? getInts(dilationAttr) : SmallVector<int64_t>(2, 1);
+  if (kernelSize.size() != 2 || stride.size() != 2 || padding.size() != 2 ||
+      dilation.size() != 2)
+    return op->emitOpError("failed to verify that `kernel_size`, `stride`, "
+                           "`padding` and `dilation` have two entries");
+  if (llvm::any_of(kernelSize, [](int64_t v) { return v < 1; }) ||
+      llvm::any_of(stride, [](int64_t v) { return v < 1; }) ||
+      llvm::any_of(dilation, [](int64_t v) { return v < 1; }))
+    return op->emitOpError("failed to verify that `kernel_size`, `stride` "
+                           "and `dilation` are positive");
+  // Every window overlaps with the input, so that max pooling never
+  // produces the padding value.
+  for (int64_t i = 0; i < 2; ++i) {
+    if (padding[i] < 0 || 2 * padding[i] > kernelSize[i])
+      return op->emitOpError("failed to verify that `padding` is "
+                             "non-negative and at most half of `kernel_size`");
+  }
+
+  auto isCompatible = [](int64_t a, int64_t b) {
+    return ShapedType::isDynamic(a) || ShapedType::isDynamic(b) || a == b;
+  };
+  if (!isCompatible(inType.getDimSize(0), outType.getDimSize(0)) ||
+      !isCompatible(inType.getDimSize(1), outType.getDimSize(1)))
+    return op->emitOpError("failed to verify that the batch and channel dims "
+                           "of the result match the input");
+  for (int64_t i = 0; i < 2; ++i) {
+    int64_t inSize = inType.getDimSize(i + 2);
+    if (ShapedType::isDynamic(inSize))
+      continue;
+    int64_t expected =
+        (inSize + 2 * padding[i] - dilation[i] * (kernelSize[i] - 1) - 1) /
+            stride[i] +
+        1;
+    if (!isCompatible(expected, outType.getDimSize(i + 2)))
+      return op->emitOpError("failed to verify that the spatial dims of the "
+                             "result match the pooling parameters");
+  }
+  return success();
+}
+
+LogicalResult MaxPool2DOp::verify() {
+  return verifyPool2DOp(*this, getIn().getType(), getOut().getType(),
+                        getKernelSize(), getStride(), getPadding(),
+                        getDilation());
+}
+
+LogicalResult AvgPool2DOp::verify() {
+  return verifyPool2DOp(*this, getIn().getType(), getOut().getType(),
+                        getKernelSize(), getStride(), getPadding(),
+                        /*dilationAttr=*/nullptr);
+}
+
+template <typename ReduceOpTy>
+static LogicalResult verifyReduceOp(ReduceOpTy op) {
+  RankedTensorType inType = op.getIn().getType();
+  RankedTensorType outType = op.getOut().getType();
+  int64_t rank = inType.getRank();
+
+  SmallVector<int64_t> axes;
+  for (Attribute axis : op.getAxes())
+    axes.push_back(cast<IntegerAttr>(axis).getInt());
+  for (auto [i, axis] : llvm::enumerate(axes)) {
+    if (axis < 0 || axis >= rank || (i > 0 && axes[i - 1] >= axis))
+      return op.emitOpError("failed to verify that `axes` are sorted, unique "
+                            "and in the range of the input rank");
+  }
+
+  bool keepdim = op.getKeepdim();
+  int64_t expectedRank =
+      keepdim ? rank : rank - static_cast<int64_t>(axes.size());
+  if (outType.getRank() != expectedRank)
+    return op.emitOpError("failed to verify that the result is of rank ")
+           << expectedRank;
+
+  auto isCompatible = [](int64_t a, int64_t b) {
+    return ShapedType::isDynamic(a) || ShapedType::isDynamic(b) || a == b;
+  };
+  int64_t outDim = 0;
+  for (int64_t i = 0; i < rank; ++i) {
+    bool isReduced = llvm::is_contained(axes, i);
+    if (isReduced && !keepdim)
+      continue;
+    int64_t expected = isReduced ? 1 : inType.getDimSize(i);
+    if (!isCompatible(expected, outType.getDimSize(outDim++)))
+      return op.emitOpError("failed to verify that the result dims match the "
+                            "dims of the input that are not reduced");
+  }
+  return success();
+}
+
+LogicalResult ReduceSumOp::verify() { return verifyReduceOp(*this); }
+
+LogicalResult ReduceProdOp::verify() { return verifyReduceOp(*this); }
+
+LogicalResult ReduceMaxOp::verify() { return verifyReduceOp(*this); }
+
+LogicalResult ReduceMinOp::verify() { return verifyReduceOp(*this); }
+
+template <typename ScanOpTy>
+static LogicalResult verifyScanOp(ScanOpTy op) {
+  int64_t rank = op.getIn().getType().getRank();
+  int64_t dim = op.getDim();
+  if (dim < 0 || dim >= rank)
+    return op.emitOpError(
+        "failed to verify that `dim` is in the range of the input rank");
+  return success();
+}
+
+LogicalResult CumsumOp::verify() { return verifyScanOp(*this); }
+
+LogicalResult CumprodOp::verify() { return verifyScanOp(*this); }
+
+LogicalResult TopKOp::verify() {
+  RankedTensorType inType = getIn().getType();
+  int64_t rank = inType.getRank();
+  int64_t dim = getDim();
+  int64_t k = getK();
+  if (dim < 0 || dim >= rank)
+    return emitOpError(
+        "failed to verify that `dim` is in the range of the input rank");
+  if (k < 0 || (!inType.isDynamicDim(dim) && k > inType.getDimSize(dim)))
+    return emitOpError("failed to verify that `k` is non-negative and at "
+                       "most the size of `dim`");
+
+  auto isCompatible = [](int64_t a, int64_t b) {
+    return ShapedType::isDynamic(a) || ShapedType::isDynamic(b) || a == b;
+  };
+  for (RankedTensorType resultType :
+       {getValues().getType(), getIndices().getType()}) {
+    if (resultType.getRank() != rank)
+      return emitOpError("failed to verify that the results are of rank ")
+             << rank;
+    for (int64_t i = 0; i < rank; ++i) {
+      int64_t expected = i == dim ? k : inType.getDimSize(i);
+      if (!isCompatible(expected, resultType.getDimSize(i)))
+        return emitOpError("failed to verify that the result dims match the "
+                           "input dims, with a size of `k` along `dim`");
+    }
+  }
+  if (!getIndices().getType().getElementType().isInteger(64))
+    return emitOpError("failed to verify that `indices` are of type i64");
+  return success();
+}
+
+LogicalResult SortOp::verify() {
+  int64_t rank = getIn().getType().getRank();
+  int64_t dim = getDim();
+  if (dim < 0 || dim >= rank)
+    return emitOpError(
+        "failed to verify that `dim` is in the range of the input rank");
+  if (!getIndices().getType().getElementType().isInteger(64))
+    return emitOpError("failed to verify that `indices` are of type i64");
+  return success();
+}
+
+template <typename SoftmaxOpTy>
+static LogicalResult verifySoftmaxOp(SoftmaxOpTy op) {
+  int64_t rank = op.getIn().getType().getRank();
+  int64_t axis = op.getAxis();
+  if (axis < 0 || axis >= rank)
+    return op.emitOpError(
+        "failed to verify that `axis` is in the range of the input rank");
+  return success();
+}
+
+LogicalResult SoftmaxOp::verify() { return verifySoftmaxOp(*this); }
+
+LogicalResult LogSoftmaxOp::verify() { return verifySoftmaxOp(*this); }
+
+// Verifies that `axis` is in the range of the input rank, and that the
+// affine parameters, if any, have the shape of the normalized dims.
+static LogicalResult verifyNormOp(Operation *op, Value in, int64_t axis,
+                                  ValueRange params) {
+  auto inputType = cast<RankedTensorType>(in.getType());
+  int64_t rank = inputType.getRank();
+  if (axis < 0 || axis >= rank)
+    return op->emitOpError(
+        "failed to verify that `axis` is in the range of the input rank");
+
+  ArrayRef<int64_t> normalizedShape = inputType.getShape().drop_front(axis);
+  for (Value param : params) {
+    auto paramType = cast<RankedTensorType>(param.getType());
+    if (paramType.getElementType() != inputType.getElementType())
+      return op->emitOpError("failed to verify that the weight and bias have "
+                             "the element type of the input");
+    if (failed(verifyCompatibleShape(paramType.getShape(), normalizedShape)))
+      return op->emitOpError("failed to verify that the weight and bias have "
+                             "the shape of the normalized dims");
+  }
+  return success();
+}
+
+LogicalResult LayerNormOp::verify() {
+  SmallVector<Value> params;
+  if (getWeight())
+    params.push_back(getWeight());
+  if (getBias())
+    params.push_back(getBias());
+  return verifyNormOp(*this, getIn(), getAxis(), params);
+}
+
+LogicalResult RMSNormOp::verify() {
+  SmallVector<Value> params;
+  if (getWeight())
+    params.push_back(getWeight());
+  return verifyNormOp(*this, getIn(), getAxis(), params);
+}
+
 //===----------------------------------------------------------------------===//
 // BindSymbolicShapeOp
 //===----------------------------------------------------------------------===//
@@ -41,6 +41,246 @@ SmallVector<int64_t> getOpFoldResultsAsShape(ArrayRef<OpFoldResult> ofrs) {
   return shape;
 }
 
+// Returns the type of a tile of `value` with the given `sizes`.
+RankedTensorType getTileType(Value value, ArrayRef<OpFoldResult> sizes) {
+  return cast<RankedTensorType>(value.getType())
+      .clone(getOpFoldResultsAsShape(sizes));
+}
+
+// Returns an iteration domain with the given sizes, that starts at zero and
+// has unit strides.
+SmallVector<Range> getIterationDomainFromSizes(OpBuilder &b,
+                                               ArrayRef<OpFoldResult> sizes) {
+  OpFoldResult zero = b.getIndexAttr(0);
+  OpFoldResult one = b.getIndexAttr(1);
+  SmallVector<Range> loopRanges;
+  for (OpFoldResult size : sizes)
+    loopRanges.push_back({zero, size, one});
+  return loopRanges;
+}
+
+// Extracts the tile at `offsets` with `sizes` from `source` and records the
+// created slice op in `slices`.
+Value extractTile(OpBuilder &b, Location loc, Value source,
+                  ArrayRef<OpFoldResult> offsets, ArrayRef<OpFoldResult> sizes,
+                  SmallVector<Operation *> &slices) {
+  SmallVector<OpFoldResult> strides(offsets.size(), b.getIndexAttr(1));
+  auto extractOp =
+      b.create<tensor::ExtractSliceOp>(loc, source, offsets, sizes, strides);
+  slices.push_back(extractOp);
+  return extractOp.getResult();
+}
+
+// Shared implementation for ops whose result tiles map one to one to the
+// iteration space, i.e. every op except `tcp.slice`.
+template <typename ConcreteModel, typename OpTy>
+struct IdentityResultTiling
+    : public TilingInterface::ExternalModel<ConcreteModel, OpTy> {
+
+  SmallVector<utils::IteratorType> getLoopIteratorTypes(Operation *op) const {
+    return SmallVector(cast<RankedTensorType>(op->getResult(0).getType())
+                           .getRank(),
+                       utils::IteratorType::parallel);
+  }
+
+  LogicalResult
+  getResultTilePosition(Operation *op, OpBuilder &b, unsigned resultNumber,
+                        ArrayRef<OpFoldResult> offsets,
+                        ArrayRef<OpFoldResult> sizes,
+                        SmallVector<OpFoldResult> &resultOffsets,
+                        SmallVector<OpFoldResult> &resultSizes) const {
+    resultOffsets.assign(offsets.begin(), offsets.end());
+    resultSizes.assign(sizes.begin(), sizes.end());
+    return success();
+  }
+
+  FailureOr<TilingResult>
+  generateResultTileValue(Operation *op, OpBuilder &b, unsigned resultNumber,
+                          ArrayRef<OpFoldResult> offsets,
+                          ArrayRef<OpFoldResult> sizes) const {
+    return static_cast<const ConcreteModel *>(this)->getTiledImplementation(
+        op, b, offsets, sizes);
+  }
+};
+
+// Tiling for elementwise ops: every operand is tiled like the result.
+template <typename OpTy>
+struct ElementwiseOpTiling
+    : public IdentityResultTiling<ElementwiseOpTiling<OpTy>, OpTy> {
+
+  SmallVector<Range> getIterationDomain(Operation *op, OpBuilder &b) const {
+    return getIterationDomainFromSizes(
+        b, tensor::getMixedSizes(b, op->getLoc(), op->getOperand(0)));
+  }
+
+  FailureOr<TilingResult>
+  getTiledImplementation(Operation *op, OpBuilder &b,
+                         ArrayRef<OpFoldResult> offsets,
+                         ArrayRef<OpFoldResult> sizes) const {
+    SmallVector<Operation *> slices;
+    SmallVector<Value> tiledOperands;
+    for (Value operand : op->getOperands())
+      tiledOperands.push_back(
+          extractTile(b, op->getLoc(), operand, offsets, sizes, slices));
+
+    Operation *tiledOp = b.clone(*op);
+    tiledOp->setOperands(tiledOperands);
+    tiledOp->getResult(0).setType(getTileType(op->getResult(0), sizes));
+    return TilingResult{
+        {tiledOp}, SmallVector<Value>(tiledOp->getResults()), slices};
+  }
+};
+
+struct BroadcastOpTiling
+    : public IdentityResultTiling<BroadcastOpTiling, tcp::BroadcastOp> {
+
+  SmallVector<Range> getIterationDomain(Operation *op, OpBuilder &b) const {
+    auto broadcastOp = cast<tcp::BroadcastOp>(op);
+    SmallVector<OpFoldResult> sizes =
+        tensor::getMixedSizes(b, op->getLoc(), broadcastOp.getIn());
+    for (auto [axis, newDimSize] : llvm::zip(broadcastOp.getAxes(),
+                                             broadcastOp.getNewDimSizes()))
+      sizes[cast<IntegerAttr>(axis).getInt()] = newDimSize;
+    return getIterationDomainFromSizes(b, sizes);
+  }
+
+  FailureOr<TilingResult>
+  getTiledImplementation(Operation *op, OpBuilder &b,
+                         ArrayRef<OpFoldResult> offsets,
+                         ArrayRef<OpFoldResult> sizes) const {
+    auto broadcastOp = cast<tcp::BroadcastOp>(op);
+    Location loc = op->getLoc();
+
+    // The broadcasted dims of the input have size 1, so every tile reads the
+    // same slice along them.
+    SmallVector<OpFoldResult> inputOffsets(offsets);
+    SmallVector<OpFoldResult> inputSizes(sizes);
+    SmallVector<Value> newDimSizes;
+    for (Attribute axisAttr : broadcastOp.getAxes()) {
+      int64_t axis = cast<IntegerAttr>(axisAttr).getInt();
+      inputOffsets[axis] = b.getIndexAttr(0);
+      inputSizes[axis] = b.getIndexAttr(1);
+      newDimSizes.push_back(
+          getValueOrCreateConstantIndexOp(b, loc, sizes[axis]));
+    }
+
+    SmallVector<Operation *> slices;
+    Value inputTile = extractTile(b, loc, broadcastOp.getIn(), inputOffsets,
+                                  inputSizes, slices);
+    auto tiledOp = b.create<tcp::BroadcastOp>(
+        loc, getTileType(broadcastOp.getOut(), sizes), inputTile, newDimSizes,
+        broadcastOp.getAxes());
+    return TilingResult{
+        {tiledOp}, SmallVector<Value>(tiledOp->getResults()), slices};
+  }
+};
+
+struct GatherOpTiling
+    : public IdentityResultTiling<GatherOpTiling, tcp::GatherOp> {
+
+  SmallVector<Range> getIterationDomain(Operation *op, OpBuilder &b) const {
+    auto gatherOp = cast<tcp::GatherOp>(op);
+    return getIterationDomainFromSizes(
+        b, tensor::getMixedSizes(b, op->getLoc(), gatherOp.getIndices()));
+  }
+
+  FailureOr<TilingResult>
+  getTiledImplementation(Operation *op, OpBuilder &b,
+                         ArrayRef<OpFoldResult> offsets,
+                         ArrayRef<OpFoldResult> sizes) const {
+    auto gatherOp = cast<tcp::GatherOp>(op);
+    Location loc = op->getLoc();
+    int64_t gatherDim = gatherOp.getDim().getSExtValue();
+
+    // The indices address the whole gather dim of the input, so every tile
+    // needs all of it. The other dims are tiled like the result.
+    SmallVector<OpFoldResult> inputOffsets(offsets);
+    SmallVector<OpFoldResult> inputSizes(sizes);
+    inputOffsets[gatherDim] = b.getIndexAttr(0);
+    inputSizes[gatherDim] =
+        tensor::getMixedSize(b, loc, gatherOp.getInput(), gatherDim);
+
+    SmallVector<Operation *> slices;
+    Value inputTile = extractTile(b, loc, gatherOp.getInput(), inputOffsets,
+                                  inputSizes, slices);
+    Value indicesTile =
+        extractTile(b, loc, gatherOp.getIndices(), offsets, sizes, slices);
+    auto tiledOp = b.create<tcp::GatherOp>(
+        loc, getTileType(gatherOp.getOut(), sizes), inputTile, indicesTile,
+        gatherOp.getDimAttr());
+    return TilingResult{
+        {tiledOp}, SmallVector<Value>(tiledOp->getResults()), slices};
+  }
+};
+
+struct GatherNDOpTiling
+    : public IdentityResultTiling<GatherNDOpTiling, tcp::GatherNDOp> {
+
+  SmallVector<Range> getIterationDomain(Operation *op, OpBuilder &b) const {
+    auto gatherOp = cast<tcp::GatherNDOp>(op);
+    Location loc = op->getLoc();
+    auto indicesType = cast<RankedTensorType>(gatherOp.getIndices().getType());
+    int64_t numBatchDims = indicesType.getRank() - 1;
+    int64_t numIndexedDims = indicesType.getShape().back();
+
+    // The result has the batch dims of the indices, followed by the dims of
+    // the input that are not indexed.
+    SmallVector<OpFoldResult> indicesSizes =
+        tensor::getMixedSizes(b, loc, gatherOp.getIndices());
+    SmallVector<OpFoldResult> inputSizes =
+        tensor::getMixedSizes(b, loc, gatherOp.getInput());
+    SmallVector<OpFoldResult> sizes(indicesSizes.begin(),
+                                    indicesSizes.begin() + numBatchDims);
+    sizes.append(inputSizes.begin() + numIndexedDims, inputSizes.end());
+    return getIterationDomainFromSizes(b, sizes);
+  }
+
+  FailureOr<TilingResult>
+  getTiledImplementation(Operation *op, OpBuilder &b,
+                         ArrayRef<OpFoldResult> offsets,
+                         ArrayRef<OpFoldResult> sizes) const {
+    auto gatherOp = cast<tcp::GatherNDOp>(op);
+    Location loc = op->getLoc();
+    auto indicesType = cast<RankedTensorType>(gatherOp.getIndices().getType());
+    int64_t numBatchDims = indicesType.getRank() - 1;
+    int64_t numIndexedDims = indicesType.getShape().back();
+
+    // The batch dims of the indices are tiled like the result, while each
+    // tile needs the full index vectors.
+    SmallVector<OpFoldResult> indicesOffsets(offsets.begin(),
+                                             offsets.begin() + numBatchDims);
+    SmallVector<OpFoldResult> indicesSizes(sizes.begin(),
+                                           sizes.begin() + numBatchDims);
+    indicesOffsets.push_back(b.getIndexAttr(0));
+    indicesSizes.push_back(b.getIndexAttr(numIndexedDims));
+
+    // The indexed dims of the input are needed in full, the remaining dims
+    // are tiled like the trailing dims of the result.
+    SmallVector<OpFoldResult> inputOffsets(numIndexedDims, b.getIndexAttr(0));
+    SmallVector<OpFoldResult> inputSizes;
+    for (int64_t i = 0; i < numIndexedDims; ++i)
+      inputSizes.push_back(
+          tensor::getMixedSize(b, loc, gatherOp.getInput(), i));
+    inputOffsets.append(offsets.begin() + numBatchDims, offsets.end());
+    inputSizes.append(sizes.begin() + numBatchDims, sizes.end());
+
+    SmallVector<Operation *> slices;
+    Value inputTile = extractTile(b, loc, gatherOp.getInput(), inputOffsets,
+                                  inputSizes, slices);
+    Value indicesTile = extractTile(b, loc, gatherOp.getIndices(),
+                                    indicesOffsets, indicesSizes, slices);
+    auto tiledOp = b.create<tcp::GatherNDOp>(
+        loc, getTileType(gatherOp.getOut(), sizes), inputTile, indicesTile);
+    return TilingResult{
+        {tiledOp}, SmallVector<Value>(tiledOp->getResults()), slices};
+  }
+};
+
+template <typename... OpTys>
+void attachElementwiseOpTiling(MLIRContext *ctx) {
+  (OpTys::template attachInterface<ElementwiseOpTiling<OpTys>>(*ctx), ...);
+}
+
 struct SliceOpTiling
     : public TilingInterface::ExternalModel<SliceOpTiling, tcp::SliceOp> {
 
@@ -165,5 +405,21 @@ void mlir::tcp::registerTilingInterfaceExternalModels(
     DialectRegistry &registry) {
   registry.addExtension(+[](MLIRContext *ctx, TcpDialect *dialect) {
     tcp::SliceOp::attachInterface<SliceOpTiling>(*ctx);
+    tcp::BroadcastOp::attachInterface<BroadcastOpTiling>(*ctx);
+    tcp::GatherOp::attachInterface<GatherOpTiling>(*ctx);
+    tcp::GatherNDOp::attachInterface<GatherNDOpTiling>(*ctx);
+
+    // Unary elementwise ops.
+    attachElementwiseOpTiling<tcp::TanhOp, tcp::ClampOp, tcp::SigmoidOp,
+                              tcp::SqrtOp, tcp::CeilOp, tcp::FloorOp,
+                              tcp::RoundOp, tcp::RoundEvenOp, tcp::CosOp,
+                              tcp::SinOp, tcp::AbsOp, tcp::LogOp, tcp::NegOp,
+                              tcp::AtanOp, tcp::CastOp>(ctx);
+    // Binary elementwise ops.
+    attachElementwiseOpTiling<tcp::AddOp, tcp::SubOp, tcp::MulOp,
+                              tcp::DivFOp, tcp::DivSIOp, tcp::DivUIOp,
+                              tcp::Atan2Op, tcp::CompareOp>(ctx);
+    // Ternary elementwise ops.
+    attachElementwiseOpTiling<tcp::SelectOp>(ctx);
   });
 }
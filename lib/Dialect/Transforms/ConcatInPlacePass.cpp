@@ -0,0 +1,189 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/ConcatInPlacePass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/Dominance.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+// Returns the chain of `tensor.insert_slice` ops that fills `emptyOp`, which
+// is how `tensor.concat` is decomposed.
+SmallVector<tensor::InsertSliceOp> getInsertChain(tensor::EmptyOp emptyOp) {
+  SmallVector<tensor::InsertSliceOp> chain;
+  Value dest = emptyOp.getResult();
+  while (dest.hasOneUse()) {
+    auto insertOp = dyn_cast<tensor::InsertSliceOp>(*dest.getUsers().begin());
+    if (!insertOp || insertOp.getDest() != dest ||
+        insertOp->getBlock() != emptyOp->getBlock())
+      break;
+    chain.push_back(insertOp);
+    dest = insertOp.getResult();
+  }
+  return chain;
+}
+
+// A linalg op whose result is only inserted into the chain, and which can
+// compute it in the slice of the destination instead of in a new tensor.
+struct Producer {
+  tensor::InsertSliceOp insertOp;
+  linalg::LinalgOp op;
+  // The init that is a `tensor.empty`, either of `op` or of the linalg op
+  // that computes the init of `op`, e.g. a `linalg.fill`.
+  OpOperand *emptyInit;
+};
+
+std::optional<Producer> getProducer(tensor::InsertSliceOp insertOp,
+                                    DominanceInfo &dominance) {
+  auto result = dyn_cast<OpResult>(insertOp.getSource());
+  if (!result || !result.hasOneUse() ||
+      insertOp.getSourceType().getRank() != insertOp.getDestType().getRank())
+    return std::nullopt;
+  auto op = dyn_cast<linalg::LinalgOp>(result.getOwner());
+  if (!op || !op.hasPureTensorSemantics() || op->getNumResults() != 1 ||
+      op->getBlock() != insertOp->getBlock())
+    return std::nullopt;
+
+  OpOperand *init = op.getDpsInitOperand(0);
+  while (auto initOp = init->get().getDefiningOp<linalg::LinalgOp>()) {
+    if (!initOp.hasPureTensorSemantics() || initOp->getNumResults() != 1 ||
+        !initOp->hasOneUse() || initOp->getBlock() != op->getBlock())
+      return std::nullopt;
+    init = initOp.getDpsInitOperand(0);
+  }
+  auto emptyOp = init->get().getDefiningOp<tensor::EmptyOp>();
+  if (!emptyOp || !emptyOp->hasOneUse())
+    return std::nullopt;
+
+  // The slice of the destination is extracted right before the empty init is
+  // used, so its offsets and strides must be available there.
+  Operation *user = init->getOwner();
+  for (Value value : llvm::concat<Value>(insertOp.getOffsets(),
+                                         insertOp.getStrides())) {
+    if (!dominance.properlyDominates(value, user))
+      return std::nullopt;
+  }
+  return Producer{insertOp, op, init};
+}
+
+// Makes the producers of the inputs of the concatenation that fills `emptyOp`
+// compute them in their slices of the result. The chain is rebuilt such that
+// each producer writes into a slice extracted from the destination right
+// before it, and inserts its result right after it. One-shot bufferization
+// then computes them in place of the result buffer, without copies.
+void concatInPlace(RewriterBase &rewriter, tensor::EmptyOp emptyOp,
+                   DominanceInfo &dominance) {
+  SmallVector<tensor::InsertSliceOp> chain = getInsertChain(emptyOp);
+  if (chain.empty())
+    return;
+
+  SmallVector<Producer> producers;
+  for (tensor::InsertSliceOp insertOp : chain) {
+    if (std::optional<Producer> producer = getProducer(insertOp, dominance))
+      producers.push_back(*producer);
+  }
+  llvm::sort(producers, [](const Producer &lhs, const Producer &rhs) {
+    return lhs.emptyInit->getOwner()->isBeforeInBlock(
+        rhs.emptyInit->getOwner());
+  });
+  // Each producer must come after the previous one, which writes the
+  // destination it extracts its slice from.
+  SmallVector<Producer> inPlaceProducers;
+  for (const Producer &producer : producers) {
+    if (inPlaceProducers.empty() ||
+        inPlaceProducers.back().op->isBeforeInBlock(
+            producer.emptyInit->getOwner()))
+      inPlaceProducers.push_back(producer);
+  }
+  if (inPlaceProducers.empty())
+    return;
+
+  // The destination must exist before the first producer.
+  Operation *firstUser = inPlaceProducers.front().emptyInit->getOwner();
+  if (!llvm::all_of(emptyOp->getOperands(), [&](Value value) {
+        return dominance.properlyDominates(value, firstUser);
+      }))
+    return;
+  if (!emptyOp->isBeforeInBlock(firstUser))
+    emptyOp->moveBefore(firstUser);
+
+  Value dest = emptyOp.getResult();
+  llvm::SmallPtrSet<Operation *, 4> inPlaceInserts;
+  for (const Producer &producer : inPlaceProducers) {
+    tensor::InsertSliceOp insertOp = producer.insertOp;
+    inPlaceInserts.insert(insertOp);
+    auto initEmptyOp =
+        producer.emptyInit->get().getDefiningOp<tensor::EmptyOp>();
+    SmallVector<OpFoldResult> sizes = initEmptyOp.getMixedSizes();
+
+    rewriter.setInsertionPoint(producer.emptyInit->getOwner());
+    Value slice = rewriter.create<tensor::ExtractSliceOp>(
+        insertOp.getLoc(), insertOp.getSourceType(), dest,
+        insertOp.getMixedOffsets(), sizes, insertOp.getMixedStrides());
+    rewriter.modifyOpInPlace(producer.emptyInit->getOwner(),
+                             [&]() { producer.emptyInit->set(slice); });
+    rewriter.eraseOp(initEmptyOp);
+
+    rewriter.setInsertionPointAfter(producer.op);
+    dest = rewriter.create<tensor::InsertSliceOp>(
+        insertOp.getLoc(), producer.op->getResult(0), dest,
+        insertOp.getMixedOffsets(), sizes, insertOp.getMixedStrides());
+  }
+
+  // The other inputs are inserted where the chain was.
+  rewriter.setInsertionPoint(chain.back());
+  for (tensor::InsertSliceOp insertOp : chain) {
+    if (inPlaceInserts.contains(insertOp))
+      continue;
+    dest = rewriter.create<tensor::InsertSliceOp>(
+        insertOp.getLoc(), insertOp.getSource(), dest,
+        insertOp.getMixedOffsets(), insertOp.getMixedSizes(),
+        insertOp.getMixedStrides());
+  }
+  rewriter.replaceAllUsesWith(chain.back().getResult(), dest);
+  for (tensor::InsertSliceOp insertOp : llvm::reverse(chain))
+    rewriter.eraseOp(insertOp);
+}
+
+class TcpConcatInPlacePass
+    : public TcpConcatInPlaceBase<TcpConcatInPlacePass> {
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    IRRewriter rewriter(&getContext());
+    DominanceInfo dominance(funcOp);
+
+    // Collect the destinations of the chains first, since the empty inits of
+    // the producers are erased along the way.
+    SmallVector<tensor::EmptyOp> emptyOps;
+    funcOp.walk([&](tensor::EmptyOp op) {
+      if (op->hasOneUse() && isa<tensor::InsertSliceOp>(*op->user_begin()))
+        emptyOps.push_back(op);
+    });
+    for (tensor::EmptyOp op : emptyOps)
+      concatInPlace(rewriter, op, dominance);
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createTcpConcatInPlacePass() {
+  return std::make_unique<TcpConcatInPlacePass>();
+}
+
+} // namespace mlir::tcp
@@ -0,0 +1,42 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/EnableFastMathPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Pass/Pass.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+class TcpEnableFastMathPass
+    : public TcpEnableFastMathBase<TcpEnableFastMathPass> {
+  void runOnOperation() override {
+    auto fastAttr =
+        arith::FastMathFlagsAttr::get(&getContext(), arith::FastMathFlags::fast);
+    // Both arith and math ops implement the interface, and their fastmath
+    // flags are carried over to the LLVM dialect.
+    getOperation().walk([&](arith::ArithFastMathInterface op) {
+      op->setAttr(op.getFastMathAttrName(), fastAttr);
+    });
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createTcpEnableFastMathPass() {
+  return std::make_unique<TcpEnableFastMathPass>();
+}
+
+} // namespace mlir::tcp
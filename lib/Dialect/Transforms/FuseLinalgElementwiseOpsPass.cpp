@@ -0,0 +1,86 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/FuseLinalgElementwiseOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/MemRef/Transforms/Transforms.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Tensor/Transforms/Transforms.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+// Returns true if `op` only re-indexes its input, as the generics created for
+// `tcp.broadcast` do.
+bool isBroadcastLike(Operation *op) {
+  auto genericOp = dyn_cast<linalg::GenericOp>(op);
+  if (!genericOp || genericOp.getNumDpsInputs() != 1 ||
+      genericOp.getNumDpsInits() != 1)
+    return false;
+  auto yieldOp = cast<linalg::YieldOp>(genericOp.getBody()->getTerminator());
+  return yieldOp.getValues()[0] == genericOp.getBody()->getArgument(0);
+}
+
+class TcpFuseLinalgElementwiseOpsPass
+    : public TcpFuseLinalgElementwiseOpsBase<
+          TcpFuseLinalgElementwiseOpsPass> {
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<affine::AffineDialect, linalg::LinalgDialect,
+                    tensor::TensorDialect>();
+  }
+
+  void runOnOperation() override {
+    Operation *op = getOperation();
+    MLIRContext *context = op->getContext();
+    RewritePatternSet patterns(context);
+
+    // Fusing a producer that has other users recomputes it in every consumer.
+    // That is only cheaper than materializing it for broadcasts, which do no
+    // arithmetic.
+    linalg::ControlFusionFn controlFn = [](OpOperand *fusedOperand) {
+      Operation *producer = fusedOperand->get().getDefiningOp();
+      return producer &&
+             (producer->hasOneUse() || isBroadcastLike(producer));
+    };
+    linalg::populateElementwiseOpsFusionPatterns(patterns, controlFn);
+    // Propagate reshapes through elementwise ops by expanding the ops, so
+    // that the chains on both sides of a reshape fuse.
+    linalg::populateFoldReshapeOpsByExpansionPatterns(patterns, controlFn);
+    linalg::populateEraseUnusedOperandsAndResultsPatterns(patterns);
+    // Resolve `tensor.dim` of fused producers, so that they become dead.
+    memref::populateResolveRankedShapedTypeResultDimsPatterns(patterns);
+    tensor::populateFoldTensorEmptyPatterns(patterns);
+    affine::AffineApplyOp::getCanonicalizationPatterns(patterns, context);
+    linalg::GenericOp::getCanonicalizationPatterns(patterns, context);
+    tensor::DimOp::getCanonicalizationPatterns(patterns, context);
+    tensor::EmptyOp::getCanonicalizationPatterns(patterns, context);
+
+    if (failed(applyPatternsAndFoldGreedily(op, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTcpFuseLinalgElementwiseOpsPass() {
+  return std::make_unique<TcpFuseLinalgElementwiseOpsPass>();
+}
+
+} // namespace mlir::tcp
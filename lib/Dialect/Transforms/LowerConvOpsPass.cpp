@@ -0,0 +1,329 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/LowerConvOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+#include "./TilingUtils.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Tensor/Transforms/Transforms.h"
+#include "mlir/Dialect/Utils/IndexingUtils.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/Dialect/Vector/Transforms/LoweringPatterns.h"
+#include "mlir/Dialect/Vector/Transforms/VectorRewritePatterns.h"
+#include "mlir/Dialect/Vector/Transforms/VectorTransforms.h"
+#include "mlir/Interfaces/TilingInterface.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "llvm/ADT/StringSwitch.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+// The im2col GEMM is only worth materializing if it covers at least one
+// micro-kernel of `tcp-pack-matmul-ops` with its default panel sizes: filters
+// map onto the rows of the lhs panels and the reduction onto their depth.
+constexpr int64_t kIm2ColMinFilters = 4;
+constexpr int64_t kIm2ColMinDepth = 32;
+
+// Largest tile along the output width of the direct kernels. The tiles of
+// the input rows stay small enough to be held in registers.
+constexpr int64_t kMaxOutputWidthTile = 8;
+
+enum class ConvStrategy { Auto, Im2Col, Direct };
+
+// Returns the tile sizes of the direct kernel of the NHWC convolution `op`.
+// The output width and channel loops are read off the indexing map of the
+// result, and the reduction over input channels, if any, off the one of the
+// input. All other loops are tiled to one.
+SmallVector<int64_t> getKernelTileSizes(linalg::LinalgOp op, int64_t lanes) {
+  SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+  SmallVector<int64_t> tileSizes(ranges.size(), 1);
+  AffineMap outputMap = op.getMatchingIndexingMap(op.getDpsInitOperand(0));
+  unsigned widthLoop = outputMap.getDimPosition(2);
+  unsigned channelLoop = outputMap.getDimPosition(3);
+  tileSizes[widthLoop] = getTileSize(ranges[widthLoop], kMaxOutputWidthTile);
+  tileSizes[channelLoop] = getTileSize(ranges[channelLoop], 2 * lanes);
+
+  AffineMap inputMap = op.getMatchingIndexingMap(op.getDpsInputOperand(0));
+  auto inputChannel = dyn_cast<AffineDimExpr>(inputMap.getResult(3));
+  if (inputChannel && inputChannel.getPosition() != channelLoop) {
+    unsigned reductionLoop = inputChannel.getPosition();
+    tileSizes[reductionLoop] = getTileSize(ranges[reductionLoop], 4 * lanes);
+  }
+  return tileSizes;
+}
+
+bool isStaticConv(linalg::LinalgOp op) {
+  return op.hasPureTensorSemantics() &&
+         !ShapedType::isDynamicShape(op.getStaticLoopRanges());
+}
+
+// Returns true if the im2col rewrite of `op` gives a GEMM that is large
+// enough to be packed, with an im2col buffer of at most `maxBytes`.
+bool preferIm2Col(linalg::Conv2DNchwFchwOp op, unsigned vectorWidth,
+                  int64_t maxBytes) {
+  auto filterType = cast<RankedTensorType>(op.getInputs()[1].getType());
+  auto outputType = cast<RankedTensorType>(op.getOutputs()[0].getType());
+  ArrayRef<int64_t> filterShape = filterType.getShape();
+  ArrayRef<int64_t> outputShape = outputType.getShape();
+
+  int64_t numFilters = filterShape[0];
+  int64_t depth = filterShape[1] * filterShape[2] * filterShape[3];
+  int64_t numPixels = outputShape[2] * outputShape[3];
+  if (numFilters < kIm2ColMinFilters || depth < kIm2ColMinDepth ||
+      numPixels < 2 * getNumLanes(op, vectorWidth))
+    return false;
+
+  int64_t elementBytes =
+      llvm::divideCeil(filterType.getElementTypeBitWidth(), 8);
+  return outputShape[0] * depth * numPixels * elementBytes <= maxBytes;
+}
+
+// Returns `value` transposed by `permutation`. Fills and constant pads are
+// recreated in the new layout instead, so that pads stay next to the
+// kernels that read them.
+Value transpose(OpBuilder &b, Location loc, Value value,
+                ArrayRef<int64_t> permutation) {
+  if (isIdentityPermutation(permutation))
+    return value;
+  if (auto padOp = value.getDefiningOp<tensor::PadOp>()) {
+    if (Value padValue = padOp.getConstantPaddingValue()) {
+      Value source = transpose(b, loc, padOp.getSource(), permutation);
+      SmallVector<OpFoldResult> low =
+          applyPermutation(padOp.getMixedLowPad(), permutation);
+      SmallVector<OpFoldResult> high =
+          applyPermutation(padOp.getMixedHighPad(), permutation);
+      return b.create<tensor::PadOp>(loc, Type(), source, low, high, padValue);
+    }
+  }
+  auto type = cast<RankedTensorType>(value.getType());
+  SmallVector<int64_t> shape = applyPermutation(type.getShape(), permutation);
+  Value empty = b.create<tensor::EmptyOp>(loc, shape, type.getElementType());
+  if (auto fillOp = value.getDefiningOp<linalg::FillOp>())
+    return b.create<linalg::FillOp>(loc, fillOp.getInputs()[0], empty)
+        .getResult(0);
+  return b.create<linalg::TransposeOp>(loc, value, empty, permutation)
+      ->getResult(0);
+}
+
+// Rewrites the channels-first `op` into `NhwcOpTy`, with the channels as the
+// innermost dim of the input and the result. The filter is transposed by
+// `filterPermutation`.
+template <typename NhwcOpTy, typename NchwOpTy>
+linalg::LinalgOp convertToNhwc(RewriterBase &rewriter, NchwOpTy op,
+                               ArrayRef<int64_t> filterPermutation) {
+  constexpr int64_t kToNhwc[] = {0, 2, 3, 1};
+  constexpr int64_t kToNchw[] = {0, 3, 1, 2};
+  Location loc = op.getLoc();
+  rewriter.setInsertionPoint(op);
+  Value input = transpose(rewriter, loc, op.getInputs()[0], kToNhwc);
+  Value filter =
+      transpose(rewriter, loc, op.getInputs()[1], filterPermutation);
+  Value init = transpose(rewriter, loc, op.getOutputs()[0], kToNhwc);
+  auto nhwcOp = rewriter.create<NhwcOpTy>(
+      loc, init.getType(), ValueRange{input, filter}, ValueRange{init},
+      op.getStrides(), op.getDilations());
+  rewriter.replaceOp(
+      op, transpose(rewriter, loc, nhwcOp->getResult(0), kToNchw));
+  return cast<linalg::LinalgOp>(nhwcOp.getOperation());
+}
+
+// Tiles the NHWC convolution `op` down to a single output row and a single
+// filter row and column, which leaves a 1-D convolution for the vectorizer.
+// With multiple threads, the output rows are distributed over an
+// `scf.forall`.
+LogicalResult tileToKernel(RewriterBase &rewriter, linalg::LinalgOp op,
+                           ArrayRef<int64_t> tileSizes, unsigned numThreads) {
+  // The output rows are loop 1 of both NHWC convolutions.
+  constexpr int64_t kOutputRowLoop = 1;
+  auto kernel = cast<TilingInterface>(op.getOperation());
+  SmallVector<int64_t> sizes(tileSizes);
+  if (numThreads > 1) {
+    SmallVector<int64_t> rowSizes(sizes.size(), 0);
+    rowSizes[kOutputRowLoop] = 1;
+    FailureOr<TilingInterface> tiled =
+        tile(rewriter, kernel, rowSizes,
+             scf::SCFTilingOptions::LoopType::ForallOp);
+    if (failed(tiled))
+      return failure();
+    kernel = *tiled;
+    sizes[kOutputRowLoop] = 0;
+  }
+  return tile(rewriter, kernel, sizes, scf::SCFTilingOptions::LoopType::ForOp);
+}
+
+class TcpLowerConvOpsPass : public TcpLowerConvOpsBase<TcpLowerConvOpsPass> {
+public:
+  TcpLowerConvOpsPass() = default;
+  TcpLowerConvOpsPass(unsigned vectorWidth, unsigned numThreads) {
+    this->vectorWidth = vectorWidth;
+    this->numThreads = numThreads;
+  }
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<affine::AffineDialect, arith::ArithDialect,
+                    linalg::LinalgDialect, scf::SCFDialect,
+                    tensor::TensorDialect, vector::VectorDialect>();
+  }
+
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    MLIRContext *context = &getContext();
+    IRRewriter rewriter(context);
+
+    std::optional<ConvStrategy> convStrategy =
+        llvm::StringSwitch<std::optional<ConvStrategy>>(strategy)
+            .Case("auto", ConvStrategy::Auto)
+            .Case("im2col", ConvStrategy::Im2Col)
+            .Case("direct", ConvStrategy::Direct)
+            .Default(std::nullopt);
+    if (!convStrategy) {
+      funcOp.emitError() << "unknown convolution strategy '" << strategy
+                         << "'";
+      return signalPassFailure();
+    }
+
+    SmallVector<linalg::LinalgOp> convOps;
+    funcOp.walk([&](linalg::LinalgOp op) {
+      if (isa<linalg::Conv2DNchwFchwOp, linalg::DepthwiseConv2DNchwChwOp,
+              linalg::PoolingNchwMaxOp, linalg::PoolingNchwSumOp>(op) &&
+          isStaticConv(op))
+        convOps.push_back(op);
+    });
+    if (convOps.empty())
+      return;
+
+    for (linalg::LinalgOp op : convOps) {
+      int64_t lanes = getNumLanes(op, vectorWidth);
+
+      // Depthwise convolutions and poolings have no reduction over channels
+      // to turn into a GEMM, so they are always computed directly.
+      if (auto depthwiseOp =
+              dyn_cast<linalg::DepthwiseConv2DNchwChwOp>(op.getOperation())) {
+        linalg::LinalgOp nhwcOp =
+            convertToNhwc<linalg::DepthwiseConv2DNhwcHwcOp>(
+                rewriter, depthwiseOp, /*filterPermutation=*/{1, 2, 0});
+        (void)tileToKernel(rewriter, nhwcOp, getKernelTileSizes(nhwcOp, lanes),
+                           numThreads);
+        continue;
+      }
+      // The window of a pooling has no channel dim to move.
+      if (auto maxOp = dyn_cast<linalg::PoolingNchwMaxOp>(op.getOperation())) {
+        linalg::LinalgOp nhwcOp = convertToNhwc<linalg::PoolingNhwcMaxOp>(
+            rewriter, maxOp, /*filterPermutation=*/{0, 1});
+        (void)tileToKernel(rewriter, nhwcOp, getKernelTileSizes(nhwcOp, lanes),
+                           numThreads);
+        continue;
+      }
+      if (auto sumOp = dyn_cast<linalg::PoolingNchwSumOp>(op.getOperation())) {
+        linalg::LinalgOp nhwcOp = convertToNhwc<linalg::PoolingNhwcSumOp>(
+            rewriter, sumOp, /*filterPermutation=*/{0, 1});
+        (void)tileToKernel(rewriter, nhwcOp, getKernelTileSizes(nhwcOp, lanes),
+                           numThreads);
+        continue;
+      }
+
+      auto convOp = cast<linalg::Conv2DNchwFchwOp>(op.getOperation());
+      bool hasUnitDilation = llvm::all_of(
+          convOp.getDilations(), [](const APInt &v) { return v.isOne(); });
+      bool useIm2Col =
+          hasUnitDilation &&
+          (*convStrategy == ConvStrategy::Im2Col ||
+           (*convStrategy == ConvStrategy::Auto &&
+            preferIm2Col(convOp, vectorWidth, im2colMaxBytes)));
+      if (useIm2Col) {
+        // The GEMM is left to `tcp-pack-matmul-ops`.
+        rewriter.setInsertionPoint(convOp);
+        if (succeeded(linalg::rewriteInIm2Col(rewriter, convOp)))
+          continue;
+      }
+
+      linalg::LinalgOp nhwcOp = convertToNhwc<linalg::Conv2DNhwcHwcfOp>(
+          rewriter, convOp, /*filterPermutation=*/{2, 3, 1, 0});
+      (void)tileToKernel(rewriter, nhwcOp, getKernelTileSizes(nhwcOp, lanes),
+                         numThreads);
+    }
+
+    // Rewrite the tiled convolutions with unit output and filter rows into
+    // 1-D convolutions. Padded inputs are sliced before they are padded, so
+    // that every tile only pads the part of the input it reads.
+    {
+      RewritePatternSet patterns(context);
+      linalg::populateDecomposeConvolutionPatterns(patterns);
+      patterns.add<linalg::ExtractSliceOfPadTensorSwapPattern>(context);
+      linalg::populateLinalgTilingCanonicalizationPatterns(patterns);
+      if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns))))
+        return signalPassFailure();
+    }
+
+    SmallVector<linalg::LinalgOp> kernels;
+    funcOp.walk([&](linalg::LinalgOp op) {
+      if (isa<linalg::Conv1DNwcWcfOp, linalg::DepthwiseConv1DNwcWcOp,
+              linalg::PoolingNwcMaxOp, linalg::PoolingNwcSumOp>(op) &&
+          isStaticConv(op))
+        kernels.push_back(op);
+    });
+    for (linalg::LinalgOp kernel : kernels) {
+      if (failed(linalg::vectorizeOpPrecondition(kernel)))
+        continue;
+      rewriter.setInsertionPoint(kernel);
+      (void)linalg::vectorize(rewriter, kernel);
+    }
+
+    // Fold the slices of the tiles into the vector transfers, and the pads
+    // of the tiles into masked vector loads.
+    {
+      RewritePatternSet patterns(context);
+      linalg::populateLinalgTilingCanonicalizationPatterns(patterns);
+      linalg::populatePadOpVectorizationPatterns(patterns);
+      tensor::populateFoldTensorSubsetIntoVectorTransferPatterns(patterns);
+      vector::populateCastAwayVectorLeadingOneDimPatterns(patterns);
+      vector::populateVectorTransferPermutationMapLoweringPatterns(patterns);
+      vector::TransferReadOp::getCanonicalizationPatterns(patterns, context);
+      vector::TransferWriteOp::getCanonicalizationPatterns(patterns, context);
+      if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns))))
+        return signalPassFailure();
+    }
+
+    // The 1-D kernels accumulate one filter tap at a time; lower their
+    // contractions to outer products, which accumulate in registers.
+    RewritePatternSet patterns(context);
+    vector::populateVectorContractLoweringPatterns(
+        patterns, vector::VectorTransformsOptions().setVectorTransformsOptions(
+                      vector::VectorContractLowering::OuterProduct));
+    if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createTcpLowerConvOpsPass() {
+  return std::make_unique<TcpLowerConvOpsPass>();
+}
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTcpLowerConvOpsPass(unsigned vectorWidth, unsigned numThreads) {
+  return std::make_unique<TcpLowerConvOpsPass>(vectorWidth, numThreads);
+}
+
+} // namespace mlir::tcp
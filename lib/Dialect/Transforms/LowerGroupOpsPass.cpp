@@ -0,0 +1,160 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/LowerGroupOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "mlir-tcp/Dialect/IR/TcpOps.h"
+
+#include "./PassDetail.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/Interfaces/TilingInterface.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+// Returns the tile sizes for `op`. Only parallel loops are tiled, so that
+// the fused producers never need to be recomputed across a reduction.
+SmallVector<OpFoldResult> getTileSizes(OpBuilder &b, TilingInterface op,
+                                       ArrayRef<int64_t> tileSizes) {
+  SmallVector<utils::IteratorType> iteratorTypes = op.getLoopIteratorTypes();
+  SmallVector<OpFoldResult> sizes;
+  for (auto [i, iteratorType] : llvm::enumerate(iteratorTypes)) {
+    int64_t size = 0;
+    if (iteratorType == utils::IteratorType::parallel) {
+      if (!tileSizes.empty())
+        size = i < tileSizes.size() ? tileSizes[i] : 0;
+      else
+        size = i + 1 < iteratorTypes.size() ? 1 : 0;
+    }
+    sizes.push_back(b.getIndexAttr(size));
+  }
+  return sizes;
+}
+
+// Tiles the op that produces `yielded` and fuses all of its producers into
+// the generated loop nest.
+LogicalResult tileAndFuseProducers(RewriterBase &rewriter, Value yielded,
+                                   ArrayRef<int64_t> tileSizes) {
+  auto consumer = yielded.getDefiningOp<TilingInterface>();
+  if (!consumer)
+    return failure();
+
+  SmallVector<OpFoldResult> sizes =
+      getTileSizes(rewriter, consumer, tileSizes);
+  if (llvm::all_of(sizes, isZeroIndex))
+    return failure();
+
+  scf::SCFTileAndFuseOptions options;
+  options.tilingOptions.setTileSizes(sizes);
+  rewriter.setInsertionPoint(consumer);
+  FailureOr<scf::SCFTileAndFuseResult> result =
+      scf::tileConsumerAndFuseProducersUsingSCF(rewriter, consumer, options);
+  if (failed(result))
+    return failure();
+
+  for (OpResult origResult : consumer->getResults()) {
+    auto it = result->replacements.find(origResult);
+    if (it != result->replacements.end())
+      rewriter.replaceAllUsesWith(origResult, it->second);
+  }
+  return success();
+}
+
+// Replaces `groupOp` by the ops in its body.
+template <typename GroupOpTy>
+void inlineGroup(RewriterBase &rewriter, GroupOpTy groupOp,
+                 ValueRange blockArgReplacements) {
+  Block *body = &groupOp.getBody().front();
+  auto yieldOp = cast<tcp::YieldOp>(body->getTerminator());
+  SmallVector<Value> results(yieldOp.getIns());
+  rewriter.inlineBlockBefore(body, groupOp, blockArgReplacements);
+  rewriter.replaceOp(groupOp, results);
+  rewriter.eraseOp(yieldOp);
+}
+
+template <typename GroupOpTy>
+void lowerGroup(RewriterBase &rewriter, GroupOpTy groupOp,
+                ArrayRef<int64_t> tileSizes) {
+  auto yieldOp =
+      cast<tcp::YieldOp>(groupOp.getBody().front().getTerminator());
+  // Yielded values that are not produced by a tileable op, such as group
+  // inputs, are left as is.
+  for (Value yielded : llvm::to_vector(yieldOp.getIns()))
+    (void)tileAndFuseProducers(rewriter, yielded, tileSizes);
+}
+
+class TcpLowerGroupOpsPass
+    : public TcpLowerGroupOpsBase<TcpLowerGroupOpsPass> {
+public:
+  TcpLowerGroupOpsPass() = default;
+  TcpLowerGroupOpsPass(ArrayRef<int64_t> tileSizes) {
+    this->tileSizes = tileSizes;
+  }
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<affine::AffineDialect, arith::ArithDialect,
+                    scf::SCFDialect, tensor::TensorDialect>();
+  }
+
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    MLIRContext *context = &getContext();
+    IRRewriter rewriter(context);
+    SmallVector<int64_t> sizes(tileSizes.begin(), tileSizes.end());
+
+    // Collect the groups first, since lowering a group rewrites its body.
+    SmallVector<Operation *> groupOps;
+    funcOp.walk([&](Operation *op) {
+      if (isa<tcp::GroupOp, tcp::IsolatedGroupOp>(op))
+        groupOps.push_back(op);
+    });
+
+    for (Operation *op : groupOps) {
+      if (auto groupOp = dyn_cast<tcp::GroupOp>(op)) {
+        lowerGroup(rewriter, groupOp, sizes);
+        inlineGroup(rewriter, groupOp, /*blockArgReplacements=*/{});
+      } else {
+        auto isolatedGroupOp = cast<tcp::IsolatedGroupOp>(op);
+        lowerGroup(rewriter, isolatedGroupOp, sizes);
+        inlineGroup(rewriter, isolatedGroupOp, isolatedGroupOp.getIns());
+      }
+    }
+
+    // Remove the producers that were fused into the tile loops.
+    RewritePatternSet patterns(context);
+    linalg::populateLinalgTilingCanonicalizationPatterns(patterns);
+    if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createTcpLowerGroupOpsPass() {
+  return std::make_unique<TcpLowerGroupOpsPass>();
+}
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTcpLowerGroupOpsPass(ArrayRef<int64_t> tileSizes) {
+  return std::make_unique<TcpLowerGroupOpsPass>(tileSizes);
+}
+
+} // namespace mlir::tcp
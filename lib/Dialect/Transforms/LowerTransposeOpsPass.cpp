@@ -0,0 +1,210 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/LowerTransposeOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+#include "./TilingUtils.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Tensor/Transforms/Transforms.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/Dialect/Vector/Transforms/LoweringPatterns.h"
+#include "mlir/Dialect/Vector/Transforms/VectorRewritePatterns.h"
+#include "mlir/Dialect/Vector/Transforms/VectorTransforms.h"
+#include "mlir/Interfaces/TilingInterface.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+// The loops of a transpose that swap places: the loop that walks the
+// innermost dim of the input, and the innermost loop, which walks the
+// innermost dim of the result.
+struct TransposedLoops {
+  int64_t inputInnermost;
+  int64_t resultInnermost;
+};
+
+// Returns the transposed loops of `op` if it is a statically shaped transpose
+// that moves the innermost dim of its input, and both transposed loops are
+// multiples of `numLanes`. Other transposes copy contiguous rows, which
+// `tcp-vectorize-linalg-ops` already handles well.
+std::optional<TransposedLoops> getTransposedLoops(linalg::TransposeOp op,
+                                                  int64_t numLanes) {
+  if (!op.hasPureTensorSemantics() || numLanes < 2)
+    return std::nullopt;
+  SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+  if (ShapedType::isDynamicShape(ranges))
+    return std::nullopt;
+  ArrayRef<int64_t> permutation = op.getPermutation();
+  int64_t rank = permutation.size();
+  if (permutation.back() == rank - 1)
+    return std::nullopt;
+
+  TransposedLoops loops;
+  loops.inputInnermost =
+      llvm::find(permutation, rank - 1) - permutation.begin();
+  loops.resultInnermost = rank - 1;
+  if (ranges[loops.inputInnermost] % numLanes != 0 ||
+      ranges[loops.resultInnermost] % numLanes != 0)
+    return std::nullopt;
+  return loops;
+}
+
+// Rewrites a tile of a transpose that has unit dims except for the two
+// transposed loops into a vector load, a transpose of the vector in
+// registers and a vector store.
+void vectorizeTile(RewriterBase &rewriter, linalg::TransposeOp op) {
+  Location loc = op.getLoc();
+  rewriter.setInsertionPoint(op);
+
+  auto dropUnitDims = [&](Value tensor) {
+    auto type = cast<RankedTensorType>(tensor.getType());
+    SmallVector<int64_t> shape;
+    for (int64_t size : type.getShape()) {
+      if (size != 1)
+        shape.push_back(size);
+    }
+    return tensor::createCanonicalRankReducingExtractSliceOp(
+        rewriter, loc, tensor,
+        RankedTensorType::get(shape, type.getElementType()));
+  };
+  Value input = dropUnitDims(op.getInput());
+  Value init = dropUnitDims(op.getInit());
+
+  auto inputType = cast<RankedTensorType>(input.getType());
+  Type elementType = inputType.getElementType();
+  Value zero = rewriter.create<arith::ConstantIndexOp>(loc, 0);
+  Value padding = rewriter.create<arith::ConstantOp>(
+      loc, rewriter.getZeroAttr(elementType));
+  bool inBounds[] = {true, true};
+  Value vector = rewriter.create<vector::TransferReadOp>(
+      loc, VectorType::get(inputType.getShape(), elementType), input,
+      ValueRange{zero, zero}, padding, ArrayRef<bool>(inBounds));
+  Value transposed = rewriter.create<vector::TransposeOp>(
+      loc, vector, ArrayRef<int64_t>{1, 0});
+  Value written = rewriter
+                      .create<vector::TransferWriteOp>(
+                          loc, transposed, init, ValueRange{zero, zero},
+                          ArrayRef<bool>(inBounds))
+                      ->getResult(0);
+  rewriter.replaceOp(op, tensor::createCanonicalRankReducingInsertSliceOp(
+                             rewriter, loc, written, op.getInit()));
+}
+
+class TcpLowerTransposeOpsPass
+    : public TcpLowerTransposeOpsBase<TcpLowerTransposeOpsPass> {
+public:
+  TcpLowerTransposeOpsPass() = default;
+  TcpLowerTransposeOpsPass(unsigned vectorWidth, unsigned numThreads) {
+    this->vectorWidth = vectorWidth;
+    this->numThreads = numThreads;
+  }
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<affine::AffineDialect, arith::ArithDialect,
+                    linalg::LinalgDialect, scf::SCFDialect,
+                    tensor::TensorDialect, vector::VectorDialect>();
+  }
+
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    MLIRContext *context = &getContext();
+    IRRewriter rewriter(context);
+
+    SmallVector<std::pair<linalg::TransposeOp, TransposedLoops>> candidates;
+    funcOp.walk([&](linalg::TransposeOp op) {
+      if (std::optional<TransposedLoops> loops =
+              getTransposedLoops(op, getNumLanes(op, vectorWidth)))
+        candidates.emplace_back(op, *loops);
+    });
+    if (candidates.empty())
+      return;
+
+    // Tile the transposed loops into cache blocks, which are transposed one
+    // after the other, and those into square tiles of one vector register
+    // per row. All other loops are tiled by 1. With multiple threads, the
+    // blocks are distributed over an `scf.forall`.
+    SmallVector<linalg::TransposeOp> tiles;
+    for (auto &[op, loops] : candidates) {
+      int64_t numLanes = getNumLanes(op, vectorWidth);
+      SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+      int64_t maxBlockTiles = std::max<int64_t>(1, blockSize / numLanes);
+
+      SmallVector<int64_t> blockSizes(ranges.size(), 1);
+      SmallVector<int64_t> tileSizes(ranges.size(), 0);
+      for (int64_t loop : {loops.inputInnermost, loops.resultInnermost}) {
+        blockSizes[loop] =
+            numLanes * getTileSize(ranges[loop] / numLanes, maxBlockTiles);
+        tileSizes[loop] = numLanes;
+      }
+
+      FailureOr<TilingInterface> block =
+          tile(rewriter, cast<TilingInterface>(op.getOperation()), blockSizes,
+               numThreads > 1 ? scf::SCFTilingOptions::LoopType::ForallOp
+                              : scf::SCFTilingOptions::LoopType::ForOp);
+      if (failed(block))
+        continue;
+      FailureOr<TilingInterface> tiled =
+          tile(rewriter, *block, tileSizes,
+               scf::SCFTilingOptions::LoopType::ForOp);
+      if (succeeded(tiled))
+        tiles.push_back(cast<linalg::TransposeOp>(tiled->getOperation()));
+    }
+
+    for (linalg::TransposeOp op : tiles)
+      vectorizeTile(rewriter, op);
+
+    // Fold the slices of the tiles into the vector transfers.
+    {
+      RewritePatternSet patterns(context);
+      linalg::populateLinalgTilingCanonicalizationPatterns(patterns);
+      tensor::populateFoldTensorSubsetIntoVectorTransferPatterns(patterns);
+      vector::TransferReadOp::getCanonicalizationPatterns(patterns, context);
+      vector::TransferWriteOp::getCanonicalizationPatterns(patterns, context);
+      if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns))))
+        return signalPassFailure();
+    }
+
+    // Transpose the tiles in registers with a single shuffle, which the
+    // backend lowers to unpack and permute instructions instead of moving
+    // one element at a time.
+    RewritePatternSet patterns(context);
+    vector::populateVectorTransposeLoweringPatterns(
+        patterns, vector::VectorTransformsOptions().setVectorTransposeLowering(
+                      vector::VectorTransposeLowering::Shuffle1D));
+    if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createTcpLowerTransposeOpsPass() {
+  return std::make_unique<TcpLowerTransposeOpsPass>();
+}
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTcpLowerTransposeOpsPass(unsigned vectorWidth, unsigned numThreads) {
+  return std::make_unique<TcpLowerTransposeOpsPass>(vectorWidth, numThreads);
+}
+
+} // namespace mlir::tcp
@@ -0,0 +1,230 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/PackMatmulOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+#include "./TilingUtils.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Tensor/Transforms/Transforms.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/Dialect/Vector/Transforms/LoweringPatterns.h"
+#include "mlir/Dialect/Vector/Transforms/VectorRewritePatterns.h"
+#include "mlir/Dialect/Vector/Transforms/VectorTransforms.h"
+#include "mlir/Interfaces/TilingInterface.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+// Order of the packed m, n and k dims. Placing k before n makes the rhs
+// panels `tile-k x nr` with n contiguous, so that each step of the
+// micro-kernel loads full vectors of rhs.
+constexpr int64_t kMnkOrder[] = {0, 2, 1};
+
+// Returns the number of columns of the rhs panels: two vector registers of
+// the element type of `op`.
+int64_t getTileN(linalg::LinalgOp op, unsigned vectorWidth) {
+  return 2 * getNumLanes(op, vectorWidth);
+}
+
+// Returns true if `op` is a statically shaped contraction of integers or
+// floats. Besides the named matmuls, this includes the contractions that are
+// generated for convolutions by `tcp-lower-conv-ops`.
+bool isPackableContraction(linalg::LinalgOp op) {
+  if (!linalg::isaContractionOpInterface(op) || !op.hasPureTensorSemantics())
+    return false;
+  if (!getElementTypeOrSelf(op.getDpsInitOperand(0)->get().getType())
+           .isIntOrFloat())
+    return false;
+  if (ShapedType::isDynamicShape(op.getStaticLoopRanges()))
+    return false;
+  FailureOr<linalg::ContractionDimensions> dims =
+      linalg::inferContractionDims(op);
+  return succeeded(dims) && !dims->m.empty() && !dims->n.empty() &&
+         !dims->k.empty();
+}
+
+// Returns true if the packable contraction `op` covers at least one
+// micro-kernel. Smaller contractions would mostly compute on padding.
+bool isPackingCandidate(linalg::LinalgOp op, ArrayRef<int64_t> mnkTileSizes) {
+  SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+  linalg::ContractionDimensions dims = *linalg::inferContractionDims(op);
+  // Only the innermost m, n and k dims are packed.
+  int64_t mnkRanges[] = {ranges[dims.m.back()], ranges[dims.n.back()],
+                         ranges[dims.k.back()]};
+  for (auto [range, tileSize] : llvm::zip_equal(mnkRanges, mnkTileSizes)) {
+    if (range < tileSize)
+      return false;
+  }
+  return true;
+}
+
+// Tiles the outer loops of the packed `op` by 1, which leaves a single
+// micro-kernel over the inner, packed loops. With multiple threads, the
+// outermost parallel loop is distributed over an `scf.forall`.
+FailureOr<linalg::LinalgOp> tileToMicroKernel(RewriterBase &rewriter,
+                                              linalg::LinalgOp op,
+                                              int64_t numPackedLoops,
+                                              unsigned numThreads) {
+  int64_t numOuterLoops = op.getNumLoops() - numPackedLoops;
+  SmallVector<utils::IteratorType> iteratorTypes = op.getIteratorTypesArray();
+  auto kernel = cast<TilingInterface>(op.getOperation());
+
+  SmallVector<int64_t> tileSizes(op.getNumLoops(), 0);
+  std::optional<int64_t> distributedLoop;
+  if (numThreads > 1) {
+    for (int64_t i = 0; i < numOuterLoops; ++i) {
+      if (iteratorTypes[i] == utils::IteratorType::parallel) {
+        distributedLoop = i;
+        break;
+      }
+    }
+  }
+  if (distributedLoop) {
+    tileSizes[*distributedLoop] = 1;
+    FailureOr<TilingInterface> tiled =
+        tile(rewriter, kernel, tileSizes,
+             scf::SCFTilingOptions::LoopType::ForallOp);
+    if (failed(tiled))
+      return failure();
+    kernel = *tiled;
+  }
+
+  for (int64_t i = 0; i < numOuterLoops; ++i)
+    tileSizes[i] = distributedLoop == i ? 0 : 1;
+  FailureOr<TilingInterface> tiled = tile(
+      rewriter, kernel, tileSizes, scf::SCFTilingOptions::LoopType::ForOp);
+  if (failed(tiled))
+    return failure();
+  return cast<linalg::LinalgOp>(tiled->getOperation());
+}
+
+class TcpPackMatmulOpsPass
+    : public TcpPackMatmulOpsBase<TcpPackMatmulOpsPass> {
+public:
+  TcpPackMatmulOpsPass() = default;
+  TcpPackMatmulOpsPass(unsigned vectorWidth, unsigned numThreads) {
+    this->vectorWidth = vectorWidth;
+    this->numThreads = numThreads;
+  }
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<affine::AffineDialect, arith::ArithDialect,
+                    linalg::LinalgDialect, scf::SCFDialect,
+                    tensor::TensorDialect, vector::VectorDialect>();
+  }
+
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    MLIRContext *context = &getContext();
+    IRRewriter rewriter(context);
+
+    SmallVector<std::pair<linalg::LinalgOp, SmallVector<int64_t>>> candidates;
+    funcOp.walk([&](linalg::LinalgOp op) {
+      if (!isPackableContraction(op))
+        return;
+      SmallVector<int64_t> mnkTileSizes = {tileM, getTileN(op, vectorWidth),
+                                           tileK};
+      if (isPackingCandidate(op, mnkTileSizes))
+        candidates.emplace_back(op, std::move(mnkTileSizes));
+    });
+    if (candidates.empty())
+      return;
+
+    // Pack the operands into panels and tile the packed contraction down to
+    // one micro-kernel per pair of panels.
+    SmallVector<tensor::PackOp> packOps;
+    SmallVector<tensor::UnPackOp> unPackOps;
+    SmallVector<linalg::LinalgOp> kernels;
+    for (auto &[op, mnkTileSizes] : candidates) {
+      rewriter.setInsertionPoint(op);
+      FailureOr<linalg::PackResult> packed = linalg::packMatmulGreedily(
+          rewriter, op, getAsIndexOpFoldResult(context, mnkTileSizes),
+          /*mnkPaddedSizesNextMultipleOf=*/{}, kMnkOrder);
+      if (failed(packed))
+        continue;
+      llvm::append_range(packOps, packed->packOps);
+      llvm::append_range(unPackOps, packed->unPackOps);
+
+      FailureOr<linalg::LinalgOp> kernel = tileToMicroKernel(
+          rewriter, packed->packedLinalgOp, mnkTileSizes.size(), numThreads);
+      // Packed contractions that cannot be tiled are lowered to loops.
+      if (succeeded(kernel))
+        kernels.push_back(*kernel);
+    }
+
+    for (linalg::LinalgOp kernel : kernels) {
+      if (failed(linalg::vectorizeOpPrecondition(kernel)))
+        continue;
+      rewriter.setInsertionPoint(kernel);
+      (void)linalg::vectorize(rewriter, kernel);
+    }
+
+    // Materialize the panels with pads and transposes, which are vectorized
+    // along with the other elementwise ops.
+    for (tensor::PackOp packOp : packOps) {
+      rewriter.setInsertionPoint(packOp);
+      (void)linalg::lowerPack(rewriter, packOp);
+    }
+    for (tensor::UnPackOp unPackOp : unPackOps) {
+      rewriter.setInsertionPoint(unPackOp);
+      (void)linalg::lowerUnPack(rewriter, unPackOp);
+    }
+
+    // Fold the panel slices into the vector transfers and turn the vectorized
+    // kernels into contractions without unit dims.
+    {
+      RewritePatternSet patterns(context);
+      linalg::populateLinalgTilingCanonicalizationPatterns(patterns);
+      tensor::populateFoldTensorSubsetIntoVectorTransferPatterns(patterns);
+      vector::populateVectorReductionToContractPatterns(patterns);
+      vector::populateCastAwayVectorLeadingOneDimPatterns(patterns);
+      vector::populateVectorTransferPermutationMapLoweringPatterns(patterns);
+      vector::TransferReadOp::getCanonicalizationPatterns(patterns, context);
+      vector::TransferWriteOp::getCanonicalizationPatterns(patterns, context);
+      if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns))))
+        return signalPassFailure();
+    }
+
+    // Unroll the contractions into a sequence of `tile-m x nr` outer
+    // products, which accumulate in registers.
+    RewritePatternSet patterns(context);
+    vector::populateVectorContractLoweringPatterns(
+        patterns, vector::VectorTransformsOptions().setVectorTransformsOptions(
+                      vector::VectorContractLowering::OuterProduct));
+    if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns))))
+      return signalPassFailure();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createTcpPackMatmulOpsPass() {
+  return std::make_unique<TcpPackMatmulOpsPass>();
+}
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTcpPackMatmulOpsPass(unsigned vectorWidth, unsigned numThreads) {
+  return std::make_unique<TcpPackMatmulOpsPass>(vectorWidth, numThreads);
+}
+
+} // namespace mlir::tcp
@@ -0,0 +1,131 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/ParallelizeLinalgOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Interfaces/TilingInterface.h"
+#include "mlir/Pass/Pass.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+// Ops with a static iteration space smaller than this are not worth the
+// overhead of dispatching them to multiple threads.
+constexpr int64_t kMinParallelIterations = 4096;
+
+// Returns the loop to distribute over the threads: the outermost parallel
+// loop that does not have a unit trip count.
+std::optional<unsigned> getDistributedLoop(linalg::LinalgOp op) {
+  SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+  SmallVector<utils::IteratorType> iteratorTypes =
+      op.getIteratorTypesArray();
+  for (unsigned i = 0; i < ranges.size(); ++i) {
+    if (iteratorTypes[i] == utils::IteratorType::parallel && ranges[i] != 1)
+      return i;
+  }
+  return std::nullopt;
+}
+
+bool isWorthParallelizing(linalg::LinalgOp op) {
+  SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+  if (ShapedType::isDynamicShape(ranges))
+    return true;
+  return ShapedType::getNumElements(ranges) >= kMinParallelIterations;
+}
+
+// Tiles `loop` of `op` into an `scf.forall` with `numThreads` iterations. The
+// tile size is at least one, so that the loop step is valid when a dynamic
+// dim is empty.
+LogicalResult distributeOverThreads(RewriterBase &rewriter,
+                                    linalg::LinalgOp op, unsigned loop,
+                                    unsigned numThreads) {
+  Location loc = op.getLoc();
+  rewriter.setInsertionPoint(op);
+  SmallVector<Range> loopRanges = op.createLoopRanges(rewriter, loc);
+  AffineExpr s0 = rewriter.getAffineSymbolExpr(0);
+
+  SmallVector<OpFoldResult> tileSizes(op.getNumLoops(),
+                                      rewriter.getIndexAttr(0));
+  AffineMap tileSizeMap = AffineMap::get(
+      /*dimCount=*/0, /*symbolCount=*/1,
+      {s0.ceilDiv(numThreads), rewriter.getAffineConstantExpr(1)},
+      rewriter.getContext());
+  tileSizes[loop] = affine::makeComposedFoldedAffineMax(
+      rewriter, loc, tileSizeMap, {loopRanges[loop].size});
+
+  scf::SCFTilingOptions options;
+  options.setLoopType(scf::SCFTilingOptions::LoopType::ForallOp);
+  options.setTileSizes(tileSizes);
+  FailureOr<scf::SCFTilingResult> tiled = scf::tileUsingSCF(
+      rewriter, cast<TilingInterface>(op.getOperation()), options);
+  if (failed(tiled))
+    return failure();
+  rewriter.replaceOp(op, tiled->replacements);
+  return success();
+}
+
+class TcpParallelizeLinalgOpsPass
+    : public TcpParallelizeLinalgOpsBase<TcpParallelizeLinalgOpsPass> {
+public:
+  TcpParallelizeLinalgOpsPass() = default;
+  TcpParallelizeLinalgOpsPass(unsigned numThreads) {
+    this->numThreads = numThreads;
+  }
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<affine::AffineDialect, arith::ArithDialect,
+                    scf::SCFDialect, tensor::TensorDialect>();
+  }
+
+  void runOnOperation() override {
+    if (numThreads < 2)
+      return;
+
+    SmallVector<linalg::LinalgOp> candidates;
+    getOperation().walk([&](linalg::LinalgOp op) {
+      if (op.hasPureTensorSemantics() && isWorthParallelizing(op) &&
+          !op->getParentOfType<scf::ForallOp>())
+        candidates.push_back(op);
+    });
+
+    IRRewriter rewriter(&getContext());
+    for (linalg::LinalgOp op : candidates) {
+      std::optional<unsigned> loop = getDistributedLoop(op);
+      if (!loop)
+        continue;
+      // Ops that cannot be tiled remain single-threaded.
+      (void)distributeOverThreads(rewriter, op, *loop, numThreads);
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTcpParallelizeLinalgOpsPass() {
+  return std::make_unique<TcpParallelizeLinalgOpsPass>();
+}
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTcpParallelizeLinalgOpsPass(unsigned numThreads) {
+  return std::make_unique<TcpParallelizeLinalgOpsPass>(numThreads);
+}
+
+} // namespace mlir::tcp
@@ -8,11 +8,24 @@
 //===----------------------------------------------------------------------===//
 
 #include "mlir-tcp/Dialect/Transforms/Passes.h"
+#include "mlir-tcp/Dialect/Transforms/ConcatInPlacePass.h"
 #include "mlir-tcp/Dialect/Transforms/DropSymbolicShapeOpsPass.h"
 #include "mlir-tcp/Dialect/Transforms/EliminateUnusedTorchOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/EnableFastMathPass.h"
+#include "mlir-tcp/Dialect/Transforms/FuseLinalgElementwiseOpsPass.h"
 #include "mlir-tcp/Dialect/Transforms/FuseTcpOpsPass.h"
 #include "mlir-tcp/Dialect/Transforms/IsolateGroupOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/LowerConvOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/LowerGroupOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/LowerTransposeOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/PackMatmulOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/ParallelizeLinalgOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/PlanMemoryPass.h"
+#include "mlir-tcp/Dialect/Transforms/ReuseInputBuffersPass.h"
+#include "mlir-tcp/Dialect/Transforms/SetTargetFeaturesPass.h"
+#include "mlir-tcp/Dialect/Transforms/SplitReductionsPass.h"
 #include "mlir-tcp/Dialect/Transforms/TransformTensorOps.h"
+#include "mlir-tcp/Dialect/Transforms/VectorizeLinalgOpsPass.h"
 #include "mlir-tcp/Dialect/Transforms/VerifyTcpBackendContractPass.h"
 
 #include "mlir/Pass/Pass.h"
@@ -0,0 +1,181 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/PlanMemoryPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Bufferization/Transforms/BufferViewFlowAnalysis.h"
+#include "mlir/Dialect/MemRef/IR/MemRef.h"
+#include "mlir/IR/Builders.h"
+#include "mlir/Pass/Pass.h"
+
+#include "llvm/Support/MathExtras.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+// An allocation to place in the arena. `start` and `end` are the positions
+// in the entry block of the first and the last op that access the buffer.
+struct PlannedBuffer {
+  memref::AllocOp allocOp;
+  int64_t size;
+  int64_t start;
+  int64_t end;
+  int64_t offset = 0;
+};
+
+// Returns the size of the buffer allocated by `allocOp` in bytes, or
+// std::nullopt if it cannot be placed in the arena.
+std::optional<int64_t> getStaticSizeInBytes(memref::AllocOp allocOp) {
+  MemRefType type = allocOp.getType();
+  if (!type.hasStaticShape() || !type.getLayout().isIdentity() ||
+      type.getMemorySpace())
+    return std::nullopt;
+  // `memref.view` reinterprets bytes, so only byte sized elements can be
+  // addressed in the arena.
+  Type elementType = type.getElementType();
+  if (!elementType.isIntOrFloat() ||
+      elementType.getIntOrFloatBitWidth() % 8 != 0)
+    return std::nullopt;
+  return type.getNumElements() * (elementType.getIntOrFloatBitWidth() / 8);
+}
+
+// Computes the live range of `allocOp`, which is the span of ops in the
+// entry block that access it or any of its aliases. Returns failure if the
+// buffer escapes the function or is already freed explicitly.
+LogicalResult computeLiveRange(PlannedBuffer &buffer, Block &entryBlock,
+                               const DenseMap<Operation *, int64_t> &positions,
+                               BufferViewFlowAnalysis &aliasAnalysis) {
+  buffer.start = positions.lookup(buffer.allocOp);
+  buffer.end = buffer.start;
+  for (Value alias : aliasAnalysis.resolve(buffer.allocOp.getResult())) {
+    for (Operation *user : alias.getUsers()) {
+      if (isa<func::ReturnOp, memref::DeallocOp>(user))
+        return failure();
+      Operation *ancestor = entryBlock.findAncestorOpInBlock(*user);
+      if (!ancestor)
+        return failure();
+      buffer.end = std::max(buffer.end, positions.lookup(ancestor));
+    }
+  }
+  return success();
+}
+
+// Assigns an offset to each buffer, such that buffers whose live ranges
+// overlap do not share memory. Larger buffers are placed first, each at the
+// lowest offset that does not conflict with the buffers placed before it.
+// Returns the size of the arena.
+int64_t assignOffsets(MutableArrayRef<PlannedBuffer> buffers,
+                      int64_t alignment) {
+  llvm::stable_sort(buffers, [](const PlannedBuffer &a,
+                                const PlannedBuffer &b) {
+    return a.size > b.size;
+  });
+
+  int64_t arenaSize = 0;
+  for (auto [i, buffer] : llvm::enumerate(buffers)) {
+    SmallVector<const PlannedBuffer *> conflicts;
+    for (const PlannedBuffer &placed : buffers.take_front(i)) {
+      if (placed.start <= buffer.end && buffer.start <= placed.end)
+        conflicts.push_back(&placed);
+    }
+    llvm::sort(conflicts, [](const PlannedBuffer *a, const PlannedBuffer *b) {
+      return a->offset < b->offset;
+    });
+
+    int64_t offset = 0;
+    for (const PlannedBuffer *placed : conflicts) {
+      if (offset + buffer.size <= placed->offset)
+        break;
+      offset = std::max<int64_t>(
+          offset, llvm::alignTo(placed->offset + placed->size, alignment));
+    }
+    buffer.offset = offset;
+    arenaSize = std::max(arenaSize, offset + buffer.size);
+  }
+  return arenaSize;
+}
+
+class TcpPlanMemoryPass : public TcpPlanMemoryBase<TcpPlanMemoryPass> {
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<arith::ArithDialect, memref::MemRefDialect>();
+  }
+
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    if (funcOp.isExternal())
+      return;
+    Block &entryBlock = funcOp.getBody().front();
+
+    DenseMap<Operation *, int64_t> positions;
+    for (auto [i, op] : llvm::enumerate(entryBlock))
+      positions[&op] = i;
+
+    // Allocations nested in loops are live once per iteration, so only the
+    // ones in the entry block are planned.
+    BufferViewFlowAnalysis aliasAnalysis(funcOp);
+    SmallVector<PlannedBuffer> buffers;
+    int64_t maxAlignment = alignment;
+    for (auto allocOp : entryBlock.getOps<memref::AllocOp>()) {
+      std::optional<int64_t> size = getStaticSizeInBytes(allocOp);
+      if (!size)
+        continue;
+      PlannedBuffer buffer{allocOp, *size, 0, 0};
+      if (failed(computeLiveRange(buffer, entryBlock, positions,
+                                  aliasAnalysis)))
+        continue;
+      if (std::optional<uint64_t> allocAlignment = allocOp.getAlignment())
+        maxAlignment = std::max<int64_t>(maxAlignment, *allocAlignment);
+      buffers.push_back(buffer);
+    }
+    if (buffers.empty())
+      return;
+
+    int64_t arenaSize = assignOffsets(buffers, maxAlignment);
+
+    // Allocate the arena once at function entry and carve the buffers out of
+    // it.
+    OpBuilder b = OpBuilder::atBlockBegin(&entryBlock);
+    Location loc = funcOp.getLoc();
+    auto arenaType = MemRefType::get({arenaSize}, b.getI8Type());
+    Value arena = b.create<memref::AllocOp>(
+        loc, arenaType, b.getI64IntegerAttr(maxAlignment));
+    for (PlannedBuffer &buffer : buffers) {
+      b.setInsertionPoint(buffer.allocOp);
+      Value offset =
+          b.create<arith::ConstantIndexOp>(buffer.allocOp.getLoc(),
+                                           buffer.offset);
+      Value view = b.create<memref::ViewOp>(
+          buffer.allocOp.getLoc(), buffer.allocOp.getType(), arena, offset,
+          /*sizes=*/ValueRange{});
+      buffer.allocOp.replaceAllUsesWith(view);
+      buffer.allocOp.erase();
+    }
+
+    funcOp->setAttr("tcp.planned_arena_bytes",
+                    b.getI64IntegerAttr(arenaSize));
+    if (emitRemarks)
+      funcOp.emitRemark() << "planned " << buffers.size()
+                          << " buffers in an arena of " << arenaSize
+                          << " bytes";
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createTcpPlanMemoryPass() {
+  return std::make_unique<TcpPlanMemoryPass>();
+}
+
+} // namespace mlir::tcp
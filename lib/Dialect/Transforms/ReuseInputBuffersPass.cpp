@@ -0,0 +1,111 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/ReuseInputBuffersPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "mlir-tcp/Dialect/IR/TcpDialect.h"
+
+#include "./PassDetail.h"
+
+#include "mlir/Dialect/Bufferization/IR/Bufferization.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Pass/Pass.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+bool isDonatedArgument(Value value) {
+  auto blockArg = dyn_cast<BlockArgument>(value);
+  if (!blockArg)
+    return false;
+  auto funcOp = dyn_cast<func::FuncOp>(blockArg.getOwner()->getParentOp());
+  return funcOp && blockArg.getOwner()->isEntryBlock() &&
+         funcOp.getArgAttr(blockArg.getArgNumber(),
+                           TcpDialect::getDonatedAttrName());
+}
+
+// Returns true if the buffer of `input` may be overwritten by `op`: its data
+// is not read by any other op, and it is either a donated argument or an
+// intermediate result. Ops that only read the shape of `input`, such as the
+// `tensor.dim` that sizes the result of `op`, do not prevent the reuse.
+bool isReusable(Value input, linalg::GenericOp op) {
+  if (llvm::any_of(input.getUsers(), [&](Operation *user) {
+        return user != op && !isa<tensor::DimOp>(user);
+      }))
+    return false;
+  if (isDonatedArgument(input))
+    return true;
+  // The results of linalg ops live in their own buffers, unlike e.g. slices
+  // of arguments or constants.
+  return input.getDefiningOp<linalg::LinalgOp>() != nullptr;
+}
+
+// Makes `op` write its result into the buffer of one of its inputs, if it
+// would otherwise write into a new buffer. Returns true on success.
+bool reuseInputBuffer(linalg::GenericOp op) {
+  if (op.getNumDpsInits() != 1 ||
+      op.getNumLoops() != op.getNumParallelLoops())
+    return false;
+  OpOperand *init = op.getDpsInitOperand(0);
+  if (!init->get().getDefiningOp<tensor::EmptyOp>() ||
+      op.payloadUsesValueFromOperand(init))
+    return false;
+  // Writing into a donated buffer only pays off if the result does not
+  // escape, since returned buffers that alias arguments are copied.
+  if (llvm::any_of(op->getUsers(), [](Operation *user) {
+        return isa<func::ReturnOp>(user);
+      }))
+    return false;
+
+  AffineMap initMap = op.getMatchingIndexingMap(init);
+  for (OpOperand *input : op.getDpsInputOperands()) {
+    // Each element is read before the same element of the result is
+    // written, so the input can be overwritten in place.
+    if (input->get().getType() != init->get().getType() ||
+        op.getMatchingIndexingMap(input) != initMap ||
+        !isReusable(input->get(), op))
+      continue;
+    init->set(input->get());
+    return true;
+  }
+  return false;
+}
+
+class TcpReuseInputBuffersPass
+    : public TcpReuseInputBuffersBase<TcpReuseInputBuffersPass> {
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<bufferization::BufferizationDialect>();
+  }
+
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+
+    // Donated arguments may be written to by one-shot bufferization.
+    for (unsigned i = 0; i < funcOp.getNumArguments(); ++i) {
+      if (funcOp.getArgAttr(i, TcpDialect::getDonatedAttrName()))
+        funcOp.setArgAttr(
+            i, bufferization::BufferizationDialect::kWritableAttrName,
+            BoolAttr::get(&getContext(), true));
+    }
+
+    funcOp.walk([](linalg::GenericOp op) { (void)reuseInputBuffer(op); });
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createTcpReuseInputBuffersPass() {
+  return std::make_unique<TcpReuseInputBuffersPass>();
+}
+
+} // namespace mlir::tcp
@@ -0,0 +1,55 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/SetTargetFeaturesPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+
+#include "mlir/Dialect/LLVMIR/LLVMDialect.h"
+#include "mlir/Pass/Pass.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+class TcpSetTargetFeaturesPass
+    : public TcpSetTargetFeaturesBase<TcpSetTargetFeaturesPass> {
+public:
+  TcpSetTargetFeaturesPass() = default;
+  TcpSetTargetFeaturesPass(StringRef targetFeatures) {
+    this->targetFeatures = targetFeatures.str();
+  }
+
+  void runOnOperation() override {
+    if (targetFeatures.empty())
+      return;
+    auto featuresAttr =
+        LLVM::TargetFeaturesAttr::get(&getContext(), targetFeatures);
+    // Declarations, e.g. of runtime functions, are compiled elsewhere.
+    getOperation().walk([&](LLVM::LLVMFuncOp funcOp) {
+      if (!funcOp.isExternal())
+        funcOp.setTargetFeaturesAttr(featuresAttr);
+    });
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<ModuleOp>> createTcpSetTargetFeaturesPass() {
+  return std::make_unique<TcpSetTargetFeaturesPass>();
+}
+
+std::unique_ptr<OperationPass<ModuleOp>>
+createTcpSetTargetFeaturesPass(StringRef targetFeatures) {
+  return std::make_unique<TcpSetTargetFeaturesPass>(targetFeatures);
+}
+
+} // namespace mlir::tcp
@@ -0,0 +1,212 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/SplitReductionsPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+#include "./TilingUtils.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/IR/LinalgInterfaces.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Interfaces/TilingInterface.h"
+#include "mlir/Pass/Pass.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+// Splitting a reduction over the threads only pays off if every thread
+// reduces at least this many elements.
+constexpr int64_t kMinElementsPerThread = 1024;
+
+// Returns the reduction loop of `op` if it is a statically shaped reduction
+// along a single loop into a single result. Contractions are left to
+// `tcp-pack-matmul-ops`.
+std::optional<unsigned> getReductionLoop(linalg::LinalgOp op) {
+  if (!op.hasPureTensorSemantics() || op.getNumDpsInits() != 1 ||
+      op.getNumReductionLoops() != 1 || linalg::isaContractionOpInterface(op))
+    return std::nullopt;
+  if (ShapedType::isDynamicShape(op.getStaticLoopRanges()))
+    return std::nullopt;
+  SmallVector<unsigned> reductionDims;
+  op.getReductionDims(reductionDims);
+  return reductionDims.front();
+}
+
+// Returns true if splitting `op` changes its result, because it reassociates
+// a floating point reduction. Min and max reductions are exact in any order.
+bool reassociatesFloats(linalg::LinalgOp op) {
+  Type elementType =
+      getElementTypeOrSelf(op.getDpsInitOperand(0)->get().getType());
+  if (!isa<FloatType>(elementType))
+    return false;
+  Value combined = op.getBlock()->getTerminator()->getOperand(0);
+  Operation *combiner = combined.getDefiningOp();
+  return !combiner ||
+         !isa<arith::MaximumFOp, arith::MinimumFOp, arith::MaxNumFOp,
+              arith::MinNumFOp>(combiner);
+}
+
+// Splits `loop` of `op` into an outer parallel loop with one iteration per
+// thread and an inner reduction loop. Only done if the parallel loops of
+// `op` cannot keep all threads busy on their own. Returns the op that
+// computes the partial results.
+FailureOr<linalg::LinalgOp> splitOverThreads(RewriterBase &rewriter,
+                                             linalg::LinalgOp op,
+                                             unsigned loop,
+                                             unsigned numThreads) {
+  SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+  int64_t numParallelIterations = 1;
+  for (auto [i, range] : llvm::enumerate(ranges)) {
+    if (i != loop)
+      numParallelIterations *= range;
+  }
+  if (numParallelIterations >= static_cast<int64_t>(numThreads))
+    return failure();
+
+  int64_t ratio = numThreads;
+  while (ratio > 1 && (ranges[loop] % ratio != 0 ||
+                       ranges[loop] / ratio < kMinElementsPerThread))
+    --ratio;
+  if (ratio < 2)
+    return failure();
+
+  rewriter.setInsertionPoint(op);
+  FailureOr<linalg::SplitReductionResult> split = linalg::splitReduction(
+      rewriter, op, [&](linalg::LinalgOp) {
+        return linalg::SplitReductionOptions{ratio, /*index=*/0,
+                                             /*innerParallel=*/false};
+      });
+  if (failed(split))
+    return failure();
+  return split->splitLinalgOp;
+}
+
+// Splits the innermost `loop` of `op` into an outer reduction loop and an
+// inner parallel loop of one vector. The partial results are then kept in
+// vector registers, and combined with a single horizontal reduction at the
+// end. Returns the op that computes the partial results.
+FailureOr<linalg::LinalgOp> splitOverLanes(RewriterBase &rewriter,
+                                           linalg::LinalgOp op, unsigned loop,
+                                           unsigned vectorWidth) {
+  if (loop != op.getNumLoops() - 1)
+    return failure();
+  int64_t numLanes = getNumLanes(op, vectorWidth);
+  int64_t range = op.getStaticLoopRanges()[loop];
+  if (numLanes < 2 || range % numLanes != 0 || range / numLanes < 2)
+    return failure();
+
+  // The lanes become the innermost dim of the partial results.
+  unsigned index = op.getRank(op.getDpsInitOperand(0));
+  rewriter.setInsertionPoint(op);
+  FailureOr<linalg::SplitReductionResult> split = linalg::splitReduction(
+      rewriter, op, [&](linalg::LinalgOp) {
+        return linalg::SplitReductionOptions{numLanes, index,
+                                             /*innerParallel=*/true};
+      });
+  if (failed(split))
+    return failure();
+  return split->splitLinalgOp;
+}
+
+// Distributes `loop` of `op` over an `scf.forall` with one iteration each.
+LogicalResult distributeOverThreads(RewriterBase &rewriter,
+                                    linalg::LinalgOp op, unsigned loop) {
+  SmallVector<OpFoldResult> tileSizes(op.getNumLoops(),
+                                      rewriter.getIndexAttr(0));
+  tileSizes[loop] = rewriter.getIndexAttr(1);
+
+  scf::SCFTilingOptions options;
+  options.setLoopType(scf::SCFTilingOptions::LoopType::ForallOp);
+  options.setTileSizes(tileSizes);
+  rewriter.setInsertionPoint(op);
+  FailureOr<scf::SCFTilingResult> tiled = scf::tileUsingSCF(
+      rewriter, cast<TilingInterface>(op.getOperation()), options);
+  if (failed(tiled))
+    return failure();
+  rewriter.replaceOp(op, tiled->replacements);
+  return success();
+}
+
+class TcpSplitReductionsPass
+    : public TcpSplitReductionsBase<TcpSplitReductionsPass> {
+public:
+  TcpSplitReductionsPass() = default;
+  TcpSplitReductionsPass(unsigned vectorWidth, unsigned numThreads,
+                         bool reassociateFP) {
+    this->vectorWidth = vectorWidth;
+    this->numThreads = numThreads;
+    this->reassociateFP = reassociateFP;
+  }
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<affine::AffineDialect, arith::ArithDialect,
+                    linalg::LinalgDialect, scf::SCFDialect,
+                    tensor::TensorDialect>();
+  }
+
+  void runOnOperation() override {
+    SmallVector<linalg::LinalgOp> candidates;
+    getOperation().walk([&](linalg::LinalgOp op) {
+      if (getReductionLoop(op) && !op->getParentOfType<scf::ForallOp>() &&
+          (reassociateFP || !reassociatesFloats(op)))
+        candidates.push_back(op);
+    });
+
+    IRRewriter rewriter(&getContext());
+    for (linalg::LinalgOp op : candidates) {
+      unsigned loop = *getReductionLoop(op);
+
+      // The thread split inserts the parallel loop in front of the
+      // reduction loop.
+      std::optional<unsigned> threadLoop;
+      if (numThreads > 1) {
+        FailureOr<linalg::LinalgOp> split =
+            splitOverThreads(rewriter, op, loop, numThreads);
+        if (succeeded(split)) {
+          op = *split;
+          threadLoop = loop++;
+        }
+      }
+
+      if (vectorWidth > 0) {
+        FailureOr<linalg::LinalgOp> split =
+            splitOverLanes(rewriter, op, loop, vectorWidth);
+        if (succeeded(split))
+          op = *split;
+      }
+
+      if (threadLoop)
+        (void)distributeOverThreads(rewriter, op, *threadLoop);
+    }
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createTcpSplitReductionsPass() {
+  return std::make_unique<TcpSplitReductionsPass>();
+}
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTcpSplitReductionsPass(unsigned vectorWidth, unsigned numThreads,
+                             bool reassociateFP) {
+  return std::make_unique<TcpSplitReductionsPass>(vectorWidth, numThreads,
+                                                  reassociateFP);
+}
+
+} // namespace mlir::tcp
@@ -0,0 +1,50 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "./TilingUtils.h"
+
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+
+namespace mlir::tcp {
+
+int64_t getNumLanes(linalg::LinalgOp op, unsigned vectorWidth) {
+  unsigned maxBitWidth = 8;
+  for (Value operand : op->getOperands()) {
+    Type elementType = getElementTypeOrSelf(operand.getType());
+    if (elementType.isIntOrFloat())
+      maxBitWidth = std::max(maxBitWidth, elementType.getIntOrFloatBitWidth());
+  }
+  return std::max<int64_t>(1, vectorWidth / maxBitWidth);
+}
+
+int64_t getTileSize(int64_t size, int64_t maxTileSize) {
+  for (int64_t tileSize = std::min(size, maxTileSize); tileSize > 1;
+       --tileSize) {
+    if (size % tileSize == 0)
+      return tileSize;
+  }
+  return 1;
+}
+
+FailureOr<TilingInterface> tile(RewriterBase &rewriter, TilingInterface op,
+                                ArrayRef<int64_t> tileSizes,
+                                scf::SCFTilingOptions::LoopType loopType) {
+  scf::SCFTilingOptions options;
+  options.setLoopType(loopType);
+  options.setTileSizes(getAsIndexOpFoldResult(op->getContext(), tileSizes));
+  rewriter.setInsertionPoint(op);
+  FailureOr<scf::SCFTilingResult> tiled =
+      scf::tileUsingSCF(rewriter, op, options);
+  if (failed(tiled))
+    return failure();
+  rewriter.replaceOp(op, tiled->replacements);
+  return cast<TilingInterface>(tiled->tiledOps.front());
+}
+
+} // namespace mlir::tcp
@@ -0,0 +1,33 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Interfaces/TilingInterface.h"
+
+namespace mlir::tcp {
+
+// Returns the number of vector lanes that fit in `vectorWidth` bits for the
+// widest element type accessed by `op`.
+int64_t getNumLanes(linalg::LinalgOp op, unsigned vectorWidth);
+
+// Returns the largest divisor of `size` that is at most `maxTileSize`, so
+// that all tiles of a loop have the same static size.
+int64_t getTileSize(int64_t size, int64_t maxTileSize);
+
+// Tiles `op` with `tileSizes` into loops of `loopType` and returns the tiled
+// op.
+FailureOr<TilingInterface> tile(RewriterBase &rewriter, TilingInterface op,
+                                ArrayRef<int64_t> tileSizes,
+                                scf::SCFTilingOptions::LoopType loopType);
+
+} // namespace mlir::tcp
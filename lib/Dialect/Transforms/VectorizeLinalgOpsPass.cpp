@@ -0,0 +1,193 @@
+//===------------------------------------------------------------*- C++ -*-===//
+//
+// Licensed under the Apache License v2.0 with LLVM Exceptions.
+// See https://llvm.org/LICENSE.txt for license information.
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// Also available under a BSD-style license. See LICENSE.
+//
+//===----------------------------------------------------------------------===//
+
+#include "mlir-tcp/Dialect/Transforms/VectorizeLinalgOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/Passes.h"
+
+#include "./PassDetail.h"
+#include "./TilingUtils.h"
+
+#include "mlir/Dialect/Affine/IR/AffineOps.h"
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/SCF/Transforms/TileUsingInterface.h"
+#include "mlir/Dialect/SCF/Transforms/Transforms.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/Dialect/Tensor/Transforms/Transforms.h"
+#include "mlir/Dialect/Vector/IR/VectorOps.h"
+#include "mlir/Dialect/Vector/Transforms/LoweringPatterns.h"
+#include "mlir/Dialect/Vector/Transforms/VectorRewritePatterns.h"
+#include "mlir/Interfaces/TilingInterface.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "mlir/Transforms/LoopInvariantCodeMotionUtils.h"
+
+using namespace mlir;
+
+namespace mlir::tcp {
+namespace {
+
+// Ops are vectorized along their innermost loop. If that loop is a
+// reduction, it must fit in a single vector, which is then reduced
+// horizontally. Larger reductions are first split by `tcp-split-reductions`.
+bool isVectorizationCandidate(linalg::LinalgOp op, int64_t numLanes) {
+  if (!op.hasPureTensorSemantics() || op.getNumLoops() == 0)
+    return false;
+  SmallVector<utils::IteratorType> iteratorTypes = op.getIteratorTypesArray();
+  if (iteratorTypes.back() == utils::IteratorType::parallel)
+    return true;
+  int64_t innermostRange = op.getStaticLoopRanges().back();
+  return !ShapedType::isDynamic(innermostRange) && innermostRange <= numLanes;
+}
+
+// Returns true if `op` covers a single vector: all loops but the innermost
+// one have a unit trip count and the innermost one fits in `numLanes`.
+bool isVectorTile(linalg::LinalgOp op, int64_t numLanes) {
+  SmallVector<int64_t> ranges = op.getStaticLoopRanges();
+  if (ranges.empty() || ShapedType::isDynamicShape(ranges))
+    return false;
+  return llvm::all_of(ArrayRef<int64_t>(ranges).drop_back(),
+                      [](int64_t range) { return range == 1; }) &&
+         ranges.back() <= numLanes;
+}
+
+// Tiles the innermost loop of `op` by `numLanes` and all outer loops by 1.
+// The innermost loop is then peeled, so that every iteration but the last one
+// operates on a full, statically shaped vector tile.
+LogicalResult tileToVectorSize(RewriterBase &rewriter, linalg::LinalgOp op,
+                               int64_t numLanes) {
+  SmallVector<OpFoldResult> tileSizes(op.getNumLoops(),
+                                      rewriter.getIndexAttr(1));
+  tileSizes.back() = rewriter.getIndexAttr(numLanes);
+
+  scf::SCFTilingOptions options;
+  options.setTileSizes(tileSizes);
+  rewriter.setInsertionPoint(op);
+  FailureOr<scf::SCFTilingResult> tiled = scf::tileUsingSCF(
+      rewriter, cast<TilingInterface>(op.getOperation()), options);
+  if (failed(tiled))
+    return failure();
+  rewriter.replaceOp(op, tiled->replacements);
+
+  if (tiled->loops.empty())
+    return success();
+  if (auto forOp = dyn_cast<scf::ForOp>(tiled->loops.back().getOperation())) {
+    scf::ForOp partialIteration;
+    // Peeling fails when the trip count is a multiple of the tile size, in
+    // which case every iteration is already a full tile.
+    (void)scf::peelForLoopAndSimplifyBounds(rewriter, forOp,
+                                            partialIteration);
+  }
+  return success();
+}
+
+class TcpVectorizeLinalgOpsPass
+    : public TcpVectorizeLinalgOpsBase<TcpVectorizeLinalgOpsPass> {
+public:
+  TcpVectorizeLinalgOpsPass() = default;
+  TcpVectorizeLinalgOpsPass(unsigned vectorWidth) {
+    this->vectorWidth = vectorWidth;
+  }
+
+  void getDependentDialects(DialectRegistry &registry) const override {
+    registry.insert<affine::AffineDialect, arith::ArithDialect,
+                    scf::SCFDialect, tensor::TensorDialect,
+                    vector::VectorDialect>();
+  }
+
+  void runOnOperation() override {
+    func::FuncOp funcOp = getOperation();
+    MLIRContext *context = &getContext();
+    IRRewriter rewriter(context);
+
+    // Split every candidate into vector sized tiles.
+    SmallVector<linalg::LinalgOp> candidates;
+    funcOp.walk([&](linalg::LinalgOp op) {
+      int64_t numLanes = getNumLanes(op, vectorWidth);
+      if (isVectorizationCandidate(op, numLanes) &&
+          !isVectorTile(op, numLanes))
+        candidates.push_back(op);
+    });
+    for (linalg::LinalgOp op : candidates) {
+      // Ops that cannot be tiled are left to the scalar lowering.
+      (void)tileToVectorSize(rewriter, op, getNumLanes(op, vectorWidth));
+    }
+
+    // Fold the bounds of the full tiles, so that they become statically
+    // shaped. Tiles of padded inputs pad their slice of the input instead,
+    // so that the padded input is never materialized.
+    {
+      RewritePatternSet patterns(context);
+      linalg::populateLinalgTilingCanonicalizationPatterns(patterns);
+      patterns.add<linalg::ExtractSliceOfPadTensorSwapPattern>(context);
+      if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns))))
+        return signalPassFailure();
+    }
+
+    // Vectorize the full tiles. Partial tiles remain linalg ops and are
+    // lowered to scalar loops later on.
+    SmallVector<linalg::LinalgOp> tiles;
+    funcOp.walk([&](linalg::LinalgOp op) {
+      int64_t numLanes = getNumLanes(op, vectorWidth);
+      if (isVectorizationCandidate(op, numLanes) && isVectorTile(op, numLanes))
+        tiles.push_back(op);
+    });
+    for (linalg::LinalgOp op : tiles) {
+      if (failed(linalg::vectorizeOpPrecondition(
+              op, /*inputVectorSizes=*/{}, /*inputScalableVecDims=*/{},
+              /*vectorizeNDExtract=*/true)))
+        continue;
+      rewriter.setInsertionPoint(op);
+      (void)linalg::vectorize(rewriter, op, /*inputVectorSizes=*/{},
+                              /*inputScalableVecDims=*/{},
+                              /*vectorizeNDExtract=*/true);
+    }
+
+    // Fold the tile slices into the vector transfers and drop the unit dims
+    // introduced by tiling. The padding of the tiles becomes the padding
+    // value of masked vector reads. Reductions over unit dims become
+    // elementwise, the others horizontal reductions of a single vector.
+    RewritePatternSet patterns(context);
+    linalg::populateLinalgTilingCanonicalizationPatterns(patterns);
+    linalg::populatePadOpVectorizationPatterns(patterns);
+    tensor::populateFoldTensorSubsetIntoVectorTransferPatterns(patterns);
+    vector::populateCastAwayVectorLeadingOneDimPatterns(patterns);
+    vector::populateVectorTransferPermutationMapLoweringPatterns(patterns);
+    vector::TransferReadOp::getCanonicalizationPatterns(patterns, context);
+    vector::TransferWriteOp::getCanonicalizationPatterns(patterns, context);
+    vector::MultiDimReductionOp::getCanonicalizationPatterns(patterns, context);
+    vector::populateVectorMultiReductionLoweringPatterns(
+        patterns, vector::VectorMultiReductionLowering::InnerReduction);
+    scf::ForOp::getCanonicalizationPatterns(patterns, context);
+    if (failed(applyPatternsAndFoldGreedily(funcOp, std::move(patterns))))
+      return signalPassFailure();
+
+    // Keep the accumulators of vectorized reductions in registers across
+    // the iterations of the reduction loops. Inner loops are hoisted first.
+    SmallVector<scf::ForOp> loops;
+    funcOp.walk([&](scf::ForOp forOp) { loops.push_back(forOp); });
+    for (scf::ForOp forOp : loops)
+      (void)hoistLoopInvariantSubsets(rewriter, forOp);
+  }
+};
+
+} // namespace
+
+std::unique_ptr<OperationPass<func::FuncOp>> createTcpVectorizeLinalgOpsPass() {
+  return std::make_unique<TcpVectorizeLinalgOpsPass>();
+}
+
+std::unique_ptr<OperationPass<func::FuncOp>>
+createTcpVectorizeLinalgOpsPass(unsigned vectorWidth) {
+  return std::make_unique<TcpVectorizeLinalgOpsPass>(vectorWidth);
+}
+
+} // namespace mlir::tcp
@@ -14,13 +14,27 @@
 #include "mlir-tcp/Conversion/TcpToTensor/TcpToTensor.h"
 #include "mlir-tcp/Conversion/TorchToTcp/TorchToTcp.h"
 #include "mlir-tcp/Conversion/TorchToTcp/TorchToTcpCustomOp.h"
+#include "mlir-tcp/Dialect/Transforms/ConcatInPlacePass.h"
 #include "mlir-tcp/Dialect/Transforms/DropSymbolicShapeOpsPass.h"
 #include "mlir-tcp/Dialect/Transforms/EliminateUnusedTorchOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/EnableFastMathPass.h"
+#include "mlir-tcp/Dialect/Transforms/FuseLinalgElementwiseOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/LowerConvOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/LowerGroupOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/LowerTransposeOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/PackMatmulOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/ParallelizeLinalgOpsPass.h"
+#include "mlir-tcp/Dialect/Transforms/PlanMemoryPass.h"
+#include "mlir-tcp/Dialect/Transforms/ReuseInputBuffersPass.h"
+#include "mlir-tcp/Dialect/Transforms/SetTargetFeaturesPass.h"
+#include "mlir-tcp/Dialect/Transforms/SplitReductionsPass.h"
 #include "mlir-tcp/Dialect/Transforms/TransformTensorOps.h"
+#include "mlir-tcp/Dialect/Transforms/VectorizeLinalgOpsPass.h"
 #include "mlir-tcp/Dialect/Transforms/VerifyTcpBackendContractPass.h"
 
 #include "mlir/Conversion/AffineToStandard/AffineToStandard.h"
 #include "mlir/Conversion/ArithToLLVM/ArithToLLVM.h"
+#include "mlir/Conversion/AsyncToLLVM/AsyncToLLVM.h"
 #include "mlir/Conversion/BufferizationToMemRef/BufferizationToMemRef.h"
 #include "mlir/Conversion/ControlFlowToLLVM/ControlFlowToLLVM.h"
 #include "mlir/Conversion/FuncToLLVM/ConvertFuncToLLVMPass.h"
@@ -29,19 +43,25 @@
 #include "mlir/Conversion/MemRefToLLVM/MemRefToLLVM.h"
 #include "mlir/Conversion/ReconcileUnrealizedCasts/ReconcileUnrealizedCasts.h"
 #include "mlir/Conversion/SCFToControlFlow/SCFToControlFlow.h"
+#include "mlir/Conversion/VectorToLLVM/ConvertVectorToLLVMPass.h"
+#include "mlir/Conversion/VectorToSCF/VectorToSCF.h"
 #include "mlir/Dialect/Arith/Transforms/Passes.h"
+#include "mlir/Dialect/Async/Passes.h"
 #include "mlir/Dialect/Bufferization/Transforms/OneShotAnalysis.h"
 #include "mlir/Dialect/Bufferization/Transforms/Passes.h"
 #include "mlir/Dialect/Func/IR/FuncOps.h"
 #include "mlir/Dialect/Func/Transforms/Passes.h"
 #include "mlir/Dialect/Linalg/Passes.h"
 #include "mlir/Dialect/MemRef/Transforms/Passes.h"
+#include "mlir/Dialect/SCF/Transforms/Passes.h"
 #include "mlir/Dialect/Tensor/Transforms/Passes.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Transforms/Passes.h"
 
 #include "torch-mlir/Dialect/TorchConversion/Transforms/Passes.h"
 
+#include <limits>
+
 using namespace mlir;
 
 static void createTorchBackendToTcpBackendPipeline(OpPassManager &pm) {
@@ -70,7 +90,74 @@ static void createTorchBackendToTcpBackendPipeline(OpPassManager &pm) {
   pm.addPass(tcp::createVerifyTcpBackendContractPass());
 }
 
-static void createTcpToLlvmPipeline(OpPassManager &pm) {
+// The number of threads that O3 parallelizes for, unless `num-threads` is
+// set. It is fixed rather than taken from the compiling host, so that the
+// generated code does not depend on the machine it was compiled on.
+static constexpr unsigned kDefaultNumThreads = 8;
+
+// Stack promotion is bounded by `stack-promotion-threshold` alone: buffers
+// of any rank are promoted as long as they are small enough.
+static constexpr unsigned kMaxStackPromotionRank =
+    std::numeric_limits<unsigned>::max();
+
+namespace {
+// The optimizations to run, after resolving the defaults implied by the
+// optimization level against the options that were set explicitly.
+struct PipelineConfig {
+  bool fuseElementwise;
+  bool vectorize;
+  unsigned vectorWidth;
+  std::string targetFeatures;
+  unsigned numThreads;
+  bool fastMath;
+  bool memoryPlanning;
+  unsigned stackPromotionThreshold;
+  bool destinationPassing;
+  SmallVector<int64_t> tileSizes;
+};
+} // namespace
+
+template <typename T>
+static T getValueOr(const PassOptions::Option<T> &option, T defaultValue) {
+  return option.hasValue() ? option.getValue() : defaultValue;
+}
+
+// Returns the vector register width in bits to vectorize for, either as given
+// explicitly or as implied by the target features.
+static unsigned getVectorWidth(const tcp::TcpToLlvmPipelineOptions &options) {
+  if (options.vectorWidth)
+    return options.vectorWidth;
+  StringRef targetFeatures = options.targetFeatures;
+  if (targetFeatures.contains("+avx512f"))
+    return 512;
+  if (targetFeatures.contains("+avx"))
+    return 256;
+  return 128;
+}
+
+static PipelineConfig
+getPipelineConfig(const tcp::TcpToLlvmPipelineOptions &options) {
+  unsigned optLevel = options.optLevel;
+  PipelineConfig config;
+  config.fuseElementwise = getValueOr(options.fuseElementwise, optLevel >= 1);
+  config.memoryPlanning = getValueOr(options.memoryPlanning, optLevel >= 1);
+  config.stackPromotionThreshold = options.stackPromotionThreshold;
+  config.destinationPassing = options.destinationPassing;
+  config.vectorize = getValueOr(options.vectorize, optLevel >= 2);
+  config.vectorWidth = getVectorWidth(options);
+  config.targetFeatures = options.targetFeatures;
+  config.numThreads = getValueOr(options.numThreads,
+                                 optLevel >= 3 ? kDefaultNumThreads : 1u);
+  config.fastMath = options.fastMath;
+  config.tileSizes.assign(options.tileSizes.begin(), options.tileSizes.end());
+  return config;
+}
+
+static void
+createTcpToLlvmPipeline(OpPassManager &pm,
+                        const tcp::TcpToLlvmPipelineOptions &options) {
+  PipelineConfig config = getPipelineConfig(options);
+
   // Drop TCP symbolic shape ops for dynamic dims
   pm.addNestedPass<func::FuncOp>(tcp::createDropSymbolicShapeOpsPass());
 
@@ -78,10 +165,66 @@ static void createTcpToLlvmPipeline(OpPassManager &pm) {
   pm.addNestedPass<func::FuncOp>(tcp::createDecomposeTensorOpsPass());
 
   // TCP -> Linalg/Arith conversions.
-  pm.addNestedPass<func::FuncOp>(tcp::createConvertTcpToLinalgPass());
+  // Floating point scans are only reassociated with fast-math.
+  pm.addNestedPass<func::FuncOp>(
+      tcp::createConvertTcpToLinalgPass(/*reassociateFP=*/config.fastMath));
   pm.addNestedPass<func::FuncOp>(tcp::createConvertTcpToTensorPass());
   pm.addNestedPass<func::FuncOp>(tcp::createConvertTcpToArithPass());
 
+  // Fuse the generics created for chains of elementwise TCP ops, so that
+  // intermediate results are not materialized.
+  if (config.fuseElementwise)
+    pm.addNestedPass<func::FuncOp>(
+        tcp::createTcpFuseLinalgElementwiseOpsPass());
+
+  // Generate a single loop nest for each TCP group and inline it.
+  pm.addNestedPass<func::FuncOp>(
+      tcp::createTcpLowerGroupOpsPass(config.tileSizes));
+
+  // Compute the inputs of concatenations in their slices of the result.
+  pm.addNestedPass<func::FuncOp>(tcp::createTcpConcatInPlacePass());
+
+  // Compute elementwise ops in the buffers of dead or donated inputs.
+  pm.addNestedPass<func::FuncOp>(tcp::createTcpReuseInputBuffersPass());
+
+  if (config.fastMath)
+    pm.addNestedPass<func::FuncOp>(tcp::createTcpEnableFastMathPass());
+
+  // Compute convolutions either as an im2col GEMM or with direct vectorized
+  // kernels, matmuls on packed panels with a vectorized micro-kernel, and
+  // transposes in cache blocks of in-register transposes. This runs before
+  // the generic parallelization, which would leave them with dynamically
+  // shaped tiles.
+  if (config.vectorize) {
+    pm.addNestedPass<func::FuncOp>(tcp::createTcpLowerConvOpsPass(
+        config.vectorWidth, config.numThreads));
+    pm.addNestedPass<func::FuncOp>(tcp::createTcpPackMatmulOpsPass(
+        config.vectorWidth, config.numThreads));
+    pm.addNestedPass<func::FuncOp>(tcp::createTcpLowerTransposeOpsPass(
+        config.vectorWidth, config.numThreads));
+  }
+
+  // Split reductions into partial reductions per thread and vector lane.
+  // Floating point sums and products are only split with fast-math, since
+  // that reassociates them.
+  if (config.vectorize || config.numThreads > 1)
+    pm.addNestedPass<func::FuncOp>(tcp::createTcpSplitReductionsPass(
+        config.vectorize ? config.vectorWidth : 0, config.numThreads,
+        /*reassociateFP=*/config.fastMath));
+
+  // Split parallel linalg ops into one chunk per thread.
+  if (config.numThreads > 1)
+    pm.addNestedPass<func::FuncOp>(
+        tcp::createTcpParallelizeLinalgOpsPass(config.numThreads));
+
+  if (config.vectorize) {
+    // Vectorize linalg ops while they still operate on tensors. Anything that
+    // does not vectorize is lowered to scalar loops further down.
+    pm.addNestedPass<func::FuncOp>(
+        tcp::createTcpVectorizeLinalgOpsPass(config.vectorWidth));
+    pm.addNestedPass<func::FuncOp>(createCanonicalizerPass());
+  }
+
   // One-shot bufferize tensor -> memref, from
   // https://mlir.llvm.org/docs/Bufferization/.
   bufferization::OneShotBufferizePassOptions bufferizationOptions;
@@ -89,6 +232,29 @@ static void createTcpToLlvmPipeline(OpPassManager &pm) {
   bufferizationOptions.functionBoundaryTypeConversion =
       bufferization::LayoutMapOption::IdentityLayoutMap;
   pm.addPass(bufferization::createOneShotBufferizePass(bufferizationOptions));
+  if (config.destinationPassing) {
+    // Write statically shaped results directly into the caller's buffers.
+    // Dynamically shaped results are still computed in a temporary buffer
+    // and copied over.
+    bufferization::BufferResultsToOutParamsOpts outParamsOptions;
+    outParamsOptions.hoistStaticAllocs = true;
+    pm.addPass(
+        bufferization::createBufferResultsToOutParamsPass(outParamsOptions));
+  }
+  if (config.memoryPlanning) {
+    // Move allocations out of loops and up to the dominating block, so that
+    // they are made once rather than once per iteration.
+    pm.addNestedPass<func::FuncOp>(bufferization::createBufferHoistingPass());
+    pm.addNestedPass<func::FuncOp>(
+        bufferization::createBufferLoopHoistingPass());
+    // Small buffers live on the stack instead of the heap.
+    if (config.stackPromotionThreshold)
+      pm.addNestedPass<func::FuncOp>(
+          bufferization::createPromoteBuffersToStackPass(
+              config.stackPromotionThreshold, kMaxStackPromotionRank));
+    // Pack the remaining static intermediate buffers into a single arena.
+    pm.addNestedPass<func::FuncOp>(tcp::createTcpPlanMemoryPass());
+  }
   // Buffer deallocation pipeline for automatically inserting
   // buffer deallocation ops after one-shot bufferization.
   // https://sourcegraph.com/github.com/llvm/llvm-project@09bc1e825068f314db71ee7eb32d9f93c5ac87a0/-/blob/mlir/lib/Dialect/Bufferization/Pipelines/BufferizationPipelines.cpp?L21
@@ -101,10 +267,31 @@ static void createTcpToLlvmPipeline(OpPassManager &pm) {
   pm.addPass(createCanonicalizerPass());
   pm.addPass(createConvertBufferizationToMemRefPass());
 
+  if (config.numThreads > 1) {
+    // Dispatch the iterations of the `scf.forall` loops created above to the
+    // async runtime's thread pool. Each iteration is already a large chunk of
+    // work, hence the minimal task size of one.
+    pm.addPass(createForallToParallelLoopPass());
+    pm.addPass(createAsyncParallelForPass(/*asyncDispatch=*/true,
+                                          config.numThreads,
+                                          /*minTaskSize=*/1));
+    pm.addPass(createAsyncToAsyncRuntimePass());
+    pm.addPass(createAsyncRuntimeRefCountingPass());
+    pm.addPass(createAsyncRuntimeRefCountingOptPass());
+    pm.addPass(createConvertAsyncToLLVMPass());
+  } else {
+    // Run the remaining `scf.forall` loops, e.g. of scatters with unique
+    // indices, sequentially.
+    pm.addPass(createForallToForLoopPass());
+  }
+
   // Blanket-convert any remaining linalg ops to loops if any remain.
   pm.addNestedPass<func::FuncOp>(createConvertLinalgToLoopsPass());
   // Blanket-convert any remaining affine ops if any remain.
   pm.addPass(createLowerAffinePass());
+  // Lower multi-dimensional vector transfers to SCF.
+  if (config.vectorize)
+    pm.addNestedPass<func::FuncOp>(createConvertVectorToSCFPass());
   // Convert SCF to CF (always needed).
   pm.addPass(createSCFToControlFlowPass());
 
@@ -119,6 +306,12 @@ static void createTcpToLlvmPipeline(OpPassManager &pm) {
   pm.addPass(memref::createExpandStridedMetadataPass());
   // The expansion may create affine expressions. Get rid of them.
   pm.addPass(createLowerAffinePass());
+  // Convert Vector to LLVM.
+  if (config.vectorize) {
+    ConvertVectorToLLVMPassOptions vectorToLLVMOptions;
+    vectorToLLVMOptions.reassociateFPReductions = config.fastMath;
+    pm.addPass(createConvertVectorToLLVMPass(vectorToLLVMOptions));
+  }
   // Convert Arith (from affine lowering) to LLVM.
   pm.addNestedPass<func::FuncOp>(createArithToLLVMConversionPass());
   // Convert MemRef to LLVM (always needed).
@@ -134,6 +327,10 @@ static void createTcpToLlvmPipeline(OpPassManager &pm) {
 
   // Convert remaining unrealized_casts (always needed).
   pm.addPass(createReconcileUnrealizedCastsPass());
+
+  // Let LLVM use the target features, e.g. for fused multiply-adds.
+  if (!config.targetFeatures.empty())
+    pm.addPass(tcp::createTcpSetTargetFeaturesPass(config.targetFeatures));
 }
 
 void tcp::registerTcpPipelines() {
@@ -142,6 +339,6 @@ void tcp::registerTcpPipelines() {
       "Pipeline lowering torch backend contract to TCP backend contract.",
       createTorchBackendToTcpBackendPipeline);
 
-  PassPipelineRegistration<>("tcp-to-llvm-pipeline", "Lowers TCP to LLVM",
-                             createTcpToLlvmPipeline);
+  PassPipelineRegistration<tcp::TcpToLlvmPipelineOptions>(
+      "tcp-to-llvm-pipeline", "Lowers TCP to LLVM", createTcpToLlvmPipeline);
 }
@@ -606,3 +606,211 @@ def index_hacked_twin_loader() -> TorchLoaderOutput:
         model=Model(),
         inputs=(x,),
     )
+
+
+def sort_network_loader() -> TorchLoaderOutput:
+    class SortNetwork(torch.nn.Module):
+        def __init__(self):
+            super().__init__()
+
+        def forward(self, x: torch.Tensor) -> tuple[torch.Tensor]:
+            values, indices = torch.sort(x, dim=1, stable=True)
+            return values, indices
+
+    # Sample inputs: rows of 16 elements, which are sorted with a sorting
+    # network, with many ties and a few NaNs, which come last
+    x = torch.randint(0, 4, (3, 16)).to(torch.float32)
+    x[0, 3] = float("nan")
+    x[1, 0] = float("nan")
+    x[1, 15] = float("nan")
+
+    # Dynamic dim constraints
+    batch = Dim("batch")
+    dynamic_shapes = {"x": {0: batch}}
+
+    return TorchLoaderOutput(
+        model=SortNetwork(), inputs=(x,), dynamic_shapes=dynamic_shapes
+    )
+
+
+def sort_merge_loader() -> TorchLoaderOutput:
+    class SortMerge(torch.nn.Module):
+        def __init__(self):
+            super().__init__()
+
+        def forward(self, x: torch.Tensor) -> tuple[torch.Tensor]:
+            values, indices = torch.sort(x, dim=1, descending=True, stable=True)
+            return values, indices
+
+    # Sample inputs: rows that are merge sorted, of a size that is not a
+    # multiple of the runs, with many ties and a few NaNs, which come first
+    x = torch.randint(0, 16, (3, 1000)).to(torch.float32)
+    x[0, 17] = float("nan")
+    x[2, 500] = float("nan")
+    x[2, 999] = float("nan")
+
+    # Dynamic dim constraints
+    batch = Dim("batch")
+    dynamic_shapes = {"x": {0: batch}}
+
+    return TorchLoaderOutput(
+        model=SortMerge(), inputs=(x,), dynamic_shapes=dynamic_shapes
+    )
+
+
+def topk_loader() -> TorchLoaderOutput:
+    class TopK(torch.nn.Module):
+        def __init__(self):
+            super().__init__()
+
+        def forward(self, x: torch.Tensor) -> tuple[torch.Tensor]:
+            values, indices = torch.topk(x, 8, dim=1)
+            return values, indices
+
+    # Sample inputs: distinct values, so that the indices are unique
+    x = torch.randperm(3 * 300).reshape(3, 300).to(torch.float32)
+
+    # Dynamic dim constraints
+    batch = Dim("batch")
+    dynamic_shapes = {"x": {0: batch}}
+
+    return TorchLoaderOutput(model=TopK(), inputs=(x,), dynamic_shapes=dynamic_shapes)
+
+
+def topk_ties_loader() -> TorchLoaderOutput:
+    class TopKTies(torch.nn.Module):
+        def __init__(self):
+            super().__init__()
+
+        def forward(self, x: torch.Tensor) -> tuple[torch.Tensor]:
+            values, indices = torch.topk(x, 8, dim=1, largest=False)
+            # `torch.topk` does not specify which of equal elements is
+            # selected, so the indices are checked through the elements they
+            # point to.
+            return values, torch.gather(x, 1, indices)
+
+    # Sample inputs: few distinct values, so that the selection ends in ties
+    x = torch.randint(0, 8, (3, 300)).to(torch.float32)
+
+    # Dynamic dim constraints
+    batch = Dim("batch")
+    dynamic_shapes = {"x": {0: batch}}
+
+    return TorchLoaderOutput(
+        model=TopKTies(), inputs=(x,), dynamic_shapes=dynamic_shapes
+    )
+
+
+def cumsum_int_loader() -> TorchLoaderOutput:
+    class CumsumInt(torch.nn.Module):
+        def __init__(self):
+            super().__init__()
+
+        def forward(self, x: torch.Tensor) -> torch.Tensor:
+            return torch.cumsum(x, dim=1)
+
+    # Sample inputs: rows that are split into blocks of 4096 elements, the
+    # last of which is partial
+    x = torch.randint(-8, 8, (2, 5000))
+
+    # Dynamic dim constraints
+    batch = Dim("batch")
+    dynamic_shapes = {"x": {0: batch}}
+
+    return TorchLoaderOutput(
+        model=CumsumInt(), inputs=(x,), dynamic_shapes=dynamic_shapes
+    )
+
+
+def cumprod_int_loader() -> TorchLoaderOutput:
+    class CumprodInt(torch.nn.Module):
+        def __init__(self):
+            super().__init__()
+
+        def forward(self, x: torch.Tensor) -> torch.Tensor:
+            return torch.cumprod(x, dim=1)
+
+    # Sample inputs: rows that are split into blocks of 4096 elements, the
+    # last of which is partial, of 1s and -1s with a few 2s so that the
+    # products do not overflow
+    x = torch.randint(0, 2, (2, 5000)) * 2 - 1
+    x[:, ::500] = 2
+
+    # Dynamic dim constraints
+    batch = Dim("batch")
+    dynamic_shapes = {"x": {0: batch}}
+
+    return TorchLoaderOutput(
+        model=CumprodInt(), inputs=(x,), dynamic_shapes=dynamic_shapes
+    )
+
+
+def cumsum_float_loader() -> TorchLoaderOutput:
+    class CumsumFloat(torch.nn.Module):
+        def __init__(self):
+            super().__init__()
+
+        def forward(self, x: torch.Tensor) -> torch.Tensor:
+            return torch.cumsum(x, dim=1)
+
+    # Sample inputs: small integers, whose sums are exact in any order, so
+    # that the scans with and without fast-math match the reference
+    x = torch.randint(0, 4, (2, 5000)).to(torch.float32)
+
+    # Dynamic dim constraints
+    batch = Dim("batch")
+    dynamic_shapes = {"x": {0: batch}}
+
+    return TorchLoaderOutput(
+        model=CumsumFloat(), inputs=(x,), dynamic_shapes=dynamic_shapes
+    )
+
+
+def softmax_loader() -> TorchLoaderOutput:
+    class Softmax(torch.nn.Module):
+        def __init__(self):
+            super().__init__()
+
+        def forward(self, x: torch.Tensor) -> torch.Tensor:
+            return torch.softmax(x, dim=1)
+
+    # Sample inputs: rows that start with -inf, so that the running max is
+    # rescaled from -inf, and an increasing row, so that it is rescaled at
+    # every element
+    x = torch.randn(4, 8)
+    x[0, :3] = float("-inf")
+    x[1, 0] = float("-inf")
+    x[1, 1:] = torch.arange(7, dtype=torch.float32)
+
+    # Dynamic dim constraints
+    batch = Dim("batch")
+    dynamic_shapes = {"x": {0: batch}}
+
+    return TorchLoaderOutput(
+        model=Softmax(), inputs=(x,), dynamic_shapes=dynamic_shapes
+    )
+
+
+def log_softmax_loader() -> TorchLoaderOutput:
+    class LogSoftmax(torch.nn.Module):
+        def __init__(self):
+            super().__init__()
+
+        def forward(self, x: torch.Tensor) -> torch.Tensor:
+            return torch.log_softmax(x, dim=1)
+
+    # Sample inputs: rows that start with -inf, so that the running max is
+    # rescaled from -inf, and an increasing row, so that it is rescaled at
+    # every element
+    x = torch.randn(4, 8)
+    x[0, :3] = float("-inf")
+    x[1, 0] = float("-inf")
+    x[1, 1:] = torch.arange(7, dtype=torch.float32)
+
+    # Dynamic dim constraints
+    batch = Dim("batch")
+    dynamic_shapes = {"x": {0: batch}}
+
+    return TorchLoaderOutput(
+        model=LogSoftmax(), inputs=(x,), dynamic_shapes=dynamic_shapes
+    )
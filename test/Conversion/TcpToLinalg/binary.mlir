@@ -166,3 +166,90 @@ func.func @atan2_f32(%arg0 : tensor<?x?xf32>, %arg1: tensor<?x?xf32>) -> tensor<
   return %0 : tensor<?x?xf32>
 }
 
+
+// -----
+
+// CHECK: #[[MAP:.*]] = affine_map<(d0, d1) -> (d0, d1)>
+
+// CHECK-LABEL: func.func @compare_f32(
+// CHECK-SAME:                %[[ARG0:.*]]: tensor<?x?xf32>,
+// CHECK-SAME:                %[[ARG1:.*]]: tensor<?x?xf32>) -> tensor<?x?xi1> {
+// CHECK:         %[[CONST0:.*]] = arith.constant 0 : index
+// CHECK:         %[[DIM0:.*]] = tensor.dim %[[ARG0]], %[[CONST0]] : tensor<?x?xf32>
+// CHECK:         %[[CONST1:.*]] = arith.constant 1 : index
+// CHECK:         %[[DIM1:.*]] = tensor.dim %[[ARG0]], %[[CONST1]] : tensor<?x?xf32>
+// CHECK:         %[[EMPTY_TENSOR:.*]] = tensor.empty(%[[DIM0]], %[[DIM1]]) : tensor<?x?xi1>
+// CHECK:         %[[GENERIC:.*]] = linalg.generic {
+// CHECK-SAME:                        indexing_maps = [#[[MAP]], #[[MAP]], #[[MAP]]],
+// CHECK-SAME:                        iterator_types = ["parallel", "parallel"]}
+// CHECK-SAME:                        ins(%[[ARG0]], %[[ARG1]] :  tensor<?x?xf32>, tensor<?x?xf32>)
+// CHECK-SAME:                        outs(%[[EMPTY_TENSOR]] : tensor<?x?xi1>) {
+// CHECK:         ^bb0(%[[BBARG0:.*]]: f32, %[[BBARG1:.*]]: f32, %{{.*}}: i1):
+// CHECK:           %[[CMPF:.*]] = arith.cmpf olt, %[[BBARG0]], %[[BBARG1]] : f32
+// CHECK:           linalg.yield %[[CMPF]] : i1
+// CHECK:         } -> tensor<?x?xi1>
+// CHECK:         return %[[GENERIC]] : tensor<?x?xi1>
+// CHECK:       }
+func.func @compare_f32(%arg0 : tensor<?x?xf32>, %arg1: tensor<?x?xf32>) -> tensor<?x?xi1> {
+  %0 = tcp.compare %arg0, %arg1 {predicate = #tcp<comparePredicate LT>} : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xi1>
+  return %0 : tensor<?x?xi1>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @compare_ne_f32(
+// CHECK:           %[[CMPF:.*]] = arith.cmpf une, %{{.*}}, %{{.*}} : f32
+// CHECK:           linalg.yield %[[CMPF]] : i1
+func.func @compare_ne_f32(%arg0 : tensor<?xf32>, %arg1: tensor<?xf32>) -> tensor<?xi1> {
+  %0 = tcp.compare %arg0, %arg1 {predicate = #tcp<comparePredicate NE>} : tensor<?xf32>, tensor<?xf32> -> tensor<?xi1>
+  return %0 : tensor<?xi1>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @compare_signed_i32(
+// CHECK:         ^bb0(%[[BBARG0:.*]]: i32, %[[BBARG1:.*]]: i32, %{{.*}}: i1):
+// CHECK:           %[[CMPI:.*]] = arith.cmpi sgt, %[[BBARG0]], %[[BBARG1]] : i32
+// CHECK:           linalg.yield %[[CMPI]] : i1
+func.func @compare_signed_i32(%arg0 : tensor<?xi32>, %arg1: tensor<?xi32>) -> tensor<?xi1> {
+  %0 = tcp.compare %arg0, %arg1 {int_signedness = #tcp<signedness Signed>, predicate = #tcp<comparePredicate GT>} : tensor<?xi32>, tensor<?xi32> -> tensor<?xi1>
+  return %0 : tensor<?xi1>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @compare_unsigned_i8(
+// CHECK:         ^bb0(%[[BBARG0:.*]]: i8, %[[BBARG1:.*]]: i8, %{{.*}}: i1):
+// CHECK:           %[[CMPI:.*]] = arith.cmpi ule, %[[BBARG0]], %[[BBARG1]] : i8
+// CHECK:           linalg.yield %[[CMPI]] : i1
+func.func @compare_unsigned_i8(%arg0 : tensor<?xi8>, %arg1: tensor<?xi8>) -> tensor<?xi1> {
+  %0 = tcp.compare %arg0, %arg1 {int_signedness = #tcp<signedness Unsigned>, predicate = #tcp<comparePredicate LE>} : tensor<?xi8>, tensor<?xi8> -> tensor<?xi1>
+  return %0 : tensor<?xi1>
+}
+
+// -----
+
+// CHECK: #[[MAP:.*]] = affine_map<(d0) -> (d0)>
+
+// CHECK-LABEL: func.func @select_f32(
+// CHECK-SAME:                %[[ARG0:.*]]: tensor<?xi1>,
+// CHECK-SAME:                %[[ARG1:.*]]: tensor<?xf32>,
+// CHECK-SAME:                %[[ARG2:.*]]: tensor<?xf32>) -> tensor<?xf32> {
+// CHECK:         %[[CONST0:.*]] = arith.constant 0 : index
+// CHECK:         %[[DIM0:.*]] = tensor.dim %[[ARG0]], %[[CONST0]] : tensor<?xi1>
+// CHECK:         %[[EMPTY_TENSOR:.*]] = tensor.empty(%[[DIM0]]) : tensor<?xf32>
+// CHECK:         %[[GENERIC:.*]] = linalg.generic {
+// CHECK-SAME:                        indexing_maps = [#[[MAP]], #[[MAP]], #[[MAP]], #[[MAP]]],
+// CHECK-SAME:                        iterator_types = ["parallel"]}
+// CHECK-SAME:                        ins(%[[ARG0]], %[[ARG1]], %[[ARG2]] :  tensor<?xi1>, tensor<?xf32>, tensor<?xf32>)
+// CHECK-SAME:                        outs(%[[EMPTY_TENSOR]] : tensor<?xf32>) {
+// CHECK:         ^bb0(%[[BBARG0:.*]]: i1, %[[BBARG1:.*]]: f32, %[[BBARG2:.*]]: f32, %{{.*}}: f32):
+// CHECK:           %[[SELECT:.*]] = arith.select %[[BBARG0]], %[[BBARG1]], %[[BBARG2]] : f32
+// CHECK:           linalg.yield %[[SELECT]] : f32
+// CHECK:         } -> tensor<?xf32>
+// CHECK:         return %[[GENERIC]] : tensor<?xf32>
+// CHECK:       }
+func.func @select_f32(%arg0 : tensor<?xi1>, %arg1: tensor<?xf32>, %arg2: tensor<?xf32>) -> tensor<?xf32> {
+  %0 = tcp.select %arg0, %arg1, %arg2 : tensor<?xi1>, tensor<?xf32>, tensor<?xf32> -> tensor<?xf32>
+  return %0 : tensor<?xf32>
+}
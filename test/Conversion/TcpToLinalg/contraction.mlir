@@ -0,0 +1,35 @@
+// RUN: tcp-opt %s -convert-tcp-to-linalg -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @matmul(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x8xf32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<8x16xf32>) -> tensor<?x16xf32>
+// CHECK:         %[[C0:.*]] = arith.constant 0 : index
+// CHECK:         %[[DIM:.*]] = tensor.dim %[[ARG0]], %[[C0]] : tensor<?x8xf32>
+// CHECK:         %[[EMPTY:.*]] = tensor.empty(%[[DIM]]) : tensor<?x16xf32>
+// CHECK:         %[[ZERO:.*]] = arith.constant 0.000000e+00 : f32
+// CHECK:         %[[FILL:.*]] = linalg.fill ins(%[[ZERO]] : f32) outs(%[[EMPTY]] : tensor<?x16xf32>) -> tensor<?x16xf32>
+// CHECK:         %[[MATMUL:.*]] = linalg.matmul ins(%[[ARG0]], %[[ARG1]] : tensor<?x8xf32>, tensor<8x16xf32>)
+// CHECK-SAME:                                   outs(%[[FILL]] : tensor<?x16xf32>) -> tensor<?x16xf32>
+// CHECK:         return %[[MATMUL]] : tensor<?x16xf32>
+func.func @matmul(%arg0 : tensor<?x8xf32>, %arg1 : tensor<8x16xf32>) -> tensor<?x16xf32> {
+  %0 = tcp.matmul %arg0, %arg1 : tensor<?x8xf32>, tensor<8x16xf32> -> tensor<?x16xf32>
+  return %0 : tensor<?x16xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @batch_matmul(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x4x8xi32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<2x8x?xi32>) -> tensor<2x4x?xi32>
+// CHECK:         %[[C2:.*]] = arith.constant 2 : index
+// CHECK:         %[[DIM:.*]] = tensor.dim %[[ARG1]], %[[C2]] : tensor<2x8x?xi32>
+// CHECK:         %[[EMPTY:.*]] = tensor.empty(%[[DIM]]) : tensor<2x4x?xi32>
+// CHECK:         %[[ZERO:.*]] = arith.constant 0 : i32
+// CHECK:         %[[FILL:.*]] = linalg.fill ins(%[[ZERO]] : i32) outs(%[[EMPTY]] : tensor<2x4x?xi32>) -> tensor<2x4x?xi32>
+// CHECK:         %[[MATMUL:.*]] = linalg.batch_matmul ins(%[[ARG0]], %[[ARG1]] : tensor<2x4x8xi32>, tensor<2x8x?xi32>)
+// CHECK-SAME:                                         outs(%[[FILL]] : tensor<2x4x?xi32>) -> tensor<2x4x?xi32>
+// CHECK:         return %[[MATMUL]] : tensor<2x4x?xi32>
+func.func @batch_matmul(%arg0 : tensor<2x4x8xi32>, %arg1 : tensor<2x8x?xi32>) -> tensor<2x4x?xi32> {
+  %0 = tcp.batch_matmul %arg0, %arg1 : tensor<2x4x8xi32>, tensor<2x8x?xi32> -> tensor<2x4x?xi32>
+  return %0 : tensor<2x4x?xi32>
+}
@@ -0,0 +1,76 @@
+// RUN: tcp-opt %s -convert-tcp-to-linalg -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @conv2d(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<1x3x16x16xf32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<8x3x3x3xf32>) -> tensor<1x8x8x8xf32>
+// CHECK:         %[[ZERO:.*]] = arith.constant 0.000000e+00 : f32
+// CHECK:         %[[PADDED:.*]] = tensor.pad %[[ARG0]] low[0, 0, 1, 1] high[0, 0, 1, 1]
+// CHECK:           tensor.yield %[[ZERO]] : f32
+// CHECK:         } : tensor<1x3x16x16xf32> to tensor<1x3x18x18xf32>
+// CHECK:         %[[EMPTY:.*]] = tensor.empty() : tensor<1x8x8x8xf32>
+// CHECK:         %[[FILL:.*]] = linalg.fill ins(%[[ZERO]] : f32) outs(%[[EMPTY]] : tensor<1x8x8x8xf32>) -> tensor<1x8x8x8xf32>
+// CHECK:         %[[CONV:.*]] = linalg.conv_2d_nchw_fchw {dilations = dense<1> : vector<2xi64>, strides = dense<2> : vector<2xi64>}
+// CHECK-SAME:                        ins(%[[PADDED]], %[[ARG1]] : tensor<1x3x18x18xf32>, tensor<8x3x3x3xf32>)
+// CHECK-SAME:                        outs(%[[FILL]] : tensor<1x8x8x8xf32>) -> tensor<1x8x8x8xf32>
+// CHECK:         return %[[CONV]] : tensor<1x8x8x8xf32>
+func.func @conv2d(%arg0 : tensor<1x3x16x16xf32>, %arg1 : tensor<8x3x3x3xf32>) -> tensor<1x8x8x8xf32> {
+  %0 = tcp.conv2d %arg0, %arg1 {stride = [2, 2], padding = [1, 1], dilation = [1, 1], groups = 1 : i64} : tensor<1x3x16x16xf32>, tensor<8x3x3x3xf32> -> tensor<1x8x8x8xf32>
+  return %0 : tensor<1x8x8x8xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @conv1d_dynamic(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x4x?xf32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<8x4x3xf32>) -> tensor<?x8x?xf32>
+// CHECK-NOT:     tensor.pad
+// CHECK:         %[[N:.*]] = tensor.dim %[[ARG0]], %{{.*}} : tensor<?x4x?xf32>
+// CHECK:         %[[W:.*]] = tensor.dim %[[ARG0]], %{{.*}} : tensor<?x4x?xf32>
+// CHECK:         %[[OW:.*]] = arith.addi
+// CHECK:         %[[EMPTY:.*]] = tensor.empty(%[[N]], %[[OW]]) : tensor<?x8x?xf32>
+// CHECK:         %[[FILL:.*]] = linalg.fill {{.*}} outs(%[[EMPTY]] : tensor<?x8x?xf32>)
+// CHECK:         linalg.conv_1d_ncw_fcw {dilations = dense<1> : vector<1xi64>, strides = dense<1> : vector<1xi64>}
+// CHECK-SAME:                        ins(%[[ARG0]], %[[ARG1]] : tensor<?x4x?xf32>, tensor<8x4x3xf32>)
+// CHECK-SAME:                        outs(%[[FILL]] : tensor<?x8x?xf32>) -> tensor<?x8x?xf32>
+func.func @conv1d_dynamic(%arg0 : tensor<?x4x?xf32>, %arg1 : tensor<8x4x3xf32>) -> tensor<?x8x?xf32> {
+  %0 = tcp.conv1d %arg0, %arg1 {stride = [1], padding = [0], dilation = [1], groups = 1 : i64} : tensor<?x4x?xf32>, tensor<8x4x3xf32> -> tensor<?x8x?xf32>
+  return %0 : tensor<?x8x?xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @conv2d_depthwise(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<1x4x8x8xf32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<4x1x3x3xf32>) -> tensor<1x4x6x6xf32>
+// CHECK:         %[[FILL:.*]] = linalg.fill
+// CHECK:         %[[WEIGHT:.*]] = tensor.collapse_shape %[[ARG1]] {{\[}}[0, 1], [2], [3]] : tensor<4x1x3x3xf32> into tensor<4x3x3xf32>
+// CHECK:         linalg.depthwise_conv_2d_nchw_chw {dilations = dense<1> : vector<2xi64>, strides = dense<1> : vector<2xi64>}
+// CHECK-SAME:                        ins(%[[ARG0]], %[[WEIGHT]] : tensor<1x4x8x8xf32>, tensor<4x3x3xf32>)
+// CHECK-SAME:                        outs(%[[FILL]] : tensor<1x4x6x6xf32>) -> tensor<1x4x6x6xf32>
+func.func @conv2d_depthwise(%arg0 : tensor<1x4x8x8xf32>, %arg1 : tensor<4x1x3x3xf32>) -> tensor<1x4x6x6xf32> {
+  %0 = tcp.conv2d %arg0, %arg1 {stride = [1, 1], padding = [0, 0], dilation = [1, 1], groups = 4 : i64} : tensor<1x4x8x8xf32>, tensor<4x1x3x3xf32> -> tensor<1x4x6x6xf32>
+  return %0 : tensor<1x4x6x6xf32>
+}
+
+// -----
+
+// CHECK-DAG:   #[[INPUT_MAP:.*]] = affine_map<(d0, d1, d2, d3, d4, d5) -> (d0, d1, d4, d3 * 2 + d5)>
+// CHECK-DAG:   #[[WEIGHT_MAP:.*]] = affine_map<(d0, d1, d2, d3, d4, d5) -> (d1, d2, d4, d5)>
+// CHECK-DAG:   #[[OUTPUT_MAP:.*]] = affine_map<(d0, d1, d2, d3, d4, d5) -> (d0, d1, d2, d3)>
+// CHECK-LABEL: func.func @conv1d_grouped(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x6x16xi32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<4x3x2xi32>) -> tensor<2x4x8xi32>
+// CHECK:         %[[FILL:.*]] = linalg.fill
+// CHECK:         %[[INPUT:.*]] = tensor.expand_shape %[[ARG0]] {{\[}}[0], [1, 2], [3]] output_shape [2, 2, 3, 16] : tensor<2x6x16xi32> into tensor<2x2x3x16xi32>
+// CHECK:         %[[WEIGHT:.*]] = tensor.expand_shape %[[ARG1]] {{\[}}[0, 1], [2], [3]] output_shape [2, 2, 3, 2] : tensor<4x3x2xi32> into tensor<2x2x3x2xi32>
+// CHECK:         %[[INIT:.*]] = tensor.expand_shape %[[FILL]] {{\[}}[0], [1, 2], [3]] output_shape [2, 2, 2, 8] : tensor<2x4x8xi32> into tensor<2x2x2x8xi32>
+// CHECK:         %[[CONV:.*]] = linalg.generic {indexing_maps = [#[[INPUT_MAP]], #[[WEIGHT_MAP]], #[[OUTPUT_MAP]]], iterator_types = ["parallel", "parallel", "parallel", "parallel", "reduction", "reduction"]}
+// CHECK-SAME:                        ins(%[[INPUT]], %[[WEIGHT]] : tensor<2x2x3x16xi32>, tensor<2x2x3x2xi32>) outs(%[[INIT]] : tensor<2x2x2x8xi32>)
+// CHECK:           arith.muli
+// CHECK:           arith.addi
+// CHECK:         %[[RESULT:.*]] = tensor.collapse_shape %[[CONV]] {{\[}}[0], [1, 2], [3]] : tensor<2x2x2x8xi32> into tensor<2x4x8xi32>
+// CHECK:         return %[[RESULT]] : tensor<2x4x8xi32>
+func.func @conv1d_grouped(%arg0 : tensor<2x6x16xi32>, %arg1 : tensor<4x3x2xi32>) -> tensor<2x4x8xi32> {
+  %0 = tcp.conv1d %arg0, %arg1 {stride = [2], padding = [0], dilation = [1], groups = 2 : i64} : tensor<2x6x16xi32>, tensor<4x3x2xi32> -> tensor<2x4x8xi32>
+  return %0 : tensor<2x4x8xi32>
+}
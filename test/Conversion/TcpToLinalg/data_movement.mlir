@@ -39,3 +39,73 @@ func.func @gatherND(%arg0 : tensor<7x11x13x17xf32>, %arg1 : tensor<3x2xi64>) ->
     %0 = "tcp.gather_nd" (%arg0, %arg1) : (tensor<7x11x13x17xf32>, tensor<3x2xi64>) -> tensor<3x13x17xf32>
     return %0 : tensor<3x13x17xf32>
 }
+
+// -----
+
+// CHECK-LABEL: func.func @transpose(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x?x8xf32>) -> tensor<8x2x?xf32>
+// CHECK:         %[[C1:.*]] = arith.constant 1 : index
+// CHECK:         %[[DIM:.*]] = tensor.dim %[[ARG0]], %[[C1]] : tensor<2x?x8xf32>
+// CHECK:         %[[EMPTY:.*]] = tensor.empty(%[[DIM]]) : tensor<8x2x?xf32>
+// CHECK:         %[[T:.*]] = linalg.transpose ins(%[[ARG0]] : tensor<2x?x8xf32>) outs(%[[EMPTY]] : tensor<8x2x?xf32>) permutation = [2, 0, 1]
+// CHECK:         return %[[T]] : tensor<8x2x?xf32>
+func.func @transpose(%arg0 : tensor<2x?x8xf32>) -> tensor<8x2x?xf32> {
+  %0 = tcp.transpose %arg0 {permutation = [2, 0, 1]} : tensor<2x?x8xf32> -> tensor<8x2x?xf32>
+  return %0 : tensor<8x2x?xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @scatter_unique(
+// CHECK-SAME:          %[[DEST:.*]]: tensor<25x4xf32>, %[[INDICES:.*]]: tensor<10x1xi64>, %[[UPDATES:.*]]: tensor<10x4xf32>) -> tensor<25x4xf32>
+// CHECK:         %[[RES:.*]] = scf.forall (%[[I:.*]]) in (10) shared_outs(%[[OUT:.*]] = %[[DEST]]) -> (tensor<25x4xf32>) {
+// CHECK:           %[[IDX:.*]] = tensor.extract %[[INDICES]][%[[I]], %{{.*}}] : tensor<10x1xi64>
+// CHECK:           %[[CAST:.*]] = arith.index_cast %[[IDX]] : i64 to index
+// CHECK:           %[[NEG:.*]] = arith.cmpi slt, %[[CAST]], %{{.*}} : index
+// CHECK:           %[[WRAPPED:.*]] = arith.addi %[[CAST]], %{{.*}} : index
+// CHECK:           %[[OFFSET:.*]] = arith.select %[[NEG]], %[[WRAPPED]], %[[CAST]] : index
+// CHECK:           %[[UPDATE:.*]] = tensor.extract_slice %[[UPDATES]][%[[I]], 0] [1, 4] [1, 1] : tensor<10x4xf32> to tensor<4xf32>
+// CHECK:           scf.forall.in_parallel {
+// CHECK:             tensor.parallel_insert_slice %[[UPDATE]] into %[[OUT]][%[[OFFSET]], 0] [1, 4] [1, 1] : tensor<4xf32> into tensor<25x4xf32>
+// CHECK:           }
+// CHECK:         }
+// CHECK:         return %[[RES]] : tensor<25x4xf32>
+func.func @scatter_unique(%arg0 : tensor<25x4xf32>, %arg1 : tensor<10x1xi64>, %arg2 : tensor<10x4xf32>) -> tensor<25x4xf32> {
+  %0 = tcp.scatter %arg0, %arg1, %arg2 {unique_indices} : tensor<25x4xf32>, tensor<10x1xi64>, tensor<10x4xf32> -> tensor<25x4xf32>
+  return %0 : tensor<25x4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @scatter_accumulate(
+// CHECK-SAME:          %[[DEST:.*]]: tensor<?x4xf32>, %[[INDICES:.*]]: tensor<?x1xi64>, %[[UPDATES:.*]]: tensor<?x4xf32>) -> tensor<?x4xf32>
+// CHECK:         %[[DIM:.*]] = tensor.dim %[[INDICES]], %{{.*}} : tensor<?x1xi64>
+// CHECK:         %[[RES:.*]] = scf.for %[[I:.*]] = %{{.*}} to %[[DIM]] step %{{.*}} iter_args(%[[OUT:.*]] = %[[DEST]]) -> (tensor<?x4xf32>) {
+// CHECK:           %[[UPDATE:.*]] = tensor.extract_slice %[[UPDATES]][%[[I]], 0] [1, 4] [1, 1] : tensor<?x4xf32> to tensor<4xf32>
+// CHECK:           %[[CURRENT:.*]] = tensor.extract_slice %[[OUT]][%[[OFFSET:.*]], 0] [1, 4] [1, 1] : tensor<?x4xf32> to tensor<4xf32>
+// CHECK:           %[[SUM:.*]] = linalg.generic {{.*}} ins(%[[UPDATE]] : tensor<4xf32>) outs(%[[CURRENT]] : tensor<4xf32>)
+// CHECK:             arith.addf
+// CHECK:           %[[INSERT:.*]] = tensor.insert_slice %[[SUM]] into %[[OUT]][%[[OFFSET]], 0] [1, 4] [1, 1] : tensor<4xf32> into tensor<?x4xf32>
+// CHECK:           scf.yield %[[INSERT]] : tensor<?x4xf32>
+// CHECK:         }
+// CHECK:         return %[[RES]] : tensor<?x4xf32>
+func.func @scatter_accumulate(%arg0 : tensor<?x4xf32>, %arg1 : tensor<?x1xi64>, %arg2 : tensor<?x4xf32>) -> tensor<?x4xf32> {
+  %0 = tcp.scatter %arg0, %arg1, %arg2 {accumulate = true} : tensor<?x4xf32>, tensor<?x1xi64>, tensor<?x4xf32> -> tensor<?x4xf32>
+  return %0 : tensor<?x4xf32>
+}
+
+// -----
+
+// Constant indices are updated in parallel when their rows are unique, and in
+// order otherwise: -24 and 1 are the same row of a dim of size 25.
+
+// CHECK-LABEL: func.func @scatter_constant_indices(
+// CHECK:         scf.forall
+// CHECK:         scf.for
+func.func @scatter_constant_indices(%arg0 : tensor<25x4xf32>, %arg1 : tensor<3x4xf32>, %arg2 : tensor<2x4xf32>) -> (tensor<25x4xf32>, tensor<25x4xf32>) {
+  %unique = arith.constant dense<[[0], [3], [-1]]> : tensor<3x1xi64>
+  %repeated = arith.constant dense<[[-24], [1]]> : tensor<2x1xi64>
+  %0 = tcp.scatter %arg0, %unique, %arg1 : tensor<25x4xf32>, tensor<3x1xi64>, tensor<3x4xf32> -> tensor<25x4xf32>
+  %1 = tcp.scatter %arg0, %repeated, %arg2 : tensor<25x4xf32>, tensor<2x1xi64>, tensor<2x4xf32> -> tensor<25x4xf32>
+  return %0, %1 : tensor<25x4xf32>, tensor<25x4xf32>
+}
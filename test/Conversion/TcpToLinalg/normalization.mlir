@@ -0,0 +1,189 @@
+// RUN: tcp-opt %s -convert-tcp-to-linalg -split-input-file | FileCheck %s
+
+// CHECK-DAG: #[[ID_MAP:.*]] = affine_map<(d0, d1) -> (d0, d1)>
+// CHECK-DAG: #[[ROW_MAP:.*]] = affine_map<(d0, d1) -> (d0)>
+// CHECK-LABEL: func.func @softmax(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x8xf32>) -> tensor<?x8xf32>
+// CHECK:         %[[C0:.*]] = arith.constant 0 : index
+// CHECK:         %[[DIM:.*]] = tensor.dim %[[ARG0]], %[[C0]] : tensor<?x8xf32>
+// CHECK:         %[[MAX_EMPTY:.*]] = tensor.empty(%[[DIM]]) : tensor<?xf32>
+// CHECK:         %[[NEG_INF:.*]] = arith.constant 0xFF800000 : f32
+// CHECK:         %[[MAX_INIT:.*]] = linalg.fill ins(%[[NEG_INF]] : f32) outs(%[[MAX_EMPTY]] : tensor<?xf32>) -> tensor<?xf32>
+// CHECK:         %[[SUM_EMPTY:.*]] = tensor.empty(%[[DIM]]) : tensor<?xf32>
+// CHECK:         %[[ZERO:.*]] = arith.constant 0.000000e+00 : f32
+// CHECK:         %[[SUM_INIT:.*]] = linalg.fill ins(%[[ZERO]] : f32) outs(%[[SUM_EMPTY]] : tensor<?xf32>) -> tensor<?xf32>
+// CHECK:         %[[STATS:.*]]:2 = linalg.generic {indexing_maps = [#[[ID_MAP]], #[[ROW_MAP]], #[[ROW_MAP]]], iterator_types = ["parallel", "reduction"]} ins(%[[ARG0]] : tensor<?x8xf32>) outs(%[[MAX_INIT]], %[[SUM_INIT]] : tensor<?xf32>, tensor<?xf32>) {
+// CHECK:         ^bb0(%[[X:.*]]: f32, %[[MAX:.*]]: f32, %[[SUM:.*]]: f32):
+// CHECK:           %[[NEW_MAX:.*]] = arith.maximumf %[[MAX]], %[[X]] : f32
+// CHECK:           %[[D0:.*]] = arith.subf %[[MAX]], %[[NEW_MAX]] : f32
+// CHECK:           %[[SCALE:.*]] = math.exp %[[D0]] : f32
+// CHECK:           %[[D1:.*]] = arith.subf %[[X]], %[[NEW_MAX]] : f32
+// CHECK:           %[[TERM:.*]] = math.exp %[[D1]] : f32
+// CHECK:           %[[SCALED:.*]] = arith.mulf %[[SUM]], %[[SCALE]] : f32
+// CHECK:           %[[ADD:.*]] = arith.addf %[[SCALED]], %[[TERM]] : f32
+// CHECK:           %[[IS_NEG_INF:.*]] = arith.cmpf oeq, %[[NEW_MAX]], %{{.*}} : f32
+// CHECK:           %[[NEW_SUM:.*]] = arith.select %[[IS_NEG_INF]], %[[SUM]], %[[ADD]] : f32
+// CHECK:           linalg.yield %[[NEW_MAX]], %[[NEW_SUM]] : f32, f32
+// CHECK:         } -> (tensor<?xf32>, tensor<?xf32>)
+// CHECK:         %[[OUT_EMPTY:.*]] = tensor.empty(%{{.*}}) : tensor<?x8xf32>
+// CHECK:         %[[OUT:.*]] = linalg.generic {indexing_maps = [#[[ID_MAP]], #[[ROW_MAP]], #[[ROW_MAP]], #[[ID_MAP]]], iterator_types = ["parallel", "parallel"]} ins(%[[ARG0]], %[[STATS]]#0, %[[STATS]]#1 : tensor<?x8xf32>, tensor<?xf32>, tensor<?xf32>) outs(%[[OUT_EMPTY]] : tensor<?x8xf32>) {
+// CHECK:         ^bb0(%[[X2:.*]]: f32, %[[MAX2:.*]]: f32, %[[SUM2:.*]]: f32, %{{.*}}: f32):
+// CHECK:           %[[SHIFTED:.*]] = arith.subf %[[X2]], %[[MAX2]] : f32
+// CHECK:           %[[EXP:.*]] = math.exp %[[SHIFTED]] : f32
+// CHECK:           %[[DIV:.*]] = arith.divf %[[EXP]], %[[SUM2]] : f32
+// CHECK:           linalg.yield %[[DIV]] : f32
+// CHECK:         } -> tensor<?x8xf32>
+// CHECK:         return %[[OUT]] : tensor<?x8xf32>
+func.func @softmax(%arg0 : tensor<?x8xf32>) -> tensor<?x8xf32> {
+  %0 = tcp.softmax %arg0 {axis = 1 : i64} : tensor<?x8xf32> -> tensor<?x8xf32>
+  return %0 : tensor<?x8xf32>
+}
+
+// -----
+
+// CHECK-DAG: #[[ID_MAP:.*]] = affine_map<(d0, d1, d2) -> (d0, d1, d2)>
+// CHECK-DAG: #[[STATS_MAP:.*]] = affine_map<(d0, d1, d2) -> (d0, d2)>
+// CHECK-LABEL: func.func @log_softmax(
+// CHECK:         %[[STATS:.*]]:2 = linalg.generic {indexing_maps = [#[[ID_MAP]], #[[STATS_MAP]], #[[STATS_MAP]]], iterator_types = ["parallel", "reduction", "parallel"]}
+// CHECK:         } -> (tensor<2x8xf32>, tensor<2x8xf32>)
+// CHECK:         linalg.generic {indexing_maps = [#[[ID_MAP]], #[[STATS_MAP]], #[[STATS_MAP]], #[[ID_MAP]]], iterator_types = ["parallel", "parallel", "parallel"]} ins(%{{.*}}, %[[STATS]]#0, %[[STATS]]#1 : tensor<2x4x8xf32>, tensor<2x8xf32>, tensor<2x8xf32>)
+// CHECK:           %[[SHIFTED:.*]] = arith.subf
+// CHECK:           %[[LOG:.*]] = math.log %{{.*}} : f32
+// CHECK:           %[[OUT:.*]] = arith.subf %[[SHIFTED]], %[[LOG]] : f32
+// CHECK:           linalg.yield %[[OUT]] : f32
+// CHECK:         } -> tensor<2x4x8xf32>
+func.func @log_softmax(%arg0 : tensor<2x4x8xf32>) -> tensor<2x4x8xf32> {
+  %0 = tcp.log_softmax %arg0 {axis = 1 : i64} : tensor<2x4x8xf32> -> tensor<2x4x8xf32>
+  return %0 : tensor<2x4x8xf32>
+}
+
+// -----
+
+// CHECK-DAG: #[[ID_MAP:.*]] = affine_map<(d0, d1) -> (d0, d1)>
+// CHECK-DAG: #[[ROW_MAP:.*]] = affine_map<(d0, d1) -> (d0)>
+// CHECK-DAG: #[[STATS_MAP:.*]] = affine_map<(d0) -> (d0)>
+// CHECK-DAG: #[[PARAM_MAP:.*]] = affine_map<(d0, d1) -> (d1)>
+// CHECK-LABEL: func.func @layer_norm(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<4x8xf32>, %[[ARG1:.*]]: tensor<8xf32>, %[[ARG2:.*]]: tensor<8xf32>) -> tensor<4x8xf32>
+// CHECK:         %[[STATS:.*]]:2 = linalg.generic {indexing_maps = [#[[ID_MAP]], #[[ROW_MAP]], #[[ROW_MAP]]], iterator_types = ["parallel", "reduction"]} ins(%[[ARG0]] : tensor<4x8xf32>)
+// CHECK:         ^bb0(%[[X:.*]]: f32, %[[MEAN:.*]]: f32, %[[M2:.*]]: f32):
+// CHECK:           %[[POS:.*]] = linalg.index 1 : index
+// CHECK:           %[[ONE:.*]] = arith.constant 1 : index
+// CHECK:           %[[NEW_POS:.*]] = arith.addi %[[POS]], %[[ONE]] : index
+// CHECK:           %[[POS_I64:.*]] = arith.index_castui %[[NEW_POS]] : index to i64
+// CHECK:           %[[NEW_COUNT:.*]] = arith.uitofp %[[POS_I64]] : i64 to f32
+// CHECK:           %[[DELTA:.*]] = arith.subf %[[X]], %[[MEAN]] : f32
+// CHECK:           %[[STEP:.*]] = arith.divf %[[DELTA]], %[[NEW_COUNT]] : f32
+// CHECK:           %[[NEW_MEAN:.*]] = arith.addf %[[MEAN]], %[[STEP]] : f32
+// CHECK:           %[[NEW_DELTA:.*]] = arith.subf %[[X]], %[[NEW_MEAN]] : f32
+// CHECK:           %[[PROD:.*]] = arith.mulf %[[DELTA]], %[[NEW_DELTA]] : f32
+// CHECK:           %[[NEW_M2:.*]] = arith.addf %[[M2]], %[[PROD]] : f32
+// CHECK:           linalg.yield %[[NEW_MEAN]], %[[NEW_M2]] : f32, f32
+// CHECK:         } -> (tensor<4xf32>, tensor<4xf32>)
+// CHECK:         %[[COUNT:.*]] = arith.constant 8.000000e+00 : f32
+// CHECK:         %[[EPS:.*]] = arith.constant 9.99999974E-6 : f32
+// CHECK:         %[[RSTD:.*]] = linalg.generic {indexing_maps = [#[[STATS_MAP]], #[[STATS_MAP]]], iterator_types = ["parallel"]} ins(%[[STATS]]#1 : tensor<4xf32>)
+// CHECK:           %[[VAR:.*]] = arith.divf %{{.*}}, %[[COUNT]] : f32
+// CHECK:           %[[VAR_EPS:.*]] = arith.addf %[[VAR]], %[[EPS]] : f32
+// CHECK:           math.rsqrt %[[VAR_EPS]] : f32
+// CHECK:         linalg.generic {indexing_maps = [#[[ID_MAP]], #[[ROW_MAP]], #[[ROW_MAP]], #[[PARAM_MAP]], #[[PARAM_MAP]], #[[ID_MAP]]], iterator_types = ["parallel", "parallel"]} ins(%[[ARG0]], %[[STATS]]#0, %[[RSTD]], %[[ARG1]], %[[ARG2]] : tensor<4x8xf32>, tensor<4xf32>, tensor<4xf32>, tensor<8xf32>, tensor<8xf32>)
+// CHECK:         ^bb0(%[[X2:.*]]: f32, %[[MEAN2:.*]]: f32, %[[RSTD2:.*]]: f32, %[[W:.*]]: f32, %[[B:.*]]: f32, %{{.*}}: f32):
+// CHECK:           %[[CENTERED:.*]] = arith.subf %[[X2]], %[[MEAN2]] : f32
+// CHECK:           %[[NORMED:.*]] = arith.mulf %[[CENTERED]], %[[RSTD2]] : f32
+// CHECK:           %[[SCALED:.*]] = arith.mulf %[[NORMED]], %[[W]] : f32
+// CHECK:           %[[OUT:.*]] = arith.addf %[[SCALED]], %[[B]] : f32
+// CHECK:           linalg.yield %[[OUT]] : f32
+// CHECK:         } -> tensor<4x8xf32>
+func.func @layer_norm(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<4x8xf32>, %[[ARG1:.*]]: tensor<8xf32>, %[[ARG2:.*]]: tensor<8xf32>) -> tensor<4x8xf32>
+// CHECK:         %[[STATS:.*]]:3 = linalg.generic {indexing_maps = [#[[ID_MAP]], #[[ROW_MAP]], #[[ROW_MAP]], #[[ROW_MAP]]], iterator_types = ["parallel", "reduction"]} ins(%[[ARG0]] : tensor<4x8xf32>)
+// CHECK:         ^bb0(%[[X:.*]]: f32, %[[COUNT:.*]]: f32, %[[MEAN:.*]]: f32, %[[M2:.*]]: f32):
+// CHECK:           %[[ONE:.*]] = arith.constant 1.000000e+00 : f32
+// CHECK:           %[[NEW_COUNT:.*]] = arith.addf %[[COUNT]], %[[ONE]] : f32
+// CHECK:           %[[DELTA:.*]] = arith.subf %[[X]], %[[MEAN]] : f32
+// CHECK:           %[[STEP:.*]] = arith.divf %[[DELTA]], %[[NEW_COUNT]] : f32
+// CHECK:           %[[NEW_MEAN:.*]] = arith.addf %[[MEAN]], %[[STEP]] : f32
+// CHECK:           %[[NEW_DELTA:.*]] = arith.subf %[[X]], %[[NEW_MEAN]] : f32
+// CHECK:           %[[PROD:.*]] = arith.mulf %[[DELTA]], %[[NEW_DELTA]] : f32
+// CHECK:           %[[NEW_M2:.*]] = arith.addf %[[M2]], %[[PROD]] : f32
+// CHECK:           linalg.yield %[[NEW_COUNT]], %[[NEW_MEAN]], %[[NEW_M2]] : f32, f32, f32
+// CHECK:         } -> (tensor<4xf32>, tensor<4xf32>, tensor<4xf32>)
+// CHECK:         %[[EPS:.*]] = arith.constant 9.99999974E-6 : f32
+// CHECK:         %[[RSTD:.*]] = linalg.generic {indexing_maps = [#[[STATS_MAP]], #[[STATS_MAP]], #[[STATS_MAP]]], iterator_types = ["parallel"]} ins(%[[STATS]]#2, %[[STATS]]#0 : tensor<4xf32>, tensor<4xf32>)
+// CHECK:           %[[VAR:.*]] = arith.divf
+// CHECK:           %[[VAR_EPS:.*]] = arith.addf %[[VAR]], %[[EPS]] : f32
+// CHECK:           math.rsqrt %[[VAR_EPS]] : f32
+// CHECK:         linalg.generic {indexing_maps = [#[[ID_MAP]], #[[ROW_MAP]], #[[ROW_MAP]], #[[PARAM_MAP]], #[[PARAM_MAP]], #[[ID_MAP]]], iterator_types = ["parallel", "parallel"]} ins(%[[ARG0]], %[[STATS]]#1, %[[RSTD]], %[[ARG1]], %[[ARG2]] : tensor<4x8xf32>, tensor<4xf32>, tensor<4xf32>, tensor<8xf32>, tensor<8xf32>)
+// CHECK:         ^bb0(%[[X2:.*]]: f32, %[[MEAN2:.*]]: f32, %[[RSTD2:.*]]: f32, %[[W:.*]]: f32, %[[B:.*]]: f32, %{{.*}}: f32):
+// CHECK:           %[[CENTERED:.*]] = arith.subf %[[X2]], %[[MEAN2]] : f32
+// CHECK:           %[[NORMED:.*]] = arith.mulf %[[CENTERED]], %[[RSTD2]] : f32
+// CHECK:           %[[SCALED:.*]] = arith.mulf %[[NORMED]], %[[W]] : f32
+// CHECK:           %[[OUT:.*]] = arith.addf %[[SCALED]], %[[B]] : f32
+// CHECK:           linalg.yield %[[OUT]] : f32
+// CHECK:         } -> tensor<4x8xf32>
+func.func @layer_norm(%arg0 : tensor<4x8xf32>, %arg1 : tensor<8xf32>, %arg2 : tensor<8xf32>) -> tensor<4x8xf32> {
+  %0 = tcp.layer_norm %arg0 weight(%arg1 : tensor<8xf32>) bias(%arg2 : tensor<8xf32>) {axis = 1 : i64, epsilon = 1.000000e-05 : f64} : tensor<4x8xf32> -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
+
+// -----
+
+// The statistics of f16 rows are accumulated in f32, so that the count and
+// the mean of long rows stay exact. The position within the row is strided
+// over all the normalized dims.
+
+// CHECK-LABEL: func.func @layer_norm_f16(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x64x64xf16>) -> tensor<2x64x64xf16>
+// CHECK:         %[[SIZE:.*]] = arith.constant 64 : index
+// CHECK:         %[[STATS:.*]]:2 = linalg.generic {{.*}} iterator_types = ["parallel", "reduction", "reduction"]} ins(%[[ARG0]] : tensor<2x64x64xf16>) outs(%{{.*}}, %{{.*}} : tensor<2xf32>, tensor<2xf32>)
+// CHECK:         ^bb0(%[[X:.*]]: f16, %{{.*}}: f32, %{{.*}}: f32):
+// CHECK:           %[[X_F32:.*]] = arith.extf %[[X]] : f16 to f32
+// CHECK:           %[[ROW:.*]] = linalg.index 1 : index
+// CHECK:           %[[SCALED:.*]] = arith.muli %[[ROW]], %[[SIZE]] : index
+// CHECK:           %[[COL:.*]] = linalg.index 2 : index
+// CHECK:           arith.addi %[[SCALED]], %[[COL]] : index
+// CHECK:           arith.uitofp %{{.*}} : i64 to f32
+// CHECK:           arith.subf %[[X_F32]], %{{.*}} : f32
+// CHECK:         } -> (tensor<2xf32>, tensor<2xf32>)
+// CHECK:         %[[COUNT:.*]] = arith.constant 4.096000e+03 : f32
+// CHECK:         %[[RSTD:.*]] = linalg.generic {{.*}} ins(%[[STATS]]#1 : tensor<2xf32>)
+// CHECK:           arith.divf %{{.*}}, %[[COUNT]] : f32
+// CHECK:         } -> tensor<2xf32>
+// CHECK:         linalg.generic {{.*}} ins(%[[ARG0]], %[[STATS]]#0, %[[RSTD]] : tensor<2x64x64xf16>, tensor<2xf32>, tensor<2xf32>)
+// CHECK:         ^bb0(%[[X2:.*]]: f16, %{{.*}}: f32, %{{.*}}: f32, %{{.*}}: f16):
+// CHECK:           arith.extf %[[X2]] : f16 to f32
+// CHECK:           %[[OUT:.*]] = arith.truncf %{{.*}} : f32 to f16
+// CHECK:           linalg.yield %[[OUT]] : f16
+// CHECK:         } -> tensor<2x64x64xf16>
+func.func @layer_norm_f16(%arg0 : tensor<2x64x64xf16>) -> tensor<2x64x64xf16> {
+  %0 = tcp.layer_norm %arg0 {axis = 1 : i64, epsilon = 1.000000e-05 : f64} : tensor<2x64x64xf16> -> tensor<2x64x64xf16>
+  return %0 : tensor<2x64x64xf16>
+}
+
+// -----
+
+// CHECK-DAG: #[[ID_MAP:.*]] = affine_map<(d0, d1, d2) -> (d0, d1, d2)>
+// CHECK-DAG: #[[ROW_MAP:.*]] = affine_map<(d0, d1, d2) -> (d0)>
+// CHECK-LABEL: func.func @rms_norm(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x?x8xf32>) -> tensor<2x?x8xf32>
+// CHECK:         %[[SUM:.*]] = linalg.generic {indexing_maps = [#[[ID_MAP]], #[[ROW_MAP]]], iterator_types = ["parallel", "reduction", "reduction"]} ins(%[[ARG0]] : tensor<2x?x8xf32>)
+// CHECK:           %[[SQUARE:.*]] = arith.mulf
+// CHECK:           arith.addf %[[SQUARE]]
+// CHECK:         } -> tensor<2xf32>
+// CHECK:         %[[C1:.*]] = arith.constant 1 : index
+// CHECK:         %[[DIM:.*]] = tensor.dim %[[ARG0]], %[[C1]] : tensor<2x?x8xf32>
+// CHECK:         %[[C8:.*]] = arith.constant 8 : index
+// CHECK:         %[[NUM:.*]] = arith.muli %[[DIM]], %[[C8]] : index
+// CHECK:         %[[NUM_I64:.*]] = arith.index_cast %[[NUM]] : index to i64
+// CHECK:         %[[COUNT:.*]] = arith.sitofp %[[NUM_I64]] : i64 to f32
+// CHECK:         %[[RSTD:.*]] = linalg.generic {{.*}} ins(%[[SUM]] : tensor<2xf32>)
+// CHECK:           arith.divf %{{.*}}, %[[COUNT]] : f32
+// CHECK:           math.rsqrt
+// CHECK:         linalg.generic {indexing_maps = [#[[ID_MAP]], #[[ROW_MAP]], #[[ID_MAP]]], iterator_types = ["parallel", "parallel", "parallel"]} ins(%[[ARG0]], %[[RSTD]] : tensor<2x?x8xf32>, tensor<2xf32>)
+// CHECK:           %[[OUT:.*]] = arith.mulf
+// CHECK:           linalg.yield %[[OUT]] : f32
+// CHECK:         } -> tensor<2x?x8xf32>
+func.func @rms_norm(%arg0 : tensor<2x?x8xf32>) -> tensor<2x?x8xf32> {
+  %0 = tcp.rms_norm %arg0 {axis = 1 : i64, epsilon = 1.000000e-06 : f64} : tensor<2x?x8xf32> -> tensor<2x?x8xf32>
+  return %0 : tensor<2x?x8xf32>
+}
@@ -0,0 +1,89 @@
+// RUN: tcp-opt %s -convert-tcp-to-linalg -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @max_pool2d(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<1x64x112x112xf32>) -> tensor<1x64x56x56xf32>
+// CHECK:         %[[NEG_INF:.*]] = arith.constant 0xFF800000 : f32
+// CHECK:         %[[PADDED:.*]] = tensor.pad %[[ARG0]] low[0, 0, 1, 1] high[0, 0, 1, 1] {
+// CHECK:           tensor.yield %[[NEG_INF]] : f32
+// CHECK:         } : tensor<1x64x112x112xf32> to tensor<1x64x114x114xf32>
+// CHECK:         %[[EMPTY:.*]] = tensor.empty() : tensor<1x64x56x56xf32>
+// CHECK:         %[[INIT:.*]] = linalg.fill ins(%[[NEG_INF]] : f32) outs(%[[EMPTY]] : tensor<1x64x56x56xf32>) -> tensor<1x64x56x56xf32>
+// CHECK:         %[[WINDOW:.*]] = tensor.empty() : tensor<3x3xf32>
+// CHECK:         %[[POOL:.*]] = linalg.pooling_nchw_max {dilations = dense<1> : vector<2xi64>, strides = dense<2> : vector<2xi64>} ins(%[[PADDED]], %[[WINDOW]] : tensor<1x64x114x114xf32>, tensor<3x3xf32>) outs(%[[INIT]] : tensor<1x64x56x56xf32>) -> tensor<1x64x56x56xf32>
+// CHECK:         return %[[POOL]] : tensor<1x64x56x56xf32>
+func.func @max_pool2d(%arg0 : tensor<1x64x112x112xf32>) -> tensor<1x64x56x56xf32> {
+  %0 = tcp.max_pool2d %arg0 {kernel_size = [3, 3], stride = [2, 2], padding = [1, 1], dilation = [1, 1]} : tensor<1x64x112x112xf32> -> tensor<1x64x56x56xf32>
+  return %0 : tensor<1x64x56x56xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @max_pool2d_int(
+// CHECK:         %[[MIN:.*]] = arith.constant -128 : i8
+// CHECK-NOT:     tensor.pad
+// CHECK:         linalg.fill ins(%[[MIN]] : i8)
+// CHECK:         linalg.pooling_nchw_max {dilations = dense<2> : vector<2xi64>, strides = dense<1> : vector<2xi64>}
+func.func @max_pool2d_int(%arg0 : tensor<1x4x8x8xi8>) -> tensor<1x4x6x6xi8> {
+  %0 = tcp.max_pool2d %arg0 {kernel_size = [2, 2], stride = [1, 1], padding = [0, 0], dilation = [2, 2]} : tensor<1x4x8x8xi8> -> tensor<1x4x6x6xi8>
+  return %0 : tensor<1x4x6x6xi8>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @avg_pool2d(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<1x8x8x8xf32>) -> tensor<1x8x4x4xf32>
+// CHECK:         %[[ZERO:.*]] = arith.constant 0.000000e+00 : f32
+// CHECK:         %[[PADDED:.*]] = tensor.pad %[[ARG0]] low[0, 0, 1, 1] high[0, 0, 1, 1]
+// CHECK:         %[[INIT:.*]] = linalg.fill ins(%[[ZERO]] : f32)
+// CHECK:         %[[SUM:.*]] = linalg.pooling_nchw_sum {dilations = dense<1> : vector<2xi64>, strides = dense<2> : vector<2xi64>} ins(%[[PADDED]], %{{.*}} : tensor<1x8x10x10xf32>, tensor<3x3xf32>) outs(%[[INIT]] : tensor<1x8x4x4xf32>) -> tensor<1x8x4x4xf32>
+// CHECK:         %[[NINE:.*]] = arith.constant 9.000000e+00 : f32
+// CHECK:         %[[MEAN:.*]] = linalg.generic {{.*}} iterator_types = ["parallel", "parallel", "parallel", "parallel"]} outs(%[[SUM]] : tensor<1x8x4x4xf32>) {
+// CHECK:         ^bb0(%[[S:.*]]: f32):
+// CHECK:           %[[DIV:.*]] = arith.divf %[[S]], %[[NINE]] : f32
+// CHECK:           linalg.yield %[[DIV]] : f32
+// CHECK:         } -> tensor<1x8x4x4xf32>
+// CHECK:         return %[[MEAN]] : tensor<1x8x4x4xf32>
+func.func @avg_pool2d(%arg0 : tensor<1x8x8x8xf32>) -> tensor<1x8x4x4xf32> {
+  %0 = tcp.avg_pool2d %arg0 {kernel_size = [3, 3], stride = [2, 2], padding = [1, 1]} : tensor<1x8x8x8xf32> -> tensor<1x8x4x4xf32>
+  return %0 : tensor<1x8x4x4xf32>
+}
+
+// -----
+
+// Without `count_include_pad`, the windows at the borders are divided by the
+// number of input elements they cover.
+
+// CHECK-LABEL: func.func @avg_pool2d_exclude_pad(
+// CHECK:         %[[SUM:.*]] = linalg.pooling_nchw_sum
+// CHECK:         linalg.generic {{.*}} outs(%[[SUM]] : tensor<1x8x4x4xf32>) {
+// CHECK:         ^bb0(%[[S:.*]]: f32):
+// CHECK:           linalg.index 2 : index
+// CHECK:           arith.minsi
+// CHECK:           arith.maxsi
+// CHECK:           linalg.index 3 : index
+// CHECK:           arith.minsi
+// CHECK:           arith.maxsi
+// CHECK:           %[[COUNT:.*]] = arith.muli
+// CHECK:           %[[COUNT_INT:.*]] = arith.index_cast %[[COUNT]] : index to i64
+// CHECK:           %[[COUNT_FP:.*]] = arith.sitofp %[[COUNT_INT]] : i64 to f32
+// CHECK:           %[[DIV:.*]] = arith.divf %[[S]], %[[COUNT_FP]] : f32
+// CHECK:           linalg.yield %[[DIV]] : f32
+func.func @avg_pool2d_exclude_pad(%arg0 : tensor<1x8x8x8xf32>) -> tensor<1x8x4x4xf32> {
+  %0 = tcp.avg_pool2d %arg0 {kernel_size = [3, 3], stride = [2, 2], padding = [1, 1], count_include_pad = false} : tensor<1x8x8x8xf32> -> tensor<1x8x4x4xf32>
+  return %0 : tensor<1x8x4x4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @max_pool2d_dynamic(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x4x?x?xf32>) -> tensor<?x4x?x?xf32>
+// CHECK:         %[[PADDED:.*]] = tensor.pad %[[ARG0]] low[0, 0, 1, 1] high[0, 0, 1, 1]
+// CHECK:         } : tensor<?x4x?x?xf32> to tensor<?x4x?x?xf32>
+// CHECK:         tensor.dim %[[PADDED]]
+// CHECK:         arith.divui
+// CHECK:         %[[EMPTY:.*]] = tensor.empty(%{{.*}}, %{{.*}}, %{{.*}}) : tensor<?x4x?x?xf32>
+// CHECK:         linalg.pooling_nchw_max {{.*}} -> tensor<?x4x?x?xf32>
+func.func @max_pool2d_dynamic(%arg0 : tensor<?x4x?x?xf32>) -> tensor<?x4x?x?xf32> {
+  %0 = tcp.max_pool2d %arg0 {kernel_size = [3, 3], stride = [2, 2], padding = [1, 1], dilation = [1, 1]} : tensor<?x4x?x?xf32> -> tensor<?x4x?x?xf32>
+  return %0 : tensor<?x4x?x?xf32>
+}
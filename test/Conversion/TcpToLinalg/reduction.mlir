@@ -0,0 +1,211 @@
+// RUN: tcp-opt %s -convert-tcp-to-linalg -split-input-file | FileCheck %s
+// RUN: tcp-opt %s -convert-tcp-to-linalg="reassociate-fp=true" -split-input-file | FileCheck %s --check-prefix=CHECK-FP
+
+// CHECK-LABEL: func.func @reduce_sum(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x8xf32>) -> tensor<?xf32>
+// CHECK:         %[[C0:.*]] = arith.constant 0 : index
+// CHECK:         %[[DIM:.*]] = tensor.dim %[[ARG0]], %[[C0]] : tensor<?x8xf32>
+// CHECK:         %[[EMPTY:.*]] = tensor.empty(%[[DIM]]) : tensor<?xf32>
+// CHECK:         %[[ZERO:.*]] = arith.constant 0.000000e+00 : f32
+// CHECK:         %[[FILL:.*]] = linalg.fill ins(%[[ZERO]] : f32) outs(%[[EMPTY]] : tensor<?xf32>) -> tensor<?xf32>
+// CHECK:         %[[REDUCE:.*]] = linalg.reduce ins(%[[ARG0]] : tensor<?x8xf32>) outs(%[[FILL]] : tensor<?xf32>) dimensions = [1]
+// CHECK:           (%[[IN:.*]]: f32, %[[ACC:.*]]: f32) {
+// CHECK:             %[[ADD:.*]] = arith.addf %[[IN]], %[[ACC]] : f32
+// CHECK:             linalg.yield %[[ADD]] : f32
+// CHECK:           }
+// CHECK:         return %[[REDUCE]] : tensor<?xf32>
+func.func @reduce_sum(%arg0 : tensor<?x8xf32>) -> tensor<?xf32> {
+  %0 = tcp.reduce_sum %arg0 {axes = [1]} : tensor<?x8xf32> -> tensor<?xf32>
+  return %0 : tensor<?xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @reduce_max_keepdim(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x4x8xf32>) -> tensor<1x4x1xf32>
+// CHECK:         %[[EMPTY:.*]] = tensor.empty() : tensor<4xf32>
+// CHECK:         %[[NEG_INF:.*]] = arith.constant 0xFF800000 : f32
+// CHECK:         %[[FILL:.*]] = linalg.fill ins(%[[NEG_INF]] : f32) outs(%[[EMPTY]] : tensor<4xf32>) -> tensor<4xf32>
+// CHECK:         %[[REDUCE:.*]] = linalg.reduce ins(%[[ARG0]] : tensor<2x4x8xf32>) outs(%[[FILL]] : tensor<4xf32>) dimensions = [0, 2]
+// CHECK:             arith.maximumf
+// CHECK:         %[[EXPAND:.*]] = tensor.expand_shape %[[REDUCE]] {{\[}}[0, 1, 2]] output_shape [1, 4, 1] : tensor<4xf32> into tensor<1x4x1xf32>
+// CHECK:         return %[[EXPAND]] : tensor<1x4x1xf32>
+func.func @reduce_max_keepdim(%arg0 : tensor<2x4x8xf32>) -> tensor<1x4x1xf32> {
+  %0 = tcp.reduce_max %arg0 {axes = [0, 2], keepdim = true} : tensor<2x4x8xf32> -> tensor<1x4x1xf32>
+  return %0 : tensor<1x4x1xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @reduce_min_int(
+// CHECK:         %[[MAX:.*]] = arith.constant 2147483647 : i32
+// CHECK:         linalg.fill ins(%[[MAX]] : i32)
+// CHECK:         linalg.reduce
+// CHECK:             arith.minsi
+func.func @reduce_min_int(%arg0 : tensor<4x8xi32>) -> tensor<8xi32> {
+  %0 = tcp.reduce_min %arg0 {axes = [0]} : tensor<4x8xi32> -> tensor<8xi32>
+  return %0 : tensor<8xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @reduce_max_bool(
+// CHECK:         %[[FALSE:.*]] = arith.constant false
+// CHECK:         linalg.fill ins(%[[FALSE]] : i1)
+// CHECK:         linalg.reduce
+// CHECK:             arith.maxui
+func.func @reduce_max_bool(%arg0 : tensor<4x8xi1>) -> tensor<8xi1> {
+  %0 = tcp.reduce_max %arg0 {axes = [0]} : tensor<4x8xi1> -> tensor<8xi1>
+  return %0 : tensor<8xi1>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @reduce_min_bool(
+// CHECK:         %[[TRUE:.*]] = arith.constant true
+// CHECK:         linalg.fill ins(%[[TRUE]] : i1)
+// CHECK:         linalg.reduce
+// CHECK:             arith.minui
+func.func @reduce_min_bool(%arg0 : tensor<4x8xi1>) -> tensor<8xi1> {
+  %0 = tcp.reduce_min %arg0 {axes = [0]} : tensor<4x8xi1> -> tensor<8xi1>
+  return %0 : tensor<8xi1>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @reduce_prod_all_keepdim(
+// CHECK:         %[[ONE:.*]] = arith.constant 1 : i64
+// CHECK:         %[[FILL:.*]] = linalg.fill ins(%[[ONE]] : i64) outs(%{{.*}} : tensor<i64>) -> tensor<i64>
+// CHECK:         %[[REDUCE:.*]] = linalg.reduce ins(%{{.*}} : tensor<4x8xi64>) outs(%[[FILL]] : tensor<i64>) dimensions = [0, 1]
+// CHECK:             arith.muli
+// CHECK:         tensor.expand_shape %[[REDUCE]] [] output_shape [1, 1] : tensor<i64> into tensor<1x1xi64>
+func.func @reduce_prod_all_keepdim(%arg0 : tensor<4x8xi64>) -> tensor<1x1xi64> {
+  %0 = tcp.reduce_prod %arg0 {axes = [0, 1], keepdim = true} : tensor<4x8xi64> -> tensor<1x1xi64>
+  return %0 : tensor<1x1xi64>
+}
+
+// -----
+
+// Rows are scanned in parallel. Floating point rows are scanned in order,
+// unless reassociation is allowed: then each chunk of 8 elements is scanned
+// in log2(8) steps of independent ops, and combined with the carry from the
+// previous chunks.
+
+// CHECK-LABEL: func.func @cumsum(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x16xf32>) -> tensor<?x16xf32>
+// CHECK:         %[[EMPTY:.*]] = tensor.empty(%{{.*}}) : tensor<?x16xf32>
+// CHECK:         %[[ZERO:.*]] = arith.constant 0.000000e+00 : f32
+// CHECK:         %[[RES:.*]] = scf.forall (%[[I:.*]]) in (%{{.*}}) shared_outs(%[[OUT:.*]] = %[[EMPTY]]) -> (tensor<?x16xf32>) {
+// CHECK:           %[[ROW:.*]] = tensor.extract_slice %[[ARG0]][%[[I]], 0] [1, 16] [1, 1] : tensor<?x16xf32> to tensor<16xf32>
+// CHECK:           %[[ROW_OUT:.*]] = tensor.extract_slice %[[OUT]][%[[I]], 0] [1, 16] [1, 1] : tensor<?x16xf32> to tensor<16xf32>
+// CHECK:           %[[SCAN:.*]]:2 = scf.for %[[J:.*]] = %{{.*}} to %{{.*}} step %{{.*}} iter_args(%[[CARRY:.*]] = %[[ZERO]], %[[ACC:.*]] = %[[ROW_OUT]]) -> (f32, tensor<16xf32>) {
+// CHECK:             %[[X:.*]] = tensor.extract %[[ROW]][%[[J]]] : tensor<16xf32>
+// CHECK:             %[[NEW_CARRY:.*]] = arith.addf %[[X]], %[[CARRY]] : f32
+// CHECK:             %[[NEW_ACC:.*]] = tensor.insert %[[NEW_CARRY]] into %[[ACC]][%[[J]]] : tensor<16xf32>
+// CHECK:             scf.yield %[[NEW_CARRY]], %[[NEW_ACC]] : f32, tensor<16xf32>
+// CHECK:           }
+// CHECK-NOT:       scf.for
+// CHECK:           scf.forall.in_parallel {
+// CHECK:             tensor.parallel_insert_slice %[[SCAN]]#1 into %[[OUT]][%[[I]], 0] [1, 16] [1, 1] : tensor<16xf32> into tensor<?x16xf32>
+// CHECK:           }
+// CHECK:         }
+// CHECK:         return %[[RES]] : tensor<?x16xf32>
+
+// CHECK-FP-LABEL: func.func @cumsum(
+// CHECK-FP-SAME:          %[[ARG0:.*]]: tensor<?x16xf32>) -> tensor<?x16xf32>
+// CHECK-FP:         %[[EMPTY:.*]] = tensor.empty(%{{.*}}) : tensor<?x16xf32>
+// CHECK-FP:         %[[ZERO:.*]] = arith.constant 0.000000e+00 : f32
+// CHECK-FP:         %[[RES:.*]] = scf.forall (%[[I:.*]]) in (%{{.*}}) shared_outs(%[[OUT:.*]] = %[[EMPTY]]) -> (tensor<?x16xf32>) {
+// CHECK-FP:           %[[ROW:.*]] = tensor.extract_slice %[[ARG0]][%[[I]], 0] [1, 16] [1, 1] : tensor<?x16xf32> to tensor<16xf32>
+// CHECK-FP:           %[[ROW_OUT:.*]] = tensor.extract_slice %[[OUT]][%[[I]], 0] [1, 16] [1, 1] : tensor<?x16xf32> to tensor<16xf32>
+// CHECK-FP:           %[[CHUNKS:.*]]:2 = scf.for %{{.*}} = %{{.*}} to %{{.*}} step %{{.*}} iter_args(%[[CARRY:.*]] = %[[ZERO]], %{{.*}} = %[[ROW_OUT]]) -> (f32, tensor<16xf32>) {
+// CHECK-FP-COUNT-8:     tensor.extract %[[ROW]]
+// CHECK-FP-NOT:         scf.if
+// CHECK-FP-COUNT-17:    arith.addf
+// CHECK-FP-COUNT-7:     tensor.insert
+// CHECK-FP:             %[[LAST:.*]] = arith.addf %{{.*}}, %[[CARRY]] : f32
+// CHECK-FP:             %[[NEW_OUT:.*]] = tensor.insert %[[LAST]] into
+// CHECK-FP:             scf.yield %[[LAST]], %[[NEW_OUT]] : f32, tensor<16xf32>
+// CHECK-FP:           }
+// CHECK-FP:           %[[REST:.*]]:2 = scf.for %{{.*}} = %{{.*}} to %{{.*}} step %{{.*}} iter_args(%{{.*}} = %[[CHUNKS]]#0, %{{.*}} = %[[CHUNKS]]#1) -> (f32, tensor<16xf32>) {
+// CHECK-FP:           scf.forall.in_parallel {
+// CHECK-FP:             tensor.parallel_insert_slice %[[REST]]#1 into %[[OUT]][%[[I]], 0] [1, 16] [1, 1] : tensor<16xf32> into tensor<?x16xf32>
+// CHECK-FP:           }
+// CHECK-FP:         }
+// CHECK-FP:         return %[[RES]] : tensor<?x16xf32>
+func.func @cumsum(%arg0 : tensor<?x16xf32>) -> tensor<?x16xf32> {
+  %0 = tcp.cumsum %arg0 {dim = 1} : tensor<?x16xf32> -> tensor<?x16xf32>
+  return %0 : tensor<?x16xf32>
+}
+
+// -----
+
+// Long rows are split into blocks of 4096 elements. The blocks are reduced in
+// parallel, their totals are scanned into the offsets of the blocks, and the
+// blocks are scanned in parallel after their offsets.
+
+// CHECK-LABEL: func.func @cumprod_blocked(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?xi64>) -> tensor<?xi64>
+// CHECK:         %[[EMPTY:.*]] = tensor.empty(%{{.*}}) : tensor<?xi64>
+// CHECK:         %[[C4096:.*]] = arith.constant 4096 : index
+// CHECK:         %[[NUM_BLOCKS:.*]] = arith.divui %{{.*}}, %[[C4096]] : index
+// CHECK:         %[[TOTALS_INIT:.*]] = tensor.empty(%[[NUM_BLOCKS]]) : tensor<?xi64>
+// CHECK:         %[[TOTALS:.*]] = scf.forall (%[[B:.*]]) in (%[[NUM_BLOCKS]]) shared_outs(%[[T:.*]] = %[[TOTALS_INIT]]) -> (tensor<?xi64>) {
+// CHECK:           %[[OFFSET:.*]] = arith.muli %[[B]], %[[C4096]] : index
+// CHECK:           %[[SIZE:.*]] = arith.minui %{{.*}}, %[[C4096]] : index
+// CHECK:           %[[BLOCK:.*]] = tensor.extract_slice %[[ARG0]][%[[OFFSET]]] [%[[SIZE]]] [1] : tensor<?xi64> to tensor<?xi64>
+// CHECK:           scf.for {{.*}} -> (i64, i64, i64, i64, i64, i64, i64, i64) {
+// CHECK-COUNT-8:     arith.muli %{{.*}}, %{{.*}} : i64
+// CHECK:           }
+// CHECK-COUNT-7:   arith.muli %{{.*}}, %{{.*}} : i64
+// CHECK:           %[[TOTAL:.*]] = scf.for {{.*}} -> (i64) {
+// CHECK:           %[[TOTAL_TENSOR:.*]] = tensor.from_elements %[[TOTAL]] : tensor<1xi64>
+// CHECK:           scf.forall.in_parallel {
+// CHECK:             tensor.parallel_insert_slice %[[TOTAL_TENSOR]] into %[[T]][%[[B]]] [1] [1] : tensor<1xi64> into tensor<?xi64>
+// CHECK:           }
+// CHECK:         }
+// CHECK:         %[[OFFSETS_INIT:.*]] = tensor.empty(%[[NUM_BLOCKS]]) : tensor<?xi64>
+// CHECK:         %[[ONE:.*]] = arith.constant 1 : i64
+// CHECK:         %[[OFFSETS:.*]]:2 = scf.for %[[K:.*]] = %{{.*}} to %{{.*}} step %{{.*}} iter_args(%[[CARRY:.*]] = %[[ONE]], %[[ACC:.*]] = %[[OFFSETS_INIT]]) -> (i64, tensor<?xi64>) {
+// CHECK:           %[[TOTAL_K:.*]] = tensor.extract %[[TOTALS]][%[[K]]] : tensor<?xi64>
+// CHECK:           %[[NEW_ACC:.*]] = tensor.insert %[[CARRY]] into %[[ACC]][%[[K]]] : tensor<?xi64>
+// CHECK:           %[[NEW_CARRY:.*]] = arith.muli %[[TOTAL_K]], %[[CARRY]] : i64
+// CHECK:           scf.yield %[[NEW_CARRY]], %[[NEW_ACC]] : i64, tensor<?xi64>
+// CHECK:         }
+// CHECK:         %[[RES:.*]] = scf.forall (%[[B3:.*]]) in (%[[NUM_BLOCKS]]) shared_outs(%[[OUT:.*]] = %[[EMPTY]]) -> (tensor<?xi64>) {
+// CHECK:           %[[OFFSET3:.*]] = arith.muli %[[B3]], %[[C4096]] : index
+// CHECK:           %[[SIZE3:.*]] = arith.minui %{{.*}}, %[[C4096]] : index
+// CHECK:           %[[INIT:.*]] = tensor.extract %[[OFFSETS]]#1[%[[B3]]] : tensor<?xi64>
+// CHECK:           %[[BLOCK3:.*]] = tensor.extract_slice %[[ARG0]][%[[OFFSET3]]] [%[[SIZE3]]] [1] : tensor<?xi64> to tensor<?xi64>
+// CHECK:           %[[BLOCK_OUT:.*]] = tensor.extract_slice %[[OUT]][%[[OFFSET3]]] [%[[SIZE3]]] [1] : tensor<?xi64> to tensor<?xi64>
+// CHECK:           scf.for %{{.*}} = %{{.*}} to %{{.*}} step %{{.*}} iter_args(%{{.*}} = %[[INIT]], %{{.*}} = %[[BLOCK_OUT]]) -> (i64, tensor<?xi64>) {
+// CHECK:           %[[SCANNED:.*]]:2 = scf.for
+// CHECK:           scf.forall.in_parallel {
+// CHECK:             tensor.parallel_insert_slice %[[SCANNED]]#1 into %[[OUT]][%[[OFFSET3]]] [%[[SIZE3]]] [1] : tensor<?xi64> into tensor<?xi64>
+// CHECK:           }
+// CHECK:         }
+// CHECK:         return %[[RES]] : tensor<?xi64>
+func.func @cumprod_blocked(%arg0 : tensor<?xi64>) -> tensor<?xi64> {
+  %0 = tcp.cumprod %arg0 {dim = 0} : tensor<?xi64> -> tensor<?xi64>
+  return %0 : tensor<?xi64>
+}
+
+// -----
+
+// Long floating point rows are not split into blocks, unless reassociation is
+// allowed.
+
+// CHECK-LABEL: func.func @cumprod_float_dynamic(
+// CHECK-NOT:     scf.forall
+// CHECK:         scf.for {{.*}} -> (f32, tensor<?xf32>) {
+// CHECK:           arith.mulf
+// CHECK:         }
+// CHECK-NOT:     scf.for
+
+// CHECK-FP-LABEL: func.func @cumprod_float_dynamic(
+// CHECK-FP:         scf.forall
+// CHECK-FP:         scf.forall
+func.func @cumprod_float_dynamic(%arg0 : tensor<?xf32>) -> tensor<?xf32> {
+  %0 = tcp.cumprod %arg0 {dim = 0} : tensor<?xf32> -> tensor<?xf32>
+  return %0 : tensor<?xf32>
+}
@@ -0,0 +1,130 @@
+// RUN: tcp-opt %s -convert-tcp-to-linalg -split-input-file | FileCheck %s
+
+// The rows are selected in parallel, each with a single pass that keeps the
+// best `k` elements so far sorted in the slices of the results.
+
+// CHECK-LABEL: func.func @topk(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x2304xf32>) -> (tensor<?x8xf32>, tensor<?x8xi64>)
+// CHECK:         %[[VALUES:.*]] = tensor.empty(%{{.*}}) : tensor<?x8xf32>
+// CHECK:         %[[INDICES:.*]] = tensor.empty(%{{.*}}) : tensor<?x8xi64>
+// CHECK:         %[[RES:.*]]:2 = scf.forall (%[[I:.*]]) in (%{{.*}}) shared_outs(%[[OUT0:.*]] = %[[VALUES]], %[[OUT1:.*]] = %[[INDICES]]) -> (tensor<?x8xf32>, tensor<?x8xi64>) {
+// CHECK:           %[[ROW:.*]] = tensor.extract_slice %[[ARG0]][%[[I]], 0] [1, 2304] [1, 1] : tensor<?x2304xf32> to tensor<2304xf32>
+// CHECK:           %[[ROW0:.*]] = tensor.extract_slice %[[OUT0]][%[[I]], 0] [1, 8] [1, 1] : tensor<?x8xf32> to tensor<8xf32>
+// CHECK:           %[[ROW1:.*]] = tensor.extract_slice %[[OUT1]][%[[I]], 0] [1, 8] [1, 1] : tensor<?x8xi64> to tensor<8xi64>
+// CHECK:           %[[SEL:.*]]:2 = scf.for %[[J:.*]] = %{{.*}} to %{{.*}} step %{{.*}} iter_args(%[[ACC0:.*]] = %[[ROW0]], %[[ACC1:.*]] = %[[ROW1]]) -> (tensor<8xf32>, tensor<8xi64>) {
+// CHECK:             %[[ELEM:.*]] = tensor.extract %[[ROW]][%[[J]]] : tensor<2304xf32>
+// CHECK:             %[[FULL:.*]] = arith.cmpi uge, %[[J]], %{{.*}} : index
+// CHECK:             %[[SELECTED:.*]] = scf.if %[[FULL]] -> (i1) {
+// CHECK:               %[[WORST:.*]] = tensor.extract %[[ACC0]][%{{.*}}] : tensor<8xf32>
+// CHECK:               arith.cmpf ogt, %[[ELEM]], %[[WORST]] : f32
+// CHECK:             } else {
+// CHECK:             %[[INSERT:.*]]:2 = scf.if %[[SELECTED]] -> (tensor<8xf32>, tensor<8xi64>) {
+// CHECK:               %[[SLOT:.*]] = arith.minui %[[J]], %{{.*}} : index
+// CHECK:               %[[INDEX:.*]] = arith.index_cast %[[J]] : index to i64
+// CHECK:               %[[SHIFT:.*]]:3 = scf.while
+// CHECK:               %[[NEW0:.*]] = tensor.insert %[[ELEM]] into %[[SHIFT]]#1[%[[SHIFT]]#0] : tensor<8xf32>
+// CHECK:               %[[NEW1:.*]] = tensor.insert %[[INDEX]] into %[[SHIFT]]#2[%[[SHIFT]]#0] : tensor<8xi64>
+// CHECK:               scf.yield %[[NEW0]], %[[NEW1]] : tensor<8xf32>, tensor<8xi64>
+// CHECK:             } else {
+// CHECK:               scf.yield %[[ACC0]], %[[ACC1]] : tensor<8xf32>, tensor<8xi64>
+// CHECK:             }
+// CHECK:             scf.yield %[[INSERT]]#0, %[[INSERT]]#1 : tensor<8xf32>, tensor<8xi64>
+// CHECK:           }
+// CHECK:           scf.forall.in_parallel {
+// CHECK:             tensor.parallel_insert_slice %[[SEL]]#0 into %[[OUT0]][%[[I]], 0] [1, 8] [1, 1] : tensor<8xf32> into tensor<?x8xf32>
+// CHECK:             tensor.parallel_insert_slice %[[SEL]]#1 into %[[OUT1]][%[[I]], 0] [1, 8] [1, 1] : tensor<8xi64> into tensor<?x8xi64>
+// CHECK:           }
+// CHECK:         }
+// CHECK:         return %[[RES]]#0, %[[RES]]#1 : tensor<?x8xf32>, tensor<?x8xi64>
+func.func @topk(%arg0 : tensor<?x2304xf32>) -> (tensor<?x8xf32>, tensor<?x8xi64>) {
+  %values, %indices = tcp.topk %arg0 {k = 8, dim = 1} : tensor<?x2304xf32> -> tensor<?x8xf32>, tensor<?x8xi64>
+  return %values, %indices : tensor<?x8xf32>, tensor<?x8xi64>
+}
+
+// -----
+
+// A single row is selected directly into the results. Integers are compared
+// as signed.
+
+// CHECK-LABEL: func.func @topk_1d_smallest(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?xi32>) -> (tensor<4xi32>, tensor<4xi64>)
+// CHECK-NOT:     scf.forall
+// CHECK:         %[[VALUES:.*]] = tensor.empty() : tensor<4xi32>
+// CHECK:         %[[INDICES:.*]] = tensor.empty() : tensor<4xi64>
+// CHECK:         %[[DIM:.*]] = tensor.dim %[[ARG0]], %{{.*}} : tensor<?xi32>
+// CHECK:         %[[SEL:.*]]:2 = scf.for %{{.*}} = %{{.*}} to %[[DIM]] step %{{.*}} iter_args(%{{.*}} = %[[VALUES]], %{{.*}} = %[[INDICES]]) -> (tensor<4xi32>, tensor<4xi64>) {
+// CHECK:           arith.cmpi slt
+// CHECK:         return %[[SEL]]#0, %[[SEL]]#1 : tensor<4xi32>, tensor<4xi64>
+func.func @topk_1d_smallest(%arg0 : tensor<?xi32>) -> (tensor<4xi32>, tensor<4xi64>) {
+  %values, %indices = tcp.topk %arg0 {k = 4, dim = 0, largest = false} : tensor<?xi32> -> tensor<4xi32>, tensor<4xi64>
+  return %values, %indices : tensor<4xi32>, tensor<4xi64>
+}
+
+// -----
+
+// Short rows are sorted in parallel, each with a sorting network without
+// branches. With `stable`, equal elements are ordered by index.
+
+// CHECK-LABEL: func.func @sort_network(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x4xf32>) -> (tensor<?x4xf32>, tensor<?x4xi64>)
+// CHECK:         %[[VALUES:.*]] = tensor.empty(%{{.*}}) : tensor<?x4xf32>
+// CHECK:         %[[INDICES:.*]] = tensor.empty(%{{.*}}) : tensor<?x4xi64>
+// CHECK:         %[[RES:.*]]:2 = scf.forall (%[[I:.*]]) in (%{{.*}}) shared_outs(%[[OUT0:.*]] = %[[VALUES]], %[[OUT1:.*]] = %[[INDICES]]) -> (tensor<?x4xf32>, tensor<?x4xi64>) {
+// CHECK:           %[[ROW:.*]] = tensor.extract_slice %[[ARG0]][%[[I]], 0] [1, 4] [1, 1] : tensor<?x4xf32> to tensor<4xf32>
+// CHECK-COUNT-4:   tensor.extract %[[ROW]]
+// CHECK-NOT:       scf.if
+// CHECK:           arith.cmpf ogt
+// CHECK:           arith.cmpi slt
+// CHECK:           arith.select
+// CHECK:           %[[SORTED0:.*]] = tensor.from_elements %{{.*}}, %{{.*}}, %{{.*}}, %{{.*}} : tensor<4xf32>
+// CHECK:           %[[SORTED1:.*]] = tensor.from_elements %{{.*}}, %{{.*}}, %{{.*}}, %{{.*}} : tensor<4xi64>
+// CHECK:           scf.forall.in_parallel {
+// CHECK:             tensor.parallel_insert_slice %[[SORTED0]] into %[[OUT0]][%[[I]], 0] [1, 4] [1, 1] : tensor<4xf32> into tensor<?x4xf32>
+// CHECK:             tensor.parallel_insert_slice %[[SORTED1]] into %[[OUT1]][%[[I]], 0] [1, 4] [1, 1] : tensor<4xi64> into tensor<?x4xi64>
+// CHECK:           }
+// CHECK:         }
+// CHECK:         return %[[RES]]#0, %[[RES]]#1 : tensor<?x4xf32>, tensor<?x4xi64>
+func.func @sort_network(%arg0 : tensor<?x4xf32>) -> (tensor<?x4xf32>, tensor<?x4xi64>) {
+  %values, %indices = tcp.sort %arg0 {dim = 1, descending = true, stable = true} : tensor<?x4xf32> -> tensor<?x4xf32>, tensor<?x4xi64>
+  return %values, %indices : tensor<?x4xf32>, tensor<?x4xi64>
+}
+
+// -----
+
+// Long rows are merge sorted. The runs of 16 elements are sorted by insertion
+// in parallel, then each pass merges pairs of adjacent runs in parallel.
+
+// CHECK-LABEL: func.func @sort_merge(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?xi32>) -> (tensor<?xi32>, tensor<?xi64>)
+// CHECK:         %[[C16:.*]] = arith.constant 16 : index
+// CHECK:         %[[NUM_RUNS:.*]] = arith.divui %{{.*}}, %[[C16]] : index
+// CHECK:         %[[RUNS:.*]]:2 = scf.forall (%[[RUN:.*]]) in (%[[NUM_RUNS]]) shared_outs(%[[OUT0:.*]] = %{{.*}}, %[[OUT1:.*]] = %{{.*}}) -> (tensor<?xi32>, tensor<?xi64>) {
+// CHECK:           %[[OFFSET:.*]] = arith.muli %[[RUN]], %[[C16]] : index
+// CHECK:           %[[RUN_SIZE:.*]] = arith.minui %{{.*}}, %[[C16]] : index
+// CHECK:           %[[ROW:.*]] = tensor.extract_slice %[[ARG0]][%[[OFFSET]]] [%[[RUN_SIZE]]] [1] : tensor<?xi32> to tensor<?xi32>
+// CHECK:           %[[SORTED:.*]]:2 = scf.for
+// CHECK:             scf.while
+// CHECK:           scf.forall.in_parallel {
+// CHECK:             tensor.parallel_insert_slice %[[SORTED]]#0 into %[[OUT0]][%[[OFFSET]]] [%[[RUN_SIZE]]] [1] : tensor<?xi32> into tensor<?xi32>
+// CHECK:             tensor.parallel_insert_slice %[[SORTED]]#1 into %[[OUT1]][%[[OFFSET]]] [%[[RUN_SIZE]]] [1] : tensor<?xi64> into tensor<?xi64>
+// CHECK:           }
+// CHECK:         }
+// CHECK:         %[[PASSES:.*]]:3 = scf.while (%[[WIDTH:.*]] = %[[C16]], %{{.*}} = %[[RUNS]]#0, %{{.*}} = %[[RUNS]]#1) : (index, tensor<?xi32>, tensor<?xi64>) -> (index, tensor<?xi32>, tensor<?xi64>) {
+// CHECK:           %[[UNSORTED:.*]] = arith.cmpi ult, %[[WIDTH]], %{{.*}} : index
+// CHECK:           scf.condition(%[[UNSORTED]])
+// CHECK:         } do {
+// CHECK:         ^bb0(%[[W:.*]]: index, %{{.*}}: tensor<?xi32>, %{{.*}}: tensor<?xi64>):
+// CHECK:           %[[PAIR_SIZE:.*]] = arith.addi %[[W]], %[[W]] : index
+// CHECK:           %[[NUM_PAIRS:.*]] = arith.divui %{{.*}}, %[[PAIR_SIZE]] : index
+// CHECK:           %[[MERGED:.*]]:2 = scf.forall (%{{.*}}) in (%[[NUM_PAIRS]])
+// CHECK:             scf.for
+// CHECK-NOT:           scf.if
+// CHECK:               arith.cmpi sgt
+// CHECK:               arith.select
+// CHECK:           scf.yield %[[PAIR_SIZE]], %[[MERGED]]#0, %[[MERGED]]#1 : index, tensor<?xi32>, tensor<?xi64>
+// CHECK:         }
+// CHECK:         return %[[PASSES]]#1, %[[PASSES]]#2 : tensor<?xi32>, tensor<?xi64>
+func.func @sort_merge(%arg0 : tensor<?xi32>) -> (tensor<?xi32>, tensor<?xi64>) {
+  %values, %indices = tcp.sort %arg0 {dim = 0, descending = true} : tensor<?xi32> -> tensor<?xi32>, tensor<?xi64>
+  return %values, %indices : tensor<?xi32>, tensor<?xi64>
+}
@@ -19,3 +19,59 @@ func.func @test_slice(%arg0: tensor<1x56x?x?xf32>) -> tensor<1x28x?x?xf32> {
   %1 = tcp.slice %arg0 starts( %c0, %c0, %c0, %c0 ) sizes( %c1, %c28, %dim, %dim_0 ) strides( %c1, %c2, %c1, %c1 ) : tensor<1x56x?x?xf32> -> tensor<1x28x?x?xf32>
   return %1 : tensor<1x28x?x?xf32>
 }
+
+// -----
+
+// CHECK-LABEL: func.func @test_reshape(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x4xf32>, %[[ARG1:.*]]: index) -> tensor<4x?xf32>
+// CHECK:           %[[C4:.*]] = arith.constant 4 : index
+// CHECK:           %[[SHAPE:.*]] = tensor.from_elements %[[C4]], %[[ARG1]] : tensor<2xindex>
+// CHECK:           %[[RESHAPE:.*]] = tensor.reshape %[[ARG0]](%[[SHAPE]]) : (tensor<?x4xf32>, tensor<2xindex>) -> tensor<4x?xf32>
+// CHECK:           return %[[RESHAPE]] : tensor<4x?xf32>
+func.func @test_reshape(%arg0: tensor<?x4xf32>, %arg1: index) -> tensor<4x?xf32> {
+  %c4 = arith.constant 4 : index
+  %0 = tcp.reshape %arg0 shape(%c4, %arg1) : tensor<?x4xf32> -> tensor<4x?xf32>
+  return %0 : tensor<4x?xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_expand_collapse_shape(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x384xf32>) -> tensor<?x16xf32>
+// CHECK:           %[[EXPANDED:.*]] = tensor.expand_shape %[[ARG0]] {{\[\[}}0], [1, 2]] output_shape [%{{.*}}, 24, 16] : tensor<?x384xf32> into tensor<?x24x16xf32>
+// CHECK:           %[[COLLAPSED:.*]] = tensor.collapse_shape %[[EXPANDED]] {{\[\[}}0, 1], [2]] : tensor<?x24x16xf32> into tensor<?x16xf32>
+// CHECK:           return %[[COLLAPSED]] : tensor<?x16xf32>
+func.func @test_expand_collapse_shape(%arg0: tensor<?x384xf32>) -> tensor<?x16xf32> {
+  %0 = tcp.expand_shape %arg0 {reassociation = [[0], [1, 2]]} : tensor<?x384xf32> -> tensor<?x24x16xf32>
+  %1 = tcp.collapse_shape %0 {reassociation = [[0, 1], [2]]} : tensor<?x24x16xf32> -> tensor<?x16xf32>
+  return %1 : tensor<?x16xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_slice_scatter(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<4x9xf32>, %[[ARG1:.*]]: tensor<4x?xf32>, %[[ARG2:.*]]: index) -> tensor<4x9xf32>
+// CHECK:           %[[DIM:.*]] = tensor.dim %[[ARG1]], %{{.*}} : tensor<4x?xf32>
+// CHECK:           %[[INSERT:.*]] = tensor.insert_slice %[[ARG1]] into %[[ARG0]][0, %[[ARG2]]] [4, %[[DIM]]] [1, 2] : tensor<4x?xf32> into tensor<4x9xf32>
+// CHECK:           return %[[INSERT]] : tensor<4x9xf32>
+func.func @test_slice_scatter(%arg0: tensor<4x9xf32>, %arg1: tensor<4x?xf32>, %arg2: index) -> tensor<4x9xf32> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %c2 = arith.constant 2 : index
+  %0 = tcp.slice_scatter %arg0, %arg1 starts(%c0, %arg2) strides(%c1, %c2) : tensor<4x9xf32>, tensor<4x?xf32> -> tensor<4x9xf32>
+  return %0 : tensor<4x9xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_pad(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<4x?xf32>, %[[ARG1:.*]]: tensor<f32>) -> tensor<5x?xf32>
+// CHECK:           %[[VAL:.*]] = tensor.extract %[[ARG1]][] : tensor<f32>
+// CHECK:           %[[PAD:.*]] = tensor.pad %[[ARG0]] low[1, 1] high[0, 2]
+// CHECK:             tensor.yield %[[VAL]] : f32
+// CHECK:           } : tensor<4x?xf32> to tensor<5x?xf32>
+// CHECK:           return %[[PAD]] : tensor<5x?xf32>
+func.func @test_pad(%arg0: tensor<4x?xf32>, %arg1: tensor<f32>) -> tensor<5x?xf32> {
+  %0 = tcp.pad %arg0, %arg1 {low = [1, 1], high = [0, 2]} : tensor<4x?xf32>, tensor<f32> -> tensor<5x?xf32>
+  return %0 : tensor<5x?xf32>
+}
@@ -0,0 +1,172 @@
+// RUN: tcp-opt %s -convert-torch-to-tcp -split-input-file | FileCheck %s
+
+// CHECK-LABEL:  func.func @torch.aten.mm(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,8],f32>, %[[ARG1:.*]]: !torch.vtensor<[8,16],f32>) -> !torch.vtensor<[?,16],f32> {
+// CHECK-DAG:     %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,8],f32> -> tensor<?x8xf32>
+// CHECK-DAG:     %[[T1:.*]] = torch_c.to_builtin_tensor %[[ARG1]] : !torch.vtensor<[8,16],f32> -> tensor<8x16xf32>
+// CHECK:         %[[T2:.*]] = tcp.matmul %[[T0]], %[[T1]] : tensor<?x8xf32>, tensor<8x16xf32> -> tensor<?x16xf32>
+// CHECK:         %[[T3:.*]] = torch_c.from_builtin_tensor %[[T2]] : tensor<?x16xf32> -> !torch.vtensor<[?,16],f32>
+// CHECK:         return %[[T3]] : !torch.vtensor<[?,16],f32>
+func.func @torch.aten.mm(%arg0: !torch.vtensor<[?,8],f32>, %arg1: !torch.vtensor<[8,16],f32>) -> !torch.vtensor<[?,16],f32> {
+  %0 = torch.aten.mm %arg0, %arg1 : !torch.vtensor<[?,8],f32>, !torch.vtensor<[8,16],f32> -> !torch.vtensor<[?,16],f32>
+  return %0 : !torch.vtensor<[?,16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.bmm(
+// CHECK:         tcp.batch_matmul %{{.*}}, %{{.*}} : tensor<2x4x8xf32>, tensor<2x8x16xf32> -> tensor<2x4x16xf32>
+func.func @torch.aten.bmm(%arg0: !torch.vtensor<[2,4,8],f32>, %arg1: !torch.vtensor<[2,8,16],f32>) -> !torch.vtensor<[2,4,16],f32> {
+  %0 = torch.aten.bmm %arg0, %arg1 : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[2,8,16],f32> -> !torch.vtensor<[2,4,16],f32>
+  return %0 : !torch.vtensor<[2,4,16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.matmul$2d(
+// CHECK:         tcp.matmul %{{.*}}, %{{.*}} : tensor<4x8xf32>, tensor<8x16xf32> -> tensor<4x16xf32>
+func.func @torch.aten.matmul$2d(%arg0: !torch.vtensor<[4,8],f32>, %arg1: !torch.vtensor<[8,16],f32>) -> !torch.vtensor<[4,16],f32> {
+  %0 = torch.aten.matmul %arg0, %arg1 : !torch.vtensor<[4,8],f32>, !torch.vtensor<[8,16],f32> -> !torch.vtensor<[4,16],f32>
+  return %0 : !torch.vtensor<[4,16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.matmul$vec_mat(
+// CHECK:         %[[LHS:.*]] = tensor.expand_shape %{{.*}} {{\[\[}}0, 1]] output_shape [1, 8] : tensor<8xf32> into tensor<1x8xf32>
+// CHECK:         %[[MM:.*]] = tcp.matmul %[[LHS]], %{{.*}} : tensor<1x8xf32>, tensor<8x16xf32> -> tensor<1x16xf32>
+// CHECK:         tensor.collapse_shape %[[MM]] {{\[\[}}0, 1]] : tensor<1x16xf32> into tensor<16xf32>
+func.func @torch.aten.matmul$vec_mat(%arg0: !torch.vtensor<[8],f32>, %arg1: !torch.vtensor<[8,16],f32>) -> !torch.vtensor<[16],f32> {
+  %0 = torch.aten.matmul %arg0, %arg1 : !torch.vtensor<[8],f32>, !torch.vtensor<[8,16],f32> -> !torch.vtensor<[16],f32>
+  return %0 : !torch.vtensor<[16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.matmul$mat_vec(
+// CHECK:         %[[RHS:.*]] = tensor.expand_shape %{{.*}} {{\[\[}}0, 1]] output_shape [8, 1] : tensor<8xf32> into tensor<8x1xf32>
+// CHECK:         %[[MM:.*]] = tcp.matmul %{{.*}}, %[[RHS]] : tensor<4x8xf32>, tensor<8x1xf32> -> tensor<4x1xf32>
+// CHECK:         tensor.collapse_shape %[[MM]] {{\[\[}}0, 1]] : tensor<4x1xf32> into tensor<4xf32>
+func.func @torch.aten.matmul$mat_vec(%arg0: !torch.vtensor<[4,8],f32>, %arg1: !torch.vtensor<[8],f32>) -> !torch.vtensor<[4],f32> {
+  %0 = torch.aten.matmul %arg0, %arg1 : !torch.vtensor<[4,8],f32>, !torch.vtensor<[8],f32> -> !torch.vtensor<[4],f32>
+  return %0 : !torch.vtensor<[4],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.matmul$batched_lhs(
+// CHECK:         %[[LHS:.*]] = tensor.collapse_shape %{{.*}} {{\[\[}}0, 1, 2], [3]] : tensor<2x3x4x8xf32> into tensor<24x8xf32>
+// CHECK:         %[[MM:.*]] = tcp.matmul %[[LHS]], %{{.*}} : tensor<24x8xf32>, tensor<8x16xf32> -> tensor<24x16xf32>
+// CHECK:         tensor.expand_shape %[[MM]] {{\[\[}}0, 1, 2], [3]] output_shape [2, 3, 4, 16] : tensor<24x16xf32> into tensor<2x3x4x16xf32>
+func.func @torch.aten.matmul$batched_lhs(%arg0: !torch.vtensor<[2,3,4,8],f32>, %arg1: !torch.vtensor<[8,16],f32>) -> !torch.vtensor<[2,3,4,16],f32> {
+  %0 = torch.aten.matmul %arg0, %arg1 : !torch.vtensor<[2,3,4,8],f32>, !torch.vtensor<[8,16],f32> -> !torch.vtensor<[2,3,4,16],f32>
+  return %0 : !torch.vtensor<[2,3,4,16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.matmul$batched(
+// CHECK:         %[[LHS:.*]] = tensor.collapse_shape %{{.*}} {{\[\[}}0, 1], [2], [3]] : tensor<2x3x4x8xf32> into tensor<6x4x8xf32>
+// CHECK:         %[[RHS:.*]] = tensor.collapse_shape %{{.*}} {{\[\[}}0, 1], [2], [3]] : tensor<2x3x8x16xf32> into tensor<6x8x16xf32>
+// CHECK:         %[[MM:.*]] = tcp.batch_matmul %[[LHS]], %[[RHS]] : tensor<6x4x8xf32>, tensor<6x8x16xf32> -> tensor<6x4x16xf32>
+// CHECK:         tensor.expand_shape %[[MM]] {{\[\[}}0, 1], [2], [3]] output_shape [2, 3, 4, 16] : tensor<6x4x16xf32> into tensor<2x3x4x16xf32>
+func.func @torch.aten.matmul$batched(%arg0: !torch.vtensor<[2,3,4,8],f32>, %arg1: !torch.vtensor<[2,3,8,16],f32>) -> !torch.vtensor<[2,3,4,16],f32> {
+  %0 = torch.aten.matmul %arg0, %arg1 : !torch.vtensor<[2,3,4,8],f32>, !torch.vtensor<[2,3,8,16],f32> -> !torch.vtensor<[2,3,4,16],f32>
+  return %0 : !torch.vtensor<[2,3,4,16],f32>
+}
+
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.linear(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[4,8],f32>, %[[ARG1:.*]]: !torch.vtensor<[16,8],f32>, %[[ARG2:.*]]: !torch.vtensor<[16],f32>) -> !torch.vtensor<[4,16],f32> {
+// CHECK-DAG:     %[[INPUT:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[4,8],f32> -> tensor<4x8xf32>
+// CHECK-DAG:     %[[WEIGHT:.*]] = torch_c.to_builtin_tensor %[[ARG1]] : !torch.vtensor<[16,8],f32> -> tensor<16x8xf32>
+// CHECK-DAG:     %[[BIAS:.*]] = torch_c.to_builtin_tensor %[[ARG2]] : !torch.vtensor<[16],f32> -> tensor<16xf32>
+// CHECK:         %[[WEIGHT_T:.*]] = tcp.transpose %[[WEIGHT]] {permutation = [1, 0]} : tensor<16x8xf32> -> tensor<8x16xf32>
+// CHECK:         %[[MM:.*]] = tcp.matmul %[[INPUT]], %[[WEIGHT_T]] : tensor<4x8xf32>, tensor<8x16xf32> -> tensor<4x16xf32>
+// CHECK:         %[[EXPANDED:.*]] = tensor.expand_shape %[[BIAS]] {{\[}}[0, 1]] {{.*}} : tensor<16xf32> into tensor<1x16xf32>
+// CHECK:         %[[BCAST:.*]] = tcp.broadcast %[[EXPANDED]], {{.*}} {axes = [0]} : tensor<1x16xf32>, index -> tensor<4x16xf32>
+// CHECK:         %[[ADD:.*]] = tcp.add %[[MM]], %[[BCAST]] : tensor<4x16xf32>, tensor<4x16xf32> -> tensor<4x16xf32>
+// CHECK:         %[[RES:.*]] = torch_c.from_builtin_tensor %[[ADD]] : tensor<4x16xf32> -> !torch.vtensor<[4,16],f32>
+// CHECK:         return %[[RES]] : !torch.vtensor<[4,16],f32>
+func.func @torch.aten.linear(%arg0: !torch.vtensor<[4,8],f32>, %arg1: !torch.vtensor<[16,8],f32>, %arg2: !torch.vtensor<[16],f32>) -> !torch.vtensor<[4,16],f32> {
+  %0 = torch.aten.linear %arg0, %arg1, %arg2 : !torch.vtensor<[4,8],f32>, !torch.vtensor<[16,8],f32>, !torch.vtensor<[16],f32> -> !torch.vtensor<[4,16],f32>
+  return %0 : !torch.vtensor<[4,16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.linear$batched_no_bias(
+// CHECK:         %[[WEIGHT_T:.*]] = tcp.transpose %{{.*}} {permutation = [1, 0]} : tensor<16x8xf32> -> tensor<8x16xf32>
+// CHECK:         %[[LHS:.*]] = tensor.collapse_shape %{{.*}} {{\[\[}}0, 1], [2]] : tensor<2x4x8xf32> into tensor<8x8xf32>
+// CHECK:         %[[MM:.*]] = tcp.matmul %[[LHS]], %[[WEIGHT_T]] : tensor<8x8xf32>, tensor<8x16xf32> -> tensor<8x16xf32>
+// CHECK:         tensor.expand_shape %[[MM]] {{\[\[}}0, 1], [2]] output_shape [2, 4, 16] : tensor<8x16xf32> into tensor<2x4x16xf32>
+// CHECK-NOT:     tcp.add
+func.func @torch.aten.linear$batched_no_bias(%arg0: !torch.vtensor<[2,4,8],f32>, %arg1: !torch.vtensor<[16,8],f32>) -> !torch.vtensor<[2,4,16],f32> {
+  %none = torch.constant.none
+  %0 = torch.aten.linear %arg0, %arg1, %none : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[16,8],f32>, !torch.none -> !torch.vtensor<[2,4,16],f32>
+  return %0 : !torch.vtensor<[2,4,16],f32>
+}
+
+// -----
+
+// Contractions that cannot be expressed in TCP are left in Torch.
+
+// CHECK-LABEL:  func.func @torch.aten.matmul$dot(
+// CHECK:         torch.aten.matmul
+// CHECK-NOT:     tcp.matmul
+func.func @torch.aten.matmul$dot(%arg0: !torch.vtensor<[8],f32>, %arg1: !torch.vtensor<[8],f32>) -> !torch.vtensor<[],f32> {
+  %0 = torch.aten.matmul %arg0, %arg1 : !torch.vtensor<[8],f32>, !torch.vtensor<[8],f32> -> !torch.vtensor<[],f32>
+  return %0 : !torch.vtensor<[],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.matmul$broadcast_batch(
+// CHECK:         torch.aten.matmul
+// CHECK-NOT:     tcp.batch_matmul
+func.func @torch.aten.matmul$broadcast_batch(%arg0: !torch.vtensor<[2,4,8],f32>, %arg1: !torch.vtensor<[1,8,16],f32>) -> !torch.vtensor<[2,4,16],f32> {
+  %0 = torch.aten.matmul %arg0, %arg1 : !torch.vtensor<[2,4,8],f32>, !torch.vtensor<[1,8,16],f32> -> !torch.vtensor<[2,4,16],f32>
+  return %0 : !torch.vtensor<[2,4,16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.matmul$batched_rhs(
+// CHECK:         torch.aten.matmul
+// CHECK-NOT:     tcp.batch_matmul
+func.func @torch.aten.matmul$batched_rhs(%arg0: !torch.vtensor<[4,8],f32>, %arg1: !torch.vtensor<[2,8,16],f32>) -> !torch.vtensor<[2,4,16],f32> {
+  %0 = torch.aten.matmul %arg0, %arg1 : !torch.vtensor<[4,8],f32>, !torch.vtensor<[2,8,16],f32> -> !torch.vtensor<[2,4,16],f32>
+  return %0 : !torch.vtensor<[2,4,16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.matmul$mixed_types(
+// CHECK:         torch.aten.matmul
+// CHECK-NOT:     tcp.matmul
+func.func @torch.aten.matmul$mixed_types(%arg0: !torch.vtensor<[4,8],f16>, %arg1: !torch.vtensor<[8,16],f32>) -> !torch.vtensor<[4,16],f32> {
+  %0 = torch.aten.matmul %arg0, %arg1 : !torch.vtensor<[4,8],f16>, !torch.vtensor<[8,16],f32> -> !torch.vtensor<[4,16],f32>
+  return %0 : !torch.vtensor<[4,16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.mm$mixed_types(
+// CHECK:         torch.aten.mm
+// CHECK-NOT:     tcp.matmul
+func.func @torch.aten.mm$mixed_types(%arg0: !torch.vtensor<[4,8],f16>, %arg1: !torch.vtensor<[8,16],f32>) -> !torch.vtensor<[4,16],f32> {
+  %0 = torch.aten.mm %arg0, %arg1 : !torch.vtensor<[4,8],f16>, !torch.vtensor<[8,16],f32> -> !torch.vtensor<[4,16],f32>
+  return %0 : !torch.vtensor<[4,16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.bmm$unranked(
+// CHECK:         torch.aten.bmm
+// CHECK-NOT:     tcp.batch_matmul
+func.func @torch.aten.bmm$unranked(%arg0: !torch.vtensor<*,f32>, %arg1: !torch.vtensor<[2,8,16],f32>) -> !torch.vtensor<[2,4,16],f32> {
+  %0 = torch.aten.bmm %arg0, %arg1 : !torch.vtensor<*,f32>, !torch.vtensor<[2,8,16],f32> -> !torch.vtensor<[2,4,16],f32>
+  return %0 : !torch.vtensor<[2,4,16],f32>
+}
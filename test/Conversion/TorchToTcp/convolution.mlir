@@ -0,0 +1,115 @@
+// RUN: tcp-opt %s -convert-torch-to-tcp -split-input-file | FileCheck %s
+
+// CHECK-LABEL:  func.func @torch.aten.convolution$2d(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[1,3,16,16],f32>, %[[ARG1:.*]]: !torch.vtensor<[8,3,3,3],f32>, %[[ARG2:.*]]: !torch.vtensor<[8],f32>) -> !torch.vtensor<[1,8,8,8],f32> {
+// CHECK-DAG:     %[[INPUT:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[1,3,16,16],f32> -> tensor<1x3x16x16xf32>
+// CHECK-DAG:     %[[WEIGHT:.*]] = torch_c.to_builtin_tensor %[[ARG1]] : !torch.vtensor<[8,3,3,3],f32> -> tensor<8x3x3x3xf32>
+// CHECK-DAG:     %[[BIAS:.*]] = torch_c.to_builtin_tensor %[[ARG2]] : !torch.vtensor<[8],f32> -> tensor<8xf32>
+// CHECK:         %[[CONV:.*]] = tcp.conv2d %[[INPUT]], %[[WEIGHT]] {dilation = [1, 1], groups = 1 : i64, padding = [1, 1], stride = [2, 2]} : tensor<1x3x16x16xf32>, tensor<8x3x3x3xf32> -> tensor<1x8x8x8xf32>
+// CHECK:         %[[EXPANDED:.*]] = tensor.expand_shape %[[BIAS]] {{\[}}[0, 1, 2, 3]] {{.*}} : tensor<8xf32> into tensor<1x8x1x1xf32>
+// CHECK:         %[[BCAST:.*]] = tcp.broadcast %[[EXPANDED]], {{.*}} {axes = [0, 2, 3]} : tensor<1x8x1x1xf32>, index, index, index -> tensor<1x8x8x8xf32>
+// CHECK:         %[[ADD:.*]] = tcp.add %[[CONV]], %[[BCAST]] : tensor<1x8x8x8xf32>, tensor<1x8x8x8xf32> -> tensor<1x8x8x8xf32>
+// CHECK:         %[[RES:.*]] = torch_c.from_builtin_tensor %[[ADD]] : tensor<1x8x8x8xf32> -> !torch.vtensor<[1,8,8,8],f32>
+// CHECK:         return %[[RES]] : !torch.vtensor<[1,8,8,8],f32>
+func.func @torch.aten.convolution$2d(%arg0: !torch.vtensor<[1,3,16,16],f32>, %arg1: !torch.vtensor<[8,3,3,3],f32>, %arg2: !torch.vtensor<[8],f32>) -> !torch.vtensor<[1,8,8,8],f32> {
+  %false = torch.constant.bool false
+  %int0 = torch.constant.int 0
+  %int1 = torch.constant.int 1
+  %int2 = torch.constant.int 2
+  %stride = torch.prim.ListConstruct %int2, %int2 : (!torch.int, !torch.int) -> !torch.list<int>
+  %padding = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %dilation = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %output_padding = torch.prim.ListConstruct %int0, %int0 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.convolution %arg0, %arg1, %arg2, %stride, %padding, %dilation, %false, %output_padding, %int1 : !torch.vtensor<[1,3,16,16],f32>, !torch.vtensor<[8,3,3,3],f32>, !torch.vtensor<[8],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[1,8,8,8],f32>
+  return %0 : !torch.vtensor<[1,8,8,8],f32>
+}
+
+// -----
+
+// A single entry in the lists applies to all spatial dims.
+
+// CHECK-LABEL:  func.func @torch.aten.convolution$1d_depthwise(
+// CHECK:         %[[CONV:.*]] = tcp.conv1d %{{.*}}, %{{.*}} {dilation = [2], groups = 4 : i64, padding = [0], stride = [1]} : tensor<?x4x32xf32>, tensor<4x1x3xf32> -> tensor<?x4x28xf32>
+// CHECK-NOT:     tcp.add
+// CHECK:         torch_c.from_builtin_tensor %[[CONV]] : tensor<?x4x28xf32> -> !torch.vtensor<[?,4,28],f32>
+func.func @torch.aten.convolution$1d_depthwise(%arg0: !torch.vtensor<[?,4,32],f32>, %arg1: !torch.vtensor<[4,1,3],f32>) -> !torch.vtensor<[?,4,28],f32> {
+  %false = torch.constant.bool false
+  %none = torch.constant.none
+  %int0 = torch.constant.int 0
+  %int1 = torch.constant.int 1
+  %int2 = torch.constant.int 2
+  %int4 = torch.constant.int 4
+  %stride = torch.prim.ListConstruct %int1 : (!torch.int) -> !torch.list<int>
+  %padding = torch.prim.ListConstruct %int0 : (!torch.int) -> !torch.list<int>
+  %dilation = torch.prim.ListConstruct %int2 : (!torch.int) -> !torch.list<int>
+  %output_padding = torch.prim.ListConstruct %int0 : (!torch.int) -> !torch.list<int>
+  %0 = torch.aten.convolution %arg0, %arg1, %none, %stride, %padding, %dilation, %false, %output_padding, %int4 : !torch.vtensor<[?,4,32],f32>, !torch.vtensor<[4,1,3],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[?,4,28],f32>
+  return %0 : !torch.vtensor<[?,4,28],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.convolution$3d(
+// CHECK:         tcp.conv3d %{{.*}}, %{{.*}} {dilation = [1, 1, 1], groups = 1 : i64, padding = [1, 1, 1], stride = [1, 1, 1]} : tensor<1x2x8x8x8xf32>, tensor<4x2x3x3x3xf32> -> tensor<1x4x8x8x8xf32>
+func.func @torch.aten.convolution$3d(%arg0: !torch.vtensor<[1,2,8,8,8],f32>, %arg1: !torch.vtensor<[4,2,3,3,3],f32>) -> !torch.vtensor<[1,4,8,8,8],f32> {
+  %false = torch.constant.bool false
+  %none = torch.constant.none
+  %int0 = torch.constant.int 0
+  %int1 = torch.constant.int 1
+  %ones = torch.prim.ListConstruct %int1, %int1, %int1 : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+  %zeros = torch.prim.ListConstruct %int0, %int0, %int0 : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.convolution %arg0, %arg1, %none, %ones, %ones, %ones, %false, %zeros, %int1 : !torch.vtensor<[1,2,8,8,8],f32>, !torch.vtensor<[4,2,3,3,3],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[1,4,8,8,8],f32>
+  return %0 : !torch.vtensor<[1,4,8,8,8],f32>
+}
+
+// -----
+
+// Transposed convolutions are left to `-convert-torch-to-tcp-custom-op`.
+
+// CHECK-LABEL:  func.func @torch.aten.convolution$transposed(
+// CHECK:         torch.aten.convolution
+// CHECK-NOT:     tcp.conv2d
+func.func @torch.aten.convolution$transposed(%arg0: !torch.vtensor<[1,64,1,100],f32>, %arg1: !torch.vtensor<[64,64,3,3],f32>) -> !torch.vtensor<[1,64,2,200],f32> {
+  %true = torch.constant.bool true
+  %none = torch.constant.none
+  %int1 = torch.constant.int 1
+  %int2 = torch.constant.int 2
+  %stride = torch.prim.ListConstruct %int2, %int2 : (!torch.int, !torch.int) -> !torch.list<int>
+  %int1x1 = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.convolution %arg0, %arg1, %none, %stride, %int1x1, %int1x1, %true, %int1x1, %int1 : !torch.vtensor<[1,64,1,100],f32>, !torch.vtensor<[64,64,3,3],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[1,64,2,200],f32>
+  return %0 : !torch.vtensor<[1,64,2,200],f32>
+}
+
+// -----
+
+// Convolutions with operands of mixed element types are left in Torch too.
+
+// CHECK-LABEL:  func.func @torch.aten.convolution$mixed_types(
+// CHECK:         torch.aten.convolution
+// CHECK-NOT:     tcp.conv2d
+func.func @torch.aten.convolution$mixed_types(%arg0: !torch.vtensor<[1,2,8,8],f16>, %arg1: !torch.vtensor<[4,2,3,3],f32>) -> !torch.vtensor<[1,4,6,6],f32> {
+  %false = torch.constant.bool false
+  %none = torch.constant.none
+  %int0 = torch.constant.int 0
+  %int1 = torch.constant.int 1
+  %ones = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %zeros = torch.prim.ListConstruct %int0, %int0 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.convolution %arg0, %arg1, %none, %ones, %zeros, %ones, %false, %zeros, %int1 : !torch.vtensor<[1,2,8,8],f16>, !torch.vtensor<[4,2,3,3],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[1,4,6,6],f32>
+  return %0 : !torch.vtensor<[1,4,6,6],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.convolution$unranked_weight(
+// CHECK:         torch.aten.convolution
+// CHECK-NOT:     tcp.conv2d
+func.func @torch.aten.convolution$unranked_weight(%arg0: !torch.vtensor<[1,2,8,8],f32>, %arg1: !torch.vtensor<*,f32>) -> !torch.vtensor<[1,4,6,6],f32> {
+  %false = torch.constant.bool false
+  %none = torch.constant.none
+  %int0 = torch.constant.int 0
+  %int1 = torch.constant.int 1
+  %ones = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %zeros = torch.prim.ListConstruct %int0, %int0 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.convolution %arg0, %arg1, %none, %ones, %zeros, %ones, %false, %zeros, %int1 : !torch.vtensor<[1,2,8,8],f32>, !torch.vtensor<*,f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[1,4,6,6],f32>
+  return %0 : !torch.vtensor<[1,4,6,6],f32>
+}
@@ -103,3 +103,314 @@ func.func @torch.aten.index.tensor_hacked_twin(%arg0: !torch.vtensor<[1,20,30],f
   %ret = torch.aten.index.Tensor_hacked_twin %arg0, %l : !torch.vtensor<[1,20,30],f32>, !torch.list<vtensor> -> !torch.vtensor<[1,5,20],f32>
   return %ret : !torch.vtensor<[1,5,20],f32>
 }
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.permute(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[2,?,8],f32>) -> !torch.vtensor<[8,2,?],f32> {
+// CHECK:         %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[2,?,8],f32> -> tensor<2x?x8xf32>
+// CHECK:         %[[T1:.*]] = tcp.transpose %[[T0]] {permutation = [2, 0, 1]} : tensor<2x?x8xf32> -> tensor<8x2x?xf32>
+// CHECK:         %[[T2:.*]] = torch_c.from_builtin_tensor %[[T1]] : tensor<8x2x?xf32> -> !torch.vtensor<[8,2,?],f32>
+// CHECK:         return %[[T2]] : !torch.vtensor<[8,2,?],f32>
+func.func @torch.aten.permute(%arg0: !torch.vtensor<[2,?,8],f32>) -> !torch.vtensor<[8,2,?],f32> {
+  %int-1 = torch.constant.int -1
+  %int0 = torch.constant.int 0
+  %int1 = torch.constant.int 1
+  %dims = torch.prim.ListConstruct %int-1, %int0, %int1 : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.permute %arg0, %dims : !torch.vtensor<[2,?,8],f32>, !torch.list<int> -> !torch.vtensor<[8,2,?],f32>
+  return %0 : !torch.vtensor<[8,2,?],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.transpose.int(
+// CHECK:         tcp.transpose %{{.*}} {permutation = [0, 3, 2, 1]} : tensor<2x3x4x5xi32> -> tensor<2x5x4x3xi32>
+func.func @torch.aten.transpose.int(%arg0: !torch.vtensor<[2,3,4,5],si32>) -> !torch.vtensor<[2,5,4,3],si32> {
+  %int1 = torch.constant.int 1
+  %int-1 = torch.constant.int -1
+  %0 = torch.aten.transpose.int %arg0, %int1, %int-1 : !torch.vtensor<[2,3,4,5],si32>, !torch.int, !torch.int -> !torch.vtensor<[2,5,4,3],si32>
+  return %0 : !torch.vtensor<[2,5,4,3],si32>
+}
+
+// -----
+
+// Permutations over non-constant dims are left in Torch.
+
+// CHECK-LABEL:  func.func @torch.aten.transpose.int$dynamic_dim(
+// CHECK:         torch.aten.transpose.int
+// CHECK-NOT:     tcp.transpose
+func.func @torch.aten.transpose.int$dynamic_dim(%arg0: !torch.vtensor<[2,3],f32>, %arg1: !torch.int) -> !torch.vtensor<[?,?],f32> {
+  %int0 = torch.constant.int 0
+  %0 = torch.aten.transpose.int %arg0, %int0, %arg1 : !torch.vtensor<[2,3],f32>, !torch.int, !torch.int -> !torch.vtensor<[?,?],f32>
+  return %0 : !torch.vtensor<[?,?],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.view$expand(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[2,12],f32>) -> !torch.vtensor<[2,3,4],f32> {
+// CHECK:         %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[2,12],f32> -> tensor<2x12xf32>
+// CHECK:         %[[T1:.*]] = tcp.expand_shape %[[T0]] {reassociation = {{\[\[}}0], [1, 2]]} : tensor<2x12xf32> -> tensor<2x3x4xf32>
+// CHECK:         %[[T2:.*]] = torch_c.from_builtin_tensor %[[T1]] : tensor<2x3x4xf32> -> !torch.vtensor<[2,3,4],f32>
+// CHECK:         return %[[T2]] : !torch.vtensor<[2,3,4],f32>
+func.func @torch.aten.view$expand(%arg0: !torch.vtensor<[2,12],f32>) -> !torch.vtensor<[2,3,4],f32> {
+  %int2 = torch.constant.int 2
+  %int3 = torch.constant.int 3
+  %int4 = torch.constant.int 4
+  %size = torch.prim.ListConstruct %int2, %int3, %int4 : (!torch.int, !torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.view %arg0, %size : !torch.vtensor<[2,12],f32>, !torch.list<int> -> !torch.vtensor<[2,3,4],f32>
+  return %0 : !torch.vtensor<[2,3,4],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.reshape$collapse(
+// CHECK:         tcp.collapse_shape %{{.*}} {reassociation = {{\[\[}}0, 1], [2]]} : tensor<2x3x4xf32> -> tensor<6x4xf32>
+func.func @torch.aten.reshape$collapse(%arg0: !torch.vtensor<[2,3,4],f32>) -> !torch.vtensor<[6,4],f32> {
+  %int-1 = torch.constant.int -1
+  %int4 = torch.constant.int 4
+  %shape = torch.prim.ListConstruct %int-1, %int4 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.reshape %arg0, %shape : !torch.vtensor<[2,3,4],f32>, !torch.list<int> -> !torch.vtensor<[6,4],f32>
+  return %0 : !torch.vtensor<[6,4],f32>
+}
+
+// -----
+
+// The dynamic dims of the input and the result have the same size when it is
+// read from the input or inferred.
+
+// CHECK-LABEL:  func.func @torch.aten.view$dynamic_dims(
+// CHECK:         tcp.expand_shape %{{.*}} {reassociation = {{\[\[}}0], [1, 2], [3]]} : tensor<?x384x?xf32> -> tensor<?x24x16x?xf32>
+// CHECK:         tcp.collapse_shape %{{.*}} {reassociation = {{\[\[}}0], [1, 2]]} : tensor<?x4x8xf32> -> tensor<?x32xf32>
+func.func @torch.aten.view$dynamic_dims(%arg0: !torch.vtensor<[?,384,?],f32>, %arg1: !torch.vtensor<[?,4,8],f32>) -> (!torch.vtensor<[?,24,16,?],f32>, !torch.vtensor<[?,32],f32>) {
+  %int-1 = torch.constant.int -1
+  %int0 = torch.constant.int 0
+  %int16 = torch.constant.int 16
+  %int24 = torch.constant.int 24
+  %int32 = torch.constant.int 32
+  %dim0 = torch.aten.size.int %arg0, %int0 : !torch.vtensor<[?,384,?],f32>, !torch.int -> !torch.int
+  %size = torch.prim.ListConstruct %dim0, %int24, %int16, %int-1 : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.view %arg0, %size : !torch.vtensor<[?,384,?],f32>, !torch.list<int> -> !torch.vtensor<[?,24,16,?],f32>
+  %shape = torch.prim.ListConstruct %int-1, %int32 : (!torch.int, !torch.int) -> !torch.list<int>
+  %1 = torch.aten.reshape %arg1, %shape : !torch.vtensor<[?,4,8],f32>, !torch.list<int> -> !torch.vtensor<[?,32],f32>
+  return %0, %1 : !torch.vtensor<[?,24,16,?],f32>, !torch.vtensor<[?,32],f32>
+}
+
+// -----
+
+// A dynamic dim that is merged with or split from static dims has their
+// product as a factor.
+
+// CHECK-LABEL:  func.func @torch.aten.view$static_factors(
+// CHECK:         tcp.collapse_shape %{{.*}} {reassociation = {{\[\[}}0, 1], [2]]} : tensor<?x4x8xf32> -> tensor<?x8xf32>
+// CHECK:         tcp.expand_shape %{{.*}} {reassociation = {{\[\[}}0, 1]]} : tensor<?xf32> -> tensor<?x4xf32>
+func.func @torch.aten.view$static_factors(%arg0: !torch.vtensor<[?,4,8],f32>, %arg1: !torch.vtensor<[?],f32>, %arg2: !torch.int) -> (!torch.vtensor<[?,8],f32>, !torch.vtensor<[?,4],f32>) {
+  %s0 = torch.symbolic_int "s0" {min_val = 2, max_val = 1024} : !torch.int
+  torch.bind_symbolic_shape %arg1, [%s0], affine_map<()[s0] -> (s0 * 4)> : !torch.vtensor<[?],f32>
+  %int0 = torch.constant.int 0
+  %int4 = torch.constant.int 4
+  %int8 = torch.constant.int 8
+  %dim0 = torch.aten.size.int %arg0, %int0 : !torch.vtensor<[?,4,8],f32>, !torch.int -> !torch.int
+  %merged = torch.aten.mul.int %dim0, %int4 : !torch.int, !torch.int -> !torch.int
+  %size = torch.prim.ListConstruct %merged, %int8 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.view %arg0, %size : !torch.vtensor<[?,4,8],f32>, !torch.list<int> -> !torch.vtensor<[?,8],f32>
+  %shape = torch.prim.ListConstruct %arg2, %int4 : (!torch.int, !torch.int) -> !torch.list<int>
+  %1 = torch.aten.view %arg1, %shape : !torch.vtensor<[?],f32>, !torch.list<int> -> !torch.vtensor<[?,4],f32>
+  torch.bind_symbolic_shape %1, [%s0], affine_map<()[s0] -> (s0, 4)> : !torch.vtensor<[?,4],f32>
+  return %0, %1 : !torch.vtensor<[?,8],f32>, !torch.vtensor<[?,4],f32>
+}
+
+// -----
+
+// The symbolic shapes of the input and the result bind their dynamic dims to
+// the same symbol, so the view only splits the static dim.
+
+// CHECK-LABEL:  func.func @torch.aten.view$symbolic_shape(
+// CHECK:         %[[S0:.*]] = tcp.symbolic_int "s0" {min_val = 2, max_val = 1024} : i64
+// CHECK:         tcp.bind_symbolic_shape %{{.*}}, [%[[S0]]], affine_map<()[s0] -> (s0, 384, 16)> : tensor<?x384x16xf32>
+// CHECK:         %[[EXPANDED:.*]] = tcp.expand_shape %{{.*}} {reassociation = {{\[\[}}0], [1, 2], [3]]} : tensor<?x384x16xf32> -> tensor<?x24x16x16xf32>
+// CHECK:         tcp.bind_symbolic_shape %[[EXPANDED]], [%[[S0]]], affine_map<()[s0] -> (s0, 24, 16, 16)> : tensor<?x24x16x16xf32>
+func.func @torch.aten.view$symbolic_shape(%arg0: !torch.vtensor<[?,384,16],f32>, %arg1: !torch.int) -> !torch.vtensor<[?,24,16,16],f32> {
+  %s0 = torch.symbolic_int "s0" {min_val = 2, max_val = 1024} : !torch.int
+  torch.bind_symbolic_shape %arg0, [%s0], affine_map<()[s0] -> (s0, 384, 16)> : !torch.vtensor<[?,384,16],f32>
+  %int16 = torch.constant.int 16
+  %int24 = torch.constant.int 24
+  %size = torch.prim.ListConstruct %arg1, %int24, %int16, %int16 : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.view %arg0, %size : !torch.vtensor<[?,384,16],f32>, !torch.list<int> -> !torch.vtensor<[?,24,16,16],f32>
+  torch.bind_symbolic_shape %0, [%s0], affine_map<()[s0] -> (s0, 24, 16, 16)> : !torch.vtensor<[?,24,16,16],f32>
+  return %0 : !torch.vtensor<[?,24,16,16],f32>
+}
+
+// -----
+
+// Without a proof that the dynamic dims have the same size, the view becomes
+// a `tcp.reshape` to the sizes given by the view.
+
+// CHECK-LABEL:  func.func @torch.aten.view$dynamic_shape(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,384,16],f32>, %[[ARG1:.*]]: tensor<?x2736x16xf32>) -> !torch.vtensor<[?,24,16,16],f32> {
+// CHECK:         %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,384,16],f32> -> tensor<?x384x16xf32>
+// CHECK:         %[[I64:.*]] = torch_c.to_i64 %{{.*}}
+// CHECK:         %[[DIM:.*]] = arith.index_cast %[[I64]] : i64 to index
+// CHECK:         %[[C24:.*]] = arith.constant 24 : index
+// CHECK:         %[[RESHAPE:.*]] = tcp.reshape %[[T0]] shape(%[[DIM]], %[[C24]], %{{.*}}, %{{.*}}) : tensor<?x384x16xf32> -> tensor<?x24x16x16xf32>
+// CHECK:         %[[RES:.*]] = torch_c.from_builtin_tensor %[[RESHAPE]] : tensor<?x24x16x16xf32> -> !torch.vtensor<[?,24,16,16],f32>
+// CHECK:         return %[[RES]] : !torch.vtensor<[?,24,16,16],f32>
+func.func @torch.aten.view$dynamic_shape(%arg0: !torch.vtensor<[?,384,16],f32>, %arg1: tensor<?x2736x16xf32>) -> !torch.vtensor<[?,24,16,16],f32> {
+  %c0 = arith.constant 0 : index
+  %int24 = torch.constant.int 24
+  %int16 = torch.constant.int 16
+  %dim_32 = tensor.dim %arg1, %c0 : tensor<?x2736x16xf32>
+  %1 = arith.index_cast %dim_32 : index to i64
+  %2 = torch_c.from_i64 %1
+  %3 = torch.prim.ListConstruct %2, %int24, %int16, %int16 : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+  %4 = torch.aten.view %arg0, %3 : !torch.vtensor<[?,384,16],f32>, !torch.list<int> -> !torch.vtensor<[?,24,16,16],f32>
+  return %4 : !torch.vtensor<[?,24,16,16],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.view$permuted_sizes(
+// CHECK-DAG:     %[[C4:.*]] = arith.constant 4 : index
+// CHECK-DAG:     %[[C6:.*]] = arith.constant 6 : index
+// CHECK:         tcp.reshape %{{.*}} shape(%[[C4]], %[[C6]]) : tensor<6x4xi32> -> tensor<4x6xi32>
+func.func @torch.aten.view$permuted_sizes(%arg0: !torch.vtensor<[6,4],si32>) -> !torch.vtensor<[4,6],si32> {
+  %int4 = torch.constant.int 4
+  %int6 = torch.constant.int 6
+  %size = torch.prim.ListConstruct %int4, %int6 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.view %arg0, %size : !torch.vtensor<[6,4],si32>, !torch.list<int> -> !torch.vtensor<[4,6],si32>
+  return %0 : !torch.vtensor<[4,6],si32>
+}
+
+// -----
+
+// The size of the dynamic dim of the result is neither given by the view nor
+// provably that of an input dim, so the view is left in Torch, for the custom
+// op conversion.
+
+// CHECK-LABEL:  func.func @torch.aten.view$inferred_dynamic_dim(
+// CHECK:         torch.aten.view
+// CHECK-NOT:     tcp.reshape
+func.func @torch.aten.view$inferred_dynamic_dim(%arg0: !torch.vtensor<[?,?],f32>) -> !torch.vtensor<[?],f32> {
+  %int-1 = torch.constant.int -1
+  %size = torch.prim.ListConstruct %int-1 : (!torch.int) -> !torch.list<int>
+  %0 = torch.aten.view %arg0, %size : !torch.vtensor<[?,?],f32>, !torch.list<int> -> !torch.vtensor<[?],f32>
+  return %0 : !torch.vtensor<[?],f32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @torch.aten._index_put_impl(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[25,4],f32>, %[[ARG1:.*]]: !torch.vtensor<[10],si32>, %[[ARG2:.*]]: !torch.vtensor<[],f32>) -> !torch.vtensor<[25,4],f32>
+// CHECK-DAG:     %[[SELF:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[25,4],f32> -> tensor<25x4xf32>
+// CHECK-DAG:     %[[VALUES:.*]] = torch_c.to_builtin_tensor %[[ARG2]] : !torch.vtensor<[],f32> -> tensor<f32>
+// CHECK-DAG:     %[[INDEX:.*]] = torch_c.to_builtin_tensor %[[ARG1]] : !torch.vtensor<[10],si32> -> tensor<10xi32>
+// CHECK:         %[[EXPANDED:.*]] = tensor.expand_shape %[[INDEX]] {{\[\[}}0, 1]] output_shape [10, 1] : tensor<10xi32> into tensor<10x1xi32>
+// CHECK:         %[[CAST:.*]] = tcp.cast %[[EXPANDED]] {{.*}} : tensor<10x1xi32> -> tensor<10x1xi64>
+// CHECK:         %[[INDICES:.*]] = tensor.concat dim(1) %[[CAST]] : (tensor<10x1xi64>) -> tensor<10x1xi64>
+// CHECK:         %[[EXPANDED_VALUES:.*]] = tensor.expand_shape %[[VALUES]] [] output_shape [1, 1] : tensor<f32> into tensor<1x1xf32>
+// CHECK:         %[[UPDATES:.*]] = tcp.broadcast %[[EXPANDED_VALUES]], %{{.*}}, %{{.*}} {axes = [0, 1]} : tensor<1x1xf32>, index, index -> tensor<10x4xf32>
+// CHECK:         %[[SCATTER:.*]] = tcp.scatter %[[SELF]], %[[INDICES]], %[[UPDATES]] : tensor<25x4xf32>, tensor<10x1xi64>, tensor<10x4xf32> -> tensor<25x4xf32>
+// CHECK:         %[[RES:.*]] = torch_c.from_builtin_tensor %[[SCATTER]] : tensor<25x4xf32> -> !torch.vtensor<[25,4],f32>
+// CHECK:         return %[[RES]] : !torch.vtensor<[25,4],f32>
+func.func @torch.aten._index_put_impl(%arg0: !torch.vtensor<[25,4],f32>, %arg1: !torch.vtensor<[10],si32>, %arg2: !torch.vtensor<[],f32>) -> !torch.vtensor<[25,4],f32> {
+  %false = torch.constant.bool false
+  %0 = torch.prim.ListConstruct %arg1 : (!torch.vtensor<[10],si32>) -> !torch.list<optional<vtensor>>
+  %1 = torch.aten._index_put_impl %arg0, %0, %arg2, %false, %false : !torch.vtensor<[25,4],f32>, !torch.list<optional<vtensor>>, !torch.vtensor<[],f32>, !torch.bool, !torch.bool -> !torch.vtensor<[25,4],f32>
+  return %1 : !torch.vtensor<[25,4],f32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @torch.aten._index_put_impl_accumulate(
+// CHECK:         %[[INDICES:.*]] = tensor.concat dim(1) %{{.*}}, %{{.*}} : (tensor<5x1xi64>, tensor<5x1xi64>) -> tensor<5x2xi64>
+// CHECK:         tcp.scatter %{{.*}}, %[[INDICES]], %{{.*}} {accumulate = true} : tensor<8x4x6xf32>, tensor<5x2xi64>, tensor<5x6xf32> -> tensor<8x4x6xf32>
+func.func @torch.aten._index_put_impl_accumulate(%arg0: !torch.vtensor<[8,4,6],f32>, %arg1: !torch.vtensor<[5],si64>, %arg2: !torch.vtensor<[5],si64>, %arg3: !torch.vtensor<[5,6],f32>) -> !torch.vtensor<[8,4,6],f32> {
+  %true = torch.constant.bool true
+  %false = torch.constant.bool false
+  %0 = torch.prim.ListConstruct %arg1, %arg2 : (!torch.vtensor<[5],si64>, !torch.vtensor<[5],si64>) -> !torch.list<optional<vtensor>>
+  %1 = torch.aten._index_put_impl %arg0, %0, %arg3, %true, %false : !torch.vtensor<[8,4,6],f32>, !torch.list<optional<vtensor>>, !torch.vtensor<[5,6],f32>, !torch.bool, !torch.bool -> !torch.vtensor<[8,4,6],f32>
+  return %1 : !torch.vtensor<[8,4,6],f32>
+}
+
+// -----
+
+// Indexing with `None`, which keeps a leading dim, is left in Torch.
+
+// CHECK-LABEL: func.func @torch.aten._index_put_impl_none_index(
+// CHECK:         torch.aten._index_put_impl
+// CHECK-NOT:     tcp.scatter
+func.func @torch.aten._index_put_impl_none_index(%arg0: !torch.vtensor<[8,4],f32>, %arg1: !torch.vtensor<[2],si64>, %arg2: !torch.vtensor<[8,2],f32>) -> !torch.vtensor<[8,4],f32> {
+  %false = torch.constant.bool false
+  %none = torch.constant.none
+  %0 = torch.prim.ListConstruct %none, %arg1 : (!torch.none, !torch.vtensor<[2],si64>) -> !torch.list<optional<vtensor>>
+  %1 = torch.aten._index_put_impl %arg0, %0, %arg2, %false, %false : !torch.vtensor<[8,4],f32>, !torch.list<optional<vtensor>>, !torch.vtensor<[8,2],f32>, !torch.bool, !torch.bool -> !torch.vtensor<[8,4],f32>
+  return %1 : !torch.vtensor<[8,4],f32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @torch.aten.slice_scatter(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[4,9],f32>, %[[ARG1:.*]]: !torch.vtensor<[4,3],f32>) -> !torch.vtensor<[4,9],f32>
+// CHECK-DAG:     %[[DEST:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[4,9],f32> -> tensor<4x9xf32>
+// CHECK-DAG:     %[[SRC:.*]] = torch_c.to_builtin_tensor %[[ARG1]] : !torch.vtensor<[4,3],f32> -> tensor<4x3xf32>
+// CHECK:         %[[OUT:.*]] = tcp.slice_scatter %[[DEST]], %[[SRC]] starts(%{{.*}}, %{{.*}}) strides(%{{.*}}, %{{.*}}) : tensor<4x9xf32>, tensor<4x3xf32> -> tensor<4x9xf32>
+// CHECK:         %[[RES:.*]] = torch_c.from_builtin_tensor %[[OUT]] : tensor<4x9xf32> -> !torch.vtensor<[4,9],f32>
+// CHECK:         return %[[RES]] : !torch.vtensor<[4,9],f32>
+func.func @torch.aten.slice_scatter(%arg0: !torch.vtensor<[4,9],f32>, %arg1: !torch.vtensor<[4,3],f32>) -> !torch.vtensor<[4,9],f32> {
+  %dim = torch.constant.int 1
+  %start = torch.constant.int 2
+  %end = torch.constant.int 8
+  %step = torch.constant.int 2
+  %0 = torch.aten.slice_scatter %arg0, %arg1, %dim, %start, %end, %step : !torch.vtensor<[4,9],f32>, !torch.vtensor<[4,3],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[4,9],f32>
+  return %0 : !torch.vtensor<[4,9],f32>
+}
+
+// -----
+
+// Slice scatters along a non-constant dim are left in Torch.
+
+// CHECK-LABEL: func.func @torch.aten.slice_scatter$dynamic_dim(
+// CHECK:         torch.aten.slice_scatter
+// CHECK-NOT:     tcp.slice_scatter
+func.func @torch.aten.slice_scatter$dynamic_dim(%arg0: !torch.vtensor<[4,9],f32>, %arg1: !torch.vtensor<[4,3],f32>, %dim: !torch.int) -> !torch.vtensor<[4,9],f32> {
+  %start = torch.constant.int 2
+  %end = torch.constant.int 8
+  %step = torch.constant.int 2
+  %0 = torch.aten.slice_scatter %arg0, %arg1, %dim, %start, %end, %step : !torch.vtensor<[4,9],f32>, !torch.vtensor<[4,3],f32>, !torch.int, !torch.int, !torch.int, !torch.int -> !torch.vtensor<[4,9],f32>
+  return %0 : !torch.vtensor<[4,9],f32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @torch.aten.constant_pad_nd(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[1,4,8,8],f32>) -> !torch.vtensor<[1,4,11,10],f32>
+// CHECK:         %[[IN:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[1,4,8,8],f32> -> tensor<1x4x8x8xf32>
+// CHECK:         %[[CST:.*]] = tcp.const {value = dense<5.000000e-01> : tensor<f64>} : tensor<f64>
+// CHECK:         %[[VAL:.*]] = tcp.cast %[[CST]] : tensor<f64> -> tensor<f32>
+// CHECK:         %[[PAD:.*]] = tcp.pad %[[IN]], %[[VAL]] {high = [0, 0, 2, 1], low = [0, 0, 1, 1]} : tensor<1x4x8x8xf32>, tensor<f32> -> tensor<1x4x11x10xf32>
+// CHECK:         %[[RES:.*]] = torch_c.from_builtin_tensor %[[PAD]] : tensor<1x4x11x10xf32> -> !torch.vtensor<[1,4,11,10],f32>
+// CHECK:         return %[[RES]] : !torch.vtensor<[1,4,11,10],f32>
+func.func @torch.aten.constant_pad_nd(%arg0: !torch.vtensor<[1,4,8,8],f32>) -> !torch.vtensor<[1,4,11,10],f32> {
+  %int1 = torch.constant.int 1
+  %int2 = torch.constant.int 2
+  %float = torch.constant.float 5.000000e-01
+  %0 = torch.prim.ListConstruct %int1, %int1, %int1, %int2 : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+  %1 = torch.aten.constant_pad_nd %arg0, %0, %float : !torch.vtensor<[1,4,8,8],f32>, !torch.list<int>, !torch.float -> !torch.vtensor<[1,4,11,10],f32>
+  return %1 : !torch.vtensor<[1,4,11,10],f32>
+}
+
+// -----
+
+// Pads that crop the input are left in Torch.
+
+// CHECK-LABEL: func.func @torch.aten.constant_pad_nd$negative(
+// CHECK:         torch.aten.constant_pad_nd
+// CHECK-NOT:     tcp.pad
+func.func @torch.aten.constant_pad_nd$negative(%arg0: !torch.vtensor<[4,8],f32>) -> !torch.vtensor<[4,7],f32> {
+  %int0 = torch.constant.int 0
+  %int-1 = torch.constant.int -1
+  %float = torch.constant.float 0.000000e+00
+  %0 = torch.prim.ListConstruct %int0, %int-1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %1 = torch.aten.constant_pad_nd %arg0, %0, %float : !torch.vtensor<[4,8],f32>, !torch.list<int>, !torch.float -> !torch.vtensor<[4,7],f32>
+  return %1 : !torch.vtensor<[4,7],f32>
+}
@@ -781,3 +781,122 @@ func.func @torch.aten.log1p(%arg0: !torch.vtensor<[?,4,19,2],f32>) -> !torch.vte
   %1 = torch.aten.log1p %arg0 : !torch.vtensor<[?,4,19,2],f32> -> !torch.vtensor<[?,4,19,2],f32>
   return %1 : !torch.vtensor<[?,4,19,2],f32>
 }
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.lt.Tensor(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,?],f32>, %[[ARG1:.*]]: !torch.vtensor<[?,?],f32>) -> !torch.vtensor<[?,?],i1> {
+// CHECK-DAG:     %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,?],f32> -> tensor<?x?xf32>
+// CHECK-DAG:     %[[T1:.*]] = torch_c.to_builtin_tensor %[[ARG1]] : !torch.vtensor<[?,?],f32> -> tensor<?x?xf32>
+// CHECK:         %[[CMP:.*]] = tcp.compare %[[T0]], %[[T1]] {predicate = #tcp<comparePredicate LT>} : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xi1>
+// CHECK:         %[[FROM_BUILTIN:.*]] = torch_c.from_builtin_tensor %[[CMP]] : tensor<?x?xi1> -> !torch.vtensor<[?,?],i1>
+// CHECK:         return %[[FROM_BUILTIN]] : !torch.vtensor<[?,?],i1>
+func.func @torch.aten.lt.Tensor(%arg0: !torch.vtensor<[?,?],f32>, %arg1: !torch.vtensor<[?,?],f32>) -> !torch.vtensor<[?,?],i1> {
+  %0 = torch.aten.lt.Tensor %arg0, %arg1 : !torch.vtensor<[?,?],f32>, !torch.vtensor<[?,?],f32> -> !torch.vtensor<[?,?],i1>
+  return %0 : !torch.vtensor<[?,?],i1>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.gt.Scalar$si64(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?],si64>) -> !torch.vtensor<[?],i1> {
+// CHECK:         %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?],si64> -> tensor<?xi64>
+// CHECK:         %[[CONST:.*]] = tcp.const {value = dense<0> : tensor<i64>} : tensor<i64>
+// CHECK:         %[[EXPAND:.*]] = tensor.expand_shape %[[CONST]] [] output_shape [1] : tensor<i64> into tensor<1xi64>
+// CHECK:         %[[C0:.*]] = arith.constant 0 : index
+// CHECK:         %[[DIM:.*]] = tensor.dim %[[T0]], %[[C0]] : tensor<?xi64>
+// CHECK:         %[[BCAST:.*]] = tcp.broadcast %[[EXPAND]], %[[DIM]] {axes = [0]} : tensor<1xi64>, index -> tensor<?xi64>
+// CHECK:         %[[CMP:.*]] = tcp.compare %[[T0]], %[[BCAST]] {int_signedness = #tcp<signedness Signed>, predicate = #tcp<comparePredicate GT>} : tensor<?xi64>, tensor<?xi64> -> tensor<?xi1>
+// CHECK:         %[[FROM_BUILTIN:.*]] = torch_c.from_builtin_tensor %[[CMP]] : tensor<?xi1> -> !torch.vtensor<[?],i1>
+// CHECK:         return %[[FROM_BUILTIN]] : !torch.vtensor<[?],i1>
+func.func @torch.aten.gt.Scalar$si64(%arg0: !torch.vtensor<[?],si64>) -> !torch.vtensor<[?],i1> {
+  %int0 = torch.constant.int 0
+  %0 = torch.aten.gt.Scalar %arg0, %int0 : !torch.vtensor<[?],si64>, !torch.int -> !torch.vtensor<[?],i1>
+  return %0 : !torch.vtensor<[?],i1>
+}
+
+// -----
+
+// Comparisons that promote `self` are left in Torch.
+
+// CHECK-LABEL:  func.func @torch.aten.lt.Scalar$promotion(
+// CHECK:         torch.aten.lt.Scalar
+// CHECK-NOT:     tcp.compare
+func.func @torch.aten.lt.Scalar$promotion(%arg0: !torch.vtensor<[?],si64>) -> !torch.vtensor<[?],i1> {
+  %float = torch.constant.float 1.500000e+00
+  %0 = torch.aten.lt.Scalar %arg0, %float : !torch.vtensor<[?],si64>, !torch.float -> !torch.vtensor<[?],i1>
+  return %0 : !torch.vtensor<[?],i1>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.eq.Tensor$promotion(
+// CHECK:         torch.aten.eq.Tensor
+// CHECK-NOT:     tcp.compare
+func.func @torch.aten.eq.Tensor$promotion(%arg0: !torch.vtensor<[?],si64>, %arg1: !torch.vtensor<[?],f32>) -> !torch.vtensor<[?],i1> {
+  %0 = torch.aten.eq.Tensor %arg0, %arg1 : !torch.vtensor<[?],si64>, !torch.vtensor<[?],f32> -> !torch.vtensor<[?],i1>
+  return %0 : !torch.vtensor<[?],i1>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.where.self(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,?],i1>, %[[ARG1:.*]]: !torch.vtensor<[?,?],f32>, %[[ARG2:.*]]: !torch.vtensor<[?,?],f32>) -> !torch.vtensor<[?,?],f32> {
+// CHECK-DAG:     %[[COND:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,?],i1> -> tensor<?x?xi1>
+// CHECK-DAG:     %[[T1:.*]] = torch_c.to_builtin_tensor %[[ARG1]] : !torch.vtensor<[?,?],f32> -> tensor<?x?xf32>
+// CHECK-DAG:     %[[T2:.*]] = torch_c.to_builtin_tensor %[[ARG2]] : !torch.vtensor<[?,?],f32> -> tensor<?x?xf32>
+// CHECK:         %[[SELECT:.*]] = tcp.select %[[COND]], %[[T1]], %[[T2]] : tensor<?x?xi1>, tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+// CHECK:         %[[FROM_BUILTIN:.*]] = torch_c.from_builtin_tensor %[[SELECT]] : tensor<?x?xf32> -> !torch.vtensor<[?,?],f32>
+// CHECK:         return %[[FROM_BUILTIN]] : !torch.vtensor<[?,?],f32>
+func.func @torch.aten.where.self(%arg0: !torch.vtensor<[?,?],i1>, %arg1: !torch.vtensor<[?,?],f32>, %arg2: !torch.vtensor<[?,?],f32>) -> !torch.vtensor<[?,?],f32> {
+  %0 = torch.aten.where.self %arg0, %arg1, %arg2 : !torch.vtensor<[?,?],i1>, !torch.vtensor<[?,?],f32>, !torch.vtensor<[?,?],f32> -> !torch.vtensor<[?,?],f32>
+  return %0 : !torch.vtensor<[?,?],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.where.self$broadcast(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?],i1>, %[[ARG1:.*]]: !torch.vtensor<[?,?],f32>, %[[ARG2:.*]]: !torch.vtensor<[],f32>) -> !torch.vtensor<[?,?],f32> {
+// CHECK:         %[[BCAST_OTHER:.*]] = tcp.broadcast %{{.*}} {axes = [0, 1]} : tensor<1x1xf32>, index, index -> tensor<?x?xf32>
+// CHECK:         %[[BCAST_COND:.*]] = tcp.broadcast %{{.*}} {axes = [0]} : tensor<1x?xi1>, index -> tensor<?x?xi1>
+// CHECK:         %[[SELECT:.*]] = tcp.select %[[BCAST_COND]], %{{.*}}, %[[BCAST_OTHER]] : tensor<?x?xi1>, tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+func.func @torch.aten.where.self$broadcast(%arg0: !torch.vtensor<[?],i1>, %arg1: !torch.vtensor<[?,?],f32>, %arg2: !torch.vtensor<[],f32>) -> !torch.vtensor<[?,?],f32> {
+  %0 = torch.aten.where.self %arg0, %arg1, %arg2 : !torch.vtensor<[?],i1>, !torch.vtensor<[?,?],f32>, !torch.vtensor<[],f32> -> !torch.vtensor<[?,?],f32>
+  return %0 : !torch.vtensor<[?,?],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.masked_fill.Scalar(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,?],f32>, %[[ARG1:.*]]: !torch.vtensor<[?,?],i1>) -> !torch.vtensor<[?,?],f32> {
+// CHECK-DAG:     %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,?],f32> -> tensor<?x?xf32>
+// CHECK-DAG:     %[[MASK:.*]] = torch_c.to_builtin_tensor %[[ARG1]] : !torch.vtensor<[?,?],i1> -> tensor<?x?xi1>
+// CHECK:         %[[CONST:.*]] = tcp.const {value = dense<0xFFF0000000000000> : tensor<f64>} : tensor<f64>
+// CHECK:         %[[CAST:.*]] = tcp.cast %[[CONST]] : tensor<f64> -> tensor<f32>
+// CHECK:         %[[BCAST:.*]] = tcp.broadcast %{{.*}} {axes = [0, 1]} : tensor<1x1xf32>, index, index -> tensor<?x?xf32>
+// CHECK:         %[[SELECT:.*]] = tcp.select %[[MASK]], %[[BCAST]], %[[T0]] : tensor<?x?xi1>, tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+// CHECK:         %[[FROM_BUILTIN:.*]] = torch_c.from_builtin_tensor %[[SELECT]] : tensor<?x?xf32> -> !torch.vtensor<[?,?],f32>
+// CHECK:         return %[[FROM_BUILTIN]] : !torch.vtensor<[?,?],f32>
+func.func @torch.aten.masked_fill.Scalar(%arg0: !torch.vtensor<[?,?],f32>, %arg1: !torch.vtensor<[?,?],i1>) -> !torch.vtensor<[?,?],f32> {
+  %float = torch.constant.float 0xFFF0000000000000
+  %0 = torch.aten.masked_fill.Scalar %arg0, %arg1, %float : !torch.vtensor<[?,?],f32>, !torch.vtensor<[?,?],i1>, !torch.float -> !torch.vtensor<[?,?],f32>
+  return %0 : !torch.vtensor<[?,?],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.threshold(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,?],f32>) -> !torch.vtensor<[?,?],f32> {
+// CHECK:         %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,?],f32> -> tensor<?x?xf32>
+// CHECK:         %[[THRESHOLD:.*]] = tcp.broadcast %{{.*}} {axes = [0, 1]} : tensor<1x1xf32>, index, index -> tensor<?x?xf32>
+// CHECK:         %[[VALUE:.*]] = tcp.broadcast %{{.*}} {axes = [0, 1]} : tensor<1x1xf32>, index, index -> tensor<?x?xf32>
+// CHECK:         %[[CMP:.*]] = tcp.compare %[[T0]], %[[THRESHOLD]] {predicate = #tcp<comparePredicate GT>} : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xi1>
+// CHECK:         %[[SELECT:.*]] = tcp.select %[[CMP]], %[[T0]], %[[VALUE]] : tensor<?x?xi1>, tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+// CHECK:         %[[FROM_BUILTIN:.*]] = torch_c.from_builtin_tensor %[[SELECT]] : tensor<?x?xf32> -> !torch.vtensor<[?,?],f32>
+// CHECK:         return %[[FROM_BUILTIN]] : !torch.vtensor<[?,?],f32>
+func.func @torch.aten.threshold(%arg0: !torch.vtensor<[?,?],f32>) -> !torch.vtensor<[?,?],f32> {
+  %float1 = torch.constant.float 1.000000e-01
+  %float0 = torch.constant.float 0.000000e+00
+  %0 = torch.aten.threshold %arg0, %float1, %float0 : !torch.vtensor<[?,?],f32>, !torch.float, !torch.float -> !torch.vtensor<[?,?],f32>
+  return %0 : !torch.vtensor<[?,?],f32>
+}
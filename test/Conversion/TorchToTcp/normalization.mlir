@@ -0,0 +1,109 @@
+// RUN: tcp-opt %s -convert-torch-to-tcp -split-input-file | FileCheck %s
+
+// CHECK-LABEL:  func.func @torch.aten._softmax(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,8],f32>) -> !torch.vtensor<[?,8],f32> {
+// CHECK:         %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,8],f32> -> tensor<?x8xf32>
+// CHECK:         %[[T1:.*]] = tcp.softmax %[[T0]] {axis = 1 : i64} : tensor<?x8xf32> -> tensor<?x8xf32>
+// CHECK:         %[[T2:.*]] = torch_c.from_builtin_tensor %[[T1]] : tensor<?x8xf32> -> !torch.vtensor<[?,8],f32>
+// CHECK:         return %[[T2]] : !torch.vtensor<[?,8],f32>
+func.func @torch.aten._softmax(%arg0: !torch.vtensor<[?,8],f32>) -> !torch.vtensor<[?,8],f32> {
+  %int-1 = torch.constant.int -1
+  %false = torch.constant.bool false
+  %0 = torch.aten._softmax %arg0, %int-1, %false : !torch.vtensor<[?,8],f32>, !torch.int, !torch.bool -> !torch.vtensor<[?,8],f32>
+  return %0 : !torch.vtensor<[?,8],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.log_softmax.int(
+// CHECK:         tcp.log_softmax %{{.*}} {axis = 0 : i64} : tensor<2x4xf32> -> tensor<2x4xf32>
+func.func @torch.aten.log_softmax.int(%arg0: !torch.vtensor<[2,4],f32>) -> !torch.vtensor<[2,4],f32> {
+  %int0 = torch.constant.int 0
+  %none = torch.constant.none
+  %0 = torch.aten.log_softmax.int %arg0, %int0, %none : !torch.vtensor<[2,4],f32>, !torch.int, !torch.none -> !torch.vtensor<[2,4],f32>
+  return %0 : !torch.vtensor<[2,4],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten._softmax$half_to_float(
+// CHECK:         torch.aten._softmax
+// CHECK-NOT:     tcp.softmax
+func.func @torch.aten._softmax$half_to_float(%arg0: !torch.vtensor<[2,4],f16>) -> !torch.vtensor<[2,4],f32> {
+  %int1 = torch.constant.int 1
+  %true = torch.constant.bool true
+  %0 = torch.aten._softmax %arg0, %int1, %true : !torch.vtensor<[2,4],f16>, !torch.int, !torch.bool -> !torch.vtensor<[2,4],f32>
+  return %0 : !torch.vtensor<[2,4],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.softmax.int$dtype(
+// CHECK:         torch.aten.softmax.int
+// CHECK-NOT:     tcp.softmax
+func.func @torch.aten.softmax.int$dtype(%arg0: !torch.vtensor<[2,4],f16>) -> !torch.vtensor<[2,4],f32> {
+  %int1 = torch.constant.int 1
+  %int6 = torch.constant.int 6
+  %0 = torch.aten.softmax.int %arg0, %int1, %int6 : !torch.vtensor<[2,4],f16>, !torch.int, !torch.int -> !torch.vtensor<[2,4],f32>
+  return %0 : !torch.vtensor<[2,4],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.layer_norm(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,4,8],f32>, %[[ARG1:.*]]: !torch.vtensor<[4,8],f32>, %[[ARG2:.*]]: !torch.vtensor<[4,8],f32>) -> !torch.vtensor<[?,4,8],f32> {
+// CHECK-DAG:     %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,4,8],f32> -> tensor<?x4x8xf32>
+// CHECK-DAG:     %[[T1:.*]] = torch_c.to_builtin_tensor %[[ARG1]] : !torch.vtensor<[4,8],f32> -> tensor<4x8xf32>
+// CHECK-DAG:     %[[T2:.*]] = torch_c.to_builtin_tensor %[[ARG2]] : !torch.vtensor<[4,8],f32> -> tensor<4x8xf32>
+// CHECK:         %[[T3:.*]] = tcp.layer_norm %[[T0]] weight(%[[T1]] : tensor<4x8xf32>) bias(%[[T2]] : tensor<4x8xf32>) {axis = 1 : i64, epsilon = 1.000000e-05 : f64} : tensor<?x4x8xf32> -> tensor<?x4x8xf32>
+// CHECK:         %[[T4:.*]] = torch_c.from_builtin_tensor %[[T3]] : tensor<?x4x8xf32> -> !torch.vtensor<[?,4,8],f32>
+// CHECK:         return %[[T4]] : !torch.vtensor<[?,4,8],f32>
+func.func @torch.aten.layer_norm(%arg0: !torch.vtensor<[?,4,8],f32>, %arg1: !torch.vtensor<[4,8],f32>, %arg2: !torch.vtensor<[4,8],f32>) -> !torch.vtensor<[?,4,8],f32> {
+  %int4 = torch.constant.int 4
+  %int8 = torch.constant.int 8
+  %float1e-05 = torch.constant.float 1.000000e-05
+  %true = torch.constant.bool true
+  %0 = torch.prim.ListConstruct %int4, %int8 : (!torch.int, !torch.int) -> !torch.list<int>
+  %1 = torch.aten.layer_norm %arg0, %0, %arg1, %arg2, %float1e-05, %true : !torch.vtensor<[?,4,8],f32>, !torch.list<int>, !torch.vtensor<[4,8],f32>, !torch.vtensor<[4,8],f32>, !torch.float, !torch.bool -> !torch.vtensor<[?,4,8],f32>
+  return %1 : !torch.vtensor<[?,4,8],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.layer_norm$no_affine(
+// CHECK:         tcp.layer_norm %{{.*}} {axis = 1 : i64, epsilon = 1.000000e-05 : f64} : tensor<2x8xf32> -> tensor<2x8xf32>
+func.func @torch.aten.layer_norm$no_affine(%arg0: !torch.vtensor<[2,8],f32>) -> !torch.vtensor<[2,8],f32> {
+  %int8 = torch.constant.int 8
+  %float1e-05 = torch.constant.float 1.000000e-05
+  %none = torch.constant.none
+  %true = torch.constant.bool true
+  %0 = torch.prim.ListConstruct %int8 : (!torch.int) -> !torch.list<int>
+  %1 = torch.aten.layer_norm %arg0, %0, %none, %none, %float1e-05, %true : !torch.vtensor<[2,8],f32>, !torch.list<int>, !torch.none, !torch.none, !torch.float, !torch.bool -> !torch.vtensor<[2,8],f32>
+  return %1 : !torch.vtensor<[2,8],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.native_layer_norm(
+// CHECK:         tcp.layer_norm %{{.*}} weight(%{{.*}} : tensor<8xf32>) bias(%{{.*}} : tensor<8xf32>) {axis = 1 : i64, epsilon = 1.000000e-05 : f64} : tensor<2x8xf32> -> tensor<2x8xf32>
+// CHECK-NOT:     torch.aten.native_layer_norm
+func.func @torch.aten.native_layer_norm(%arg0: !torch.vtensor<[2,8],f32>, %arg1: !torch.vtensor<[8],f32>, %arg2: !torch.vtensor<[8],f32>) -> !torch.vtensor<[2,8],f32> {
+  %int8 = torch.constant.int 8
+  %float1e-05 = torch.constant.float 1.000000e-05
+  %0 = torch.prim.ListConstruct %int8 : (!torch.int) -> !torch.list<int>
+  %result0, %result1, %result2 = torch.aten.native_layer_norm %arg0, %0, %arg1, %arg2, %float1e-05 : !torch.vtensor<[2,8],f32>, !torch.list<int>, !torch.vtensor<[8],f32>, !torch.vtensor<[8],f32>, !torch.float -> !torch.vtensor<[2,8],f32>, !torch.vtensor<[2,1],f32>, !torch.vtensor<[2,1],f32>
+  return %result0 : !torch.vtensor<[2,8],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.native_layer_norm$stats(
+// CHECK:         torch.aten.native_layer_norm
+// CHECK-NOT:     tcp.layer_norm
+func.func @torch.aten.native_layer_norm$stats(%arg0: !torch.vtensor<[2,8],f32>, %arg1: !torch.vtensor<[8],f32>, %arg2: !torch.vtensor<[8],f32>) -> (!torch.vtensor<[2,8],f32>, !torch.vtensor<[2,1],f32>) {
+  %int8 = torch.constant.int 8
+  %float1e-05 = torch.constant.float 1.000000e-05
+  %0 = torch.prim.ListConstruct %int8 : (!torch.int) -> !torch.list<int>
+  %result0, %result1, %result2 = torch.aten.native_layer_norm %arg0, %0, %arg1, %arg2, %float1e-05 : !torch.vtensor<[2,8],f32>, !torch.list<int>, !torch.vtensor<[8],f32>, !torch.vtensor<[8],f32>, !torch.float -> !torch.vtensor<[2,8],f32>, !torch.vtensor<[2,1],f32>, !torch.vtensor<[2,1],f32>
+  return %result0, %result1 : !torch.vtensor<[2,8],f32>, !torch.vtensor<[2,1],f32>
+}
@@ -0,0 +1,123 @@
+// RUN: tcp-opt %s -convert-torch-to-tcp -split-input-file | FileCheck %s
+
+// CHECK-LABEL:  func.func @torch.aten.max_pool2d(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[1,64,112,112],f32>) -> !torch.vtensor<[1,64,56,56],f32> {
+// CHECK:         %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[1,64,112,112],f32> -> tensor<1x64x112x112xf32>
+// CHECK:         %[[T1:.*]] = tcp.max_pool2d %[[T0]] {dilation = [1, 1], kernel_size = [3, 3], padding = [1, 1], stride = [2, 2]} : tensor<1x64x112x112xf32> -> tensor<1x64x56x56xf32>
+// CHECK:         %[[T2:.*]] = torch_c.from_builtin_tensor %[[T1]] : tensor<1x64x56x56xf32> -> !torch.vtensor<[1,64,56,56],f32>
+// CHECK:         return %[[T2]] : !torch.vtensor<[1,64,56,56],f32>
+func.func @torch.aten.max_pool2d(%arg0: !torch.vtensor<[1,64,112,112],f32>) -> !torch.vtensor<[1,64,56,56],f32> {
+  %false = torch.constant.bool false
+  %int1 = torch.constant.int 1
+  %int2 = torch.constant.int 2
+  %int3 = torch.constant.int 3
+  %kernel_size = torch.prim.ListConstruct %int3, %int3 : (!torch.int, !torch.int) -> !torch.list<int>
+  %stride = torch.prim.ListConstruct %int2, %int2 : (!torch.int, !torch.int) -> !torch.list<int>
+  %padding = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %dilation = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.max_pool2d %arg0, %kernel_size, %stride, %padding, %dilation, %false : !torch.vtensor<[1,64,112,112],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool -> !torch.vtensor<[1,64,56,56],f32>
+  return %0 : !torch.vtensor<[1,64,56,56],f32>
+}
+
+// -----
+
+// An empty stride defaults to the kernel size, and single entries apply to
+// both spatial dims.
+
+// CHECK-LABEL:  func.func @torch.aten.max_pool2d$default_stride(
+// CHECK:         tcp.max_pool2d %{{.*}} {dilation = [1, 1], kernel_size = [2, 2], padding = [0, 0], stride = [2, 2]} : tensor<1x8x8x8xf32> -> tensor<1x8x4x4xf32>
+func.func @torch.aten.max_pool2d$default_stride(%arg0: !torch.vtensor<[1,8,8,8],f32>) -> !torch.vtensor<[1,8,4,4],f32> {
+  %false = torch.constant.bool false
+  %int0 = torch.constant.int 0
+  %int1 = torch.constant.int 1
+  %int2 = torch.constant.int 2
+  %kernel_size = torch.prim.ListConstruct %int2 : (!torch.int) -> !torch.list<int>
+  %stride = torch.prim.ListConstruct  : () -> !torch.list<int>
+  %padding = torch.prim.ListConstruct %int0 : (!torch.int) -> !torch.list<int>
+  %dilation = torch.prim.ListConstruct %int1 : (!torch.int) -> !torch.list<int>
+  %0 = torch.aten.max_pool2d %arg0, %kernel_size, %stride, %padding, %dilation, %false : !torch.vtensor<[1,8,8,8],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool -> !torch.vtensor<[1,8,4,4],f32>
+  return %0 : !torch.vtensor<[1,8,4,4],f32>
+}
+
+// -----
+
+// Poolings in ceil mode are left in Torch.
+
+// CHECK-LABEL:  func.func @torch.aten.max_pool2d$ceil_mode(
+// CHECK:         torch.aten.max_pool2d
+// CHECK-NOT:     tcp.max_pool2d
+func.func @torch.aten.max_pool2d$ceil_mode(%arg0: !torch.vtensor<[1,8,9,9],f32>) -> !torch.vtensor<[1,8,5,5],f32> {
+  %true = torch.constant.bool true
+  %int0 = torch.constant.int 0
+  %int1 = torch.constant.int 1
+  %int2 = torch.constant.int 2
+  %kernel_size = torch.prim.ListConstruct %int2, %int2 : (!torch.int, !torch.int) -> !torch.list<int>
+  %stride = torch.prim.ListConstruct %int2, %int2 : (!torch.int, !torch.int) -> !torch.list<int>
+  %padding = torch.prim.ListConstruct %int0, %int0 : (!torch.int, !torch.int) -> !torch.list<int>
+  %dilation = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.max_pool2d %arg0, %kernel_size, %stride, %padding, %dilation, %true : !torch.vtensor<[1,8,9,9],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool -> !torch.vtensor<[1,8,5,5],f32>
+  return %0 : !torch.vtensor<[1,8,5,5],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.avg_pool2d(
+// CHECK:         tcp.avg_pool2d %{{.*}} {count_include_pad = false, kernel_size = [3, 3], padding = [1, 1], stride = [2, 2]} : tensor<2x16x9x9xf32> -> tensor<2x16x5x5xf32>
+func.func @torch.aten.avg_pool2d(%arg0: !torch.vtensor<[2,16,9,9],f32>) -> !torch.vtensor<[2,16,5,5],f32> {
+  %false = torch.constant.bool false
+  %none = torch.constant.none
+  %int1 = torch.constant.int 1
+  %int2 = torch.constant.int 2
+  %int3 = torch.constant.int 3
+  %kernel_size = torch.prim.ListConstruct %int3, %int3 : (!torch.int, !torch.int) -> !torch.list<int>
+  %stride = torch.prim.ListConstruct %int2, %int2 : (!torch.int, !torch.int) -> !torch.list<int>
+  %padding = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.avg_pool2d %arg0, %kernel_size, %stride, %padding, %false, %false, %none : !torch.vtensor<[2,16,9,9],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.bool, !torch.none -> !torch.vtensor<[2,16,5,5],f32>
+  return %0 : !torch.vtensor<[2,16,5,5],f32>
+}
+
+// -----
+
+// Average poolings with a divisor override are left in Torch.
+
+// CHECK-LABEL:  func.func @torch.aten.avg_pool2d$divisor_override(
+// CHECK:         torch.aten.avg_pool2d
+// CHECK-NOT:     tcp.avg_pool2d
+func.func @torch.aten.avg_pool2d$divisor_override(%arg0: !torch.vtensor<[1,8,8,8],f32>) -> !torch.vtensor<[1,8,4,4],f32> {
+  %false = torch.constant.bool false
+  %true = torch.constant.bool true
+  %int0 = torch.constant.int 0
+  %int2 = torch.constant.int 2
+  %int3 = torch.constant.int 3
+  %kernel_size = torch.prim.ListConstruct %int2, %int2 : (!torch.int, !torch.int) -> !torch.list<int>
+  %stride = torch.prim.ListConstruct %int2, %int2 : (!torch.int, !torch.int) -> !torch.list<int>
+  %padding = torch.prim.ListConstruct %int0, %int0 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.avg_pool2d %arg0, %kernel_size, %stride, %padding, %false, %true, %int3 : !torch.vtensor<[1,8,8,8],f32>, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.bool, !torch.int -> !torch.vtensor<[1,8,4,4],f32>
+  return %0 : !torch.vtensor<[1,8,4,4],f32>
+}
+
+// -----
+
+// Adaptive average poolings over static multiples of the output size are
+// plain average poolings.
+
+// CHECK-LABEL:  func.func @torch.aten.adaptive_avg_pool2d(
+// CHECK:         tcp.avg_pool2d %{{.*}} {{.*}}kernel_size = [7, 7], padding = [0, 0], stride = [7, 7]} : tensor<1x512x7x7xf32> -> tensor<1x512x1x1xf32>
+func.func @torch.aten.adaptive_avg_pool2d(%arg0: !torch.vtensor<[1,512,7,7],f32>) -> !torch.vtensor<[1,512,1,1],f32> {
+  %int1 = torch.constant.int 1
+  %output_size = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.adaptive_avg_pool2d %arg0, %output_size : !torch.vtensor<[1,512,7,7],f32>, !torch.list<int> -> !torch.vtensor<[1,512,1,1],f32>
+  return %0 : !torch.vtensor<[1,512,1,1],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.adaptive_avg_pool2d$uneven(
+// CHECK:         torch.aten.adaptive_avg_pool2d
+// CHECK-NOT:     tcp.avg_pool2d
+func.func @torch.aten.adaptive_avg_pool2d$uneven(%arg0: !torch.vtensor<[1,8,7,7],f32>) -> !torch.vtensor<[1,8,2,2],f32> {
+  %int2 = torch.constant.int 2
+  %output_size = torch.prim.ListConstruct %int2, %int2 : (!torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.adaptive_avg_pool2d %arg0, %output_size : !torch.vtensor<[1,8,7,7],f32>, !torch.list<int> -> !torch.vtensor<[1,8,2,2],f32>
+  return %0 : !torch.vtensor<[1,8,2,2],f32>
+}
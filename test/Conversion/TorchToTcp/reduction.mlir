@@ -0,0 +1,151 @@
+// RUN: tcp-opt %s -convert-torch-to-tcp -split-input-file | FileCheck %s
+
+// CHECK-LABEL:  func.func @torch.aten.sum.dim_IntList(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,8],f32>) -> !torch.vtensor<[?],f32> {
+// CHECK:         %[[T0:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,8],f32> -> tensor<?x8xf32>
+// CHECK:         %[[T1:.*]] = tcp.reduce_sum %[[T0]] {axes = [1]{{.*}}} : tensor<?x8xf32> -> tensor<?xf32>
+// CHECK:         %[[T2:.*]] = torch_c.from_builtin_tensor %[[T1]] : tensor<?xf32> -> !torch.vtensor<[?],f32>
+// CHECK:         return %[[T2]] : !torch.vtensor<[?],f32>
+func.func @torch.aten.sum.dim_IntList(%arg0: !torch.vtensor<[?,8],f32>) -> !torch.vtensor<[?],f32> {
+  %int-1 = torch.constant.int -1
+  %false = torch.constant.bool false
+  %none = torch.constant.none
+  %0 = torch.prim.ListConstruct %int-1 : (!torch.int) -> !torch.list<int>
+  %1 = torch.aten.sum.dim_IntList %arg0, %0, %false, %none : !torch.vtensor<[?,8],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[?],f32>
+  return %1 : !torch.vtensor<[?],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.sum$promote(
+// CHECK:         %[[CAST:.*]] = tcp.cast %{{.*}} {in_int_signedness = #tcp<signedness Signed>, out_int_signedness = #tcp<signedness Signed>} : tensor<4x8xi8> -> tensor<4x8xi64>
+// CHECK:         tcp.reduce_sum %[[CAST]] {axes = [0, 1]{{.*}}} : tensor<4x8xi64> -> tensor<i64>
+func.func @torch.aten.sum$promote(%arg0: !torch.vtensor<[4,8],si8>) -> !torch.vtensor<[],si64> {
+  %none = torch.constant.none
+  %0 = torch.aten.sum %arg0, %none : !torch.vtensor<[4,8],si8>, !torch.none -> !torch.vtensor<[],si64>
+  return %0 : !torch.vtensor<[],si64>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.amax(
+// CHECK:         tcp.reduce_max %{{.*}} {axes = [0, 2], keepdim = true} : tensor<2x4x8xf32> -> tensor<1x4x1xf32>
+func.func @torch.aten.amax(%arg0: !torch.vtensor<[2,4,8],f32>) -> !torch.vtensor<[1,4,1],f32> {
+  %int0 = torch.constant.int 0
+  %int2 = torch.constant.int 2
+  %true = torch.constant.bool true
+  %0 = torch.prim.ListConstruct %int2, %int0 : (!torch.int, !torch.int) -> !torch.list<int>
+  %1 = torch.aten.amax %arg0, %0, %true : !torch.vtensor<[2,4,8],f32>, !torch.list<int>, !torch.bool -> !torch.vtensor<[1,4,1],f32>
+  return %1 : !torch.vtensor<[1,4,1],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.min(
+// CHECK:         tcp.reduce_min %{{.*}} {axes = [0, 1]{{.*}}} : tensor<4x8xi32> -> tensor<i32>
+func.func @torch.aten.min(%arg0: !torch.vtensor<[4,8],si32>) -> !torch.vtensor<[],si32> {
+  %0 = torch.aten.min %arg0 : !torch.vtensor<[4,8],si32> -> !torch.vtensor<[],si32>
+  return %0 : !torch.vtensor<[],si32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.prod.dim_int(
+// CHECK:         tcp.reduce_prod %{{.*}} {axes = [0]{{.*}}} : tensor<4x8xf32> -> tensor<8xf32>
+func.func @torch.aten.prod.dim_int(%arg0: !torch.vtensor<[4,8],f32>) -> !torch.vtensor<[8],f32> {
+  %int0 = torch.constant.int 0
+  %false = torch.constant.bool false
+  %none = torch.constant.none
+  %0 = torch.aten.prod.dim_int %arg0, %int0, %false, %none : !torch.vtensor<[4,8],f32>, !torch.int, !torch.bool, !torch.none -> !torch.vtensor<[8],f32>
+  return %0 : !torch.vtensor<[8],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.mean.dim(
+// CHECK:         %[[SUM:.*]] = tcp.reduce_sum %{{.*}} {axes = [1], keepdim = true} : tensor<4x8xf32> -> tensor<4x1xf32>
+// CHECK:         %[[COUNT:.*]] = arith.constant 8.000000e+00 : f32
+// CHECK:         %[[COUNT_TENSOR:.*]] = tensor.from_elements %[[COUNT]] : tensor<f32>
+// CHECK:         %[[EXPAND:.*]] = tensor.expand_shape %[[COUNT_TENSOR]] [] output_shape [1, 1] : tensor<f32> into tensor<1x1xf32>
+// CHECK:         %[[BCAST:.*]] = tcp.broadcast %[[EXPAND]]
+// CHECK:         tcp.divf %[[SUM]], %[[BCAST]] : tensor<4x1xf32>, tensor<4x1xf32> -> tensor<4x1xf32>
+func.func @torch.aten.mean.dim(%arg0: !torch.vtensor<[4,8],f32>) -> !torch.vtensor<[4,1],f32> {
+  %int1 = torch.constant.int 1
+  %true = torch.constant.bool true
+  %none = torch.constant.none
+  %0 = torch.prim.ListConstruct %int1 : (!torch.int) -> !torch.list<int>
+  %1 = torch.aten.mean.dim %arg0, %0, %true, %none : !torch.vtensor<[4,8],f32>, !torch.list<int>, !torch.bool, !torch.none -> !torch.vtensor<[4,1],f32>
+  return %1 : !torch.vtensor<[4,1],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.mean$dynamic(
+// CHECK:         %[[SUM:.*]] = tcp.reduce_sum %[[IN:.*]] {axes = [0, 1]{{.*}}} : tensor<?x8xf32> -> tensor<f32>
+// CHECK:         %[[C0:.*]] = arith.constant 0 : index
+// CHECK:         %[[DIM:.*]] = tensor.dim %[[IN]], %[[C0]] : tensor<?x8xf32>
+// CHECK:         %[[C8:.*]] = arith.constant 8 : index
+// CHECK:         %[[MUL:.*]] = arith.muli %[[DIM]], %[[C8]] : index
+// CHECK:         %[[INT:.*]] = arith.index_cast %[[MUL]] : index to i64
+// CHECK:         %[[FP:.*]] = arith.sitofp %[[INT]] : i64 to f32
+// CHECK:         %[[COUNT:.*]] = tensor.from_elements %[[FP]] : tensor<f32>
+// CHECK:         tcp.divf %[[SUM]], %[[COUNT]] : tensor<f32>, tensor<f32> -> tensor<f32>
+func.func @torch.aten.mean$dynamic(%arg0: !torch.vtensor<[?,8],f32>) -> !torch.vtensor<[],f32> {
+  %none = torch.constant.none
+  %0 = torch.aten.mean %arg0, %none : !torch.vtensor<[?,8],f32>, !torch.none -> !torch.vtensor<[],f32>
+  return %0 : !torch.vtensor<[],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.amax$dynamic_dims(
+// CHECK:         torch.aten.amax
+// CHECK-NOT:     tcp.reduce_max
+func.func @torch.aten.amax$dynamic_dims(%arg0: !torch.vtensor<[4,8],f32>, %arg1: !torch.int) -> !torch.vtensor<[4],f32> {
+  %false = torch.constant.bool false
+  %0 = torch.prim.ListConstruct %arg1 : (!torch.int) -> !torch.list<int>
+  %1 = torch.aten.amax %arg0, %0, %false : !torch.vtensor<[4,8],f32>, !torch.list<int>, !torch.bool -> !torch.vtensor<[4],f32>
+  return %1 : !torch.vtensor<[4],f32>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.cumsum(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?],si32>) -> !torch.vtensor<[?],si64>
+// CHECK:         %[[IN:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?],si32> -> tensor<?xi32>
+// CHECK:         %[[CAST:.*]] = tcp.cast %[[IN]] {in_int_signedness = #tcp<signedness Signed>, out_int_signedness = #tcp<signedness Signed>} : tensor<?xi32> -> tensor<?xi64>
+// CHECK:         %[[SUM:.*]] = tcp.cumsum %[[CAST]] {dim = 0 : i64} : tensor<?xi64> -> tensor<?xi64>
+// CHECK:         %[[RES:.*]] = torch_c.from_builtin_tensor %[[SUM]] : tensor<?xi64> -> !torch.vtensor<[?],si64>
+// CHECK:         return %[[RES]]
+func.func @torch.aten.cumsum(%arg0: !torch.vtensor<[?],si32>) -> !torch.vtensor<[?],si64> {
+  %int0 = torch.constant.int 0
+  %none = torch.constant.none
+  %0 = torch.aten.cumsum %arg0, %int0, %none : !torch.vtensor<[?],si32>, !torch.int, !torch.none -> !torch.vtensor<[?],si64>
+  return %0 : !torch.vtensor<[?],si64>
+}
+
+// -----
+
+// CHECK-LABEL:  func.func @torch.aten.cumprod(
+// CHECK-NOT:     tcp.cast
+// CHECK:         tcp.cumprod %{{.*}} {dim = 1 : i64} : tensor<4x?xf32> -> tensor<4x?xf32>
+func.func @torch.aten.cumprod(%arg0: !torch.vtensor<[4,?],f32>) -> !torch.vtensor<[4,?],f32> {
+  %int-1 = torch.constant.int -1
+  %none = torch.constant.none
+  %0 = torch.aten.cumprod %arg0, %int-1, %none : !torch.vtensor<[4,?],f32>, !torch.int, !torch.none -> !torch.vtensor<[4,?],f32>
+  return %0 : !torch.vtensor<[4,?],f32>
+}
+
+// -----
+
+// Scans with a dtype are left in Torch.
+
+// CHECK-LABEL:  func.func @torch.aten.cumsum$dtype(
+// CHECK:         torch.aten.cumsum
+// CHECK-NOT:     tcp.cumsum
+func.func @torch.aten.cumsum$dtype(%arg0: !torch.vtensor<[4,8],f32>) -> !torch.vtensor<[4,8],f64> {
+  %int1 = torch.constant.int 1
+  %int7 = torch.constant.int 7
+  %0 = torch.aten.cumsum %arg0, %int1, %int7 : !torch.vtensor<[4,8],f32>, !torch.int, !torch.int -> !torch.vtensor<[4,8],f64>
+  return %0 : !torch.vtensor<[4,8],f64>
+}
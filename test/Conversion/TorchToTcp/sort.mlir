@@ -0,0 +1,103 @@
+// RUN: tcp-opt %s -convert-torch-to-tcp -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @torch.aten.topk(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,2304],f32>) -> (!torch.vtensor<[?,80],f32>, !torch.vtensor<[?,80],si64>)
+// CHECK:         %[[IN:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,2304],f32> -> tensor<?x2304xf32>
+// CHECK:         %[[VALUES:.*]], %[[INDICES:.*]] = tcp.topk %[[IN]] {dim = 1 : i64, k = 80 : i64, largest = false} : tensor<?x2304xf32> -> tensor<?x80xf32>, tensor<?x80xi64>
+// CHECK-DAG:     %[[RES0:.*]] = torch_c.from_builtin_tensor %[[VALUES]] : tensor<?x80xf32> -> !torch.vtensor<[?,80],f32>
+// CHECK-DAG:     %[[RES1:.*]] = torch_c.from_builtin_tensor %[[INDICES]] : tensor<?x80xi64> -> !torch.vtensor<[?,80],si64>
+// CHECK:         return %[[RES0]], %[[RES1]]
+func.func @torch.aten.topk(%arg0: !torch.vtensor<[?,2304],f32>) -> (!torch.vtensor<[?,80],f32>, !torch.vtensor<[?,80],si64>) {
+  %int-1 = torch.constant.int -1
+  %int80 = torch.constant.int 80
+  %false = torch.constant.bool false
+  %true = torch.constant.bool true
+  %values, %indices = torch.aten.topk %arg0, %int80, %int-1, %false, %true : !torch.vtensor<[?,2304],f32>, !torch.int, !torch.int, !torch.bool, !torch.bool -> !torch.vtensor<[?,80],f32>, !torch.vtensor<[?,80],si64>
+  return %values, %indices : !torch.vtensor<[?,80],f32>, !torch.vtensor<[?,80],si64>
+}
+
+// -----
+
+// Top-k with a non-constant `k` is left in Torch.
+
+// CHECK-LABEL: func.func @torch.aten.topk$dynamic_k(
+// CHECK:         torch.aten.topk
+// CHECK-NOT:     tcp.topk
+func.func @torch.aten.topk$dynamic_k(%arg0: !torch.vtensor<[4,16],f32>, %arg1: !torch.int) -> !torch.vtensor<[4,?],f32> {
+  %int1 = torch.constant.int 1
+  %true = torch.constant.bool true
+  %values, %indices = torch.aten.topk %arg0, %arg1, %int1, %true, %true : !torch.vtensor<[4,16],f32>, !torch.int, !torch.int, !torch.bool, !torch.bool -> !torch.vtensor<[4,?],f32>, !torch.vtensor<[4,?],si64>
+  return %values : !torch.vtensor<[4,?],f32>
+}
+
+// -----
+
+// Integers are compared as signed by tcp.topk, so unsigned top-k is left in
+// Torch.
+
+// CHECK-LABEL: func.func @torch.aten.topk$unsigned(
+// CHECK:         torch.aten.topk
+// CHECK-NOT:     tcp.topk
+func.func @torch.aten.topk$unsigned(%arg0: !torch.vtensor<[4,16],ui8>) -> !torch.vtensor<[4,2],ui8> {
+  %int1 = torch.constant.int 1
+  %int2 = torch.constant.int 2
+  %true = torch.constant.bool true
+  %values, %indices = torch.aten.topk %arg0, %int2, %int1, %true, %true : !torch.vtensor<[4,16],ui8>, !torch.int, !torch.int, !torch.bool, !torch.bool -> !torch.vtensor<[4,2],ui8>, !torch.vtensor<[4,2],si64>
+  return %values : !torch.vtensor<[4,2],ui8>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @torch.aten.sort(
+// CHECK-SAME:         %[[ARG0:.*]]: !torch.vtensor<[?,2304],si32>) -> (!torch.vtensor<[?,2304],si32>, !torch.vtensor<[?,2304],si64>)
+// CHECK:         %[[IN:.*]] = torch_c.to_builtin_tensor %[[ARG0]] : !torch.vtensor<[?,2304],si32> -> tensor<?x2304xi32>
+// CHECK:         %[[VALUES:.*]], %[[INDICES:.*]] = tcp.sort %[[IN]] {descending = true, dim = 1 : i64, stable = false} : tensor<?x2304xi32> -> tensor<?x2304xi32>, tensor<?x2304xi64>
+// CHECK-DAG:     %[[RES0:.*]] = torch_c.from_builtin_tensor %[[VALUES]] : tensor<?x2304xi32> -> !torch.vtensor<[?,2304],si32>
+// CHECK-DAG:     %[[RES1:.*]] = torch_c.from_builtin_tensor %[[INDICES]] : tensor<?x2304xi64> -> !torch.vtensor<[?,2304],si64>
+// CHECK:         return %[[RES0]], %[[RES1]]
+func.func @torch.aten.sort(%arg0: !torch.vtensor<[?,2304],si32>) -> (!torch.vtensor<[?,2304],si32>, !torch.vtensor<[?,2304],si64>) {
+  %int-1 = torch.constant.int -1
+  %true = torch.constant.bool true
+  %values, %indices = torch.aten.sort %arg0, %int-1, %true : !torch.vtensor<[?,2304],si32>, !torch.int, !torch.bool -> !torch.vtensor<[?,2304],si32>, !torch.vtensor<[?,2304],si64>
+  return %values, %indices : !torch.vtensor<[?,2304],si32>, !torch.vtensor<[?,2304],si64>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @torch.aten.sort.stable(
+// CHECK:         tcp.sort %{{.*}} {descending = false, dim = 1 : i64, stable = true} : tensor<4x4096xf32> -> tensor<4x4096xf32>, tensor<4x4096xi64>
+func.func @torch.aten.sort.stable(%arg0: !torch.vtensor<[4,4096],f32>) -> (!torch.vtensor<[4,4096],f32>, !torch.vtensor<[4,4096],si64>) {
+  %int1 = torch.constant.int 1
+  %true = torch.constant.bool true
+  %false = torch.constant.bool false
+  %values, %indices = torch.aten.sort.stable %arg0, %true, %int1, %false : !torch.vtensor<[4,4096],f32>, !torch.bool, !torch.int, !torch.bool -> !torch.vtensor<[4,4096],f32>, !torch.vtensor<[4,4096],si64>
+  return %values, %indices : !torch.vtensor<[4,4096],f32>, !torch.vtensor<[4,4096],si64>
+}
+
+// -----
+
+// Without `stable`, `aten.sort.stable` does not guarantee the order of equal
+// elements either.
+
+// CHECK-LABEL: func.func @torch.aten.sort.stable$none(
+// CHECK:         tcp.sort %{{.*}} {descending = true, dim = 0 : i64, stable = false} : tensor<16xi32> -> tensor<16xi32>, tensor<16xi64>
+func.func @torch.aten.sort.stable$none(%arg0: !torch.vtensor<[16],si32>) -> (!torch.vtensor<[16],si32>, !torch.vtensor<[16],si64>) {
+  %none = torch.constant.none
+  %int0 = torch.constant.int 0
+  %true = torch.constant.bool true
+  %values, %indices = torch.aten.sort.stable %arg0, %none, %int0, %true : !torch.vtensor<[16],si32>, !torch.none, !torch.int, !torch.bool -> !torch.vtensor<[16],si32>, !torch.vtensor<[16],si64>
+  return %values, %indices : !torch.vtensor<[16],si32>, !torch.vtensor<[16],si64>
+}
+
+// -----
+
+// Sorts with a non-constant `descending` are left in Torch.
+
+// CHECK-LABEL: func.func @torch.aten.sort$dynamic_descending(
+// CHECK:         torch.aten.sort
+// CHECK-NOT:     tcp.sort
+func.func @torch.aten.sort$dynamic_descending(%arg0: !torch.vtensor<[4,16],f32>, %arg1: !torch.bool) -> !torch.vtensor<[4,16],f32> {
+  %int1 = torch.constant.int 1
+  %values, %indices = torch.aten.sort %arg0, %int1, %arg1 : !torch.vtensor<[4,16],f32>, !torch.int, !torch.bool -> !torch.vtensor<[4,16],f32>, !torch.vtensor<[4,16],si64>
+  return %values : !torch.vtensor<[4,16],f32>
+}
@@ -92,3 +92,64 @@ func.func @test_atan2_f32(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x?xf32>) -> t
   return %0 : tensor<?x?xf32>
 }
 
+
+// -----
+
+// CHECK-LABEL: func.func @test_compare_f32(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x?xf32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<?x?xf32>) -> tensor<?x?xi1>
+// CHECK:         %[[CMP:.*]] = tcp.compare %[[ARG0]], %[[ARG1]] {predicate = #tcp<comparePredicate LT>} : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xi1>
+// CHECK:         return %[[CMP]] : tensor<?x?xi1>
+func.func @test_compare_f32(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x?xf32>) -> tensor<?x?xi1> {
+  %0 = tcp.compare %arg0, %arg1 {predicate = #tcp<comparePredicate LT>} : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xi1>
+  return %0 : tensor<?x?xi1>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_compare_i32(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?xi32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<?xi32>) -> tensor<?xi1>
+// CHECK:         %[[CMP:.*]] = tcp.compare %[[ARG0]], %[[ARG1]] {int_signedness = #tcp<signedness Signed>, predicate = #tcp<comparePredicate GE>} : tensor<?xi32>, tensor<?xi32> -> tensor<?xi1>
+// CHECK:         return %[[CMP]] : tensor<?xi1>
+func.func @test_compare_i32(%arg0 : tensor<?xi32>, %arg1 : tensor<?xi32>) -> tensor<?xi1> {
+  %0 = tcp.compare %arg0, %arg1 {int_signedness = #tcp<signedness Signed>, predicate = #tcp<comparePredicate GE>} : tensor<?xi32>, tensor<?xi32> -> tensor<?xi1>
+  return %0 : tensor<?xi1>
+}
+
+// -----
+
+func.func @test_compare_diff_elem_type(%arg0 : tensor<?xf32>, %arg1 : tensor<?xi32>) -> tensor<?xi1> {
+  // expected-error@+1 {{'tcp.compare' op failed to verify that all of {in1, in2} have same element type}}
+  %0 = tcp.compare %arg0, %arg1 {predicate = #tcp<comparePredicate EQ>} : tensor<?xf32>, tensor<?xi32> -> tensor<?xi1>
+  return %0 : tensor<?xi1>
+}
+
+// -----
+
+func.func @test_compare_float_signedness(%arg0 : tensor<?xf32>, %arg1 : tensor<?xf32>) -> tensor<?xi1> {
+  // expected-error@+1 {{'tcp.compare' op failed to verify that `int_signedness` is not set for floating point operands}}
+  %0 = tcp.compare %arg0, %arg1 {int_signedness = #tcp<signedness Signed>, predicate = #tcp<comparePredicate EQ>} : tensor<?xf32>, tensor<?xf32> -> tensor<?xi1>
+  return %0 : tensor<?xi1>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_select(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x?xi1>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<?x?xf32>,
+// CHECK-SAME:          %[[ARG2:.*]]: tensor<?x?xf32>) -> tensor<?x?xf32>
+// CHECK:         %[[SELECT:.*]] = tcp.select %[[ARG0]], %[[ARG1]], %[[ARG2]] : tensor<?x?xi1>, tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+// CHECK:         return %[[SELECT]] : tensor<?x?xf32>
+func.func @test_select(%arg0 : tensor<?x?xi1>, %arg1 : tensor<?x?xf32>, %arg2 : tensor<?x?xf32>) -> tensor<?x?xf32> {
+  %0 = tcp.select %arg0, %arg1, %arg2 : tensor<?x?xi1>, tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  return %0 : tensor<?x?xf32>
+}
+
+// -----
+
+func.func @test_select_diff_shape(%arg0 : tensor<5xi1>, %arg1 : tensor<6xf32>, %arg2 : tensor<6xf32>) -> tensor<6xf32> {
+  // expected-error@+1 {{'tcp.select' op all non-scalar operands/results must have the same shape and base type}}
+  %0 = tcp.select %arg0, %arg1, %arg2 : tensor<5xi1>, tensor<6xf32>, tensor<6xf32> -> tensor<6xf32>
+  return %0 : tensor<6xf32>
+}
@@ -27,3 +27,116 @@ func.func @test_tcp_symbolic_int$canonicalize(%arg0: tensor<?xf32>, %arg1: tenso
   tcp.bind_symbolic_shape %arg1, [%0], affine_map<()[s0] -> (s0 + 1)> : tensor<?xf32>
   return %arg0 : tensor<?xf32>
 }
+
+// -----
+
+// CHECK-LABEL: func.func @test_transpose_identity(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x4xf32>) -> tensor<2x4xf32>
+// CHECK-NOT:     tcp.transpose
+// CHECK:         return %[[ARG0]] : tensor<2x4xf32>
+func.func @test_transpose_identity(%arg0 : tensor<2x4xf32>) -> tensor<2x4xf32> {
+  %0 = tcp.transpose %arg0 {permutation = [0, 1]} : tensor<2x4xf32> -> tensor<2x4xf32>
+  return %0 : tensor<2x4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_transpose_inverse(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x4x8xf32>) -> tensor<2x4x8xf32>
+// CHECK-NOT:     tcp.transpose
+// CHECK:         return %[[ARG0]] : tensor<2x4x8xf32>
+func.func @test_transpose_inverse(%arg0 : tensor<2x4x8xf32>) -> tensor<2x4x8xf32> {
+  %0 = tcp.transpose %arg0 {permutation = [2, 0, 1]} : tensor<2x4x8xf32> -> tensor<8x2x4xf32>
+  %1 = tcp.transpose %0 {permutation = [1, 2, 0]} : tensor<8x2x4xf32> -> tensor<2x4x8xf32>
+  return %1 : tensor<2x4x8xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_transpose_chain(
+// CHECK:         %[[T0:.*]] = tcp.transpose %{{.*}} {permutation = [1, 0, 2]}
+// CHECK:         %[[T1:.*]] = tcp.transpose %[[T0]] {permutation = [0, 2, 1]}
+// CHECK:         return %[[T1]]
+func.func @test_transpose_chain(%arg0 : tensor<2x4x8xf32>) -> tensor<4x8x2xf32> {
+  %0 = tcp.transpose %arg0 {permutation = [1, 0, 2]} : tensor<2x4x8xf32> -> tensor<4x2x8xf32>
+  %1 = tcp.transpose %0 {permutation = [0, 2, 1]} : tensor<4x2x8xf32> -> tensor<4x8x2xf32>
+  return %1 : tensor<4x8x2xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_collapse_of_expand_shape(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x16xf32>) -> tensor<?x16xf32>
+// CHECK-NOT:     tcp.expand_shape
+// CHECK-NOT:     tcp.collapse_shape
+// CHECK:         return %[[ARG0]] : tensor<?x16xf32>
+func.func @test_collapse_of_expand_shape(%arg0 : tensor<?x16xf32>) -> tensor<?x16xf32> {
+  %0 = tcp.expand_shape %arg0 {reassociation = [[0, 1], [2]]} : tensor<?x16xf32> -> tensor<?x4x16xf32>
+  %1 = tcp.collapse_shape %0 {reassociation = [[0, 1], [2]]} : tensor<?x4x16xf32> -> tensor<?x16xf32>
+  return %1 : tensor<?x16xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_expand_of_collapse_shape(
+// CHECK:         %[[C:.*]] = tcp.collapse_shape %{{.*}} {reassociation = {{\[\[}}0, 1], [2]]}
+// CHECK:         %[[E:.*]] = tcp.expand_shape %[[C]] {reassociation = {{\[\[}}0], [1, 2]]}
+// CHECK:         return %[[E]]
+func.func @test_expand_of_collapse_shape(%arg0 : tensor<2x4x8xf32>) -> tensor<8x2x4xf32> {
+  %0 = tcp.collapse_shape %arg0 {reassociation = [[0, 1], [2]]} : tensor<2x4x8xf32> -> tensor<8x8xf32>
+  %1 = tcp.expand_shape %0 {reassociation = [[0], [1, 2]]} : tensor<8x8xf32> -> tensor<8x2x4xf32>
+  return %1 : tensor<8x2x4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_pad_zero(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<4x8xf32>, %{{.*}}: tensor<f32>) -> tensor<4x8xf32>
+// CHECK-NOT:     tcp.pad
+// CHECK:         return %[[ARG0]] : tensor<4x8xf32>
+func.func @test_pad_zero(%arg0 : tensor<4x8xf32>, %arg1 : tensor<f32>) -> tensor<4x8xf32> {
+  %0 = tcp.pad %arg0, %arg1 {low = [0, 0], high = [0, 0]} : tensor<4x8xf32>, tensor<f32> -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_pad_into_conv2d(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<1x4x8x8xf32>, %[[ARG1:.*]]: tensor<8x4x3x3xf32>)
+// CHECK-NOT:     tcp.pad
+// CHECK:         %[[CONV:.*]] = tcp.conv2d %[[ARG0]], %[[ARG1]] {dilation = [1, 1], groups = 1 : i64, padding = [2, 1], stride = [1, 1]} : tensor<1x4x8x8xf32>, tensor<8x4x3x3xf32> -> tensor<1x8x10x8xf32>
+// CHECK:         return %[[CONV]]
+func.func @test_pad_into_conv2d(%arg0 : tensor<1x4x8x8xf32>, %arg1 : tensor<8x4x3x3xf32>) -> tensor<1x8x10x8xf32> {
+  %cst = tcp.const {value = dense<0.0> : tensor<f32>} : tensor<f32>
+  %0 = tcp.pad %arg0, %cst {low = [0, 0, 1, 0], high = [0, 0, 1, 0]} : tensor<1x4x8x8xf32>, tensor<f32> -> tensor<1x4x10x8xf32>
+  %1 = tcp.conv2d %0, %arg1 {stride = [1, 1], padding = [1, 1], dilation = [1, 1], groups = 1 : i64} : tensor<1x4x10x8xf32>, tensor<8x4x3x3xf32> -> tensor<1x8x10x8xf32>
+  return %1 : tensor<1x8x10x8xf32>
+}
+
+// -----
+
+// The zero padding value that TorchToTcp creates is a cast constant.
+
+// CHECK-LABEL: func.func @test_pad_into_conv2d_cast_zero(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<1x4x8x8xf32>, %[[ARG1:.*]]: tensor<8x4x3x3xf32>)
+// CHECK-NOT:     tcp.pad
+// CHECK:         tcp.conv2d %[[ARG0]], %[[ARG1]] {dilation = [1, 1], groups = 1 : i64, padding = [1, 1], stride = [1, 1]}
+func.func @test_pad_into_conv2d_cast_zero(%arg0 : tensor<1x4x8x8xf32>, %arg1 : tensor<8x4x3x3xf32>) -> tensor<1x8x8x8xf32> {
+  %cst = tcp.const {value = dense<0.0> : tensor<f64>} : tensor<f64>
+  %0 = tcp.cast %cst : tensor<f64> -> tensor<f32>
+  %1 = tcp.pad %arg0, %0 {low = [0, 0, 1, 1], high = [0, 0, 1, 1]} : tensor<1x4x8x8xf32>, tensor<f32> -> tensor<1x4x10x10xf32>
+  %2 = tcp.conv2d %1, %arg1 {stride = [1, 1], padding = [0, 0], dilation = [1, 1], groups = 1 : i64} : tensor<1x4x10x10xf32>, tensor<8x4x3x3xf32> -> tensor<1x8x8x8xf32>
+  return %2 : tensor<1x8x8x8xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_pad_into_conv2d_asymmetric(
+// CHECK:         %[[PAD:.*]] = tcp.pad
+// CHECK:         tcp.conv2d %[[PAD]], %{{.*}} {dilation = [1, 1], groups = 1 : i64, padding = [0, 0], stride = [1, 1]}
+func.func @test_pad_into_conv2d_asymmetric(%arg0 : tensor<1x4x8x8xf32>, %arg1 : tensor<8x4x3x3xf32>) -> tensor<1x8x7x6xf32> {
+  %cst = tcp.const {value = dense<0.0> : tensor<f32>} : tensor<f32>
+  %0 = tcp.pad %arg0, %cst {low = [0, 0, 1, 0], high = [0, 0, 0, 0]} : tensor<1x4x8x8xf32>, tensor<f32> -> tensor<1x4x9x8xf32>
+  %1 = tcp.conv2d %0, %arg1 {stride = [1, 1], padding = [0, 0], dilation = [1, 1], groups = 1 : i64} : tensor<1x4x9x8xf32>, tensor<8x4x3x3xf32> -> tensor<1x8x7x6xf32>
+  return %1 : tensor<1x8x7x6xf32>
+}
@@ -0,0 +1,97 @@
+// RUN: tcp-opt %s -split-input-file -tcp-concat-in-place | FileCheck %s
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+
+// CHECK-LABEL: func.func @concat_producers(
+// CHECK-SAME:      %[[ARG0:.+]]: tensor<2x4xf32>, %[[ARG1:.+]]: tensor<2x8xf32>, %[[ARG2:.+]]: tensor<8x4xf32>, %[[ARG3:.+]]: tensor<2x4xf32>)
+// CHECK:         %[[DEST:.+]] = tensor.empty() : tensor<2x12xf32>
+// CHECK:         %[[SLICE0:.+]] = tensor.extract_slice %[[DEST]][0, 4] [2, 4] [1, 1] : tensor<2x12xf32> to tensor<2x4xf32>
+// CHECK:         %[[TANH:.+]] = linalg.generic {{.*}} ins(%[[ARG0]] : tensor<2x4xf32>) outs(%[[SLICE0]] : tensor<2x4xf32>)
+// CHECK:         %[[INSERT0:.+]] = tensor.insert_slice %[[TANH]] into %[[DEST]][0, 4] [2, 4] [1, 1] : tensor<2x4xf32> into tensor<2x12xf32>
+// CHECK:         %[[SLICE1:.+]] = tensor.extract_slice %[[INSERT0]][0, 8] [2, 4] [1, 1] : tensor<2x12xf32> to tensor<2x4xf32>
+// CHECK:         %[[FILL:.+]] = linalg.fill ins(%{{.+}} : f32) outs(%[[SLICE1]] : tensor<2x4xf32>)
+// CHECK:         %[[MATMUL:.+]] = linalg.matmul ins(%[[ARG1]], %[[ARG2]] : tensor<2x8xf32>, tensor<8x4xf32>) outs(%[[FILL]] : tensor<2x4xf32>)
+// CHECK:         %[[INSERT1:.+]] = tensor.insert_slice %[[MATMUL]] into %[[INSERT0]][0, 8] [2, 4] [1, 1] : tensor<2x4xf32> into tensor<2x12xf32>
+// CHECK:         %[[INSERT2:.+]] = tensor.insert_slice %[[ARG3]] into %[[INSERT1]][0, 0] [2, 4] [1, 1] : tensor<2x4xf32> into tensor<2x12xf32>
+// CHECK:         return %[[INSERT2]] : tensor<2x12xf32>
+func.func @concat_producers(%arg0: tensor<2x4xf32>, %arg1: tensor<2x8xf32>, %arg2: tensor<8x4xf32>, %arg3: tensor<2x4xf32>) -> tensor<2x12xf32> {
+  %cst = arith.constant 0.000000e+00 : f32
+  %0 = tensor.empty() : tensor<2x4xf32>
+  %1 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel"]} ins(%arg0 : tensor<2x4xf32>) outs(%0 : tensor<2x4xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %9 = math.tanh %in : f32
+    linalg.yield %9 : f32
+  } -> tensor<2x4xf32>
+  %2 = tensor.empty() : tensor<2x4xf32>
+  %3 = linalg.fill ins(%cst : f32) outs(%2 : tensor<2x4xf32>) -> tensor<2x4xf32>
+  %4 = linalg.matmul ins(%arg1, %arg2 : tensor<2x8xf32>, tensor<8x4xf32>) outs(%3 : tensor<2x4xf32>) -> tensor<2x4xf32>
+  %5 = tensor.empty() : tensor<2x12xf32>
+  %6 = tensor.insert_slice %arg3 into %5[0, 0] [2, 4] [1, 1] : tensor<2x4xf32> into tensor<2x12xf32>
+  %7 = tensor.insert_slice %1 into %6[0, 4] [2, 4] [1, 1] : tensor<2x4xf32> into tensor<2x12xf32>
+  %8 = tensor.insert_slice %4 into %7[0, 8] [2, 4] [1, 1] : tensor<2x4xf32> into tensor<2x12xf32>
+  return %8 : tensor<2x12xf32>
+}
+
+// -----
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+
+// A producer whose result is also used elsewhere keeps its own tensor.
+
+// CHECK-LABEL: func.func @producer_with_other_users(
+// CHECK:         %[[EMPTY:.+]] = tensor.empty() : tensor<2x4xf32>
+// CHECK:         %[[TANH:.+]] = linalg.generic {{.*}} outs(%[[EMPTY]] : tensor<2x4xf32>)
+// CHECK:         %[[DEST:.+]] = tensor.empty() : tensor<4x4xf32>
+// CHECK:         %[[INSERT0:.+]] = tensor.insert_slice %[[TANH]] into %[[DEST]][0, 0] [2, 4] [1, 1]
+// CHECK:         tensor.insert_slice %{{.+}} into %[[INSERT0]][2, 0] [2, 4] [1, 1]
+// CHECK-NOT:     tensor.extract_slice
+func.func @producer_with_other_users(%arg0: tensor<2x4xf32>, %arg1: tensor<2x4xf32>) -> (tensor<4x4xf32>, tensor<2x4xf32>) {
+  %0 = tensor.empty() : tensor<2x4xf32>
+  %1 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel"]} ins(%arg0 : tensor<2x4xf32>) outs(%0 : tensor<2x4xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %5 = math.tanh %in : f32
+    linalg.yield %5 : f32
+  } -> tensor<2x4xf32>
+  %2 = tensor.empty() : tensor<4x4xf32>
+  %3 = tensor.insert_slice %1 into %2[0, 0] [2, 4] [1, 1] : tensor<2x4xf32> into tensor<4x4xf32>
+  %4 = tensor.insert_slice %arg1 into %3[2, 0] [2, 4] [1, 1] : tensor<2x4xf32> into tensor<4x4xf32>
+  return %4, %1 : tensor<4x4xf32>, tensor<2x4xf32>
+}
+
+// -----
+
+#map = affine_map<(d0) -> (d0)>
+
+// The offset of the second input is only computed after its producer, which
+// then keeps its own tensor.
+
+// CHECK-LABEL: func.func @dynamic_offsets(
+// CHECK:         %[[DEST:.+]] = tensor.empty(%{{.+}}) : tensor<?xf32>
+// CHECK:         %[[SLICE:.+]] = tensor.extract_slice %[[DEST]][0] [%{{.+}}] [1] : tensor<?xf32> to tensor<?xf32>
+// CHECK:         %[[TANH:.+]] = linalg.generic {{.*}} outs(%[[SLICE]] : tensor<?xf32>)
+// CHECK:         %[[INSERT0:.+]] = tensor.insert_slice %[[TANH]] into %[[DEST]][0] [%{{.+}}] [1]
+// CHECK:         %[[EMPTY:.+]] = tensor.empty(%{{.+}}) : tensor<?xf32>
+// CHECK:         %[[EXP:.+]] = linalg.generic {{.*}} outs(%[[EMPTY]] : tensor<?xf32>)
+// CHECK:         tensor.insert_slice %[[EXP]] into %[[INSERT0]]
+func.func @dynamic_offsets(%arg0: tensor<?xf32>, %arg1: tensor<?xf32>, %size: index) -> tensor<?xf32> {
+  %c0 = arith.constant 0 : index
+  %d0 = tensor.dim %arg0, %c0 : tensor<?xf32>
+  %d1 = tensor.dim %arg1, %c0 : tensor<?xf32>
+  %0 = tensor.empty(%d0) : tensor<?xf32>
+  %1 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel"]} ins(%arg0 : tensor<?xf32>) outs(%0 : tensor<?xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %7 = math.tanh %in : f32
+    linalg.yield %7 : f32
+  } -> tensor<?xf32>
+  %2 = tensor.empty(%d1) : tensor<?xf32>
+  %3 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel"]} ins(%arg1 : tensor<?xf32>) outs(%2 : tensor<?xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %7 = math.exp %in : f32
+    linalg.yield %7 : f32
+  } -> tensor<?xf32>
+  %4 = tensor.empty(%size) : tensor<?xf32>
+  %5 = tensor.insert_slice %1 into %4[0] [%d0] [1] : tensor<?xf32> into tensor<?xf32>
+  %offset = arith.addi %d0, %c0 : index
+  %6 = tensor.insert_slice %3 into %5[%offset] [%d1] [1] : tensor<?xf32> into tensor<?xf32>
+  return %6 : tensor<?xf32>
+}
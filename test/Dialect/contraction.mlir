@@ -0,0 +1,55 @@
+// RUN: tcp-opt %s -split-input-file -verify-diagnostics | FileCheck %s
+
+// CHECK-LABEL: func.func @test_matmul(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x8xf32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<8x16xf32>) -> tensor<?x16xf32>
+// CHECK:         %[[MATMUL:.*]] = tcp.matmul %[[ARG0]], %[[ARG1]] : tensor<?x8xf32>, tensor<8x16xf32> -> tensor<?x16xf32>
+// CHECK:         return %[[MATMUL]] : tensor<?x16xf32>
+func.func @test_matmul(%arg0 : tensor<?x8xf32>, %arg1 : tensor<8x16xf32>) -> tensor<?x16xf32> {
+  %0 = tcp.matmul %arg0, %arg1 : tensor<?x8xf32>, tensor<8x16xf32> -> tensor<?x16xf32>
+  return %0 : tensor<?x16xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_batch_matmul(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x4x8xi32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<2x8x?xi32>) -> tensor<2x4x?xi32>
+// CHECK:         %[[MATMUL:.*]] = tcp.batch_matmul %[[ARG0]], %[[ARG1]] : tensor<2x4x8xi32>, tensor<2x8x?xi32> -> tensor<2x4x?xi32>
+// CHECK:         return %[[MATMUL]] : tensor<2x4x?xi32>
+func.func @test_batch_matmul(%arg0 : tensor<2x4x8xi32>, %arg1 : tensor<2x8x?xi32>) -> tensor<2x4x?xi32> {
+  %0 = tcp.batch_matmul %arg0, %arg1 : tensor<2x4x8xi32>, tensor<2x8x?xi32> -> tensor<2x4x?xi32>
+  return %0 : tensor<2x4x?xi32>
+}
+
+// -----
+
+func.func @test_matmul_rank(%arg0 : tensor<2x4x8xf32>, %arg1 : tensor<8x16xf32>) -> tensor<4x16xf32> {
+  // expected-error@+1{{'tcp.matmul' op failed to verify that all operands and the result are of rank 2}}
+  %0 = tcp.matmul %arg0, %arg1 : tensor<2x4x8xf32>, tensor<8x16xf32> -> tensor<4x16xf32>
+  return %0 : tensor<4x16xf32>
+}
+
+// -----
+
+func.func @test_matmul_contraction_dims(%arg0 : tensor<4x8xf32>, %arg1 : tensor<6x16xf32>) -> tensor<4x16xf32> {
+  // expected-error@+1{{'tcp.matmul' op failed to verify that the contraction dims of lhs and rhs match}}
+  %0 = tcp.matmul %arg0, %arg1 : tensor<4x8xf32>, tensor<6x16xf32> -> tensor<4x16xf32>
+  return %0 : tensor<4x16xf32>
+}
+
+// -----
+
+func.func @test_matmul_result_shape(%arg0 : tensor<4x8xf32>, %arg1 : tensor<8x16xf32>) -> tensor<4x8xf32> {
+  // expected-error@+1{{'tcp.matmul' op failed to verify that the result shape matches the operands}}
+  %0 = tcp.matmul %arg0, %arg1 : tensor<4x8xf32>, tensor<8x16xf32> -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
+
+// -----
+
+func.func @test_batch_matmul_batch_dims(%arg0 : tensor<2x4x8xf32>, %arg1 : tensor<3x8x16xf32>) -> tensor<2x4x16xf32> {
+  // expected-error@+1{{'tcp.batch_matmul' op failed to verify that the batch dims of all operands match}}
+  %0 = tcp.batch_matmul %arg0, %arg1 : tensor<2x4x8xf32>, tensor<3x8x16xf32> -> tensor<2x4x16xf32>
+  return %0 : tensor<2x4x16xf32>
+}
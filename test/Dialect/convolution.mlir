@@ -0,0 +1,69 @@
+// RUN: tcp-opt %s -split-input-file -verify-diagnostics | FileCheck %s
+
+// CHECK-LABEL: func.func @test_conv1d(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x4x16xf32>,
+// CHECK-SAME:          %[[ARG1:.*]]: tensor<8x4x3xf32>) -> tensor<?x8x8xf32>
+// CHECK:         %[[CONV:.*]] = tcp.conv1d %[[ARG0]], %[[ARG1]] {dilation = [1], groups = 1 : i64, padding = [1], stride = [2]} : tensor<?x4x16xf32>, tensor<8x4x3xf32> -> tensor<?x8x8xf32>
+// CHECK:         return %[[CONV]] : tensor<?x8x8xf32>
+func.func @test_conv1d(%arg0 : tensor<?x4x16xf32>, %arg1 : tensor<8x4x3xf32>) -> tensor<?x8x8xf32> {
+  %0 = tcp.conv1d %arg0, %arg1 {stride = [2], padding = [1], dilation = [1], groups = 1 : i64} : tensor<?x4x16xf32>, tensor<8x4x3xf32> -> tensor<?x8x8xf32>
+  return %0 : tensor<?x8x8xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_conv2d_grouped(
+// CHECK:         tcp.conv2d %{{.*}}, %{{.*}} {dilation = [2, 2], groups = 2 : i64, padding = [0, 0], stride = [1, 1]} : tensor<1x8x10x10xf32>, tensor<6x4x3x3xf32> -> tensor<1x6x6x6xf32>
+func.func @test_conv2d_grouped(%arg0 : tensor<1x8x10x10xf32>, %arg1 : tensor<6x4x3x3xf32>) -> tensor<1x6x6x6xf32> {
+  %0 = tcp.conv2d %arg0, %arg1 {stride = [1, 1], padding = [0, 0], dilation = [2, 2], groups = 2 : i64} : tensor<1x8x10x10xf32>, tensor<6x4x3x3xf32> -> tensor<1x6x6x6xf32>
+  return %0 : tensor<1x6x6x6xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_conv3d(
+// CHECK:         tcp.conv3d %{{.*}}, %{{.*}} {dilation = [1, 1, 1], groups = 1 : i64, padding = [1, 1, 1], stride = [1, 1, 1]} : tensor<2x3x?x8x8xf32>, tensor<4x3x3x3x3xf32> -> tensor<2x4x?x8x8xf32>
+func.func @test_conv3d(%arg0 : tensor<2x3x?x8x8xf32>, %arg1 : tensor<4x3x3x3x3xf32>) -> tensor<2x4x?x8x8xf32> {
+  %0 = tcp.conv3d %arg0, %arg1 {stride = [1, 1, 1], padding = [1, 1, 1], dilation = [1, 1, 1], groups = 1 : i64} : tensor<2x3x?x8x8xf32>, tensor<4x3x3x3x3xf32> -> tensor<2x4x?x8x8xf32>
+  return %0 : tensor<2x4x?x8x8xf32>
+}
+
+// -----
+
+func.func @test_conv2d_rank(%arg0 : tensor<1x4x16xf32>, %arg1 : tensor<8x4x3x3xf32>) -> tensor<1x8x14x14xf32> {
+  // expected-error@+1{{'tcp.conv2d' op failed to verify that input, weight and result are of rank 4}}
+  %0 = tcp.conv2d %arg0, %arg1 {stride = [1, 1], padding = [0, 0], dilation = [1, 1], groups = 1 : i64} : tensor<1x4x16xf32>, tensor<8x4x3x3xf32> -> tensor<1x8x14x14xf32>
+  return %0 : tensor<1x8x14x14xf32>
+}
+
+// -----
+
+func.func @test_conv2d_attrs(%arg0 : tensor<1x4x16x16xf32>, %arg1 : tensor<8x4x3x3xf32>) -> tensor<1x8x14x14xf32> {
+  // expected-error@+1{{'tcp.conv2d' op failed to verify that `stride`, `padding` and `dilation` have one entry per spatial dim}}
+  %0 = tcp.conv2d %arg0, %arg1 {stride = [1], padding = [0, 0], dilation = [1, 1], groups = 1 : i64} : tensor<1x4x16x16xf32>, tensor<8x4x3x3xf32> -> tensor<1x8x14x14xf32>
+  return %0 : tensor<1x8x14x14xf32>
+}
+
+// -----
+
+func.func @test_conv2d_groups(%arg0 : tensor<1x4x16x16xf32>, %arg1 : tensor<8x4x3x3xf32>) -> tensor<1x8x14x14xf32> {
+  // expected-error@+1{{'tcp.conv2d' op failed to verify that the input channels match the weight channels times `groups`}}
+  %0 = tcp.conv2d %arg0, %arg1 {stride = [1, 1], padding = [0, 0], dilation = [1, 1], groups = 2 : i64} : tensor<1x4x16x16xf32>, tensor<8x4x3x3xf32> -> tensor<1x8x14x14xf32>
+  return %0 : tensor<1x8x14x14xf32>
+}
+
+// -----
+
+func.func @test_conv2d_spatial_dims(%arg0 : tensor<1x4x16x16xf32>, %arg1 : tensor<8x4x3x3xf32>) -> tensor<1x8x16x16xf32> {
+  // expected-error@+1{{'tcp.conv2d' op failed to verify that the spatial dims of the result match the convolution parameters}}
+  %0 = tcp.conv2d %arg0, %arg1 {stride = [1, 1], padding = [0, 0], dilation = [1, 1], groups = 1 : i64} : tensor<1x4x16x16xf32>, tensor<8x4x3x3xf32> -> tensor<1x8x16x16xf32>
+  return %0 : tensor<1x8x16x16xf32>
+}
+
+// -----
+
+func.func @test_conv2d_kernel_too_large(%arg0 : tensor<1x4x4x4xf32>, %arg1 : tensor<8x4x3x3xf32>) -> tensor<1x8x0x0xf32> {
+  // expected-error@+1{{'tcp.conv2d' op failed to verify that the dilated kernel fits into the padded input}}
+  %0 = tcp.conv2d %arg0, %arg1 {stride = [1, 1], padding = [0, 0], dilation = [2, 2], groups = 1 : i64} : tensor<1x4x4x4xf32>, tensor<8x4x3x3xf32> -> tensor<1x8x0x0xf32>
+  return %0 : tensor<1x8x0x0xf32>
+}
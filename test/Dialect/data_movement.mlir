@@ -31,3 +31,203 @@ func.func @test_slice(%arg0: tensor<1x56x?x?xf32>) -> tensor<1x28x?x?xf32> {
   %1 = tcp.slice %arg0 starts ( %c0, %c0, %c0, %c0 ) sizes ( %c1, %c28, %dim, %dim_0 ) strides ( %c1, %c2, %c1, %c1 ) : tensor<1x56x?x?xf32> -> tensor<1x28x?x?xf32>
   return %1 : tensor<1x28x?x?xf32>
 }
+
+// -----
+
+// CHECK-LABEL: func.func @test_transpose(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x?x8xf32>) -> tensor<8x2x?xf32>
+// CHECK:         %[[T:.*]] = tcp.transpose %[[ARG0]] {permutation = [2, 0, 1]} : tensor<2x?x8xf32> -> tensor<8x2x?xf32>
+// CHECK:         return %[[T]] : tensor<8x2x?xf32>
+func.func @test_transpose(%arg0 : tensor<2x?x8xf32>) -> tensor<8x2x?xf32> {
+  %0 = tcp.transpose %arg0 {permutation = [2, 0, 1]} : tensor<2x?x8xf32> -> tensor<8x2x?xf32>
+  return %0 : tensor<8x2x?xf32>
+}
+
+// -----
+
+func.func @test_transpose_rank(%arg0 : tensor<2x4xf32>) -> tensor<4x2x1xf32> {
+  // expected-error@+1{{'tcp.transpose' op failed to verify that the input and result have the same rank}}
+  %0 = tcp.transpose %arg0 {permutation = [1, 0]} : tensor<2x4xf32> -> tensor<4x2x1xf32>
+  return %0 : tensor<4x2x1xf32>
+}
+
+// -----
+
+func.func @test_transpose_permutation(%arg0 : tensor<2x4xf32>) -> tensor<4x2xf32> {
+  // expected-error@+1{{'tcp.transpose' op failed to verify that `permutation` is a permutation of the input dims}}
+  %0 = tcp.transpose %arg0 {permutation = [1, 1]} : tensor<2x4xf32> -> tensor<4x2xf32>
+  return %0 : tensor<4x2xf32>
+}
+
+// -----
+
+func.func @test_transpose_shape(%arg0 : tensor<2x4xf32>) -> tensor<2x4xf32> {
+  // expected-error@+1{{'tcp.transpose' op failed to verify that the result shape is the permuted input shape}}
+  %0 = tcp.transpose %arg0 {permutation = [1, 0]} : tensor<2x4xf32> -> tensor<2x4xf32>
+  return %0 : tensor<2x4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_reshape(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x4xf32>, %[[ARG1:.*]]: index) -> tensor<4x?xf32>
+// CHECK:         %[[C4:.*]] = arith.constant 4 : index
+// CHECK:         %[[R:.*]] = tcp.reshape %[[ARG0]] shape(%[[C4]], %[[ARG1]]) : tensor<?x4xf32> -> tensor<4x?xf32>
+// CHECK:         return %[[R]] : tensor<4x?xf32>
+func.func @test_reshape(%arg0 : tensor<?x4xf32>, %arg1 : index) -> tensor<4x?xf32> {
+  %c4 = arith.constant 4 : index
+  %0 = tcp.reshape %arg0 shape(%c4, %arg1) : tensor<?x4xf32> -> tensor<4x?xf32>
+  return %0 : tensor<4x?xf32>
+}
+
+// -----
+
+func.func @test_reshape_shape(%arg0 : tensor<6x4xf32>) -> tensor<4x6xf32> {
+  %c4 = arith.constant 4 : index
+  // expected-error@+1{{'tcp.reshape' op failed to verify that `shape` has one size per dim of the result}}
+  %0 = tcp.reshape %arg0 shape(%c4) : tensor<6x4xf32> -> tensor<4x6xf32>
+  return %0 : tensor<4x6xf32>
+}
+
+// -----
+
+func.func @test_reshape_num_elements(%arg0 : tensor<6x4xf32>) -> tensor<4x4xf32> {
+  %c4 = arith.constant 4 : index
+  // expected-error@+1{{'tcp.reshape' op failed to verify that the input and result have the same number of elements}}
+  %0 = tcp.reshape %arg0 shape(%c4, %c4) : tensor<6x4xf32> -> tensor<4x4xf32>
+  return %0 : tensor<4x4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_expand_collapse_shape(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x16xf32>, %[[ARG1:.*]]: tensor<1x1xf32>) -> (tensor<?x64xf32>, tensor<f32>)
+// CHECK:         %[[E:.*]] = tcp.expand_shape %[[ARG0]] {reassociation = {{\[\[}}0, 1], [2]]} : tensor<?x16xf32> -> tensor<?x4x16xf32>
+// CHECK:         %[[C:.*]] = tcp.collapse_shape %[[E]] {reassociation = {{\[\[}}0], [1, 2]]} : tensor<?x4x16xf32> -> tensor<?x64xf32>
+// CHECK:         %[[S:.*]] = tcp.collapse_shape %[[ARG1]] {reassociation = []} : tensor<1x1xf32> -> tensor<f32>
+// CHECK:         return %[[C]], %[[S]] : tensor<?x64xf32>, tensor<f32>
+func.func @test_expand_collapse_shape(%arg0 : tensor<?x16xf32>, %arg1 : tensor<1x1xf32>) -> (tensor<?x64xf32>, tensor<f32>) {
+  %0 = tcp.expand_shape %arg0 {reassociation = [[0, 1], [2]]} : tensor<?x16xf32> -> tensor<?x4x16xf32>
+  %1 = tcp.collapse_shape %0 {reassociation = [[0], [1, 2]]} : tensor<?x4x16xf32> -> tensor<?x64xf32>
+  %2 = tcp.collapse_shape %arg1 {reassociation = []} : tensor<1x1xf32> -> tensor<f32>
+  return %1, %2 : tensor<?x64xf32>, tensor<f32>
+}
+
+// -----
+
+func.func @test_expand_shape_groups(%arg0 : tensor<4x16xf32>) -> tensor<4x4x4xf32> {
+  // expected-error@+1{{'tcp.expand_shape' op failed to verify that the groups of `reassociation` are contiguous and cover all dims of the expanded tensor}}
+  %0 = tcp.expand_shape %arg0 {reassociation = [[0], [2, 1]]} : tensor<4x16xf32> -> tensor<4x4x4xf32>
+  return %0 : tensor<4x4x4xf32>
+}
+
+// -----
+
+func.func @test_expand_shape_dynamic_dims(%arg0 : tensor<?xf32>) -> tensor<?x?xf32> {
+  // expected-error@+1{{'tcp.expand_shape' op failed to verify that each group of `reassociation` has at most one dynamic dim}}
+  %0 = tcp.expand_shape %arg0 {reassociation = [[0, 1]]} : tensor<?xf32> -> tensor<?x?xf32>
+  return %0 : tensor<?x?xf32>
+}
+
+// -----
+
+func.func @test_collapse_shape_sizes(%arg0 : tensor<4x4x4xf32>) -> tensor<4x8xf32> {
+  // expected-error@+1{{'tcp.collapse_shape' op failed to verify that each collapsed dim is the product of its group of dims}}
+  %0 = tcp.collapse_shape %arg0 {reassociation = [[0], [1, 2]]} : tensor<4x4x4xf32> -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_scatter(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<25x4xf32>, %[[ARG1:.*]]: tensor<10x1xi64>, %[[ARG2:.*]]: tensor<10x4xf32>, %[[ARG3:.*]]: tensor<?x2xi64>, %[[ARG4:.*]]: tensor<?xf32>)
+// CHECK:         %[[S0:.*]] = tcp.scatter %[[ARG0]], %[[ARG1]], %[[ARG2]] {unique_indices} : tensor<25x4xf32>, tensor<10x1xi64>, tensor<10x4xf32> -> tensor<25x4xf32>
+// CHECK:         %[[S1:.*]] = tcp.scatter %[[ARG0]], %[[ARG3]], %[[ARG4]] {accumulate = true} : tensor<25x4xf32>, tensor<?x2xi64>, tensor<?xf32> -> tensor<25x4xf32>
+// CHECK:         return %[[S0]], %[[S1]] : tensor<25x4xf32>, tensor<25x4xf32>
+func.func @test_scatter(%arg0 : tensor<25x4xf32>, %arg1 : tensor<10x1xi64>, %arg2 : tensor<10x4xf32>, %arg3 : tensor<?x2xi64>, %arg4 : tensor<?xf32>) -> (tensor<25x4xf32>, tensor<25x4xf32>) {
+  %0 = tcp.scatter %arg0, %arg1, %arg2 {unique_indices} : tensor<25x4xf32>, tensor<10x1xi64>, tensor<10x4xf32> -> tensor<25x4xf32>
+  %1 = tcp.scatter %arg0, %arg3, %arg4 {accumulate = true} : tensor<25x4xf32>, tensor<?x2xi64>, tensor<?xf32> -> tensor<25x4xf32>
+  return %0, %1 : tensor<25x4xf32>, tensor<25x4xf32>
+}
+
+// -----
+
+func.func @test_scatter_indices(%arg0 : tensor<25x4xf32>, %arg1 : tensor<10x3xi64>, %arg2 : tensor<10xf32>) -> tensor<25x4xf32> {
+  // expected-error@+1{{'tcp.scatter' op failed to verify that the last dim of `indices` is static and at most the rank of `dest`}}
+  %0 = tcp.scatter %arg0, %arg1, %arg2 : tensor<25x4xf32>, tensor<10x3xi64>, tensor<10xf32> -> tensor<25x4xf32>
+  return %0 : tensor<25x4xf32>
+}
+
+// -----
+
+func.func @test_scatter_updates(%arg0 : tensor<25x4xf32>, %arg1 : tensor<10x1xi64>, %arg2 : tensor<10x8xf32>) -> tensor<25x4xf32> {
+  // expected-error@+1{{'tcp.scatter' op failed to verify that `updates` has the shape of the indexed slices}}
+  %0 = tcp.scatter %arg0, %arg1, %arg2 : tensor<25x4xf32>, tensor<10x1xi64>, tensor<10x8xf32> -> tensor<25x4xf32>
+  return %0 : tensor<25x4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_slice_scatter(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<4x9xf32>, %[[ARG1:.*]]: tensor<4x?xf32>, %[[ARG2:.*]]: index)
+// CHECK:         %[[C0:.*]] = arith.constant 0 : index
+// CHECK:         %[[C1:.*]] = arith.constant 1 : index
+// CHECK:         %[[S:.*]] = tcp.slice_scatter %[[ARG0]], %[[ARG1]] starts(%[[C0]], %[[ARG2]]) strides(%[[C1]], %[[C1]]) : tensor<4x9xf32>, tensor<4x?xf32> -> tensor<4x9xf32>
+// CHECK:         return %[[S]] : tensor<4x9xf32>
+func.func @test_slice_scatter(%arg0 : tensor<4x9xf32>, %arg1 : tensor<4x?xf32>, %arg2 : index) -> tensor<4x9xf32> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %0 = tcp.slice_scatter %arg0, %arg1 starts(%c0, %arg2) strides(%c1, %c1) : tensor<4x9xf32>, tensor<4x?xf32> -> tensor<4x9xf32>
+  return %0 : tensor<4x9xf32>
+}
+
+// -----
+
+func.func @test_slice_scatter_rank(%arg0 : tensor<4x9xf32>, %arg1 : tensor<9xf32>, %arg2 : index) -> tensor<4x9xf32> {
+  // expected-error@+1{{'tcp.slice_scatter' op failed to verify that `dest` and `src` have the same rank}}
+  %0 = tcp.slice_scatter %arg0, %arg1 starts(%arg2, %arg2) strides(%arg2, %arg2) : tensor<4x9xf32>, tensor<9xf32> -> tensor<4x9xf32>
+  return %0 : tensor<4x9xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_pad(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<4x?xf32>, %[[ARG1:.*]]: tensor<f32>)
+// CHECK:         %[[P:.*]] = tcp.pad %[[ARG0]], %[[ARG1]] {high = [0, 2], low = [1, 1]} : tensor<4x?xf32>, tensor<f32> -> tensor<5x?xf32>
+// CHECK:         return %[[P]] : tensor<5x?xf32>
+func.func @test_pad(%arg0 : tensor<4x?xf32>, %arg1 : tensor<f32>) -> tensor<5x?xf32> {
+  %0 = tcp.pad %arg0, %arg1 {low = [1, 1], high = [0, 2]} : tensor<4x?xf32>, tensor<f32> -> tensor<5x?xf32>
+  return %0 : tensor<5x?xf32>
+}
+
+// -----
+
+func.func @test_pad_value_rank(%arg0 : tensor<4x8xf32>, %arg1 : tensor<1xf32>) -> tensor<4x11xf32> {
+  // expected-error@+1{{'tcp.pad' op failed to verify that `padding_value` is a 0-d tensor}}
+  %0 = tcp.pad %arg0, %arg1 {low = [0, 1], high = [0, 2]} : tensor<4x8xf32>, tensor<1xf32> -> tensor<4x11xf32>
+  return %0 : tensor<4x11xf32>
+}
+
+// -----
+
+func.func @test_pad_num_pads(%arg0 : tensor<4x8xf32>, %arg1 : tensor<f32>) -> tensor<4x11xf32> {
+  // expected-error@+1{{'tcp.pad' op failed to verify that `low` and `high` have one entry per dim}}
+  %0 = tcp.pad %arg0, %arg1 {low = [1], high = [2]} : tensor<4x8xf32>, tensor<f32> -> tensor<4x11xf32>
+  return %0 : tensor<4x11xf32>
+}
+
+// -----
+
+func.func @test_pad_negative(%arg0 : tensor<4x8xf32>, %arg1 : tensor<f32>) -> tensor<4x7xf32> {
+  // expected-error@+1{{'tcp.pad' op failed to verify that `low` and `high` are non-negative}}
+  %0 = tcp.pad %arg0, %arg1 {low = [0, -1], high = [0, 0]} : tensor<4x8xf32>, tensor<f32> -> tensor<4x7xf32>
+  return %0 : tensor<4x7xf32>
+}
+
+// -----
+
+func.func @test_pad_result_shape(%arg0 : tensor<4x8xf32>, %arg1 : tensor<f32>) -> tensor<4x10xf32> {
+  // expected-error@+1{{'tcp.pad' op failed to verify that the result dims are the padded input dims}}
+  %0 = tcp.pad %arg0, %arg1 {low = [0, 1], high = [0, 2]} : tensor<4x8xf32>, tensor<f32> -> tensor<4x10xf32>
+  return %0 : tensor<4x10xf32>
+}
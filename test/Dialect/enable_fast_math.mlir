@@ -0,0 +1,12 @@
+// RUN: tcp-opt %s -tcp-enable-fast-math | FileCheck %s
+
+// CHECK-LABEL: func.func @fast_math(
+// CHECK:         arith.addf {{.*}} fastmath<fast> : f32
+// CHECK:         math.tanh {{.*}} fastmath<fast> : f32
+// CHECK:         arith.addi {{.*}} : i32
+func.func @fast_math(%arg0: f32, %arg1: f32, %arg2: i32) -> (f32, i32) {
+  %0 = arith.addf %arg0, %arg1 : f32
+  %1 = math.tanh %0 : f32
+  %2 = arith.addi %arg2, %arg2 : i32
+  return %1, %2 : f32, i32
+}
@@ -0,0 +1,87 @@
+// RUN: tcp-opt %s -convert-tcp-to-linalg -convert-tcp-to-tensor -tcp-fuse-linalg-elementwise-ops -split-input-file | FileCheck %s
+
+// CHECK-LABEL: func.func @fuse_add_mul(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<?x?xf32>, %[[ARG1:.*]]: tensor<?x?xf32>, %[[ARG2:.*]]: tensor<?x?xf32>)
+// CHECK:         %[[GENERIC:.*]] = linalg.generic
+// CHECK-SAME:        ins(%[[ARG0]], %[[ARG1]], %[[ARG2]] : tensor<?x?xf32>, tensor<?x?xf32>, tensor<?x?xf32>)
+// CHECK:           arith.addf
+// CHECK:           arith.mulf
+// CHECK:         } -> tensor<?x?xf32>
+// CHECK-NOT:     linalg.generic
+// CHECK:         return %[[GENERIC]]
+func.func @fuse_add_mul(%arg0: tensor<?x?xf32>, %arg1: tensor<?x?xf32>, %arg2: tensor<?x?xf32>) -> tensor<?x?xf32> {
+  %0 = tcp.add %arg0, %arg1 : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  %1 = tcp.mul %0, %arg2 : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  return %1 : tensor<?x?xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @fuse_broadcast_chain(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<?x?xf32>, %[[ARG1:.*]]: tensor<1x?xf32>)
+// CHECK:         %[[GENERIC:.*]] = linalg.generic
+// CHECK-SAME:        ins(%[[ARG0]], %[[ARG1]] : tensor<?x?xf32>, tensor<1x?xf32>)
+// CHECK:           arith.subf
+// CHECK:           math.sqrt
+// CHECK:           arith.divf
+// CHECK:         } -> tensor<?x?xf32>
+// CHECK-NOT:     linalg.generic
+// CHECK:         return %[[GENERIC]]
+func.func @fuse_broadcast_chain(%arg0: tensor<?x?xf32>, %arg1: tensor<1x?xf32>) -> tensor<?x?xf32> {
+  %c0 = arith.constant 0 : index
+  %dim = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+  %0 = tcp.broadcast %arg1, %dim {axes = [0]} : tensor<1x?xf32>, index -> tensor<?x?xf32>
+  %1 = tcp.sub %arg0, %0 : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  %2 = tcp.sqrt %0 : tensor<?x?xf32> -> tensor<?x?xf32>
+  %3 = tcp.divf %1, %2 : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  return %3 : tensor<?x?xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @keep_shared_producer(
+// CHECK:         %[[SHARED:.*]] = linalg.generic
+// CHECK:           arith.addf
+// CHECK:         linalg.generic
+// CHECK-SAME:        ins(%[[SHARED]], %[[SHARED]] : tensor<?xf32>, tensor<?xf32>)
+// CHECK:           arith.mulf
+func.func @keep_shared_producer(%arg0: tensor<?xf32>, %arg1: tensor<?xf32>) -> tensor<?xf32> {
+  %0 = tcp.add %arg0, %arg1 : tensor<?xf32>, tensor<?xf32> -> tensor<?xf32>
+  %1 = tcp.mul %0, %0 : tensor<?xf32>, tensor<?xf32> -> tensor<?xf32>
+  return %1 : tensor<?xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @fuse_across_collapse_shape(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<4x8xf32>, %[[ARG1:.*]]: tensor<32xf32>)
+// CHECK:         tensor.expand_shape %[[ARG1]] {{\[\[}}0, 1]] output_shape [4, 8] : tensor<32xf32> into tensor<4x8xf32>
+// CHECK:         %[[GENERIC:.*]] = linalg.generic
+// CHECK:           math.tanh
+// CHECK:           arith.addf
+// CHECK:         } -> tensor<4x8xf32>
+// CHECK-NOT:     linalg.generic
+// CHECK:         %[[COLLAPSED:.*]] = tensor.collapse_shape %[[GENERIC]] {{\[\[}}0, 1]] : tensor<4x8xf32> into tensor<32xf32>
+// CHECK:         return %[[COLLAPSED]]
+func.func @fuse_across_collapse_shape(%arg0: tensor<4x8xf32>, %arg1: tensor<32xf32>) -> tensor<32xf32> {
+  %0 = tcp.tanh %arg0 : tensor<4x8xf32> -> tensor<4x8xf32>
+  %1 = tcp.collapse_shape %0 {reassociation = [[0, 1]]} : tensor<4x8xf32> -> tensor<32xf32>
+  %2 = tcp.add %1, %arg1 : tensor<32xf32>, tensor<32xf32> -> tensor<32xf32>
+  return %2 : tensor<32xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @fuse_compare_select(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<?x?xf32>, %[[ARG1:.*]]: tensor<?x?xf32>, %[[ARG2:.*]]: tensor<?x?xf32>)
+// CHECK:         %[[GENERIC:.*]] = linalg.generic
+// CHECK:           %[[CMP:.*]] = arith.cmpf ogt
+// CHECK:           arith.select %[[CMP]]
+// CHECK:         } -> tensor<?x?xf32>
+// CHECK-NOT:     linalg.generic
+// CHECK:         return %[[GENERIC]]
+func.func @fuse_compare_select(%arg0: tensor<?x?xf32>, %arg1: tensor<?x?xf32>, %arg2: tensor<?x?xf32>) -> tensor<?x?xf32> {
+  %0 = tcp.compare %arg0, %arg1 {predicate = #tcp<comparePredicate GT>} : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xi1>
+  %1 = tcp.select %0, %arg0, %arg2 : tensor<?x?xi1>, tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  return %1 : tensor<?x?xf32>
+}
@@ -0,0 +1,136 @@
+// RUN: tcp-opt %s -tcp-lower-conv-ops -split-input-file | FileCheck %s
+// RUN: tcp-opt %s -tcp-lower-conv-ops="strategy=direct" -split-input-file | FileCheck %s --check-prefix=CHECK-DIRECT
+// RUN: tcp-opt %s -tcp-lower-conv-ops="num-threads=4" -split-input-file | FileCheck %s --check-prefix=CHECK-MT
+
+// Convolutions with a deep reduction become an im2col buffer and a GEMM.
+
+// CHECK-LABEL: func.func @conv_im2col(
+// CHECK-NOT:     linalg.conv_2d_nchw_fchw
+// CHECK:         %[[COL:.*]] = linalg.generic {{.*}} outs(%{{.*}} : tensor<1x144x64xf32>)
+// CHECK:         %[[GEMM:.*]] = linalg.generic {{.*}} ins(%{{.*}}, %[[COL]] : tensor<8x144xf32>, tensor<1x144x64xf32>) outs(%{{.*}} : tensor<1x8x64xf32>)
+// CHECK:           arith.mulf
+// CHECK:           arith.addf
+// CHECK:         tensor.expand_shape %[[GEMM]] {{.*}} : tensor<1x8x64xf32> into tensor<1x8x8x8xf32>
+
+// CHECK-DIRECT-LABEL: func.func @conv_im2col(
+// CHECK-DIRECT-NOT:     tensor<1x144x64xf32>
+// CHECK-DIRECT:         linalg.transpose
+// CHECK-DIRECT:         scf.for
+// CHECK-DIRECT-NOT:     linalg.conv_2d_nhwc_hwcf
+// CHECK-DIRECT:           vector.outerproduct
+func.func @conv_im2col(%arg0: tensor<1x16x10x10xf32>, %arg1: tensor<8x16x3x3xf32>, %arg2: tensor<1x8x8x8xf32>) -> tensor<1x8x8x8xf32> {
+  %0 = linalg.conv_2d_nchw_fchw {dilations = dense<1> : vector<2xi64>, strides = dense<1> : vector<2xi64>} ins(%arg0, %arg1 : tensor<1x16x10x10xf32>, tensor<8x16x3x3xf32>) outs(%arg2 : tensor<1x8x8x8xf32>) -> tensor<1x8x8x8xf32>
+  return %0 : tensor<1x8x8x8xf32>
+}
+
+// -----
+
+// Convolutions with few input channels are computed directly in NHWC, one
+// output row and filter tap at a time.
+
+// CHECK-LABEL: func.func @conv_direct(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<1x3x18x18xf32>, %[[ARG1:.*]]: tensor<8x3x3x3xf32>, %[[ARG2:.*]]: tensor<1x8x16x16xf32>)
+// CHECK:         linalg.transpose ins(%[[ARG0]] : tensor<1x3x18x18xf32>) outs(%{{.*}} : tensor<1x18x18x3xf32>) permutation = [0, 2, 3, 1]
+// CHECK:         linalg.transpose ins(%[[ARG1]] : tensor<8x3x3x3xf32>) outs(%{{.*}} : tensor<3x3x3x8xf32>) permutation = [2, 3, 1, 0]
+// CHECK:         linalg.transpose ins(%[[ARG2]] : tensor<1x8x16x16xf32>) outs(%{{.*}} : tensor<1x16x16x8xf32>) permutation = [0, 2, 3, 1]
+// CHECK:         scf.for
+// CHECK-NOT:     linalg.conv
+// CHECK:           vector.outerproduct
+// CHECK:         linalg.transpose ins(%{{.*}} : tensor<1x16x16x8xf32>) outs(%{{.*}} : tensor<1x8x16x16xf32>) permutation = [0, 3, 1, 2]
+
+// CHECK-MT-LABEL: func.func @conv_direct(
+// CHECK-MT:         scf.forall
+// CHECK-MT:           scf.for
+// CHECK-MT:             vector.outerproduct
+func.func @conv_direct(%arg0: tensor<1x3x18x18xf32>, %arg1: tensor<8x3x3x3xf32>, %arg2: tensor<1x8x16x16xf32>) -> tensor<1x8x16x16xf32> {
+  %0 = linalg.conv_2d_nchw_fchw {dilations = dense<1> : vector<2xi64>, strides = dense<1> : vector<2xi64>} ins(%arg0, %arg1 : tensor<1x3x18x18xf32>, tensor<8x3x3x3xf32>) outs(%arg2 : tensor<1x8x16x16xf32>) -> tensor<1x8x16x16xf32>
+  return %0 : tensor<1x8x16x16xf32>
+}
+
+// -----
+
+// Depthwise convolutions are always computed directly. The fill of the
+// result is recreated in NHWC instead of being transposed.
+
+// CHECK-LABEL: func.func @conv_depthwise(
+// CHECK-NOT:     linalg.fill {{.*}} -> tensor<1x16x6x6xf32>
+// CHECK:         linalg.transpose {{.*}} permutation = [0, 2, 3, 1]
+// CHECK:         linalg.transpose {{.*}} permutation = [1, 2, 0]
+// CHECK:         linalg.fill {{.*}} -> tensor<1x6x6x16xf32>
+// CHECK:         scf.for
+// CHECK-NOT:     linalg.depthwise_conv
+// CHECK:           vector.fma
+// CHECK:         linalg.transpose {{.*}} permutation = [0, 3, 1, 2]
+func.func @conv_depthwise(%arg0: tensor<1x16x8x8xf32>, %arg1: tensor<16x3x3xf32>) -> tensor<1x16x6x6xf32> {
+  %cst = arith.constant 0.000000e+00 : f32
+  %0 = tensor.empty() : tensor<1x16x6x6xf32>
+  %1 = linalg.fill ins(%cst : f32) outs(%0 : tensor<1x16x6x6xf32>) -> tensor<1x16x6x6xf32>
+  %2 = linalg.depthwise_conv_2d_nchw_chw {dilations = dense<1> : vector<2xi64>, strides = dense<1> : vector<2xi64>} ins(%arg0, %arg1 : tensor<1x16x8x8xf32>, tensor<16x3x3xf32>) outs(%1 : tensor<1x16x6x6xf32>) -> tensor<1x16x6x6xf32>
+  return %2 : tensor<1x16x6x6xf32>
+}
+
+// -----
+
+// The tiles of depthwise convolutions cover a divisor of the output width
+// and of the channels.
+
+// CHECK-LABEL: func.func @conv_depthwise_tile_sizes(
+// CHECK:         scf.for
+// CHECK:           vector.fma {{.*}} : vector<1x6x8xf32>
+func.func @conv_depthwise_tile_sizes(%arg0: tensor<1x24x8x14xf32>, %arg1: tensor<24x3x3xf32>, %arg2: tensor<1x24x6x12xf32>) -> tensor<1x24x6x12xf32> {
+  %0 = linalg.depthwise_conv_2d_nchw_chw {dilations = dense<1> : vector<2xi64>, strides = dense<1> : vector<2xi64>} ins(%arg0, %arg1 : tensor<1x24x8x14xf32>, tensor<24x3x3xf32>) outs(%arg2 : tensor<1x24x6x12xf32>) -> tensor<1x24x6x12xf32>
+  return %0 : tensor<1x24x6x12xf32>
+}
+
+// -----
+
+// Dynamically shaped convolutions are left as is.
+
+// CHECK-LABEL: func.func @conv_dynamic(
+// CHECK:         linalg.conv_2d_nchw_fchw
+// CHECK-NOT:     vector.outerproduct
+func.func @conv_dynamic(%arg0: tensor<?x16x10x10xf32>, %arg1: tensor<8x16x3x3xf32>, %arg2: tensor<?x8x8x8xf32>) -> tensor<?x8x8x8xf32> {
+  %0 = linalg.conv_2d_nchw_fchw {dilations = dense<1> : vector<2xi64>, strides = dense<1> : vector<2xi64>} ins(%arg0, %arg1 : tensor<?x16x10x10xf32>, tensor<8x16x3x3xf32>) outs(%arg2 : tensor<?x8x8x8xf32>) -> tensor<?x8x8x8xf32>
+  return %0 : tensor<?x8x8x8xf32>
+}
+
+// -----
+
+// Poolings are computed in NHWC with the vectorized 1-D kernels. The padding
+// is applied per tile instead of materializing the padded NHWC input.
+
+// CHECK-LABEL: func.func @max_pool_padded(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<1x16x8x8xf32>)
+// CHECK:         linalg.transpose ins(%[[ARG0]] : tensor<1x16x8x8xf32>) outs(%{{.*}} : tensor<1x8x8x16xf32>) permutation = [0, 2, 3, 1]
+// CHECK-NOT:     tensor<1x10x10x16xf32>
+// CHECK:         scf.for
+// CHECK-NOT:     linalg.pooling
+// CHECK:           arith.maximumf {{.*}} : vector<
+// CHECK:         linalg.transpose {{.*}} permutation = [0, 3, 1, 2]
+func.func @max_pool_padded(%arg0: tensor<1x16x8x8xf32>) -> tensor<1x16x4x4xf32> {
+  %cst = arith.constant 0xFF800000 : f32
+  %padded = tensor.pad %arg0 low[0, 0, 1, 1] high[0, 0, 1, 1] {
+  ^bb0(%i: index, %j: index, %k: index, %l: index):
+    tensor.yield %cst : f32
+  } : tensor<1x16x8x8xf32> to tensor<1x16x10x10xf32>
+  %window = tensor.empty() : tensor<3x3xf32>
+  %0 = tensor.empty() : tensor<1x16x4x4xf32>
+  %1 = linalg.fill ins(%cst : f32) outs(%0 : tensor<1x16x4x4xf32>) -> tensor<1x16x4x4xf32>
+  %2 = linalg.pooling_nchw_max {dilations = dense<1> : vector<2xi64>, strides = dense<2> : vector<2xi64>} ins(%padded, %window : tensor<1x16x10x10xf32>, tensor<3x3xf32>) outs(%1 : tensor<1x16x4x4xf32>) -> tensor<1x16x4x4xf32>
+  return %2 : tensor<1x16x4x4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @sum_pool(
+// CHECK:         scf.for
+// CHECK-NOT:     linalg.pooling
+// CHECK:           arith.addf {{.*}} : vector<
+func.func @sum_pool(%arg0: tensor<1x16x8x8xf32>) -> tensor<1x16x4x4xf32> {
+  %cst = arith.constant 0.000000e+00 : f32
+  %window = tensor.empty() : tensor<2x2xf32>
+  %0 = tensor.empty() : tensor<1x16x4x4xf32>
+  %1 = linalg.fill ins(%cst : f32) outs(%0 : tensor<1x16x4x4xf32>) -> tensor<1x16x4x4xf32>
+  %2 = linalg.pooling_nchw_sum {dilations = dense<1> : vector<2xi64>, strides = dense<2> : vector<2xi64>} ins(%arg0, %window : tensor<1x16x8x8xf32>, tensor<2x2xf32>) outs(%1 : tensor<1x16x4x4xf32>) -> tensor<1x16x4x4xf32>
+  return %2 : tensor<1x16x4x4xf32>
+}
@@ -0,0 +1,52 @@
+// RUN: tcp-opt %s -convert-tcp-to-linalg -tcp-lower-group-ops -split-input-file | FileCheck %s
+// RUN: tcp-opt %s -convert-tcp-to-linalg -tcp-lower-group-ops="tile-sizes=4,8" -split-input-file | FileCheck %s --check-prefix=CHECK-TILED
+
+// CHECK-LABEL: func.func @lower_isolated_group(
+// CHECK-SAME:      %[[ARG0:.*]]: tensor<?x?xf32>, %[[ARG1:.*]]: tensor<?x?xf32>)
+// CHECK-NOT:     tcp.isolated_group
+// CHECK:         %[[EMPTY:.*]] = tensor.empty
+// CHECK:         %[[LOOP:.*]] = scf.for %{{.*}} iter_args(%[[ITER:.*]] = %[[EMPTY]]) -> (tensor<?x?xf32>) {
+// CHECK:           %[[ADD:.*]] = linalg.generic {{.*}} -> tensor<1x?xf32>
+// CHECK:             arith.addf
+// CHECK:           %[[TANH:.*]] = linalg.generic {{.*}} ins(%[[ADD]] : tensor<1x?xf32>) {{.*}} -> tensor<1x?xf32>
+// CHECK:             math.tanh
+// CHECK:           %[[INSERT:.*]] = tensor.insert_slice %[[TANH]] into %[[ITER]]
+// CHECK:           scf.yield %[[INSERT]]
+// CHECK:         return %[[LOOP]]
+
+// CHECK-TILED-LABEL: func.func @lower_isolated_group(
+// CHECK-TILED:         scf.for
+// CHECK-TILED:           scf.for
+// CHECK-TILED:             linalg.generic {{.*}} -> tensor<?x?xf32>
+// CHECK-TILED:               arith.addf
+// CHECK-TILED:             linalg.generic {{.*}} -> tensor<?x?xf32>
+// CHECK-TILED:               math.tanh
+func.func @lower_isolated_group(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x?xf32>) -> tensor<?x?xf32> {
+  %0 = tcp.isolated_group %arg0, %arg1 {
+    ^bb0(%arg2 : tensor<?x?xf32>, %arg3 : tensor<?x?xf32>) :
+      %1 = tcp.add %arg2, %arg3 : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+      %2 = tcp.tanh %1 : tensor<?x?xf32> -> tensor<?x?xf32>
+      tcp.yield %2 : tensor<?x?xf32>
+  } : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  return %0 : tensor<?x?xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @lower_group(
+// CHECK-NOT:     tcp.group
+// CHECK:         scf.for
+// CHECK:           linalg.generic
+// CHECK:             arith.subf
+// CHECK:           linalg.generic
+// CHECK:             arith.mulf
+// CHECK:         return
+func.func @lower_group(%arg0 : tensor<8x16xf32>, %arg1 : tensor<8x16xf32>) -> tensor<8x16xf32> {
+  %0 = "tcp.group" () ({
+    ^bb0() :
+      %1 = tcp.sub %arg0, %arg1 : tensor<8x16xf32>, tensor<8x16xf32> -> tensor<8x16xf32>
+      %2 = tcp.mul %1, %1 : tensor<8x16xf32>, tensor<8x16xf32> -> tensor<8x16xf32>
+      tcp.yield %2 : tensor<8x16xf32>
+  }) : () -> tensor<8x16xf32>
+  return %0 : tensor<8x16xf32>
+}
@@ -0,0 +1,71 @@
+// RUN: tcp-opt %s -tcp-lower-transpose-ops -split-input-file | FileCheck %s
+// RUN: tcp-opt %s -tcp-lower-transpose-ops="num-threads=4" -split-input-file | FileCheck %s --check-prefix=CHECK-MT
+
+// The transpose is split into 64x64 blocks and those into 4x4 tiles, which
+// are transposed in registers.
+
+// CHECK-LABEL: func.func @transpose_2d(
+// CHECK-NOT:     linalg.transpose
+// CHECK:         scf.for
+// CHECK:           scf.for
+// CHECK:             scf.for
+// CHECK:               %[[READ:.*]] = vector.transfer_read {{.*}}, vector<4x4xf32>
+// CHECK:               %[[FLAT:.*]] = vector.shape_cast %[[READ]] : vector<4x4xf32> to vector<16xf32>
+// CHECK:               %[[SHUFFLE:.*]] = vector.shuffle %[[FLAT]], %[[FLAT]] [0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15] : vector<16xf32>, vector<16xf32>
+// CHECK:               %[[TILE:.*]] = vector.shape_cast %[[SHUFFLE]] : vector<16xf32> to vector<4x4xf32>
+// CHECK:               vector.transfer_write %[[TILE]], {{.*}} : vector<4x4xf32>, tensor<
+// CHECK-NOT:     linalg.transpose
+// CHECK:         return
+
+// CHECK-MT-LABEL: func.func @transpose_2d(
+// CHECK-MT:         scf.forall
+// CHECK-MT:           scf.for
+// CHECK-MT:             scf.for
+// CHECK-MT:               vector.shuffle
+// CHECK-MT:         return
+func.func @transpose_2d(%arg0: tensor<64x128xf32>) -> tensor<128x64xf32> {
+  %0 = tensor.empty() : tensor<128x64xf32>
+  %1 = linalg.transpose ins(%arg0 : tensor<64x128xf32>) outs(%0 : tensor<128x64xf32>) permutation = [1, 0]
+  return %1 : tensor<128x64xf32>
+}
+
+// -----
+
+// The other dims are tiled by 1.
+
+// CHECK-LABEL: func.func @transpose_batched(
+// CHECK-NOT:     linalg.transpose
+// CHECK:         scf.for
+// CHECK:           vector.transfer_read {{.*}}, vector<4x4xf32>
+// CHECK:           vector.shuffle
+// CHECK:           vector.transfer_write {{.*}} : vector<4x4xf32>, tensor<
+func.func @transpose_batched(%arg0: tensor<2x8x16xf32>) -> tensor<2x16x8xf32> {
+  %0 = tensor.empty() : tensor<2x16x8xf32>
+  %1 = linalg.transpose ins(%arg0 : tensor<2x8x16xf32>) outs(%0 : tensor<2x16x8xf32>) permutation = [0, 2, 1]
+  return %1 : tensor<2x16x8xf32>
+}
+
+// -----
+
+// Transposes that keep the innermost dim in place copy contiguous rows and
+// are left as is, as are transposes that do not divide into vector tiles.
+
+// CHECK-LABEL: func.func @transpose_rows(
+// CHECK:         linalg.transpose
+// CHECK-NOT:     vector.shuffle
+func.func @transpose_rows(%arg0: tensor<8x4x16xf32>) -> tensor<4x8x16xf32> {
+  %0 = tensor.empty() : tensor<4x8x16xf32>
+  %1 = linalg.transpose ins(%arg0 : tensor<8x4x16xf32>) outs(%0 : tensor<4x8x16xf32>) permutation = [1, 0, 2]
+  return %1 : tensor<4x8x16xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @transpose_unaligned(
+// CHECK:         linalg.transpose
+// CHECK-NOT:     vector.shuffle
+func.func @transpose_unaligned(%arg0: tensor<6x10xf32>) -> tensor<10x6xf32> {
+  %0 = tensor.empty() : tensor<10x6xf32>
+  %1 = linalg.transpose ins(%arg0 : tensor<6x10xf32>) outs(%0 : tensor<10x6xf32>) permutation = [1, 0]
+  return %1 : tensor<10x6xf32>
+}
@@ -0,0 +1,82 @@
+// RUN: tcp-opt %s -split-input-file -verify-diagnostics | FileCheck %s
+
+// CHECK-LABEL: func.func @test_softmax(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x8xf32>) -> tensor<?x8xf32>
+// CHECK:         %[[SOFTMAX:.*]] = tcp.softmax %[[ARG0]] {axis = 1 : i64} : tensor<?x8xf32> -> tensor<?x8xf32>
+// CHECK:         return %[[SOFTMAX]] : tensor<?x8xf32>
+func.func @test_softmax(%arg0 : tensor<?x8xf32>) -> tensor<?x8xf32> {
+  %0 = tcp.softmax %arg0 {axis = 1 : i64} : tensor<?x8xf32> -> tensor<?x8xf32>
+  return %0 : tensor<?x8xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_log_softmax(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x4x8xf16>) -> tensor<2x4x8xf16>
+// CHECK:         %[[LOG_SOFTMAX:.*]] = tcp.log_softmax %[[ARG0]] {axis = 0 : i64} : tensor<2x4x8xf16> -> tensor<2x4x8xf16>
+// CHECK:         return %[[LOG_SOFTMAX]] : tensor<2x4x8xf16>
+func.func @test_log_softmax(%arg0 : tensor<2x4x8xf16>) -> tensor<2x4x8xf16> {
+  %0 = tcp.log_softmax %arg0 {axis = 0 : i64} : tensor<2x4x8xf16> -> tensor<2x4x8xf16>
+  return %0 : tensor<2x4x8xf16>
+}
+
+// -----
+
+func.func @test_softmax_axis_out_of_range(%arg0 : tensor<4x8xf32>) -> tensor<4x8xf32> {
+  // expected-error@+1{{'tcp.softmax' op failed to verify that `axis` is in the range of the input rank}}
+  %0 = tcp.softmax %arg0 {axis = 2 : i64} : tensor<4x8xf32> -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
+
+// -----
+
+func.func @test_log_softmax_int(%arg0 : tensor<4x8xi32>) -> tensor<4x8xi32> {
+  // expected-error@+1{{'tcp.log_softmax' op operand #0 must be ranked tensor of floating-point values}}
+  %0 = tcp.log_softmax %arg0 {axis = 1 : i64} : tensor<4x8xi32> -> tensor<4x8xi32>
+  return %0 : tensor<4x8xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_layer_norm(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x4x8xf32>, %[[ARG1:.*]]: tensor<4x8xf32>, %[[ARG2:.*]]: tensor<4x8xf32>) -> tensor<?x4x8xf32>
+// CHECK:         %[[NORM:.*]] = tcp.layer_norm %[[ARG0]] weight(%[[ARG1]] : tensor<4x8xf32>) bias(%[[ARG2]] : tensor<4x8xf32>) {axis = 1 : i64, epsilon = 1.000000e-05 : f64} : tensor<?x4x8xf32> -> tensor<?x4x8xf32>
+// CHECK:         return %[[NORM]] : tensor<?x4x8xf32>
+func.func @test_layer_norm(%arg0 : tensor<?x4x8xf32>, %arg1 : tensor<4x8xf32>, %arg2 : tensor<4x8xf32>) -> tensor<?x4x8xf32> {
+  %0 = tcp.layer_norm %arg0 weight(%arg1 : tensor<4x8xf32>) bias(%arg2 : tensor<4x8xf32>) {axis = 1 : i64, epsilon = 1.000000e-05 : f64} : tensor<?x4x8xf32> -> tensor<?x4x8xf32>
+  return %0 : tensor<?x4x8xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_layer_norm_no_affine(
+// CHECK:         tcp.layer_norm %{{.*}} {axis = 1 : i64, epsilon = 1.000000e-05 : f64} : tensor<4x8xf32> -> tensor<4x8xf32>
+func.func @test_layer_norm_no_affine(%arg0 : tensor<4x8xf32>) -> tensor<4x8xf32> {
+  %0 = tcp.layer_norm %arg0 {axis = 1 : i64, epsilon = 1.000000e-05 : f64} : tensor<4x8xf32> -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_rms_norm(
+// CHECK:         tcp.rms_norm %{{.*}} weight(%{{.*}} : tensor<8xf16>) {axis = 1 : i64, epsilon = 1.000000e-06 : f64} : tensor<4x8xf16> -> tensor<4x8xf16>
+func.func @test_rms_norm(%arg0 : tensor<4x8xf16>, %arg1 : tensor<8xf16>) -> tensor<4x8xf16> {
+  %0 = tcp.rms_norm %arg0 weight(%arg1 : tensor<8xf16>) {axis = 1 : i64, epsilon = 1.000000e-06 : f64} : tensor<4x8xf16> -> tensor<4x8xf16>
+  return %0 : tensor<4x8xf16>
+}
+
+// -----
+
+func.func @test_layer_norm_weight_shape(%arg0 : tensor<4x8xf32>, %arg1 : tensor<4x8xf32>) -> tensor<4x8xf32> {
+  // expected-error@+1{{'tcp.layer_norm' op failed to verify that the weight and bias have the shape of the normalized dims}}
+  %0 = tcp.layer_norm %arg0 weight(%arg1 : tensor<4x8xf32>) {axis = 1 : i64, epsilon = 1.000000e-05 : f64} : tensor<4x8xf32> -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
+
+// -----
+
+func.func @test_rms_norm_axis_out_of_range(%arg0 : tensor<4x8xf32>) -> tensor<4x8xf32> {
+  // expected-error@+1{{'tcp.rms_norm' op failed to verify that `axis` is in the range of the input rank}}
+  %0 = tcp.rms_norm %arg0 {axis = 2 : i64, epsilon = 1.000000e-06 : f64} : tensor<4x8xf32> -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
@@ -0,0 +1,116 @@
+// RUN: tcp-opt %s -tcp-pack-matmul-ops -split-input-file | FileCheck %s
+// RUN: tcp-opt %s -tcp-pack-matmul-ops="num-threads=4" -split-input-file | FileCheck %s --check-prefix=CHECK-MT
+
+// CHECK-LABEL: func.func @matmul(
+// CHECK-NOT:     linalg.matmul
+// CHECK-NOT:     tensor.pack
+// CHECK:         scf.for
+// CHECK:           scf.for
+// CHECK:             scf.for
+// CHECK:               vector.outerproduct
+// CHECK-NOT:     tensor.unpack
+// CHECK:         return
+
+// CHECK-MT-LABEL: func.func @matmul(
+// CHECK-MT:         scf.forall
+// CHECK-MT:           scf.for
+// CHECK-MT:             scf.for
+// CHECK-MT:               vector.outerproduct
+// CHECK-MT:         return
+func.func @matmul(%arg0: tensor<16x64xf32>, %arg1: tensor<64x32xf32>) -> tensor<16x32xf32> {
+  %cst = arith.constant 0.000000e+00 : f32
+  %0 = tensor.empty() : tensor<16x32xf32>
+  %1 = linalg.fill ins(%cst : f32) outs(%0 : tensor<16x32xf32>) -> tensor<16x32xf32>
+  %2 = linalg.matmul ins(%arg0, %arg1 : tensor<16x64xf32>, tensor<64x32xf32>) outs(%1 : tensor<16x32xf32>) -> tensor<16x32xf32>
+  return %2 : tensor<16x32xf32>
+}
+
+// -----
+
+// The panels are padded when the sizes are not multiples of the tile sizes.
+
+// CHECK-LABEL: func.func @matmul_padded(
+// CHECK-NOT:     linalg.matmul
+// CHECK:         tensor.pad
+// CHECK:         vector.outerproduct
+// CHECK:         tensor.extract_slice {{.*}} to tensor<18x30xf32>
+// CHECK:         return
+func.func @matmul_padded(%arg0: tensor<18x40xf32>, %arg1: tensor<40x30xf32>, %arg2: tensor<18x30xf32>) -> tensor<18x30xf32> {
+  %0 = linalg.matmul ins(%arg0, %arg1 : tensor<18x40xf32>, tensor<40x30xf32>) outs(%arg2 : tensor<18x30xf32>) -> tensor<18x30xf32>
+  return %0 : tensor<18x30xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @batch_matmul(
+// CHECK-NOT:     linalg.batch_matmul
+// CHECK:         scf.for
+// CHECK:           scf.for
+// CHECK:             scf.for
+// CHECK:               scf.for
+// CHECK:                 vector.outerproduct
+// CHECK:         return
+func.func @batch_matmul(%arg0: tensor<2x8x32xf32>, %arg1: tensor<2x32x16xf32>, %arg2: tensor<2x8x16xf32>) -> tensor<2x8x16xf32> {
+  %0 = linalg.batch_matmul ins(%arg0, %arg1 : tensor<2x8x32xf32>, tensor<2x32x16xf32>) outs(%arg2 : tensor<2x8x16xf32>) -> tensor<2x8x16xf32>
+  return %0 : tensor<2x8x16xf32>
+}
+
+// -----
+
+// Contractions in generic form, such as the GEMMs of im2col convolutions, are
+// packed along their innermost m, n and k dims.
+
+#map = affine_map<(d0, d1, d2, d3) -> (d1, d3)>
+#map1 = affine_map<(d0, d1, d2, d3) -> (d0, d3, d2)>
+#map2 = affine_map<(d0, d1, d2, d3) -> (d0, d1, d2)>
+
+// CHECK-LABEL: func.func @generic_contraction(
+// CHECK-NOT:     linalg.generic
+// CHECK:         scf.for
+// CHECK:                 vector.outerproduct
+// CHECK:         return
+func.func @generic_contraction(%arg0: tensor<16x64xf32>, %arg1: tensor<2x64x32xf32>, %arg2: tensor<2x16x32xf32>) -> tensor<2x16x32xf32> {
+  %0 = linalg.generic {indexing_maps = [#map, #map1, #map2], iterator_types = ["parallel", "parallel", "parallel", "reduction"]} ins(%arg0, %arg1 : tensor<16x64xf32>, tensor<2x64x32xf32>) outs(%arg2 : tensor<2x16x32xf32>) {
+  ^bb0(%in: f32, %in_0: f32, %out: f32):
+    %1 = arith.mulf %in, %in_0 : f32
+    %2 = arith.addf %out, %1 : f32
+    linalg.yield %2 : f32
+  } -> tensor<2x16x32xf32>
+  return %0 : tensor<2x16x32xf32>
+}
+
+// -----
+
+// Matmuls smaller than a single micro-kernel or with dynamic shapes are left
+// as is.
+
+// CHECK-LABEL: func.func @matmul_small(
+// CHECK:         linalg.matmul
+// CHECK-NOT:     vector.outerproduct
+func.func @matmul_small(%arg0: tensor<2x3xf32>, %arg1: tensor<3x4xf32>, %arg2: tensor<2x4xf32>) -> tensor<2x4xf32> {
+  %0 = linalg.matmul ins(%arg0, %arg1 : tensor<2x3xf32>, tensor<3x4xf32>) outs(%arg2 : tensor<2x4xf32>) -> tensor<2x4xf32>
+  return %0 : tensor<2x4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @matmul_dynamic(
+// CHECK:         linalg.matmul
+// CHECK-NOT:     vector.outerproduct
+func.func @matmul_dynamic(%arg0: tensor<?x64xf32>, %arg1: tensor<64x32xf32>, %arg2: tensor<?x32xf32>) -> tensor<?x32xf32> {
+  %0 = linalg.matmul ins(%arg0, %arg1 : tensor<?x64xf32>, tensor<64x32xf32>) outs(%arg2 : tensor<?x32xf32>) -> tensor<?x32xf32>
+  return %0 : tensor<?x32xf32>
+}
+
+// -----
+
+// Ops with index elements are skipped before their tile sizes are computed.
+
+// CHECK-LABEL: func.func @fill_index(
+// CHECK:         linalg.fill
+// CHECK-NOT:     tensor.pack
+func.func @fill_index(%arg0: index) -> tensor<64x64xindex> {
+  %empty = tensor.empty() : tensor<64x64xindex>
+  %0 = linalg.fill ins(%arg0 : index) outs(%empty : tensor<64x64xindex>) -> tensor<64x64xindex>
+  return %0 : tensor<64x64xindex>
+}
@@ -0,0 +1,62 @@
+// RUN: tcp-opt %s -tcp-parallelize-linalg-ops="num-threads=4" -split-input-file | FileCheck %s
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+
+// The step is clamped to one, for when the dim is empty.
+// CHECK-LABEL: func.func @parallelize_dynamic_add(
+// CHECK:         %[[STEP:.*]] = affine.max affine_map<()[s0] -> (s0 ceildiv 4, 1)>()[%{{.*}}]
+// CHECK:         %[[RESULT:.*]] = scf.forall (%{{.*}}) = (0) to (%{{.*}}) step (%[[STEP]]) shared_outs(%{{.*}} = %{{.*}}) -> (tensor<?x?xf32>) {
+// CHECK:           %[[TILE:.*]] = linalg.generic
+// CHECK:           scf.forall.in_parallel {
+// CHECK:             tensor.parallel_insert_slice %[[TILE]]
+// CHECK:         return %[[RESULT]] : tensor<?x?xf32>
+func.func @parallelize_dynamic_add(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x?xf32>) -> tensor<?x?xf32> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+  %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+  %empty = tensor.empty(%dim0, %dim1) : tensor<?x?xf32>
+  %0 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = ["parallel", "parallel"]}
+        ins(%arg0, %arg1 : tensor<?x?xf32>, tensor<?x?xf32>) outs(%empty : tensor<?x?xf32>) {
+  ^bb0(%in: f32, %in_0: f32, %out: f32):
+    %1 = arith.addf %in, %in_0 : f32
+    linalg.yield %1 : f32
+  } -> tensor<?x?xf32>
+  return %0 : tensor<?x?xf32>
+}
+
+// -----
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+
+// CHECK-LABEL: func.func @parallelize_skips_unit_dims(
+// CHECK:         scf.forall (%{{.*}}) = (0) to (8192) step (2048)
+// CHECK:           linalg.generic {{.*}} ins(%{{.*}} : tensor<1x2048xf32>)
+func.func @parallelize_skips_unit_dims(%arg0 : tensor<1x8192xf32>) -> tensor<1x8192xf32> {
+  %empty = tensor.empty() : tensor<1x8192xf32>
+  %0 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel"]}
+        ins(%arg0 : tensor<1x8192xf32>) outs(%empty : tensor<1x8192xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %1 = math.sqrt %in : f32
+    linalg.yield %1 : f32
+  } -> tensor<1x8192xf32>
+  return %0 : tensor<1x8192xf32>
+}
+
+// -----
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+
+// CHECK-LABEL: func.func @parallelize_skips_small_ops(
+// CHECK-NOT:     scf.forall
+// CHECK:         linalg.generic
+func.func @parallelize_skips_small_ops(%arg0 : tensor<4x4xf32>) -> tensor<4x4xf32> {
+  %empty = tensor.empty() : tensor<4x4xf32>
+  %0 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel", "parallel"]}
+        ins(%arg0 : tensor<4x4xf32>) outs(%empty : tensor<4x4xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %1 = math.sqrt %in : f32
+    linalg.yield %1 : f32
+  } -> tensor<4x4xf32>
+  return %0 : tensor<4x4xf32>
+}
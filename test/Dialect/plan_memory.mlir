@@ -0,0 +1,44 @@
+// RUN: tcp-opt %s -split-input-file -tcp-plan-memory="emit-remarks=true" -verify-diagnostics | FileCheck %s
+
+// %0 and %1 are live at the same time, %2 reuses the memory of %0.
+
+// CHECK-LABEL: func.func @reuse_dead_buffer(
+// CHECK-SAME:      attributes {tcp.planned_arena_bytes = 512 : i64}
+// CHECK:         %[[ARENA:.+]] = memref.alloc() {alignment = 64 : i64} : memref<512xi8>
+// CHECK:         %[[OFF0:.+]] = arith.constant 0 : index
+// CHECK:         %[[BUF0:.+]] = memref.view %[[ARENA]][%[[OFF0]]][] : memref<512xi8> to memref<64xf32>
+// CHECK:         %[[OFF1:.+]] = arith.constant 256 : index
+// CHECK:         %[[BUF1:.+]] = memref.view %[[ARENA]][%[[OFF1]]][] : memref<512xi8> to memref<64xf32>
+// CHECK:         %[[OFF2:.+]] = arith.constant 0 : index
+// CHECK:         %[[BUF2:.+]] = memref.view %[[ARENA]][%[[OFF2]]][] : memref<512xi8> to memref<64xf32>
+// CHECK:         memref.copy %[[BUF1]], %[[BUF2]]
+// CHECK:         %[[RES:.+]] = memref.alloc() : memref<64xf32>
+// CHECK:         return %[[RES]]
+// expected-remark@+1 {{planned 3 buffers in an arena of 512 bytes}}
+func.func @reuse_dead_buffer(%arg0: memref<64xf32>) -> memref<64xf32> {
+  %0 = memref.alloc() : memref<64xf32>
+  memref.copy %arg0, %0 : memref<64xf32> to memref<64xf32>
+  %1 = memref.alloc() : memref<64xf32>
+  memref.copy %0, %1 : memref<64xf32> to memref<64xf32>
+  %2 = memref.alloc() : memref<64xf32>
+  memref.copy %1, %2 : memref<64xf32> to memref<64xf32>
+  %3 = memref.alloc() : memref<64xf32>
+  memref.copy %2, %3 : memref<64xf32> to memref<64xf32>
+  return %3 : memref<64xf32>
+}
+
+// -----
+
+// Dynamically shaped buffers and buffers that escape through an alias are
+// left alone.
+
+// CHECK-LABEL: func.func @not_planned(
+// CHECK-NOT:     tcp.planned_arena_bytes
+// CHECK-NOT:     memref.view
+func.func @not_planned(%arg0: index, %arg1: memref<4xf32>) -> (memref<?xf32>, memref<4xf32>) {
+  %0 = memref.alloc(%arg0) : memref<?xf32>
+  %1 = memref.alloc() : memref<4xf32>
+  memref.copy %arg1, %1 : memref<4xf32> to memref<4xf32>
+  %2 = memref.cast %1 : memref<4xf32> to memref<4xf32>
+  return %0, %2 : memref<?xf32>, memref<4xf32>
+}
@@ -0,0 +1,86 @@
+// RUN: tcp-opt %s -split-input-file -verify-diagnostics | FileCheck %s
+
+// CHECK-LABEL: func.func @test_max_pool2d(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<1x64x112x112xf32>) -> tensor<1x64x56x56xf32>
+// CHECK:         %[[POOL:.*]] = tcp.max_pool2d %[[ARG0]] {dilation = [1, 1], kernel_size = [3, 3], padding = [1, 1], stride = [2, 2]} : tensor<1x64x112x112xf32> -> tensor<1x64x56x56xf32>
+// CHECK:         return %[[POOL]] : tensor<1x64x56x56xf32>
+func.func @test_max_pool2d(%arg0 : tensor<1x64x112x112xf32>) -> tensor<1x64x56x56xf32> {
+  %0 = tcp.max_pool2d %arg0 {kernel_size = [3, 3], stride = [2, 2], padding = [1, 1], dilation = [1, 1]} : tensor<1x64x112x112xf32> -> tensor<1x64x56x56xf32>
+  return %0 : tensor<1x64x56x56xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_max_pool2d_dynamic(
+// CHECK:         tcp.max_pool2d %{{.*}} : tensor<?x8x?x?xi32> -> tensor<?x8x?x?xi32>
+func.func @test_max_pool2d_dynamic(%arg0 : tensor<?x8x?x?xi32>) -> tensor<?x8x?x?xi32> {
+  %0 = tcp.max_pool2d %arg0 {kernel_size = [2, 2], stride = [1, 1], padding = [0, 0], dilation = [2, 2]} : tensor<?x8x?x?xi32> -> tensor<?x8x?x?xi32>
+  return %0 : tensor<?x8x?x?xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_avg_pool2d(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x16x9x9xf32>) -> tensor<2x16x5x5xf32>
+// CHECK:         %[[POOL:.*]] = tcp.avg_pool2d %[[ARG0]] {count_include_pad = false, {{.*}}} : tensor<2x16x9x9xf32> -> tensor<2x16x5x5xf32>
+// CHECK:         return %[[POOL]] : tensor<2x16x5x5xf32>
+func.func @test_avg_pool2d(%arg0 : tensor<2x16x9x9xf32>) -> tensor<2x16x5x5xf32> {
+  %0 = tcp.avg_pool2d %arg0 {kernel_size = [3, 3], stride = [2, 2], padding = [1, 1], count_include_pad = false} : tensor<2x16x9x9xf32> -> tensor<2x16x5x5xf32>
+  return %0 : tensor<2x16x5x5xf32>
+}
+
+// -----
+
+func.func @test_max_pool2d_rank(%arg0 : tensor<64x112x112xf32>) -> tensor<64x56x56xf32> {
+  // expected-error@+1{{'tcp.max_pool2d' op failed to verify that the input and result are of rank 4}}
+  %0 = tcp.max_pool2d %arg0 {kernel_size = [3, 3], stride = [2, 2], padding = [1, 1], dilation = [1, 1]} : tensor<64x112x112xf32> -> tensor<64x56x56xf32>
+  return %0 : tensor<64x56x56xf32>
+}
+
+// -----
+
+func.func @test_max_pool2d_kernel_size(%arg0 : tensor<1x4x8x8xf32>) -> tensor<1x4x8x8xf32> {
+  // expected-error@+1{{'tcp.max_pool2d' op failed to verify that `kernel_size`, `stride`, `padding` and `dilation` have two entries}}
+  %0 = tcp.max_pool2d %arg0 {kernel_size = [1], stride = [1, 1], padding = [0, 0], dilation = [1, 1]} : tensor<1x4x8x8xf32> -> tensor<1x4x8x8xf32>
+  return %0 : tensor<1x4x8x8xf32>
+}
+
+// -----
+
+func.func @test_max_pool2d_stride(%arg0 : tensor<1x4x8x8xf32>) -> tensor<1x4x8x8xf32> {
+  // expected-error@+1{{'tcp.max_pool2d' op failed to verify that `kernel_size`, `stride` and `dilation` are positive}}
+  %0 = tcp.max_pool2d %arg0 {kernel_size = [1, 1], stride = [0, 1], padding = [0, 0], dilation = [1, 1]} : tensor<1x4x8x8xf32> -> tensor<1x4x8x8xf32>
+  return %0 : tensor<1x4x8x8xf32>
+}
+
+// -----
+
+func.func @test_max_pool2d_padding(%arg0 : tensor<1x4x8x8xf32>) -> tensor<1x4x10x10xf32> {
+  // expected-error@+1{{'tcp.max_pool2d' op failed to verify that `padding` is non-negative and at most half of `kernel_size`}}
+  %0 = tcp.max_pool2d %arg0 {kernel_size = [1, 1], stride = [1, 1], padding = [1, 1], dilation = [1, 1]} : tensor<1x4x8x8xf32> -> tensor<1x4x10x10xf32>
+  return %0 : tensor<1x4x10x10xf32>
+}
+
+// -----
+
+func.func @test_avg_pool2d_channels(%arg0 : tensor<1x4x8x8xf32>) -> tensor<1x8x4x4xf32> {
+  // expected-error@+1{{'tcp.avg_pool2d' op failed to verify that the batch and channel dims of the result match the input}}
+  %0 = tcp.avg_pool2d %arg0 {kernel_size = [2, 2], stride = [2, 2], padding = [0, 0]} : tensor<1x4x8x8xf32> -> tensor<1x8x4x4xf32>
+  return %0 : tensor<1x8x4x4xf32>
+}
+
+// -----
+
+func.func @test_avg_pool2d_spatial_dims(%arg0 : tensor<1x4x8x8xf32>) -> tensor<1x4x3x3xf32> {
+  // expected-error@+1{{'tcp.avg_pool2d' op failed to verify that the spatial dims of the result match the pooling parameters}}
+  %0 = tcp.avg_pool2d %arg0 {kernel_size = [2, 2], stride = [2, 2], padding = [0, 0]} : tensor<1x4x8x8xf32> -> tensor<1x4x3x3xf32>
+  return %0 : tensor<1x4x3x3xf32>
+}
+
+// -----
+
+func.func @test_avg_pool2d_int(%arg0 : tensor<1x4x8x8xi32>) -> tensor<1x4x4x4xi32> {
+  // expected-error@+1{{'tcp.avg_pool2d' op operand #0 must be ranked tensor of floating-point values}}
+  %0 = tcp.avg_pool2d %arg0 {kernel_size = [2, 2], stride = [2, 2], padding = [0, 0]} : tensor<1x4x8x8xi32> -> tensor<1x4x4x4xi32>
+  return %0 : tensor<1x4x4x4xi32>
+}
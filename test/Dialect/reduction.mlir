@@ -0,0 +1,90 @@
+// RUN: tcp-opt %s -split-input-file -verify-diagnostics | FileCheck %s
+
+// CHECK-LABEL: func.func @test_reduce_sum(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x8xf32>) -> tensor<?xf32>
+// CHECK:         %[[SUM:.*]] = tcp.reduce_sum %[[ARG0]] {axes = [1]} : tensor<?x8xf32> -> tensor<?xf32>
+// CHECK:         return %[[SUM]] : tensor<?xf32>
+func.func @test_reduce_sum(%arg0 : tensor<?x8xf32>) -> tensor<?xf32> {
+  %0 = tcp.reduce_sum %arg0 {axes = [1]} : tensor<?x8xf32> -> tensor<?xf32>
+  return %0 : tensor<?xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_reduce_max_keepdim(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<2x4x8xi32>) -> tensor<1x4x1xi32>
+// CHECK:         %[[MAX:.*]] = tcp.reduce_max %[[ARG0]] {axes = [0, 2], keepdim = true} : tensor<2x4x8xi32> -> tensor<1x4x1xi32>
+// CHECK:         return %[[MAX]] : tensor<1x4x1xi32>
+func.func @test_reduce_max_keepdim(%arg0 : tensor<2x4x8xi32>) -> tensor<1x4x1xi32> {
+  %0 = tcp.reduce_max %arg0 {axes = [0, 2], keepdim = true} : tensor<2x4x8xi32> -> tensor<1x4x1xi32>
+  return %0 : tensor<1x4x1xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_reduce_prod_all(
+// CHECK:         tcp.reduce_prod %{{.*}} {axes = [0, 1]} : tensor<4x8xf32> -> tensor<f32>
+func.func @test_reduce_prod_all(%arg0 : tensor<4x8xf32>) -> tensor<f32> {
+  %0 = tcp.reduce_prod %arg0 {axes = [0, 1]} : tensor<4x8xf32> -> tensor<f32>
+  return %0 : tensor<f32>
+}
+
+// -----
+
+func.func @test_reduce_axes_unsorted(%arg0 : tensor<4x8xf32>) -> tensor<f32> {
+  // expected-error@+1{{'tcp.reduce_min' op failed to verify that `axes` are sorted, unique and in the range of the input rank}}
+  %0 = tcp.reduce_min %arg0 {axes = [1, 0]} : tensor<4x8xf32> -> tensor<f32>
+  return %0 : tensor<f32>
+}
+
+// -----
+
+func.func @test_reduce_axes_out_of_range(%arg0 : tensor<4x8xf32>) -> tensor<4xf32> {
+  // expected-error@+1{{'tcp.reduce_sum' op failed to verify that `axes` are sorted, unique and in the range of the input rank}}
+  %0 = tcp.reduce_sum %arg0 {axes = [2]} : tensor<4x8xf32> -> tensor<4xf32>
+  return %0 : tensor<4xf32>
+}
+
+// -----
+
+func.func @test_reduce_result_rank(%arg0 : tensor<4x8xf32>) -> tensor<4xf32> {
+  // expected-error@+1{{'tcp.reduce_sum' op failed to verify that the result is of rank 2}}
+  %0 = tcp.reduce_sum %arg0 {axes = [1], keepdim = true} : tensor<4x8xf32> -> tensor<4xf32>
+  return %0 : tensor<4xf32>
+}
+
+// -----
+
+func.func @test_reduce_result_dims(%arg0 : tensor<4x8xf32>) -> tensor<4x8xf32> {
+  // expected-error@+1{{'tcp.reduce_sum' op failed to verify that the result dims match the dims of the input that are not reduced}}
+  %0 = tcp.reduce_sum %arg0 {axes = [1], keepdim = true} : tensor<4x8xf32> -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_cumsum(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<4x?xf32>) -> tensor<4x?xf32>
+// CHECK:         %[[SUM:.*]] = tcp.cumsum %[[ARG0]] {dim = 1 : i64} : tensor<4x?xf32> -> tensor<4x?xf32>
+// CHECK:         return %[[SUM]] : tensor<4x?xf32>
+func.func @test_cumsum(%arg0 : tensor<4x?xf32>) -> tensor<4x?xf32> {
+  %0 = tcp.cumsum %arg0 {dim = 1} : tensor<4x?xf32> -> tensor<4x?xf32>
+  return %0 : tensor<4x?xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_cumprod(
+// CHECK:         tcp.cumprod %{{.*}} {dim = 0 : i64} : tensor<?xi64> -> tensor<?xi64>
+func.func @test_cumprod(%arg0 : tensor<?xi64>) -> tensor<?xi64> {
+  %0 = tcp.cumprod %arg0 {dim = 0} : tensor<?xi64> -> tensor<?xi64>
+  return %0 : tensor<?xi64>
+}
+
+// -----
+
+func.func @test_cumsum_dim(%arg0 : tensor<4x8xf32>) -> tensor<4x8xf32> {
+  // expected-error@+1{{'tcp.cumsum' op failed to verify that `dim` is in the range of the input rank}}
+  %0 = tcp.cumsum %arg0 {dim = 2} : tensor<4x8xf32> -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
@@ -0,0 +1,93 @@
+// RUN: tcp-opt %s -split-input-file -tcp-reuse-input-buffers | FileCheck %s
+
+#map = affine_map<(d0) -> (d0)>
+
+// CHECK-LABEL: func.func @donated_argument(
+// CHECK-SAME:      %[[ARG0:.+]]: tensor<?xf32> {bufferization.writable = true, tcp.donated},
+// CHECK-SAME:      %[[ARG1:.+]]: tensor<?xf32>)
+// CHECK:         %[[ADD:.+]] = linalg.generic {{.*}} ins(%[[ARG0]], %[[ARG1]] : tensor<?xf32>, tensor<?xf32>) outs(%[[ARG0]] : tensor<?xf32>)
+// CHECK:         %[[EMPTY:.+]] = tensor.empty
+// CHECK:         linalg.generic {{.*}} ins(%[[ADD]] : tensor<?xf32>) outs(%[[EMPTY]] : tensor<?xf32>)
+func.func @donated_argument(%arg0: tensor<?xf32> {tcp.donated}, %arg1: tensor<?xf32>) -> tensor<?xf32> {
+  %c0 = arith.constant 0 : index
+  %dim = tensor.dim %arg0, %c0 : tensor<?xf32>
+  %0 = tensor.empty(%dim) : tensor<?xf32>
+  %1 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = ["parallel"]} ins(%arg0, %arg1 : tensor<?xf32>, tensor<?xf32>) outs(%0 : tensor<?xf32>) {
+  ^bb0(%in: f32, %in_0: f32, %out: f32):
+    %3 = arith.addf %in, %in_0 : f32
+    linalg.yield %3 : f32
+  } -> tensor<?xf32>
+  // The returned result is not computed in place of an input.
+  %2 = tensor.empty(%dim) : tensor<?xf32>
+  %3 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel"]} ins(%1 : tensor<?xf32>) outs(%2 : tensor<?xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %4 = math.tanh %in : f32
+    linalg.yield %4 : f32
+  } -> tensor<?xf32>
+  return %3 : tensor<?xf32>
+}
+
+// -----
+
+#map = affine_map<(d0) -> (d0)>
+
+// CHECK-LABEL: func.func @dead_intermediate(
+// CHECK-SAME:      %[[ARG0:.+]]: tensor<?xf32>) -> tensor<?xf32>
+// CHECK:         %[[EMPTY:.+]] = tensor.empty
+// CHECK:         %[[NEG:.+]] = linalg.generic {{.*}} ins(%[[ARG0]] : tensor<?xf32>) outs(%[[EMPTY]] : tensor<?xf32>)
+// CHECK:         %[[EXP:.+]] = linalg.generic {{.*}} ins(%[[NEG]] : tensor<?xf32>) outs(%[[NEG]] : tensor<?xf32>)
+// CHECK:         tensor.empty
+// CHECK:         linalg.generic {{.*}} ins(%[[EXP]] : tensor<?xf32>) outs(%{{.+}} : tensor<?xf32>)
+func.func @dead_intermediate(%arg0: tensor<?xf32>) -> tensor<?xf32> {
+  %c0 = arith.constant 0 : index
+  %dim = tensor.dim %arg0, %c0 : tensor<?xf32>
+  %0 = tensor.empty(%dim) : tensor<?xf32>
+  %1 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel"]} ins(%arg0 : tensor<?xf32>) outs(%0 : tensor<?xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %5 = arith.negf %in : f32
+    linalg.yield %5 : f32
+  } -> tensor<?xf32>
+  %2 = tensor.empty(%dim) : tensor<?xf32>
+  %3 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel"]} ins(%1 : tensor<?xf32>) outs(%2 : tensor<?xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %5 = math.exp %in : f32
+    linalg.yield %5 : f32
+  } -> tensor<?xf32>
+  %4 = tensor.empty(%dim) : tensor<?xf32>
+  %5 = linalg.generic {indexing_maps = [#map, #map], iterator_types = ["parallel"]} ins(%3 : tensor<?xf32>) outs(%4 : tensor<?xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %6 = math.tanh %in : f32
+    linalg.yield %6 : f32
+  } -> tensor<?xf32>
+  return %5 : tensor<?xf32>
+}
+
+// -----
+
+#map = affine_map<(d0) -> (d0)>
+
+// The donated argument is read after the first op, so it is not overwritten.
+
+// CHECK-LABEL: func.func @donated_argument_read_later(
+// CHECK-SAME:      %[[ARG0:.+]]: tensor<?xf32> {bufferization.writable = true, tcp.donated},
+// CHECK-SAME:      %[[ARG1:.+]]: tensor<?xf32>)
+// CHECK:         %[[EMPTY:.+]] = tensor.empty
+// CHECK:         %[[ADD:.+]] = linalg.generic {{.*}} ins(%[[ARG0]], %[[ARG1]] : tensor<?xf32>, tensor<?xf32>) outs(%[[EMPTY]] : tensor<?xf32>)
+// CHECK:         linalg.generic {{.*}} ins(%[[ADD]], %[[ARG0]] : tensor<?xf32>, tensor<?xf32>) outs(%{{.+}} : tensor<?xf32>)
+func.func @donated_argument_read_later(%arg0: tensor<?xf32> {tcp.donated}, %arg1: tensor<?xf32>) -> tensor<?xf32> {
+  %c0 = arith.constant 0 : index
+  %dim = tensor.dim %arg0, %c0 : tensor<?xf32>
+  %0 = tensor.empty(%dim) : tensor<?xf32>
+  %1 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = ["parallel"]} ins(%arg0, %arg1 : tensor<?xf32>, tensor<?xf32>) outs(%0 : tensor<?xf32>) {
+  ^bb0(%in: f32, %in_0: f32, %out: f32):
+    %3 = arith.addf %in, %in_0 : f32
+    linalg.yield %3 : f32
+  } -> tensor<?xf32>
+  %2 = tensor.empty(%dim) : tensor<?xf32>
+  %3 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = ["parallel"]} ins(%1, %arg0 : tensor<?xf32>, tensor<?xf32>) outs(%2 : tensor<?xf32>) {
+  ^bb0(%in: f32, %in_0: f32, %out: f32):
+    %4 = arith.mulf %in, %in_0 : f32
+    linalg.yield %4 : f32
+  } -> tensor<?xf32>
+  return %3 : tensor<?xf32>
+}
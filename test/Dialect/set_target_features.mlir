@@ -0,0 +1,14 @@
+// RUN: tcp-opt %s -tcp-set-target-features="target-features=+avx2,+fma" | FileCheck %s
+
+// CHECK-LABEL: llvm.func @main(
+// CHECK-SAME:      target_features = #llvm.target_features<["+avx2", "+fma"]>
+llvm.func @main(%arg0: f32) -> f32 {
+  %0 = llvm.call @sqrtf(%arg0) : (f32) -> f32
+  llvm.return %0 : f32
+}
+
+// Declarations are left alone.
+
+// CHECK-LABEL: llvm.func @sqrtf(
+// CHECK-NOT:       target_features
+llvm.func @sqrtf(f32) -> f32
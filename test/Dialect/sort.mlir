@@ -0,0 +1,77 @@
+// RUN: tcp-opt %s -split-input-file -verify-diagnostics | FileCheck %s
+
+// CHECK-LABEL: func.func @test_topk(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x2304xf32>)
+// CHECK:         %[[VALUES:.*]], %[[INDICES:.*]] = tcp.topk %[[ARG0]] {dim = 1 : i64, k = 8 : i64, largest = false} : tensor<?x2304xf32> -> tensor<?x8xf32>, tensor<?x8xi64>
+// CHECK:         return %[[VALUES]], %[[INDICES]] : tensor<?x8xf32>, tensor<?x8xi64>
+func.func @test_topk(%arg0 : tensor<?x2304xf32>) -> (tensor<?x8xf32>, tensor<?x8xi64>) {
+  %values, %indices = tcp.topk %arg0 {k = 8, dim = 1, largest = false} : tensor<?x2304xf32> -> tensor<?x8xf32>, tensor<?x8xi64>
+  return %values, %indices : tensor<?x8xf32>, tensor<?x8xi64>
+}
+
+// -----
+
+func.func @test_topk_dim(%arg0 : tensor<4x16xf32>) -> (tensor<4x8xf32>, tensor<4x8xi64>) {
+  // expected-error@+1{{'tcp.topk' op failed to verify that `dim` is in the range of the input rank}}
+  %values, %indices = tcp.topk %arg0 {k = 8, dim = 2} : tensor<4x16xf32> -> tensor<4x8xf32>, tensor<4x8xi64>
+  return %values, %indices : tensor<4x8xf32>, tensor<4x8xi64>
+}
+
+// -----
+
+func.func @test_topk_k(%arg0 : tensor<4x16xf32>) -> (tensor<4x32xf32>, tensor<4x32xi64>) {
+  // expected-error@+1{{'tcp.topk' op failed to verify that `k` is non-negative and at most the size of `dim`}}
+  %values, %indices = tcp.topk %arg0 {k = 32, dim = 1} : tensor<4x16xf32> -> tensor<4x32xf32>, tensor<4x32xi64>
+  return %values, %indices : tensor<4x32xf32>, tensor<4x32xi64>
+}
+
+// -----
+
+func.func @test_topk_result_shape(%arg0 : tensor<4x16xf32>) -> (tensor<4x4xf32>, tensor<4x8xi64>) {
+  // expected-error@+1{{'tcp.topk' op failed to verify that the result dims match the input dims, with a size of `k` along `dim`}}
+  %values, %indices = tcp.topk %arg0 {k = 8, dim = 1} : tensor<4x16xf32> -> tensor<4x4xf32>, tensor<4x8xi64>
+  return %values, %indices : tensor<4x4xf32>, tensor<4x8xi64>
+}
+
+// -----
+
+func.func @test_topk_indices_type(%arg0 : tensor<4x16xf32>) -> (tensor<4x8xf32>, tensor<4x8xi32>) {
+  // expected-error@+1{{'tcp.topk' op failed to verify that `indices` are of type i64}}
+  %values, %indices = tcp.topk %arg0 {k = 8, dim = 1} : tensor<4x16xf32> -> tensor<4x8xf32>, tensor<4x8xi32>
+  return %values, %indices : tensor<4x8xf32>, tensor<4x8xi32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @test_sort(
+// CHECK-SAME:          %[[ARG0:.*]]: tensor<?x2304xf32>)
+// CHECK:         %[[VALUES:.*]], %[[INDICES:.*]] = tcp.sort %[[ARG0]] {descending = true, dim = 1 : i64, stable = true} : tensor<?x2304xf32> -> tensor<?x2304xf32>, tensor<?x2304xi64>
+// CHECK:         return %[[VALUES]], %[[INDICES]] : tensor<?x2304xf32>, tensor<?x2304xi64>
+func.func @test_sort(%arg0 : tensor<?x2304xf32>) -> (tensor<?x2304xf32>, tensor<?x2304xi64>) {
+  %values, %indices = tcp.sort %arg0 {dim = 1, descending = true, stable = true} : tensor<?x2304xf32> -> tensor<?x2304xf32>, tensor<?x2304xi64>
+  return %values, %indices : tensor<?x2304xf32>, tensor<?x2304xi64>
+}
+
+// -----
+
+func.func @test_sort_dim(%arg0 : tensor<4x16xf32>) -> (tensor<4x16xf32>, tensor<4x16xi64>) {
+  // expected-error@+1{{'tcp.sort' op failed to verify that `dim` is in the range of the input rank}}
+  %values, %indices = tcp.sort %arg0 {dim = -1} : tensor<4x16xf32> -> tensor<4x16xf32>, tensor<4x16xi64>
+  return %values, %indices : tensor<4x16xf32>, tensor<4x16xi64>
+}
+
+// -----
+
+func.func @test_sort_result_shape(%arg0 : tensor<4x16xf32>) -> (tensor<4x16xf32>, tensor<4x8xi64>) {
+  // expected-error@+1{{'tcp.sort' op failed to verify that all of {in, values, indices} have same shape}}
+  %values, %indices = tcp.sort %arg0 {dim = 1} : tensor<4x16xf32> -> tensor<4x16xf32>, tensor<4x8xi64>
+  return %values, %indices : tensor<4x16xf32>, tensor<4x8xi64>
+}
+
+// -----
+
+func.func @test_sort_indices_type(%arg0 : tensor<4x16xf32>) -> (tensor<4x16xf32>, tensor<4x16xi32>) {
+  // expected-error@+1{{'tcp.sort' op failed to verify that `indices` are of type i64}}
+  %values, %indices = tcp.sort %arg0 {dim = 1} : tensor<4x16xf32> -> tensor<4x16xf32>, tensor<4x16xi32>
+  return %values, %indices : tensor<4x16xf32>, tensor<4x16xi32>
+}
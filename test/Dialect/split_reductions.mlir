@@ -0,0 +1,120 @@
+// RUN: tcp-opt %s -tcp-split-reductions="vector-width=256 reassociate-fp=true" -split-input-file | FileCheck %s
+// RUN: tcp-opt %s -tcp-split-reductions="vector-width=256 num-threads=4 reassociate-fp=true" -split-input-file | FileCheck %s --check-prefix=CHECK-MT
+// RUN: tcp-opt %s -tcp-split-reductions="vector-width=256 num-threads=4" -split-input-file | FileCheck %s --check-prefix=CHECK-STRICT
+
+// CHECK-LABEL: func.func @split_rows(
+// CHECK:         %[[EXPAND:.*]] = tensor.expand_shape %{{.*}} {{\[\[}}0], [1, 2]] output_shape [4, 128, 8] : tensor<4x1024xf32> into tensor<4x128x8xf32>
+// CHECK:         %[[EMPTY:.*]] = tensor.empty() : tensor<4x8xf32>
+// CHECK:         %[[FILL:.*]] = linalg.fill ins(%{{.*}} : f32) outs(%[[EMPTY]] : tensor<4x8xf32>) -> tensor<4x8xf32>
+// CHECK:         %[[PARTIAL:.*]] = linalg.generic
+// CHECK-SAME:        iterator_types = ["parallel", "reduction", "parallel"]
+// CHECK-SAME:        ins(%[[EXPAND]] : tensor<4x128x8xf32>) outs(%[[FILL]] : tensor<4x8xf32>)
+// CHECK:         %[[RESULT:.*]] = linalg.generic
+// CHECK-SAME:        iterator_types = ["parallel", "reduction"]
+// CHECK-SAME:        ins(%[[PARTIAL]] : tensor<4x8xf32>)
+// CHECK:         return %[[RESULT]] : tensor<4xf32>
+
+// Float sums are not split without `reassociate-fp`.
+// CHECK-STRICT-LABEL: func.func @split_rows(
+// CHECK-STRICT-NOT:     linalg.generic
+// CHECK-STRICT:         linalg.reduce ins(%{{.*}} : tensor<4x1024xf32>)
+
+// The rows keep all threads busy, so only the lanes are split.
+// CHECK-MT-LABEL: func.func @split_rows(
+// CHECK-MT-NOT:     scf.forall
+// CHECK-MT:         iterator_types = ["parallel", "reduction", "parallel"]
+func.func @split_rows(%arg0 : tensor<4x1024xf32>) -> tensor<4xf32> {
+  %zero = arith.constant 0.000000e+00 : f32
+  %empty = tensor.empty() : tensor<4xf32>
+  %fill = linalg.fill ins(%zero : f32) outs(%empty : tensor<4xf32>) -> tensor<4xf32>
+  %0 = linalg.reduce ins(%arg0 : tensor<4x1024xf32>) outs(%fill : tensor<4xf32>) dimensions = [1]
+    (%in: f32, %acc: f32) {
+      %1 = arith.addf %in, %acc : f32
+      linalg.yield %1 : f32
+    }
+  return %0 : tensor<4xf32>
+}
+
+// -----
+
+// CHECK-LABEL: func.func @split_full_reduction(
+// CHECK-NOT:     scf.forall
+// CHECK:         tensor.expand_shape %{{.*}} {{\[\[}}0, 1]] output_shape [1024, 8] : tensor<8192xi32> into tensor<1024x8xi32>
+// CHECK:         linalg.generic
+// CHECK-SAME:        iterator_types = ["reduction", "parallel"]
+// CHECK:           arith.maxsi
+// CHECK:         linalg.generic
+// CHECK-SAME:        iterator_types = ["reduction"]
+
+// Integer reductions are always split.
+// CHECK-STRICT-LABEL: func.func @split_full_reduction(
+// CHECK-STRICT:         scf.forall
+
+// The reduction is split over the threads first, and each partial reduction
+// is then split over the lanes.
+// CHECK-MT-LABEL: func.func @split_full_reduction(
+// CHECK-MT:         tensor.expand_shape %{{.*}} {{\[\[}}0, 1]] output_shape [4, 2048] : tensor<8192xi32> into tensor<4x2048xi32>
+// CHECK-MT:         tensor.expand_shape %{{.*}} {{\[\[}}0], [1, 2]] output_shape [4, 256, 8] : tensor<4x2048xi32> into tensor<4x256x8xi32>
+// CHECK-MT:         %[[PARTIAL:.*]] = scf.forall (%{{.*}}) {{.*}}(4) shared_outs(%{{.*}} = %{{.*}}) -> (tensor<4x8xi32>) {
+// CHECK-MT:           linalg.generic
+// CHECK-MT-SAME:          iterator_types = ["parallel", "reduction", "parallel"]
+// CHECK-MT-SAME:          ins(%{{.*}} : tensor<1x256x8xi32>)
+// CHECK-MT:           scf.forall.in_parallel
+// CHECK-MT:         %[[COMBINED:.*]] = linalg.generic
+// CHECK-MT-SAME:        iterator_types = ["parallel", "reduction"]
+// CHECK-MT-SAME:        ins(%[[PARTIAL]] : tensor<4x8xi32>)
+// CHECK-MT:         linalg.generic
+// CHECK-MT-SAME:        iterator_types = ["reduction"]
+// CHECK-MT-SAME:        ins(%[[COMBINED]] : tensor<4xi32>)
+func.func @split_full_reduction(%arg0 : tensor<8192xi32>) -> tensor<i32> {
+  %min = arith.constant -2147483648 : i32
+  %empty = tensor.empty() : tensor<i32>
+  %fill = linalg.fill ins(%min : i32) outs(%empty : tensor<i32>) -> tensor<i32>
+  %0 = linalg.reduce ins(%arg0 : tensor<8192xi32>) outs(%fill : tensor<i32>) dimensions = [0]
+    (%in: i32, %acc: i32) {
+      %1 = arith.maxsi %in, %acc : i32
+      linalg.yield %1 : i32
+    }
+  return %0 : tensor<i32>
+}
+
+// -----
+
+// Dynamically shaped reductions, and reductions that are too short, are not
+// split.
+// CHECK-LABEL: func.func @no_split(
+// CHECK-NOT:     linalg.generic
+// CHECK:         linalg.reduce ins(%{{.*}} : tensor<?x1024xf32>)
+// CHECK:         linalg.reduce ins(%{{.*}} : tensor<4x8xf32>)
+func.func @no_split(%arg0 : tensor<?x1024xf32>, %arg1 : tensor<?xf32>, %arg2 : tensor<4x8xf32>, %arg3 : tensor<4xf32>) -> (tensor<?xf32>, tensor<4xf32>) {
+  %0 = linalg.reduce ins(%arg0 : tensor<?x1024xf32>) outs(%arg1 : tensor<?xf32>) dimensions = [1]
+    (%in: f32, %acc: f32) {
+      %2 = arith.addf %in, %acc : f32
+      linalg.yield %2 : f32
+    }
+  %1 = linalg.reduce ins(%arg2 : tensor<4x8xf32>) outs(%arg3 : tensor<4xf32>) dimensions = [1]
+    (%in: f32, %acc: f32) {
+      %2 = arith.addf %in, %acc : f32
+      linalg.yield %2 : f32
+    }
+  return %0, %1 : tensor<?xf32>, tensor<4xf32>
+}
+
+// -----
+
+// Float max reductions are exact in any order, so they are split without
+// `reassociate-fp`.
+// CHECK-STRICT-LABEL: func.func @split_max(
+// CHECK-STRICT:         scf.forall
+// CHECK-STRICT:           arith.maximumf
+func.func @split_max(%arg0 : tensor<8192xf32>) -> tensor<f32> {
+  %min = arith.constant 0xFF800000 : f32
+  %empty = tensor.empty() : tensor<f32>
+  %fill = linalg.fill ins(%min : f32) outs(%empty : tensor<f32>) -> tensor<f32>
+  %0 = linalg.reduce ins(%arg0 : tensor<8192xf32>) outs(%fill : tensor<f32>) dimensions = [0]
+    (%in: f32, %acc: f32) {
+      %1 = arith.maximumf %in, %acc : f32
+      linalg.yield %1 : f32
+    }
+  return %0 : tensor<f32>
+}
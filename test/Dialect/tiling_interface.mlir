@@ -0,0 +1,83 @@
+// RUN: tcp-opt --split-input-file -transform-interpreter -canonicalize -cse %s | FileCheck %s
+
+// CHECK-LABEL: func.func @fuse_elementwise_and_broadcast(
+// CHECK-SAME:      %[[ARG0:.+]]: tensor<1x16xf32>, %[[ARG1:.+]]: tensor<8x16xf32>) -> tensor<8x16xf64>
+// CHECK:         scf.for %[[IV0:.+]] = {{.+}} iter_args(%[[ACC0:.+]] = {{.+}}) -> (tensor<8x16xf64>) {
+// CHECK:           scf.for %[[IV1:.+]] = {{.+}} iter_args(%[[ACC1:.+]] = %[[ACC0]]) -> (tensor<8x16xf64>) {
+// CHECK:             %[[IN:.+]] = tensor.extract_slice %[[ARG0]][0, %[[IV1]]] [1, 4] [1, 1] : tensor<1x16xf32> to tensor<1x4xf32>
+// CHECK:             %[[BCAST:.+]] = tcp.broadcast %[[IN]], {{.+}} {axes = [0]} : tensor<1x4xf32>, index -> tensor<2x4xf32>
+// CHECK:             %[[LHS:.+]] = tensor.extract_slice %[[ARG1]][%[[IV0]], %[[IV1]]] [2, 4] [1, 1] : tensor<8x16xf32> to tensor<2x4xf32>
+// CHECK:             %[[TANH:.+]] = tcp.tanh %[[LHS]] : tensor<2x4xf32> -> tensor<2x4xf32>
+// CHECK:             %[[ADD:.+]] = tcp.add %[[TANH]], %[[BCAST]] : tensor<2x4xf32>, tensor<2x4xf32> -> tensor<2x4xf32>
+// CHECK:             %[[CAST:.+]] = tcp.cast %[[ADD]] : tensor<2x4xf32> -> tensor<2x4xf64>
+// CHECK:             tensor.insert_slice %[[CAST]] into %[[ACC1]][%[[IV0]], %[[IV1]]] [2, 4] [1, 1] : tensor<2x4xf64> into tensor<8x16xf64>
+func.func @fuse_elementwise_and_broadcast(%arg0: tensor<1x16xf32>, %arg1: tensor<8x16xf32>) -> tensor<8x16xf64> {
+  %c8 = arith.constant 8 : index
+  %0 = tcp.broadcast %arg0, %c8 {axes = [0]} : tensor<1x16xf32>, index -> tensor<8x16xf32>
+  %1 = tcp.tanh %arg1 : tensor<8x16xf32> -> tensor<8x16xf32>
+  %2 = tcp.add %1, %0 : tensor<8x16xf32>, tensor<8x16xf32> -> tensor<8x16xf32>
+  %3 = tcp.cast %2 : tensor<8x16xf32> -> tensor<8x16xf64>
+  return %3 : tensor<8x16xf64>
+}
+
+module attributes {transform.with_named_sequence} {
+  transform.named_sequence @__transform_main(%arg0: !transform.any_op {transform.readonly}) {
+    %cast = transform.structured.match ops{["tcp.cast"]} in %arg0 : (!transform.any_op) -> !transform.any_op
+
+    %1, %loops:2 = transform.structured.fuse %cast {tile_sizes = [2, 4], tile_interchange = [0, 1]}
+      : (!transform.any_op) -> (!transform.any_op, !transform.any_op, !transform.any_op)
+
+    transform.yield
+  }
+}
+
+// -----
+
+// CHECK-LABEL: func.func @fuse_gather(
+// CHECK-SAME:      %[[ARG0:.+]]: tensor<4x10xf32>, %[[ARG1:.+]]: tensor<4x6xi64>) -> tensor<4x6xf32>
+// CHECK:         scf.for %[[IV:.+]] = {{.+}} iter_args(%[[ACC:.+]] = {{.+}}) -> (tensor<4x6xf32>) {
+// CHECK:           %[[IN:.+]] = tensor.extract_slice %[[ARG0]][%[[IV]], 0] [1, 10] [1, 1] : tensor<4x10xf32> to tensor<1x10xf32>
+// CHECK:           %[[NEG:.+]] = tcp.neg %[[IN]] : tensor<1x10xf32> -> tensor<1x10xf32>
+// CHECK:           %[[IDX:.+]] = tensor.extract_slice %[[ARG1]][%[[IV]], 0] [1, 6] [1, 1] : tensor<4x6xi64> to tensor<1x6xi64>
+// CHECK:           %[[GATHER:.+]] = tcp.gather %[[NEG]], %[[IDX]] {dim = 1 : index} : tensor<1x10xf32>, tensor<1x6xi64> -> tensor<1x6xf32>
+// CHECK:           tensor.insert_slice %[[GATHER]] into %[[ACC]][%[[IV]], 0] [1, 6] [1, 1] : tensor<1x6xf32> into tensor<4x6xf32>
+func.func @fuse_gather(%arg0: tensor<4x10xf32>, %arg1: tensor<4x6xi64>) -> tensor<4x6xf32> {
+  %0 = tcp.neg %arg0 : tensor<4x10xf32> -> tensor<4x10xf32>
+  %1 = tcp.gather %0, %arg1 {dim = 1 : index} : tensor<4x10xf32>, tensor<4x6xi64> -> tensor<4x6xf32>
+  return %1 : tensor<4x6xf32>
+}
+
+module attributes {transform.with_named_sequence} {
+  transform.named_sequence @__transform_main(%arg0: !transform.any_op {transform.readonly}) {
+    %gather = transform.structured.match ops{["tcp.gather"]} in %arg0 : (!transform.any_op) -> !transform.any_op
+
+    %1, %loops = transform.structured.fuse %gather {tile_sizes = [1, 0], tile_interchange = [0, 1]}
+      : (!transform.any_op) -> (!transform.any_op, !transform.any_op)
+
+    transform.yield
+  }
+}
+
+// -----
+
+// CHECK-LABEL: func.func @tile_gather_nd(
+// CHECK-SAME:      %[[ARG0:.+]]: tensor<7x11x13xf32>, %[[ARG1:.+]]: tensor<3x2xi64>) -> tensor<3x13xf32>
+// CHECK:         scf.for %[[IV:.+]] = {{.+}} iter_args(%[[ACC:.+]] = {{.+}}) -> (tensor<3x13xf32>) {
+// CHECK:           %[[IDX:.+]] = tensor.extract_slice %[[ARG1]][%[[IV]], 0] [1, 2] [1, 1] : tensor<3x2xi64> to tensor<1x2xi64>
+// CHECK:           %[[GATHER:.+]] = tcp.gather_nd %[[ARG0]], %[[IDX]] : tensor<7x11x13xf32>, tensor<1x2xi64> -> tensor<1x13xf32>
+// CHECK:           tensor.insert_slice %[[GATHER]] into %[[ACC]][%[[IV]], 0] [1, 13] [1, 1] : tensor<1x13xf32> into tensor<3x13xf32>
+func.func @tile_gather_nd(%arg0: tensor<7x11x13xf32>, %arg1: tensor<3x2xi64>) -> tensor<3x13xf32> {
+  %0 = tcp.gather_nd %arg0, %arg1 : tensor<7x11x13xf32>, tensor<3x2xi64> -> tensor<3x13xf32>
+  return %0 : tensor<3x13xf32>
+}
+
+module attributes {transform.with_named_sequence} {
+  transform.named_sequence @__transform_main(%arg0: !transform.any_op {transform.readonly}) {
+    %gather = transform.structured.match ops{["tcp.gather_nd"]} in %arg0 : (!transform.any_op) -> !transform.any_op
+
+    %1, %loops = transform.structured.fuse %gather {tile_sizes = [1, 0], tile_interchange = [0, 1]}
+      : (!transform.any_op) -> (!transform.any_op, !transform.any_op)
+
+    transform.yield
+  }
+}
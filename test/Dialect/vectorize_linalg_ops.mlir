@@ -0,0 +1,93 @@
+// RUN: tcp-opt %s -tcp-vectorize-linalg-ops="vector-width=256" -split-input-file | FileCheck %s
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+
+// CHECK-LABEL: func.func @vectorize_dynamic_add(
+// CHECK:         scf.for
+// CHECK:           scf.for
+// CHECK:             vector.transfer_read {{.*}} : tensor<?x?xf32>, vector<8xf32>
+// CHECK:             vector.transfer_read {{.*}} : tensor<?x?xf32>, vector<8xf32>
+// CHECK:             arith.addf {{.*}} : vector<8xf32>
+// CHECK:             vector.transfer_write {{.*}} : vector<8xf32>, tensor<?x?xf32>
+// CHECK:           scf.for
+// CHECK:             linalg.generic
+// CHECK:               arith.addf {{.*}} : f32
+func.func @vectorize_dynamic_add(%arg0 : tensor<?x?xf32>, %arg1 : tensor<?x?xf32>) -> tensor<?x?xf32> {
+  %c0 = arith.constant 0 : index
+  %c1 = arith.constant 1 : index
+  %dim0 = tensor.dim %arg0, %c0 : tensor<?x?xf32>
+  %dim1 = tensor.dim %arg0, %c1 : tensor<?x?xf32>
+  %empty = tensor.empty(%dim0, %dim1) : tensor<?x?xf32>
+  %0 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = ["parallel", "parallel"]}
+        ins(%arg0, %arg1 : tensor<?x?xf32>, tensor<?x?xf32>) outs(%empty : tensor<?x?xf32>) {
+  ^bb0(%in: f32, %in_0: f32, %out: f32):
+    %1 = arith.addf %in, %in_0 : f32
+    linalg.yield %1 : f32
+  } -> tensor<?x?xf32>
+  return %0 : tensor<?x?xf32>
+}
+
+// -----
+
+#map = affine_map<(d0, d1) -> (d0, d1)>
+
+// CHECK-LABEL: func.func @vectorize_static_mul(
+// CHECK:         scf.for
+// CHECK:           scf.for
+// CHECK:             vector.transfer_read {{.*}} : tensor<4x32xi32>, vector<8xi32>
+// CHECK:             arith.muli {{.*}} : vector<8xi32>
+// CHECK:             vector.transfer_write {{.*}} : vector<8xi32>, tensor<4x32xi32>
+// CHECK-NOT:     linalg.generic
+func.func @vectorize_static_mul(%arg0 : tensor<4x32xi32>, %arg1 : tensor<4x32xi32>) -> tensor<4x32xi32> {
+  %empty = tensor.empty() : tensor<4x32xi32>
+  %0 = linalg.generic {indexing_maps = [#map, #map, #map], iterator_types = ["parallel", "parallel"]}
+        ins(%arg0, %arg1 : tensor<4x32xi32>, tensor<4x32xi32>) outs(%empty : tensor<4x32xi32>) {
+  ^bb0(%in: i32, %in_0: i32, %out: i32):
+    %1 = arith.muli %in, %in_0 : i32
+    linalg.yield %1 : i32
+  } -> tensor<4x32xi32>
+  return %0 : tensor<4x32xi32>
+}
+
+// -----
+
+#map = affine_map<(d0, d1, d2) -> (d0, d1, d2)>
+#map1 = affine_map<(d0, d1, d2) -> (d0, d2)>
+
+// The partial sums of a reduction that was split over the lanes stay in a
+// vector register across the reduction loop.
+// CHECK-LABEL: func.func @vectorize_split_reduction(
+// CHECK:         scf.for
+// CHECK:           %[[ACC:.*]] = vector.transfer_read {{.*}} : tensor<4x8xf32>, vector<8xf32>
+// CHECK:           scf.for {{.*}} iter_args({{.*}}%[[ACC]]) -> ({{.*}}vector<8xf32>{{.*}}) {
+// CHECK:             vector.transfer_read {{.*}} : tensor<4x128x8xf32>, vector<8xf32>
+// CHECK:             arith.addf {{.*}} : vector<8xf32>
+// CHECK:             scf.yield
+// CHECK:           vector.transfer_write {{.*}} : vector<8xf32>, tensor<4x8xf32>
+func.func @vectorize_split_reduction(%arg0 : tensor<4x128x8xf32>, %arg1 : tensor<4x8xf32>) -> tensor<4x8xf32> {
+  %0 = linalg.generic {indexing_maps = [#map, #map1], iterator_types = ["parallel", "reduction", "parallel"]}
+        ins(%arg0 : tensor<4x128x8xf32>) outs(%arg1 : tensor<4x8xf32>) {
+  ^bb0(%in: f32, %out: f32):
+    %1 = arith.addf %in, %out : f32
+    linalg.yield %1 : f32
+  } -> tensor<4x8xf32>
+  return %0 : tensor<4x8xf32>
+}
+
+// -----
+
+// Reductions along the innermost loop are vectorized if the loop fits in a
+// single vector.
+// CHECK-LABEL: func.func @vectorize_horizontal_reduction(
+// CHECK:         scf.for
+// CHECK:           vector.transfer_read {{.*}} : tensor<4x8xf32>, vector<{{(1x)?}}8xf32>
+// CHECK:           vector.{{(multi_)?}}reduction <add>
+// CHECK-NOT:     linalg.reduce
+func.func @vectorize_horizontal_reduction(%arg0 : tensor<4x8xf32>, %arg1 : tensor<4xf32>) -> tensor<4xf32> {
+  %0 = linalg.reduce ins(%arg0 : tensor<4x8xf32>) outs(%arg1 : tensor<4xf32>) dimensions = [1]
+    (%in: f32, %acc: f32) {
+      %1 = arith.addf %in, %acc : f32
+      linalg.yield %1 : f32
+    }
+  return %0 : tensor<4xf32>
+}
@@ -1,4 +1,5 @@
-// RUN: tcp-opt %s -tcp-to-llvm-pipeline | FileCheck %s
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="opt-level=1" | FileCheck %s
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="opt-level=1 fuse-elementwise=false" | FileCheck %s --check-prefix=CHECK-UNFUSED
 
 // CHECK-LABEL: llvm.func @main
 // CHECK:         llvm.mlir.constant
@@ -19,12 +20,39 @@
 // CHECK:         llvm.icmp
 // CHECK:         llvm.cond_br
 // CHECK:         llvm.load
-// CHECK:         llvm.mul
-// CHECK:         llvm.add
+// CHECK:         llvm.load
+// CHECK:         llvm.load
 // CHECK:         llvm.fadd
-// CHECK:         llvm.store
 // CHECK:         llvm.fmul
+// CHECK:         llvm.store
+// CHECK-NOT:     llvm.fmul
 // CHECK:       llvm.return
+
+// CHECK-UNFUSED-LABEL: llvm.func @main
+// CHECK-UNFUSED:         llvm.mlir.constant
+// CHECK-UNFUSED:         llvm.insertvalue
+// CHECK-UNFUSED:         llvm.extractvalue
+// CHECK-UNFUSED:         llvm.alloca
+// CHECK-UNFUSED:         llvm.store
+// CHECK-UNFUSED:         llvm.getelementptr
+// CHECK-UNFUSED:         llvm.load
+// CHECK-UNFUSED:         llvm.mul
+// CHECK-UNFUSED:         llvm.ptrtoint
+// CHECK-UNFUSED:         llvm.add
+// CHECK-UNFUSED:         llvm.call
+// CHECK-UNFUSED:         llvm.sub
+// CHECK-UNFUSED:         llvm.urem
+// CHECK-UNFUSED:         llvm.inttoptr
+// CHECK-UNFUSED:         llvm.br
+// CHECK-UNFUSED:         llvm.icmp
+// CHECK-UNFUSED:         llvm.cond_br
+// CHECK-UNFUSED:         llvm.load
+// CHECK-UNFUSED:         llvm.mul
+// CHECK-UNFUSED:         llvm.add
+// CHECK-UNFUSED:         llvm.fadd
+// CHECK-UNFUSED:         llvm.store
+// CHECK-UNFUSED:         llvm.fmul
+// CHECK-UNFUSED:       llvm.return
 func.func @main(%arg0: tensor<?x?xf32>,
                   %arg1: tensor<?x?xf32>,
                   %arg2: tensor<?x?xf32>) -> tensor<?x?xf32> {
@@ -0,0 +1,16 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=true vector-width=256" | FileCheck %s
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=false" | FileCheck %s --check-prefix=CHECK-NOVEC
+
+// CHECK-LABEL: llvm.func @main
+// CHECK:         llvm.intr.fmuladd{{.*}}vector<{{[0-9]+}}xf32>
+// CHECK:       llvm.return
+
+// CHECK-NOVEC-LABEL: llvm.func @main
+// CHECK-NOVEC-NOT:     vector<
+// CHECK-NOVEC:         llvm.fmul {{.*}} : f32
+// CHECK-NOVEC:         llvm.fadd {{.*}} : f32
+// CHECK-NOVEC:       llvm.return
+func.func @main(%arg0: tensor<1x16x10x10xf32>, %arg1: tensor<8x16x3x3xf32>) -> tensor<1x8x10x10xf32> {
+  %0 = tcp.conv2d %arg0, %arg1 {stride = [1, 1], padding = [1, 1], dilation = [1, 1], groups = 1 : i64} : tensor<1x16x10x10xf32>, tensor<8x16x3x3xf32> -> tensor<1x8x10x10xf32>
+  return %0 : tensor<1x8x10x10xf32>
+}
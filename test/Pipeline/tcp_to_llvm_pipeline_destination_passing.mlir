@@ -0,0 +1,19 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="opt-level=1 destination-passing=true" | FileCheck %s
+
+// The result is written into the trailing buffer argument, so nothing is
+// allocated or returned.
+
+// CHECK-LABEL: llvm.func @main({{[^-]*}}) {
+// CHECK-NOT:     llvm.call @malloc
+// CHECK:         llvm.fadd
+// CHECK:         llvm.fmul
+// CHECK:         llvm.store
+// CHECK-NOT:     llvm.call @malloc
+// CHECK:         llvm.return{{$}}
+func.func @main(%arg0: tensor<4x8xf32>,
+                  %arg1: tensor<4x8xf32>,
+                  %arg2: tensor<4x8xf32>) -> tensor<4x8xf32> {
+  %0 = tcp.add %arg0, %arg1 : tensor<4x8xf32>, tensor<4x8xf32> -> tensor<4x8xf32>
+  %1 = tcp.mul %0, %arg2 : tensor<4x8xf32>, tensor<4x8xf32> -> tensor<4x8xf32>
+  return %1 : tensor<4x8xf32>
+}
@@ -0,0 +1,16 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=true vector-width=256" | FileCheck %s
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=false" | FileCheck %s --check-prefix=CHECK-NOVEC
+
+// CHECK-LABEL: llvm.func @main
+// CHECK:         llvm.intr.fmuladd{{.*}}vector<16xf32>
+// CHECK:       llvm.return
+
+// CHECK-NOVEC-LABEL: llvm.func @main
+// CHECK-NOVEC-NOT:     vector<
+// CHECK-NOVEC:         llvm.fmul {{.*}} : f32
+// CHECK-NOVEC:         llvm.fadd {{.*}} : f32
+// CHECK-NOVEC:       llvm.return
+func.func @main(%arg0: tensor<16x64xf32>, %arg1: tensor<64x32xf32>) -> tensor<16x32xf32> {
+  %0 = tcp.matmul %arg0, %arg1 : tensor<16x64xf32>, tensor<64x32xf32> -> tensor<16x32xf32>
+  return %0 : tensor<16x32xf32>
+}
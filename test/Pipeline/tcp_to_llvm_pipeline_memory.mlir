@@ -0,0 +1,43 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="opt-level=1 fuse-elementwise=false" | FileCheck %s
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="opt-level=1 fuse-elementwise=false stack-promotion-threshold=0" | FileCheck %s --check-prefix=CHECK-HEAP
+
+// The intermediate result of the add is small enough to live on the stack,
+// only the returned buffer is allocated on the heap.
+
+// CHECK-LABEL: llvm.func @main
+// CHECK:         llvm.alloca {{.*}} x f32
+// CHECK-COUNT-1: llvm.call @malloc
+// CHECK-NOT:     llvm.call @malloc
+// CHECK:       llvm.return
+
+// CHECK-HEAP-LABEL: llvm.func @main
+// CHECK-HEAP-NOT:     llvm.alloca {{.*}} x f32
+// CHECK-HEAP-COUNT-2: llvm.call @malloc
+// CHECK-HEAP:       llvm.return
+func.func @main(%arg0: tensor<4xf32>,
+                  %arg1: tensor<4xf32>,
+                  %arg2: tensor<4xf32>) -> tensor<4xf32> {
+  %0 = tcp.add %arg0, %arg1 : tensor<4xf32>, tensor<4xf32> -> tensor<4xf32>
+  %1 = tcp.mul %0, %arg2 : tensor<4xf32>, tensor<4xf32> -> tensor<4xf32>
+  return %1 : tensor<4xf32>
+}
+
+// Buffers of any rank are promoted, as long as they fit under the threshold.
+
+// CHECK-LABEL: llvm.func @rank2
+// CHECK:         llvm.alloca {{.*}} x f32
+// CHECK-COUNT-1: llvm.call @malloc
+// CHECK-NOT:     llvm.call @malloc
+// CHECK:       llvm.return
+
+// CHECK-HEAP-LABEL: llvm.func @rank2
+// CHECK-HEAP-NOT:     llvm.alloca {{.*}} x f32
+// CHECK-HEAP-COUNT-2: llvm.call @malloc
+// CHECK-HEAP:       llvm.return
+func.func @rank2(%arg0: tensor<4x8xf32>,
+                 %arg1: tensor<4x8xf32>,
+                 %arg2: tensor<4x8xf32>) -> tensor<4x8xf32> {
+  %0 = tcp.add %arg0, %arg1 : tensor<4x8xf32>, tensor<4x8xf32> -> tensor<4x8xf32>
+  %1 = tcp.mul %0, %arg2 : tensor<4x8xf32>, tensor<4x8xf32> -> tensor<4x8xf32>
+  return %1 : tensor<4x8xf32>
+}
@@ -0,0 +1,40 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline | FileCheck %s --check-prefix=CHECK-O0
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="opt-level=0" | FileCheck %s --check-prefix=CHECK-O0
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="opt-level=2 target-features=+avx2" | FileCheck %s --check-prefix=CHECK-O2
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="opt-level=3" | FileCheck %s --check-prefix=CHECK-O3
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="opt-level=2 vectorize=false" | FileCheck %s --check-prefix=CHECK-NOVEC
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="opt-level=1 fast-math=true" | FileCheck %s --check-prefix=CHECK-FAST
+
+// CHECK-O0-LABEL: llvm.func @main
+// CHECK-O0:         llvm.fadd
+// CHECK-O0:         llvm.store
+// CHECK-O0:         llvm.fmul
+// CHECK-O0:       llvm.return
+
+// CHECK-O2-LABEL: llvm.func @main
+// CHECK-O2:         llvm.fadd {{.*}} : vector<8xf32>
+// CHECK-O2:         llvm.fmul {{.*}} : vector<8xf32>
+// CHECK-O2:       llvm.return
+
+// CHECK-O3-LABEL: llvm.func @main
+// CHECK-O3:         llvm.call @mlirAsyncRuntimeCreateGroup
+// CHECK-O3:         llvm.call @mlirAsyncRuntimeAwaitAllInGroup
+// CHECK-O3:       llvm.return
+
+// CHECK-NOVEC-LABEL: llvm.func @main
+// CHECK-NOVEC-NOT:     vector<
+// CHECK-NOVEC:         llvm.fadd {{.*}} : f32
+// CHECK-NOVEC:         llvm.fmul {{.*}} : f32
+// CHECK-NOVEC:       llvm.return
+
+// CHECK-FAST-LABEL: llvm.func @main
+// CHECK-FAST:         llvm.fadd {{.*}} {fastmathFlags = #llvm.fastmath<fast>} : f32
+// CHECK-FAST:         llvm.fmul {{.*}} {fastmathFlags = #llvm.fastmath<fast>} : f32
+// CHECK-FAST:       llvm.return
+func.func @main(%arg0: tensor<?x?xf32>,
+                  %arg1: tensor<?x?xf32>,
+                  %arg2: tensor<?x?xf32>) -> tensor<?x?xf32> {
+  %0 = tcp.add %arg0, %arg1 : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  %1 = tcp.mul %0, %arg2 : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  return %1 : tensor<?x?xf32>
+}
@@ -0,0 +1,24 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=true vector-width=256 fast-math=true" | FileCheck %s
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=true vector-width=256" | FileCheck %s --check-prefix=CHECK-STRICT
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=false" | FileCheck %s --check-prefix=CHECK-NOVEC
+
+// CHECK-LABEL: llvm.func @main
+// CHECK:         llvm.fadd {{.*}} : vector<8xf32>
+// CHECK:         llvm.intr.vector.reduce.fadd
+// CHECK:       llvm.return
+
+// Without fast-math, the sum is accumulated in order.
+// CHECK-STRICT-LABEL: llvm.func @main
+// CHECK-STRICT-NOT:     llvm.intr.vector.reduce.fadd
+// CHECK-STRICT:         llvm.fadd {{.*}} : f32
+// CHECK-STRICT-NOT:     llvm.intr.vector.reduce.fadd
+// CHECK-STRICT:       llvm.return
+
+// CHECK-NOVEC-LABEL: llvm.func @main
+// CHECK-NOVEC-NOT:     vector<
+// CHECK-NOVEC:         llvm.fadd {{.*}} : f32
+// CHECK-NOVEC:       llvm.return
+func.func @main(%arg0: tensor<4x1024xf32>) -> tensor<4x1xf32> {
+  %0 = tcp.reduce_sum %arg0 {axes = [1], keepdim = true} : tensor<4x1024xf32> -> tensor<4x1xf32>
+  return %0 : tensor<4x1xf32>
+}
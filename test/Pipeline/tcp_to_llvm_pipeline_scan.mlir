@@ -0,0 +1,32 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="fast-math=true" | FileCheck %s
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline | FileCheck %s --check-prefix=CHECK-STRICT
+
+// With fast-math, the row is split into 256 blocks of 4096 elements, which
+// are reduced with 8 partial sums per chunk, then the totals of the blocks are
+// scanned into their offsets, and finally each block is scanned after its
+// offset, with 25 independent adds per chunk of 8 elements.
+
+// CHECK-LABEL: llvm.func @main
+// CHECK-DAG:     %[[NUM_BLOCKS:.*]] = llvm.mlir.constant(256 : index) : i64
+// CHECK-DAG:     %[[BLOCK_SIZE:.*]] = llvm.mlir.constant(4096 : index) : i64
+// CHECK:         llvm.icmp "slt" %{{.*}}, %[[NUM_BLOCKS]] : i64
+// CHECK:         llvm.mul %{{.*}}, %[[BLOCK_SIZE]] : i64
+// CHECK-COUNT-8: llvm.fadd
+// CHECK:         llvm.icmp "slt" %{{.*}}, %[[NUM_BLOCKS]] : i64
+// CHECK:         llvm.fadd
+// CHECK:         llvm.icmp "slt" %{{.*}}, %[[NUM_BLOCKS]] : i64
+// CHECK:         llvm.mul %{{.*}}, %[[BLOCK_SIZE]] : i64
+// CHECK-COUNT-25: llvm.fadd
+// CHECK:       llvm.return
+
+// Otherwise, the row is scanned in order, with a single add per element.
+
+// CHECK-STRICT-LABEL: llvm.func @main
+// CHECK-STRICT-NOT:     llvm.mlir.constant(4096 : index)
+// CHECK-STRICT:         llvm.fadd
+// CHECK-STRICT-NOT:     llvm.fadd
+// CHECK-STRICT:       llvm.return
+func.func @main(%arg0: tensor<1048576xf32>) -> tensor<1048576xf32> {
+  %0 = tcp.cumsum %arg0 {dim = 0} : tensor<1048576xf32> -> tensor<1048576xf32>
+  return %0 : tensor<1048576xf32>
+}
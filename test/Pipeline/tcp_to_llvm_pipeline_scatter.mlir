@@ -0,0 +1,34 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="num-threads=4" -split-input-file | FileCheck %s
+
+// The rows of indices that are not known to be unique are scattered in order,
+// even with multiple threads, so that the last update of a repeated row wins.
+// Each row loads its index, and wraps it around the dim when it is negative.
+
+// CHECK-LABEL: llvm.func @scatter(
+// CHECK-NOT:     llvm.call @mlirAsyncRuntime
+// CHECK:         %[[INDEX:.*]] = llvm.load %{{.*}} : !llvm.ptr -> i64
+// CHECK:         %[[IS_NEGATIVE:.*]] = llvm.icmp "slt" %[[INDEX]], %{{.*}} : i64
+// CHECK:         llvm.select %[[IS_NEGATIVE]], %{{.*}}, %[[INDEX]] : i1, i64
+// CHECK-NOT:     llvm.call @mlirAsyncRuntime
+// CHECK:       llvm.return
+func.func @scatter(%arg0: tensor<25x4xf32>, %arg1: tensor<10x1xi64>, %arg2: tensor<10x4xf32>) -> tensor<25x4xf32> {
+  %0 = tcp.scatter %arg0, %arg1, %arg2 : tensor<25x4xf32>, tensor<10x1xi64>, tensor<10x4xf32> -> tensor<25x4xf32>
+  return %0 : tensor<25x4xf32>
+}
+
+// -----
+
+// Accumulations add each update to the current slice in order, so that the
+// updates of a repeated row are all summed.
+
+// CHECK-LABEL: llvm.func @scatter_accumulate(
+// CHECK-NOT:     llvm.call @mlirAsyncRuntime
+// CHECK:         %[[INDEX:.*]] = llvm.load %{{.*}} : !llvm.ptr -> i64
+// CHECK:         llvm.select %{{.*}}, %{{.*}}, %[[INDEX]] : i1, i64
+// CHECK:         llvm.fadd %{{.*}}, %{{.*}} : f32
+// CHECK-NOT:     llvm.call @mlirAsyncRuntime
+// CHECK:       llvm.return
+func.func @scatter_accumulate(%arg0: tensor<25x4xf32>, %arg1: tensor<10x1xi64>, %arg2: tensor<10x4xf32>) -> tensor<25x4xf32> {
+  %0 = tcp.scatter %arg0, %arg1, %arg2 {accumulate = true} : tensor<25x4xf32>, tensor<10x1xi64>, tensor<10x4xf32> -> tensor<25x4xf32>
+  return %0 : tensor<25x4xf32>
+}
@@ -0,0 +1,38 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline -split-input-file | FileCheck %s
+
+// Short rows are sorted with a sorting network, whose comparators are
+// straight-line selects without branches, before the sorted row is stored.
+
+// CHECK-LABEL: llvm.func @sort_network(
+// CHECK:         llvm.fcmp "olt" %{{.*}}, %{{.*}} : f32
+// CHECK-NOT:     llvm.cond_br
+// CHECK:         llvm.select %{{.*}}, %{{.*}}, %{{.*}} : i1, f32
+// CHECK-NOT:     llvm.cond_br
+// CHECK:         llvm.select %{{.*}}, %{{.*}}, %{{.*}} : i1, i64
+// CHECK-NOT:     llvm.cond_br
+// CHECK:         llvm.store
+// CHECK:       llvm.return
+func.func @sort_network(%arg0: tensor<8x16xf32>) -> (tensor<8x16xf32>, tensor<8x16xi64>) {
+  %values, %indices = tcp.sort %arg0 {dim = 1, stable = true} : tensor<8x16xf32> -> tensor<8x16xf32>, tensor<8x16xi64>
+  return %values, %indices : tensor<8x16xf32>, tensor<8x16xi64>
+}
+
+// -----
+
+// Longer rows are merge sorted. The runs are first sorted by insertion, which
+// branches on each comparison. Then, each pass merges pairs of runs of
+// `width` elements into runs of twice the width, until they span the row. The
+// merge itself picks the next element with selects, without branches.
+
+// CHECK-LABEL: llvm.func @sort_merge(
+// CHECK:         llvm.fcmp "ogt" %{{.*}}, %{{.*}} : f32
+// CHECK:         llvm.cond_br
+// CHECK:         llvm.add %[[WIDTH:.*]], %[[WIDTH]] : i64
+// CHECK:         llvm.fcmp "ogt" %{{.*}}, %{{.*}} : f32
+// CHECK-NOT:     llvm.cond_br
+// CHECK:         llvm.select %{{.*}}, %{{.*}}, %{{.*}} : i1, f32
+// CHECK:       llvm.return
+func.func @sort_merge(%arg0: tensor<8x4096xf32>) -> (tensor<8x4096xf32>, tensor<8x4096xi64>) {
+  %values, %indices = tcp.sort %arg0 {dim = 1, descending = true} : tensor<8x4096xf32> -> tensor<8x4096xf32>, tensor<8x4096xi64>
+  return %values, %indices : tensor<8x4096xf32>, tensor<8x4096xi64>
+}
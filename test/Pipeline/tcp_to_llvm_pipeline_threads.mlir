@@ -0,0 +1,11 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="num-threads=4" | FileCheck %s
+
+// CHECK-LABEL: llvm.func @main
+// CHECK:         llvm.call @mlirAsyncRuntimeCreateGroup
+// CHECK:         llvm.call @mlirAsyncRuntimeAwaitAllInGroup
+// CHECK:       llvm.return
+func.func @main(%arg0: tensor<?x?xf32>,
+                  %arg1: tensor<?x?xf32>) -> tensor<?x?xf32> {
+  %0 = tcp.add %arg0, %arg1 : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  return %0 : tensor<?x?xf32>
+}
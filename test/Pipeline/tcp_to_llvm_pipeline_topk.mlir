@@ -0,0 +1,18 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline | FileCheck %s
+
+// Each row is scanned once. Once the `k` slots are full, an element is only
+// compared with the last selected one, and it is inserted, shifting the
+// selected elements after it, only when it comes before it.
+
+// CHECK-LABEL: llvm.func @main
+// CHECK:         %[[IS_FULL:.*]] = llvm.icmp "uge" %{{.*}}, %{{.*}} : i64
+// CHECK:         llvm.cond_br %[[IS_FULL]]
+// CHECK:         llvm.fcmp "ogt" %{{.*}}, %{{.*}} : f32
+// CHECK:         llvm.intr.umin
+// CHECK:         llvm.fcmp "ogt" %{{.*}}, %{{.*}} : f32
+// CHECK:         llvm.cond_br
+// CHECK:       llvm.return
+func.func @main(%arg0: tensor<64x2304xf32>) -> (tensor<64x8xf32>, tensor<64x8xi64>) {
+  %values, %indices = tcp.topk %arg0 {k = 8, dim = 1} : tensor<64x2304xf32> -> tensor<64x8xf32>, tensor<64x8xi64>
+  return %values, %indices : tensor<64x8xf32>, tensor<64x8xi64>
+}
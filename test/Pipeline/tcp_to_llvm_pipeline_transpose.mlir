@@ -0,0 +1,16 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=true vector-width=256" | FileCheck %s
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=false" | FileCheck %s --check-prefix=CHECK-NOVEC
+
+// The 8x8 tiles of the transpose are transposed with a single shuffle.
+
+// CHECK-LABEL: llvm.func @main
+// CHECK:         llvm.shufflevector {{.*}} : vector<64xf32>
+// CHECK:       llvm.return
+
+// CHECK-NOVEC-LABEL: llvm.func @main
+// CHECK-NOVEC-NOT:     vector<
+// CHECK-NOVEC:       llvm.return
+func.func @main(%arg0: tensor<64x128xf32>) -> tensor<128x64xf32> {
+  %0 = tcp.transpose %arg0 {permutation = [1, 0]} : tensor<64x128xf32> -> tensor<128x64xf32>
+  return %0 : tensor<128x64xf32>
+}
@@ -0,0 +1,21 @@
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=true target-features=+avx2" | FileCheck %s
+// RUN: tcp-opt %s -tcp-to-llvm-pipeline="vectorize=true vector-width=128" | FileCheck %s --check-prefix=CHECK-128
+
+// CHECK-LABEL: llvm.func @main
+// CHECK-SAME:      target_features = #llvm.target_features<["+avx2"]>
+// CHECK:         llvm.fadd {{.*}} : vector<8xf32>
+// CHECK:         llvm.fmul {{.*}} : vector<8xf32>
+// CHECK:       llvm.return
+
+// CHECK-128-LABEL: llvm.func @main
+// CHECK-128-NOT:     target_features
+// CHECK-128:         llvm.fadd {{.*}} : vector<4xf32>
+// CHECK-128:         llvm.fmul {{.*}} : vector<4xf32>
+// CHECK-128:       llvm.return
+func.func @main(%arg0: tensor<?x?xf32>,
+                  %arg1: tensor<?x?xf32>,
+                  %arg2: tensor<?x?xf32>) -> tensor<?x?xf32> {
+  %0 = tcp.add %arg0, %arg1 : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  %1 = tcp.mul %0, %arg2 : tensor<?x?xf32>, tensor<?x?xf32> -> tensor<?x?xf32>
+  return %1 : tensor<?x?xf32>
+}
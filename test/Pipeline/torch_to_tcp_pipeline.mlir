@@ -135,3 +135,45 @@ func.func @torch.aten.div.Tensor$mixed_signed_int_div(%arg0: !torch.vtensor<[?,
   %0 = torch.aten.div.Tensor %arg0, %arg1 : !torch.vtensor<[?, ?],si16>, !torch.vtensor<[?, ?],ui32> -> !torch.vtensor<[?, ?],ui32>
   return %0 : !torch.vtensor<[?, ?],ui32>
 }
+
+// -----
+
+// A zero pad of the input of a convolution is folded into its padding.
+
+// CHECK-LABEL: func.func @torch.aten.constant_pad_nd$convolution(
+// CHECK-SAME:         %[[ARG0:.*]]: tensor<1x4x8x8xf32>, %[[ARG1:.*]]: tensor<8x4x3x3xf32>) -> tensor<1x8x8x8xf32>
+// CHECK-NOT:     tcp.pad
+// CHECK:         %[[CONV:.*]] = tcp.conv2d %[[ARG0]], %[[ARG1]] {dilation = [1, 1], groups = 1 : i64, padding = [1, 1], stride = [1, 1]} : tensor<1x4x8x8xf32>, tensor<8x4x3x3xf32> -> tensor<1x8x8x8xf32>
+// CHECK:         return %[[CONV]] : tensor<1x8x8x8xf32>
+func.func @torch.aten.constant_pad_nd$convolution(%arg0: !torch.vtensor<[1,4,8,8],f32>, %arg1: !torch.vtensor<[8,4,3,3],f32>) -> !torch.vtensor<[1,8,8,8],f32> {
+  %none = torch.constant.none
+  %false = torch.constant.bool false
+  %int0 = torch.constant.int 0
+  %int1 = torch.constant.int 1
+  %float0 = torch.constant.float 0.000000e+00
+  %pad = torch.prim.ListConstruct %int1, %int1, %int1, %int1 : (!torch.int, !torch.int, !torch.int, !torch.int) -> !torch.list<int>
+  %0 = torch.aten.constant_pad_nd %arg0, %pad, %float0 : !torch.vtensor<[1,4,8,8],f32>, !torch.list<int>, !torch.float -> !torch.vtensor<[1,4,10,10],f32>
+  %stride = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %padding = torch.prim.ListConstruct %int0, %int0 : (!torch.int, !torch.int) -> !torch.list<int>
+  %dilation = torch.prim.ListConstruct %int1, %int1 : (!torch.int, !torch.int) -> !torch.list<int>
+  %output_padding = torch.prim.ListConstruct %int0, %int0 : (!torch.int, !torch.int) -> !torch.list<int>
+  %1 = torch.aten.convolution %0, %arg1, %none, %stride, %padding, %dilation, %false, %output_padding, %int1 : !torch.vtensor<[1,4,10,10],f32>, !torch.vtensor<[8,4,3,3],f32>, !torch.none, !torch.list<int>, !torch.list<int>, !torch.list<int>, !torch.bool, !torch.list<int>, !torch.int -> !torch.vtensor<[1,8,8,8],f32>
+  return %1 : !torch.vtensor<[1,8,8,8],f32>
+}
+
+// -----
+
+// Index puts that TorchToTcp does not convert fall back to a custom op. The
+// index operands are named after their positions in the list of indices.
+
+// CHECK-LABEL: func.func @torch.aten._index_put_impl$none_index(
+// CHECK:         tcp.custom_op("torch.aten._index_put_impl")
+// CHECK-SAME:        torch_operand_names = ["self", "index_1", "values"]
+// CHECK-NOT:     tcp.scatter
+func.func @torch.aten._index_put_impl$none_index(%arg0: !torch.vtensor<[8,4],f32>, %arg1: !torch.vtensor<[2],si64>, %arg2: !torch.vtensor<[8,2],f32>) -> !torch.vtensor<[8,4],f32> {
+  %false = torch.constant.bool false
+  %none = torch.constant.none
+  %0 = torch.prim.ListConstruct %none, %arg1 : (!torch.none, !torch.vtensor<[2],si64>) -> !torch.list<optional<vtensor>>
+  %1 = torch.aten._index_put_impl %arg0, %0, %arg2, %false, %false : !torch.vtensor<[8,4],f32>, !torch.list<optional<vtensor>>, !torch.vtensor<[8,2],f32>, !torch.bool, !torch.bool -> !torch.vtensor<[8,4],f32>
+  return %1 : !torch.vtensor<[8,4],f32>
+}
@@ -41,6 +41,17 @@ using IndexTy = long;
 //   int64_t strides[N];
 //   ...
 // };
+//
+// The caller owns the returned buffers and must `free` their `basePtr`.
+//
+// When compiled with `-tcp-to-llvm-pipeline="destination-passing=true"`, the
+// same function instead has the ABI:
+//
+//   void func(DECL_RANK_1_MEMREF_ABI(float), DECL_RANK_2_MEMREF_ABI(float),
+//             DECL_RANK_2_MEMREF_ABI(float), DECL_RANK_3_MEMREF_ABI(float))
+//
+// where the trailing arguments are buffers, provided by the caller, that the
+// results are written into. They must have the shapes of the results.
 
 #define DECL_RANK_3_MEMREF_ABI(data_type)                                      \
   data_type *, data_type *, IndexTy, IndexTy, IndexTy, IndexTy, IndexTy,       \
@@ -12,6 +12,7 @@ def aot_compile(
         tcp_source = None,
         torch_loader_lib = None,
         torch_loader_path = "",
+        pipeline_options = {},
         skip_ci = False):
     """
     AOT compile Torch or TCP programs to a CPU library and execute it to
@@ -37,6 +38,13 @@ def aot_compile(
         the PyTorch program.
     torch_loader_path
         Full python import path (dot separated) to the torch_loader function.
+    pipeline_options
+        Dict of `tcp-to-llvm-pipeline` options, e.g.
+        `{"opt-level": "3", "target-features": "+avx2,+fma"}`. The target
+        features are also passed on to `llc`, and the MLIR async runtime is
+        linked in when the options enable multi-threading. With
+        `"destination-passing": "true"` the generated test passes
+        preallocated result buffers to the compiled function.
     skip_ci
         When `True`, skip execute tests from CI (and `bazel test //...` expansions).
 
@@ -71,7 +79,8 @@ def aot_compile(
             tcp dialect program (*_tcp.mlir) using `-torch-backend-to-tcp-backend-pipeline`.
         gen_foo_mlir_llvm:
             genrule that invokes `tcp-opt` to convert the tcp dialect program to the
-            llvm dialect program (*_llvm.mlir) using `-tcp-to-llvm-pipeline`.
+            llvm dialect program (*_llvm.mlir) using `-tcp-to-llvm-pipeline`
+            configured with `pipeline_options`.
         gen_foo_llvm_ir:
             genrule that invokes `mlir-translate` to convert the llvm dialect program to
             the llvm assembly (*.ll) using `-mlir-to-llvmir`.
@@ -104,6 +113,31 @@ def aot_compile(
 
     _name = "_internal_" + name
 
+    pipeline = "-tcp-to-llvm-pipeline"
+    if pipeline_options:
+        pipeline += "='" + " ".join([
+            key + "=" + value
+            for key, value in pipeline_options.items()
+        ]) + "'"
+
+    llc_flags = ""
+    target_features = pipeline_options.get("target-features", "")
+    if target_features:
+        llc_flags += " -mattr=" + target_features
+
+    # Multi-threaded code calls into the async runtime. This mirrors the
+    # defaults of the pipeline: O3 uses multiple threads.
+    num_threads = pipeline_options.get("num-threads", "")
+    if num_threads:
+        multi_threaded = int(num_threads) > 1
+    else:
+        multi_threaded = int(pipeline_options.get("opt-level", "0")) >= 3
+
+    # Results are passed in as trailing arguments with destination passing.
+    generator_flags = ""
+    if pipeline_options.get("destination-passing", "false") == "true":
+        generator_flags = " --destination_passing"
+
     # Use torch_export based compilation if tcp_source is not specified
     if not tcp_source:
         torch_exporter = name + "_torch_exporter"
@@ -160,7 +194,7 @@ def aot_compile(
         srcs = [tcp_source or (_name + "_tcp.mlir"), "//:tcp-opt"],
         outs = [_name + "_llvm.mlir"],
         cmd = "./$(location //:tcp-opt)" +
-              " -tcp-to-llvm-pipeline $(location " + (tcp_source or (_name + "_tcp.mlir")) + ")" +
+              " " + pipeline + " $(location " + (tcp_source or (_name + "_tcp.mlir")) + ")" +
               " > $(OUTS)",
     )
 
@@ -179,7 +213,8 @@ def aot_compile(
         name = "gen_" + name + "_host_asm",
         srcs = [_name + ".ll"],
         outs = [_name + ".S"],
-        cmd = "./$(location @llvm-project//llvm:llc) -O3 --relocation-model=pic < $(SRCS)" +
+        cmd = "./$(location @llvm-project//llvm:llc) -O3 --relocation-model=pic" +
+              llc_flags + " < $(SRCS)" +
               " > $(OUTS)",
         tools = ["@llvm-project//llvm:llc"],
     )
@@ -187,6 +222,7 @@ def aot_compile(
     cc_library(
         name = "aot_compiled_" + name,
         srcs = [_name + ".S"],
+        deps = ["@llvm-project//mlir:mlir_async_runtime"] if multi_threaded else [],
         # Can only be consumed (depended on) by test targets.
         # Prevents inadvertent use in a production usecase.
         testonly = True,
@@ -207,7 +243,7 @@ def aot_compile(
             args = [
                 "--test_template_path=$(location " + test_template_file + ")",
                 "--reference_tensors_path=$(location " + reference_tensors_file + ")",
-            ],
+            ] + (["--destination_passing"] if generator_flags else []),
             data = [
                 test_template_file,
                 reference_tensors_file,
@@ -224,6 +260,7 @@ def aot_compile(
             cmd = "./$(location " + execute_test_generator + ")" +
                   " --test_template_path=$(location " + test_template_file + ")" +
                   " --reference_tensors_path=$(location " + reference_tensors_file + ")" +
+                  generator_flags +
                   " > $(OUTS)",
             tools = [execute_test_generator],
         )
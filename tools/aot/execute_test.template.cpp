@@ -13,6 +13,10 @@
 #include "cnpy.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
 using namespace mlir::tcp;
 
 #pragma clang diagnostic ignored "-Wreturn-type-c-linkage"
@@ -76,6 +80,39 @@ CreateMemRefFromNpyArray(cnpy::NpyArray &arr) {
   return Result;
 }
 
+// Allocates a memref with the shape of `arr`, for functions compiled with
+// destination passing, which write their results into caller provided
+// buffers. The memref must be released with `free(Result.basePtr)`.
+template <typename DataType, int Rank>
+static StridedMemRefType<DataType, Rank>
+AllocateMemRefLike(cnpy::NpyArray &arr) {
+  StridedMemRefType<DataType, Rank> Result;
+  Result.basePtr = static_cast<DataType *>(
+      malloc(std::max<size_t>(arr.num_vals, 1) * sizeof(DataType)));
+  Result.data = Result.basePtr;
+  Result.offset = 0;
+
+  int stride = 1;
+  for (int i = Rank - 1; i >= 0; --i) {
+    Result.sizes[i] = arr.shape[i];
+    Result.strides[i] = stride;
+    stride *= arr.shape[i];
+  }
+
+  return Result;
+}
+
+// AllocateMemRefLike function specialized for rank 0
+template <typename DataType>
+static StridedMemRefType<DataType, 0>
+AllocateMemRefLike(cnpy::NpyArray &arr) {
+  StridedMemRefType<DataType, 0> Result;
+  Result.basePtr = static_cast<DataType *>(malloc(sizeof(DataType)));
+  Result.data = Result.basePtr;
+  Result.offset = 0;
+  return Result;
+}
+
 // ### DO NOT MODIFY ### //
 // This template file is pre-processed by `aot_compile` bazel macro
 // to materialize the templated parameters based on the inputs
@@ -86,12 +123,18 @@ struct OutputMemRefDescriptor {
   // StridedMemRefType<float, 2> Output0;
 };
 
-extern "C" OutputMemRefDescriptor func_main(
-    //##INPUT_MEMREF_ABI_DECLARATIONS##//
-    // DECL_RANK_2_MEMREF_ABI(float),
-    // DECL_RANK_2_MEMREF_ABI(float),
-    // DECL_RANK_2_MEMREF_ABI(float)
-);
+extern "C" //##FUNC_MAIN_RESULT_TYPE##//
+    // OutputMemRefDescriptor
+    // (void with destination passing)
+    func_main(
+        //##INPUT_MEMREF_ABI_DECLARATIONS##//
+        // DECL_RANK_2_MEMREF_ABI(float),
+        // DECL_RANK_2_MEMREF_ABI(float),
+        // DECL_RANK_2_MEMREF_ABI(float)
+        //##OUTPUT_MEMREF_ABI_DECLARATIONS##//
+        // (destination passing only)
+        // , DECL_RANK_2_MEMREF_ABI(float)
+    );
 
 TEST(AotCompiled, ExecuteTest) {
 
@@ -114,11 +157,19 @@ TEST(AotCompiled, ExecuteTest) {
   // StridedMemRefType<float, 2> Input2 =
   //     CreateMemRefFromNpyArray<float, 2>(refInput2);
 
-  OutputMemRefDescriptor Result = func_main(
+  //##ALLOCATE_RESULT_MEMREF##//
+  // OutputMemRefDescriptor Result = func_main(
+  // (with destination passing:)
+  // OutputMemRefDescriptor Result;
+  // Result.Output0 = AllocateMemRefLike<float, 2>(refOutput0);
+  // func_main(
       //##PASS_INPUT_MEMREF_ARGUMENTS##//
       // PASS_RANK_2_MEMREF(Input0),
       // PASS_RANK_2_MEMREF(Input1),
       // PASS_RANK_2_MEMREF(Input2)
+      //##PASS_OUTPUT_MEMREF_ARGUMENTS##//
+      // (destination passing only)
+      // , PASS_RANK_2_MEMREF(Result.Output0)
   );
 
   //##ASSERT_RESULT_SHAPE_MATCHES_REFERENCE##//
@@ -20,6 +20,12 @@ parser.add_argument(
     required=True,
     help="Path to the file containing the reference inputs and outputs (.npz)",
 )
+parser.add_argument(
+    "--destination_passing",
+    action="store_true",
+    help="Whether the program was compiled with destination passing, i.e. "
+    "writes its results into buffers provided by the caller",
+)
 
 NUMPY_TO_MEMREF_DTYPE_MAP = {
     # Add more mappings as needed
@@ -55,6 +61,9 @@ def main():
     # Track string substitutions
     input_memref_abi_declarations = []
     pass_input_memref_arguments = []
+    output_memref_abi_declarations = []
+    pass_output_memref_arguments = []
+    allocate_result_memref_str = ""
     create_memref_from_npy_array_str = ""
     output_memref_variable_declarations_str = ""
     assert_result_shape_matches_reference_str = ""
@@ -97,11 +106,36 @@ def main():
             for n in range(rank):
                 assert_result_shape_matches_reference_str += f"""
   ASSERT_EQ(Result.{key}.sizes[{n}], ref{key}.shape[{n}]);"""
-            expect_result_data_matches_reference_str += f"""
+            # NaNs compare unequal, so they are expected at the same positions
+            # as in the reference instead.
+            if dtype in ("float", "double"):
+                expect_result_data_matches_reference_str += f"""
+  for (int i = 0; i < ref{key}.num_vals; i++) {{
+    if (std::isnan(ref{key}.data<{dtype}>()[i]))
+      EXPECT_TRUE(std::isnan(Result.{key}.data[i]));
+    else
+      {MEMREF_DTYPE_TO_GTEST_ASSERT_MAP[dtype]}(Result.{key}.data[i], ref{key}.data<{dtype}>()[i]);
+  }}"""
+            else:
+                expect_result_data_matches_reference_str += f"""
   for (int i = 0; i < ref{key}.num_vals; i++)
     {MEMREF_DTYPE_TO_GTEST_ASSERT_MAP[dtype]}(Result.{key}.data[i], ref{key}.data<{dtype}>()[i]);"""
             deallocate_result_memref_str += f"""
   free(Result.{key}.basePtr);"""
+            output_memref_abi_declarations.append(
+                f"""
+        DECL_RANK_{rank}_MEMREF_ABI({dtype})"""
+            )
+            pass_output_memref_arguments.append(
+                f"""
+      PASS_RANK_{rank}_MEMREF(Result.{key})"""
+            )
+            if rank == 0:
+                allocate_result_memref_str += f"""
+  Result.{key} = AllocateMemRefLike<{dtype}>(ref{key});"""
+            else:
+                allocate_result_memref_str += f"""
+  Result.{key} = AllocateMemRefLike<{dtype}, {rank}>(ref{key});"""
 
         read_reference_tensors_into_npy_array_str += f"""
   cnpy::NpyArray ref{key} = reference_tensors["{key}"];"""
@@ -110,11 +144,33 @@ def main():
     input_memref_abi_declarations_str = ",".join(input_memref_abi_declarations)
     pass_input_memref_arguments_str = ",".join(pass_input_memref_arguments)
 
+    # With destination passing, the caller allocates the results and passes
+    # them after the inputs.
+    if args.destination_passing:
+        func_main_result_type_str = "void"
+        output_memref_abi_declarations_str = "," + ",".join(
+            output_memref_abi_declarations
+        )
+        pass_output_memref_arguments_str = "," + ",".join(
+            pass_output_memref_arguments
+        )
+        allocate_result_memref_str = f"""OutputMemRefDescriptor Result;{allocate_result_memref_str}
+  func_main("""
+    else:
+        func_main_result_type_str = "OutputMemRefDescriptor"
+        output_memref_abi_declarations_str = ""
+        pass_output_memref_arguments_str = ""
+        allocate_result_memref_str = "OutputMemRefDescriptor Result = func_main("
+
     substitutions = {
         r"//##OUTPUT_MEMREF_VARIABLE_DECLARATIONS##//": output_memref_variable_declarations_str,
+        r"//##FUNC_MAIN_RESULT_TYPE##//": func_main_result_type_str,
         r"//##INPUT_MEMREF_ABI_DECLARATIONS##//": input_memref_abi_declarations_str,
+        r"//##OUTPUT_MEMREF_ABI_DECLARATIONS##//": output_memref_abi_declarations_str,
         r"//##REFERENCE_TENSORS_PATH##//": reference_tensors_path_str,
+        r"//##ALLOCATE_RESULT_MEMREF##//": allocate_result_memref_str,
         r"//##PASS_INPUT_MEMREF_ARGUMENTS##//": pass_input_memref_arguments_str,
+        r"//##PASS_OUTPUT_MEMREF_ARGUMENTS##//": pass_output_memref_arguments_str,
         r"//##READ_REFERENCE_TENSORS_INTO_NPY_ARRAY##//": read_reference_tensors_into_npy_array_str,
         r"//##CREATE_MEMREF_FROM_NPY_ARRAY##//": create_memref_from_npy_array_str,
         r"//##ASSERT_RESULT_SHAPE_MATCHES_REFERENCE##//": assert_result_shape_matches_reference_str,